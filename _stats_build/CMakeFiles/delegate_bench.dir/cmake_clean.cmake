@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/delegate_bench.dir/bench/delegate_bench.cpp.o"
+  "CMakeFiles/delegate_bench.dir/bench/delegate_bench.cpp.o.d"
+  "delegate_bench"
+  "delegate_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/delegate_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/echo/main.cpp" "CMakeFiles/echo.dir/src/echo/main.cpp.o" "gcc" "CMakeFiles/echo.dir/src/echo/main.cpp.o.d"
+  "/root/repo/src/echo/server.cpp" "CMakeFiles/echo.dir/src/echo/server.cpp.o" "gcc" "CMakeFiles/echo.dir/src/echo/server.cpp.o.d"
+  "/root/repo/src/echo/session.cpp" "CMakeFiles/echo.dir/src/echo/session.cpp.o" "gcc" "CMakeFiles/echo.dir/src/echo/session.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_stats_build/CMakeFiles/io.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
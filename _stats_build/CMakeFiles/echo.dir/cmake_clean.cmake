@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/echo.dir/src/echo/main.cpp.o"
+  "CMakeFiles/echo.dir/src/echo/main.cpp.o.d"
+  "CMakeFiles/echo.dir/src/echo/server.cpp.o"
+  "CMakeFiles/echo.dir/src/echo/server.cpp.o.d"
+  "CMakeFiles/echo.dir/src/echo/session.cpp.o"
+  "CMakeFiles/echo.dir/src/echo/session.cpp.o.d"
+  "echo"
+  "echo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/echo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,40 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/io/acceptor.cpp" "CMakeFiles/io.dir/src/io/acceptor.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/acceptor.cpp.o.d"
+  "/root/repo/src/io/acceptor_base.cpp" "CMakeFiles/io.dir/src/io/acceptor_base.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/acceptor_base.cpp.o.d"
+  "/root/repo/src/io/addrinfo.cpp" "CMakeFiles/io.dir/src/io/addrinfo.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/addrinfo.cpp.o.d"
+  "/root/repo/src/io/bus.cpp" "CMakeFiles/io.dir/src/io/bus.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/bus.cpp.o.d"
+  "/root/repo/src/io/channel.cpp" "CMakeFiles/io.dir/src/io/channel.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/channel.cpp.o.d"
+  "/root/repo/src/io/context.cpp" "CMakeFiles/io.dir/src/io/context.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/context.cpp.o.d"
+  "/root/repo/src/io/context_pool.cpp" "CMakeFiles/io.dir/src/io/context_pool.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/context_pool.cpp.o.d"
+  "/root/repo/src/io/endianness.cpp" "CMakeFiles/io.dir/src/io/endianness.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/endianness.cpp.o.d"
+  "/root/repo/src/io/epoll.cpp" "CMakeFiles/io.dir/src/io/epoll.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/epoll.cpp.o.d"
+  "/root/repo/src/io/error.cpp" "CMakeFiles/io.dir/src/io/error.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/error.cpp.o.d"
+  "/root/repo/src/io/event_reciever.cpp" "CMakeFiles/io.dir/src/io/event_reciever.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/event_reciever.cpp.o.d"
+  "/root/repo/src/io/eventfd.cpp" "CMakeFiles/io.dir/src/io/eventfd.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/eventfd.cpp.o.d"
+  "/root/repo/src/io/flags.cpp" "CMakeFiles/io.dir/src/io/flags.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/flags.cpp.o.d"
+  "/root/repo/src/io/object.cpp" "CMakeFiles/io.dir/src/io/object.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/object.cpp.o.d"
+  "/root/repo/src/io/session_base.cpp" "CMakeFiles/io.dir/src/io/session_base.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/session_base.cpp.o.d"
+  "/root/repo/src/io/session_manager.cpp" "CMakeFiles/io.dir/src/io/session_manager.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/session_manager.cpp.o.d"
+  "/root/repo/src/io/socket.cpp" "CMakeFiles/io.dir/src/io/socket.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/socket.cpp.o.d"
+  "/root/repo/src/io/socket_options.cpp" "CMakeFiles/io.dir/src/io/socket_options.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/socket_options.cpp.o.d"
+  "/root/repo/src/io/stats.cpp" "CMakeFiles/io.dir/src/io/stats.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/stats.cpp.o.d"
+  "/root/repo/src/io/timer_wheel.cpp" "CMakeFiles/io.dir/src/io/timer_wheel.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/timer_wheel.cpp.o.d"
+  "/root/repo/src/io/uring.cpp" "CMakeFiles/io.dir/src/io/uring.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/uring.cpp.o.d"
+  "/root/repo/src/io/v4.cpp" "CMakeFiles/io.dir/src/io/v4.cpp.o" "gcc" "CMakeFiles/io.dir/src/io/v4.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
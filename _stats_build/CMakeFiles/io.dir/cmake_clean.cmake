@@ -0,0 +1,53 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/io.dir/src/io/acceptor.cpp.o"
+  "CMakeFiles/io.dir/src/io/acceptor.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/acceptor_base.cpp.o"
+  "CMakeFiles/io.dir/src/io/acceptor_base.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/addrinfo.cpp.o"
+  "CMakeFiles/io.dir/src/io/addrinfo.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/bus.cpp.o"
+  "CMakeFiles/io.dir/src/io/bus.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/channel.cpp.o"
+  "CMakeFiles/io.dir/src/io/channel.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/context.cpp.o"
+  "CMakeFiles/io.dir/src/io/context.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/context_pool.cpp.o"
+  "CMakeFiles/io.dir/src/io/context_pool.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/endianness.cpp.o"
+  "CMakeFiles/io.dir/src/io/endianness.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/epoll.cpp.o"
+  "CMakeFiles/io.dir/src/io/epoll.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/error.cpp.o"
+  "CMakeFiles/io.dir/src/io/error.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/event_reciever.cpp.o"
+  "CMakeFiles/io.dir/src/io/event_reciever.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/eventfd.cpp.o"
+  "CMakeFiles/io.dir/src/io/eventfd.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/flags.cpp.o"
+  "CMakeFiles/io.dir/src/io/flags.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/object.cpp.o"
+  "CMakeFiles/io.dir/src/io/object.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/session_base.cpp.o"
+  "CMakeFiles/io.dir/src/io/session_base.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/session_manager.cpp.o"
+  "CMakeFiles/io.dir/src/io/session_manager.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/socket.cpp.o"
+  "CMakeFiles/io.dir/src/io/socket.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/socket_options.cpp.o"
+  "CMakeFiles/io.dir/src/io/socket_options.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/stats.cpp.o"
+  "CMakeFiles/io.dir/src/io/stats.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/timer_wheel.cpp.o"
+  "CMakeFiles/io.dir/src/io/timer_wheel.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/uring.cpp.o"
+  "CMakeFiles/io.dir/src/io/uring.cpp.o.d"
+  "CMakeFiles/io.dir/src/io/v4.cpp.o"
+  "CMakeFiles/io.dir/src/io/v4.cpp.o.d"
+  "libio.a"
+  "libio.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/io.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
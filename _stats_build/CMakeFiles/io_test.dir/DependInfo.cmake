@@ -0,0 +1,51 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/acceptor_base_test.cpp" "CMakeFiles/io_test.dir/tests/acceptor_base_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/acceptor_base_test.cpp.o.d"
+  "/root/repo/tests/acceptor_test.cpp" "CMakeFiles/io_test.dir/tests/acceptor_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/acceptor_test.cpp.o.d"
+  "/root/repo/tests/addrinfo_test.cpp" "CMakeFiles/io_test.dir/tests/addrinfo_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/addrinfo_test.cpp.o.d"
+  "/root/repo/tests/bus_test.cpp" "CMakeFiles/io_test.dir/tests/bus_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/bus_test.cpp.o.d"
+  "/root/repo/tests/channel_test.cpp" "CMakeFiles/io_test.dir/tests/channel_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/channel_test.cpp.o.d"
+  "/root/repo/tests/context_pool_test.cpp" "CMakeFiles/io_test.dir/tests/context_pool_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/context_pool_test.cpp.o.d"
+  "/root/repo/tests/context_test.cpp" "CMakeFiles/io_test.dir/tests/context_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/context_test.cpp.o.d"
+  "/root/repo/tests/delegate_test.cpp" "CMakeFiles/io_test.dir/tests/delegate_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/delegate_test.cpp.o.d"
+  "/root/repo/tests/endianness_test.cpp" "CMakeFiles/io_test.dir/tests/endianness_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/endianness_test.cpp.o.d"
+  "/root/repo/tests/epoll_test.cpp" "CMakeFiles/io_test.dir/tests/epoll_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/epoll_test.cpp.o.d"
+  "/root/repo/tests/error_test.cpp" "CMakeFiles/io_test.dir/tests/error_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/error_test.cpp.o.d"
+  "/root/repo/tests/eventfd_test.cpp" "CMakeFiles/io_test.dir/tests/eventfd_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/eventfd_test.cpp.o.d"
+  "/root/repo/tests/flags_bitwise_and_test.cpp" "CMakeFiles/io_test.dir/tests/flags_bitwise_and_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/flags_bitwise_and_test.cpp.o.d"
+  "/root/repo/tests/flags_bitwise_or_test.cpp" "CMakeFiles/io_test.dir/tests/flags_bitwise_or_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/flags_bitwise_or_test.cpp.o.d"
+  "/root/repo/tests/flags_ostream_test.cpp" "CMakeFiles/io_test.dir/tests/flags_ostream_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/flags_ostream_test.cpp.o.d"
+  "/root/repo/tests/input_object_test.cpp" "CMakeFiles/io_test.dir/tests/input_object_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/input_object_test.cpp.o.d"
+  "/root/repo/tests/io_object_test.cpp" "CMakeFiles/io_test.dir/tests/io_object_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/io_object_test.cpp.o.d"
+  "/root/repo/tests/mock/acceptor_base_mock.cpp" "CMakeFiles/io_test.dir/tests/mock/acceptor_base_mock.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/mock/acceptor_base_mock.cpp.o.d"
+  "/root/repo/tests/mock/bus_mock.cpp" "CMakeFiles/io_test.dir/tests/mock/bus_mock.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/mock/bus_mock.cpp.o.d"
+  "/root/repo/tests/mock/object_mock.cpp" "CMakeFiles/io_test.dir/tests/mock/object_mock.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/mock/object_mock.cpp.o.d"
+  "/root/repo/tests/mock/session_base_mock.cpp" "CMakeFiles/io_test.dir/tests/mock/session_base_mock.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/mock/session_base_mock.cpp.o.d"
+  "/root/repo/tests/mock/session_manager_mock.cpp" "CMakeFiles/io_test.dir/tests/mock/session_manager_mock.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/mock/session_manager_mock.cpp.o.d"
+  "/root/repo/tests/mpsc_queue_test.cpp" "CMakeFiles/io_test.dir/tests/mpsc_queue_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/mpsc_queue_test.cpp.o.d"
+  "/root/repo/tests/object_base_test.cpp" "CMakeFiles/io_test.dir/tests/object_base_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/object_base_test.cpp.o.d"
+  "/root/repo/tests/output_object_test.cpp" "CMakeFiles/io_test.dir/tests/output_object_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/output_object_test.cpp.o.d"
+  "/root/repo/tests/session_base_test.cpp" "CMakeFiles/io_test.dir/tests/session_base_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/session_base_test.cpp.o.d"
+  "/root/repo/tests/session_manager_test.cpp" "CMakeFiles/io_test.dir/tests/session_manager_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/session_manager_test.cpp.o.d"
+  "/root/repo/tests/socket_test.cpp" "CMakeFiles/io_test.dir/tests/socket_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/socket_test.cpp.o.d"
+  "/root/repo/tests/stats_test.cpp" "CMakeFiles/io_test.dir/tests/stats_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/stats_test.cpp.o.d"
+  "/root/repo/tests/timer_wheel_test.cpp" "CMakeFiles/io_test.dir/tests/timer_wheel_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/timer_wheel_test.cpp.o.d"
+  "/root/repo/tests/uring_test.cpp" "CMakeFiles/io_test.dir/tests/uring_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/uring_test.cpp.o.d"
+  "/root/repo/tests/v4_test.cpp" "CMakeFiles/io_test.dir/tests/v4_test.cpp.o" "gcc" "CMakeFiles/io_test.dir/tests/v4_test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_stats_build/CMakeFiles/io.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
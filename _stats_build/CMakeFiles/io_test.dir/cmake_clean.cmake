@@ -0,0 +1,73 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/io_test.dir/tests/acceptor_base_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/acceptor_base_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/acceptor_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/acceptor_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/addrinfo_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/addrinfo_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/bus_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/bus_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/channel_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/channel_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/context_pool_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/context_pool_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/context_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/context_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/delegate_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/delegate_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/endianness_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/endianness_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/epoll_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/epoll_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/error_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/error_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/eventfd_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/eventfd_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/flags_bitwise_and_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/flags_bitwise_and_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/flags_bitwise_or_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/flags_bitwise_or_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/flags_ostream_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/flags_ostream_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/input_object_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/input_object_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/io_object_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/io_object_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/mock/acceptor_base_mock.cpp.o"
+  "CMakeFiles/io_test.dir/tests/mock/acceptor_base_mock.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/mock/bus_mock.cpp.o"
+  "CMakeFiles/io_test.dir/tests/mock/bus_mock.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/mock/object_mock.cpp.o"
+  "CMakeFiles/io_test.dir/tests/mock/object_mock.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/mock/session_base_mock.cpp.o"
+  "CMakeFiles/io_test.dir/tests/mock/session_base_mock.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/mock/session_manager_mock.cpp.o"
+  "CMakeFiles/io_test.dir/tests/mock/session_manager_mock.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/mpsc_queue_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/mpsc_queue_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/object_base_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/object_base_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/output_object_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/output_object_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/session_base_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/session_base_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/session_manager_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/session_manager_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/socket_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/socket_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/stats_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/stats_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/timer_wheel_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/timer_wheel_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/uring_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/uring_test.cpp.o.d"
+  "CMakeFiles/io_test.dir/tests/v4_test.cpp.o"
+  "CMakeFiles/io_test.dir/tests/v4_test.cpp.o.d"
+  "io_test"
+  "io_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/io_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
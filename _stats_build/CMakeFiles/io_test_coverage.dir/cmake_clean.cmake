@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/io_test_coverage"
+  "io_test_coverage.base"
+  "io_test_coverage.capture"
+  "io_test_coverage.info"
+  "io_test_coverage.total"
+  "io_test_coverage/index.html"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/io_test_coverage.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,33 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/psql_proxy/data_processor.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/data_processor.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/data_processor.cpp.o.d"
+  "/root/repo/src/psql_proxy/endianness.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/endianness.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/endianness.cpp.o.d"
+  "/root/repo/src/psql_proxy/file_writer.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/file_writer.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/file_writer.cpp.o.d"
+  "/root/repo/src/psql_proxy/handler.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/handler.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/handler.cpp.o.d"
+  "/root/repo/src/psql_proxy/main.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/main.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/main.cpp.o.d"
+  "/root/repo/src/psql_proxy/message.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/message.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/message.cpp.o.d"
+  "/root/repo/src/psql_proxy/message_logger.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/message_logger.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/message_logger.cpp.o.d"
+  "/root/repo/src/psql_proxy/protocol/parameter_status.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/parameter_status.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/parameter_status.cpp.o.d"
+  "/root/repo/src/psql_proxy/protocol/query.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/query.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/query.cpp.o.d"
+  "/root/repo/src/psql_proxy/protocol/startup_message.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/startup_message.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/startup_message.cpp.o.d"
+  "/root/repo/src/psql_proxy/protocol/terminate.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/terminate.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/terminate.cpp.o.d"
+  "/root/repo/src/psql_proxy/query_processor.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/query_processor.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/query_processor.cpp.o.d"
+  "/root/repo/src/psql_proxy/server.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/server.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/server.cpp.o.d"
+  "/root/repo/src/psql_proxy/session.cpp" "CMakeFiles/psql_proxy.dir/src/psql_proxy/session.cpp.o" "gcc" "CMakeFiles/psql_proxy.dir/src/psql_proxy/session.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_stats_build/CMakeFiles/io.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
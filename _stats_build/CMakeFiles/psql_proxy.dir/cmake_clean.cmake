@@ -0,0 +1,37 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/data_processor.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/data_processor.cpp.o.d"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/endianness.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/endianness.cpp.o.d"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/file_writer.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/file_writer.cpp.o.d"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/handler.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/handler.cpp.o.d"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/main.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/main.cpp.o.d"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/message.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/message.cpp.o.d"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/message_logger.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/message_logger.cpp.o.d"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/parameter_status.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/parameter_status.cpp.o.d"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/query.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/query.cpp.o.d"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/startup_message.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/startup_message.cpp.o.d"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/terminate.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/protocol/terminate.cpp.o.d"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/query_processor.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/query_processor.cpp.o.d"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/server.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/server.cpp.o.d"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/session.cpp.o"
+  "CMakeFiles/psql_proxy.dir/src/psql_proxy/session.cpp.o.d"
+  "psql_proxy"
+  "psql_proxy.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/psql_proxy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
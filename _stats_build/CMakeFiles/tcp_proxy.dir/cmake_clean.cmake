@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tcp_proxy.dir/src/tcp_proxy/main.cpp.o"
+  "CMakeFiles/tcp_proxy.dir/src/tcp_proxy/main.cpp.o.d"
+  "CMakeFiles/tcp_proxy.dir/src/tcp_proxy/server.cpp.o"
+  "CMakeFiles/tcp_proxy.dir/src/tcp_proxy/server.cpp.o.d"
+  "CMakeFiles/tcp_proxy.dir/src/tcp_proxy/session.cpp.o"
+  "CMakeFiles/tcp_proxy.dir/src/tcp_proxy/session.cpp.o.d"
+  "tcp_proxy"
+  "tcp_proxy.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tcp_proxy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
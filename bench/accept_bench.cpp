@@ -0,0 +1,122 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+/// @brief The connection churn benchmark of the io::ip::tcp::acceptor.
+/// The client threads connect and reset the connections in a loop like the clients do
+/// in a reconnect storm after a failover, the accepted connections per second are reported
+/// for the one connection per wakeup and for the batched accept.
+
+#include <io/acceptor.hpp>
+#include <io/endpoint.hpp>
+#include <io/epoll.hpp>
+#include <io/v4.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    /// @brief Connect and reset the connections until the \p stop is requested
+    /// @param target The acceptor address
+    /// @param stop The stop flag
+    /// @param connects The successful connects counter
+    void churn(const io::ip::endpoint &target, const std::atomic_bool &stop, std::atomic_size_t &connects)
+    {
+        // reset the connection on close to avoid the TIME_WAIT ports exhaustion
+        const linger reset{1, 0};
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            io::file_descriptor_t fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (-1 == fd)
+            {
+                continue;
+            }
+            ::setsockopt(fd, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+            if (0 == ::connect(fd, target.data(), target.size()))
+            {
+                connects.fetch_add(1, std::memory_order_relaxed);
+            }
+            ::close(fd);
+        }
+    }
+
+    void bench_accept(const io::ip::v4 &address, std::size_t batch, std::size_t clients, std::chrono::seconds duration)
+    {
+        auto bus = std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
+        std::size_t accepted = 0;
+        std::size_t wakeups = 0;
+        io::ip::tcp::acceptor acceptor(
+            bus,
+            address, 4096,
+            [&](io::file_descriptor_t fd, const io::ip::endpoint &)
+            {
+                ++accepted;
+                ::close(fd);
+            });
+        acceptor.set_accept_batch(batch);
+
+        std::atomic_bool stop{false};
+        std::atomic_size_t connects{0};
+        const io::ip::endpoint target(address);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < clients; ++i)
+        {
+            threads.emplace_back(churn, std::cref(target), std::cref(stop), std::ref(connects));
+        }
+
+        const auto start = clock_type::now();
+        while (clock_type::now() - start < duration)
+        {
+            bus->wait_events(
+                std::chrono::milliseconds{10},
+                64,
+                [](io::event_reciever *, const io::error &error)
+                {
+                    std::cerr << error.what() << "; errno = " << error.get_errno() << std::endl;
+                });
+            ++wakeups;
+        }
+        const double elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+        stop.store(true);
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        std::cout << "accept batch " << std::setw(4) << batch
+                  << ": " << std::setw(10) << std::fixed << std::setprecision(0) << accepted / elapsed << " accepts/sec"
+                  << std::setw(10) << connects.load() / elapsed << " connects/sec"
+                  << std::setw(8) << std::setprecision(2) << static_cast<double>(accepted) / wakeups << " accepts/wakeup"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::chrono::seconds duration{3};
+    std::size_t clients = 4;
+    if (argc > 1)
+    {
+        duration = std::chrono::seconds{std::stoul(argv[1])};
+    }
+    if (argc > 2)
+    {
+        clients = std::stoul(argv[2]);
+    }
+    const io::ip::v4 address{"127.0.0.1", "23457"};
+    bench_accept(address, 1, clients, duration);
+    bench_accept(address, io::ip::acceptor_base::DEFAULT_ACCEPT_BATCH, clients, duration);
+    return 0;
+}
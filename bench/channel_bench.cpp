@@ -0,0 +1,144 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+/// @brief The forwarding throughput benchmark of the io::channel.
+/// The writer thread streams the data to one loopback TCP connection, the channel forwards it
+/// to the other one and the reader thread drains it, like the large result set goes through the proxy.
+/// The throughput is reported for the copy through the user space buffer and for the splice through the pipe.
+
+#include <io/channel.hpp>
+#include <io/epoll.hpp>
+#include <io/socket.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    /// @brief Open the loopback TCP connection
+    /// @param listener The listening socket
+    /// @param address The listening socket address
+    /// @return The connected and the accepted sockets
+    std::pair<int, int> connect_pair(int listener, const sockaddr_in &address)
+    {
+        const int client = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (-1 == client || -1 == ::connect(client, reinterpret_cast<const sockaddr *>(&address), sizeof(address)))
+        {
+            throw io::error("failed to connect", client, errno);
+        }
+        const int server = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (-1 == server)
+        {
+            throw io::error("failed to accept", listener, errno);
+        }
+        return {client, server};
+    }
+
+    void bench_channel(bool is_splice_enabled, std::size_t total)
+    {
+        const int listener = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        const int reuse = 1;
+        ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(23464);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (-1 == ::bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) || -1 == ::listen(listener, 4))
+        {
+            throw io::error("failed to listen", listener, errno);
+        }
+        // the writer -> input, output -> reader
+        const auto [writer_fd, input_fd] = connect_pair(listener, address);
+        const auto [output_fd, reader_fd] = connect_pair(listener, address);
+        ::close(listener);
+
+        auto bus = std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
+        // the channel sides are non-blocking, the peers block
+        ::fcntl(input_fd, F_SETFL, O_NONBLOCK);
+        ::fcntl(output_fd, F_SETFL, O_NONBLOCK);
+        auto input = std::make_shared<io::ip::tcp::socket>(bus, input_fd);
+        auto output = std::make_shared<io::ip::tcp::socket>(bus, output_fd);
+        auto channel = io::make_channel(input, output);
+        channel->set_splice_enabled(is_splice_enabled);
+
+        std::atomic_bool done{false};
+        const auto start = clock_type::now();
+        std::thread writer(
+            [&, fd = writer_fd]()
+            {
+                std::vector<char> chunk(256 * 1024, 'x');
+                for (std::size_t sent = 0; sent < total;)
+                {
+                    const ssize_t n = ::send(fd, chunk.data(), std::min(chunk.size(), total - sent), MSG_NOSIGNAL);
+                    if (n <= 0)
+                    {
+                        break;
+                    }
+                    sent += static_cast<std::size_t>(n);
+                }
+            });
+        std::thread reader(
+            [&, fd = reader_fd]()
+            {
+                std::vector<char> chunk(256 * 1024);
+                for (std::size_t recieved = 0; recieved < total;)
+                {
+                    const ssize_t n = ::recv(fd, chunk.data(), chunk.size(), 0);
+                    if (n <= 0)
+                    {
+                        break;
+                    }
+                    recieved += static_cast<std::size_t>(n);
+                }
+                done.store(true);
+            });
+
+        while (!done.load())
+        {
+            bus->wait_events(
+                std::chrono::milliseconds{10},
+                64,
+                [](io::event_reciever *, const io::error &error)
+                {
+                    std::cerr << error.what() << "; errno = " << error.get_errno() << std::endl;
+                });
+        }
+        const double elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+        writer.join();
+        reader.join();
+        ::close(writer_fd);
+        ::close(reader_fd);
+
+        std::cout << (channel->is_splice_mode() ? "splice" : "copy  ")
+                  << ": " << std::setw(10) << std::fixed << std::setprecision(1) << total / elapsed / (1024 * 1024) << " MiB/sec"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t total = std::size_t{1} << 30;
+    if (argc > 1)
+    {
+        total = std::stoul(argv[1]) << 20;
+    }
+    bench_channel(false, total);
+    bench_channel(true, total);
+    return 0;
+}
@@ -0,0 +1,183 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+/// @brief The io::delegate versus std::function dispatch cost microbenchmark.
+/// It also counts the heap allocations of the io::bus event loop iteration.
+
+#include <io/bus.hpp>
+#include <io/delegate.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::atomic_size_t allocations{0};
+}
+
+void *operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    /// @brief The \ref io::bus implementation reporting the deferred events only
+    class null_bus final
+        : public io::bus
+    {
+    private:
+        void _add_fd(io::file_descriptor_t, handle_t) override {}
+        void _del_fd(io::file_descriptor_t) override {}
+        void _set_output_interest(io::file_descriptor_t, handle_t, bool) override {}
+        void _wait_events(std::chrono::milliseconds, std::size_t) override {}
+    };
+
+    /// @brief The object with the shared pointer capture like io::channel callbacks have
+    struct target
+        : std::enable_shared_from_this<target>
+    {
+        std::size_t counter = 0;
+        void handle(io::event_reciever *, io::file_descriptor_t fd, io::flags)
+        {
+            counter += static_cast<std::size_t>(fd);
+        }
+    };
+
+    void report(const std::string &name, clock_type::duration elapsed, std::size_t iterations, std::size_t allocs)
+    {
+        const double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+        std::cout << std::left << std::setw(44) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(2) << ns << " ns/op"
+                  << std::setw(12) << std::setprecision(3) << static_cast<double>(allocs) / iterations << " allocs/op"
+                  << std::endl;
+    }
+
+    template <typename Callback>
+    void bench_make_and_call(const std::string &name, std::size_t iterations)
+    {
+        auto self = std::make_shared<target>();
+        target *raw = self.get();
+        const std::size_t allocs_before = allocations.load();
+        const auto start = clock_type::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            Callback cb = [raw, self](io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask)
+            {
+                raw->handle(reciever, fd, mask);
+            };
+            Callback moved = std::move(cb);
+            moved(nullptr, 1, io::flags::in);
+        }
+        report(name, clock_type::now() - start, iterations, allocations.load() - allocs_before);
+    }
+
+    template <typename Callback>
+    void bench_call(const std::string &name, std::size_t iterations)
+    {
+        auto self = std::make_shared<target>();
+        target *raw = self.get();
+        std::vector<Callback> callbacks;
+        for (int i = 0; i < 64; ++i)
+        {
+            callbacks.emplace_back(
+                [raw, self](io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask)
+                {
+                    raw->handle(reciever, fd, mask);
+                });
+        }
+        const std::size_t allocs_before = allocations.load();
+        const auto start = clock_type::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            callbacks[i & 63](nullptr, static_cast<io::file_descriptor_t>(i & 1), io::flags::in);
+        }
+        report(name, clock_type::now() - start, iterations, allocations.load() - allocs_before);
+        if (0 == raw->counter)
+        {
+            std::cout << "unexpected counter value" << std::endl;
+        }
+    }
+
+    void bench_bus_loop(std::size_t fds_count, std::size_t iterations)
+    {
+        auto bus = std::make_shared<null_bus>();
+        auto self = std::make_shared<target>();
+        target *raw = self.get();
+        for (std::size_t fd = 0; fd < fds_count; ++fd)
+        {
+            bus->add_fd(
+                static_cast<io::file_descriptor_t>(fd),
+                [raw, self](io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask)
+                {
+                    raw->handle(reciever, fd, mask);
+                });
+        }
+        io::bus::error_callback_t on_error = [](io::event_reciever *, const io::error &error)
+        {
+            std::cerr << error.what() << std::endl;
+        };
+        // warm up the internal buffers
+        for (std::size_t fd = 0; fd < fds_count; ++fd)
+        {
+            bus->enqueue_event(static_cast<io::file_descriptor_t>(fd), io::flags::in);
+        }
+        bus->wait_events(std::chrono::milliseconds{0}, fds_count, on_error);
+
+        const std::size_t allocs_before = allocations.load();
+        const auto start = clock_type::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            for (std::size_t fd = 0; fd < fds_count; ++fd)
+            {
+                bus->enqueue_event(static_cast<io::file_descriptor_t>(fd), io::flags::in);
+            }
+            bus->wait_events(std::chrono::milliseconds{0}, fds_count, on_error);
+        }
+        report("io::bus enqueue + dispatch (" + std::to_string(fds_count) + " fds)",
+               clock_type::now() - start, iterations * fds_count, allocations.load() - allocs_before);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t iterations = 10000000;
+    if (argc > 1)
+    {
+        iterations = std::stoul(argv[1]);
+    }
+    using bus_delegate_t = io::bus::callback_t;
+    using bus_function_t = std::function<void(io::event_reciever *, io::file_descriptor_t, io::flags)>;
+
+    bench_make_and_call<bus_function_t>("std::function construct + move + call", iterations);
+    bench_make_and_call<bus_delegate_t>("io::delegate construct + move + call", iterations);
+    bench_call<bus_function_t>("std::function call", iterations);
+    bench_call<bus_delegate_t>("io::delegate call", iterations);
+    bench_bus_loop(1000, iterations / 1000);
+    return 0;
+}
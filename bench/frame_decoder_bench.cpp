@@ -0,0 +1,177 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+/// @brief The parse throughput benchmark of the psql::frame_decoder.
+/// The client stream is either read from the captured traffic file (the raw bytes the client sent,
+/// starting from the startup message) or synthesized: the pipelined extended query protocol traffic
+/// and the COPY FROM STDIN traffic with the row and the batch sized messages.
+/// The stream is fed in the chunks of the socket reads size.
+/// The "decode all" lines inspect every message and decode it with psql::make_message,
+/// the difference to the pass through lines is the message decoding cost.
+
+#include <psql_proxy/frame_decoder.hpp>
+#include <psql_proxy/message.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    void append_uint32(std::vector<std::byte> &stream, std::uint32_t value)
+    {
+        for (int shift = 24; shift >= 0; shift -= 8)
+        {
+            stream.push_back(std::byte(value >> shift));
+        }
+    }
+
+    void append_frame(std::vector<std::byte> &stream, char code, const std::string &payload)
+    {
+        if ('\0' != code)
+        {
+            stream.push_back(std::byte(code));
+        }
+        append_uint32(stream, static_cast<std::uint32_t>(payload.size() + sizeof(std::uint32_t)));
+        for (char c : payload)
+        {
+            stream.push_back(std::byte(c));
+        }
+    }
+
+    std::vector<std::byte> make_startup()
+    {
+        std::vector<std::byte> stream;
+        append_frame(stream, '\0', std::string("\0\3\0\0user\0postgres\0database\0bench\0\0", 36));
+        return stream;
+    }
+
+    /// @brief The Parse/Bind/Execute/Sync batches mixed with the simple queries
+    std::vector<std::byte> make_extended_stream(std::size_t total)
+    {
+        std::vector<std::byte> stream = make_startup();
+        const std::string query("select id, name, balance from accounts where id = $1;\0", 54);
+        while (stream.size() < total)
+        {
+            append_frame(stream, 'P', std::string("\0", 1) + query + std::string("\0\0", 2));
+            append_frame(stream, 'B', std::string("\0\0\0\0\0\1\0\0\0\x08" "12345678\0\0", 20));
+            append_frame(stream, 'E', std::string("\0\0\0\0\0", 5));
+            append_frame(stream, 'S', std::string());
+            append_frame(stream, 'Q', query);
+        }
+        return stream;
+    }
+
+    /// @brief The COPY FROM STDIN with the CopyData messages of the \p row_len
+    std::vector<std::byte> make_copy_stream(std::size_t total, std::size_t row_len)
+    {
+        std::vector<std::byte> stream = make_startup();
+        append_frame(stream, 'Q', std::string("copy accounts from stdin;\0", 26));
+        const std::string rows(row_len, 'x');
+        while (stream.size() < total)
+        {
+            append_frame(stream, 'd', rows);
+        }
+        append_frame(stream, 'c', std::string());
+        return stream;
+    }
+
+    void bench_decoder(const std::string &name, const std::vector<std::byte> &stream, std::size_t chunk_sz, std::size_t rounds, bool decode_all = false)
+    {
+        psql::frame_decoder::codes_t codes;
+        codes.set(0);
+        codes.set('Q');
+        codes.set('X');
+        if (decode_all)
+        {
+            codes.set();
+        }
+        std::size_t inspected_len = 0;
+        std::uint64_t messages_count = 0;
+        std::uint64_t frames_count = 0;
+        std::uint64_t reassembled_bytes = 0;
+
+        const auto start = clock_type::now();
+        for (std::size_t round = 0; round < rounds; ++round)
+        {
+            psql::frame_decoder decoder(
+                codes,
+                [&inspected_len, &messages_count, decode_all](const psql::frame_decoder::frame &frame)
+                {
+                    inspected_len += frame.payload_len;
+                    if (decode_all && psql::make_message(frame.code, frame.payload, frame.payload_len))
+                    {
+                        ++messages_count;
+                    }
+                });
+            for (std::size_t pos = 0; pos < stream.size(); pos += chunk_sz)
+            {
+                decoder.decode(stream.data() + pos, std::min(chunk_sz, stream.size() - pos));
+            }
+            frames_count += decoder.get_frames_count();
+            reassembled_bytes += decoder.get_reassembled_bytes();
+        }
+        const double elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+        const double total = static_cast<double>(stream.size()) * rounds;
+
+        std::cout << std::left << std::setw(10) << name << (decode_all ? " decode all" : "") << " chunk " << std::right << std::setw(6) << chunk_sz
+                  << ": " << std::setw(7) << std::fixed << std::setprecision(2) << total / elapsed / 1e9 << " GB/sec; "
+                  << std::setw(7) << std::setprecision(1) << frames_count / elapsed / 1e6 << " M frames/sec; "
+                  << "reassembled " << std::setprecision(3) << 100.0 * reassembled_bytes / total << "%; "
+                  << "inspected " << inspected_len / rounds << " bytes";
+        if (decode_all)
+        {
+            std::cout << "; " << std::setprecision(1) << 1e9 * elapsed / messages_count << " ns/message";
+        }
+        std::cout << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // the chunks are parsed right after the socket read, so the stream is kept cache resident
+    const std::size_t total = 1024 * 1024;
+    const std::size_t rounds = 1024;
+    if (argc > 1)
+    {
+        std::ifstream file(argv[1], std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "failed to open " << argv[1] << std::endl;
+            return 1;
+        }
+        std::vector<std::byte> stream;
+        std::transform(
+            std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>(), std::back_inserter(stream),
+            [](char c)
+            {
+                return std::byte(c);
+            });
+        bench_decoder("captured", stream, 65536, rounds);
+        bench_decoder("captured", stream, 1448, rounds);
+        bench_decoder("captured", stream, 65536, rounds, true);
+        return 0;
+    }
+
+    const std::vector<std::byte> extended = make_extended_stream(total);
+    // psql sends a message per row, the drivers batch the rows
+    const std::vector<std::byte> copy_rows = make_copy_stream(total, 100);
+    const std::vector<std::byte> copy = make_copy_stream(total, 8192);
+    bench_decoder("extended", extended, 65536, rounds);
+    bench_decoder("extended", extended, 1448, rounds);
+    bench_decoder("extended", extended, 65536, rounds, true);
+    bench_decoder("copy rows", copy_rows, 65536, rounds);
+    bench_decoder("copy rows", copy_rows, 1448, rounds);
+    bench_decoder("copy rows", copy_rows, 65536, rounds, true);
+    bench_decoder("copy", copy, 65536, rounds);
+    bench_decoder("copy", copy, 1448, rounds);
+    return 0;
+}
@@ -38,7 +38,7 @@ int main(int argc, char *argv[])
     try
     {
         io::bus_ptr io_bus =
-            std::make_shared<io::system::epoll>(EPOLLIN | EPOLLOUT | EPOLLPRI | EPOLLET);
+            std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
 
         std::string host = "127.0.0.1";
         if (argc > 1)
@@ -67,7 +67,7 @@ int main(int argc, char *argv[])
                       << std::endl;
         };
 
-        io_context = std::make_shared<io::context>(io_bus, std::chrono::milliseconds{10});
+        io_context = std::make_shared<io::context>(io_bus);
         io_context->run(error_handler);
 
         std::cout << "echo service finish" << std::endl;
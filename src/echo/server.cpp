@@ -20,7 +20,7 @@ echo::server::server(
 	int tcp_backlog)
 	: _session_manager(
 		  std::make_shared<io::ip::tcp::acceptor>(io_bus, address, tcp_backlog),
-		  [this](io::file_descriptor_t fd, const io::ip::v4 &address) -> io::ip::tcp::session_base_ptr
+		  [this](io::file_descriptor_t fd, const io::ip::endpoint &address) -> io::ip::tcp::session_base_ptr
 		  {
 			  return _make_new_session(fd, address);
 		  })
@@ -28,7 +28,7 @@ echo::server::server(
 	std::cout << "[+] Listening on " << address << std::endl;
 }
 
-io::ip::tcp::session_base_ptr echo::server::_make_new_session(io::file_descriptor_t fd, const io::ip::v4 &address)
+io::ip::tcp::session_base_ptr echo::server::_make_new_session(io::file_descriptor_t fd, const io::ip::endpoint &address)
 {
 	std::cout << "[+] Got connection from: " << address << " --> fd: " << fd << "\n";
 	auto sock = std::make_shared<socket_t>(_session_manager.get_acceptor()->get_bus(), fd);
@@ -6,7 +6,6 @@
 #include "error.hpp"
 #include "log.hpp"
 
-#include <string> // std::to_string
 #include <iostream>
 
 #include <unistd.h>		// ::close
@@ -27,34 +26,6 @@ namespace
 		return handler;
 	}
 
-	// get sockaddr ip_v4
-	const void *get_in_addr(const sockaddr *sa)
-	{
-		const sockaddr_in *sai = reinterpret_cast<const sockaddr_in *>(sa);
-		return reinterpret_cast<const void *>(&(sai->sin_addr));
-	}
-
-	// get sockaddr port
-	in_port_t get_in_port(const sockaddr *sa)
-	{
-		const sockaddr_in *sai = reinterpret_cast<const sockaddr_in *>(sa);
-		return sai->sin_port;
-	}
-
-	/// @brief Construct the IPv4 address from \ref sockaddr_storage struct
-	/// @param sa The \ref sockaddr_storage struct
-	/// @return The address object constructed
-	io::ip::v4 make_v4(sockaddr_storage const &sa)
-	{
-		std::array<char, INET_ADDRSTRLEN> conn_addr{0};
-		inet_ntop(sa.ss_family, get_in_addr(reinterpret_cast<const sockaddr *>(&sa)), conn_addr.data(), conn_addr.size());
-
-		std::string host = std::string(conn_addr.begin(), conn_addr.end());
-		in_port_t port = get_in_port(reinterpret_cast<const sockaddr *>(&sa));
-		std::string sport = std::to_string(port);
-		return io::ip::v4(host, sport);
-	}
-
 	io::file_descriptor_t _open_socket()
 	{
 		io::file_descriptor_t sfd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, IPPROTO_TCP);
@@ -95,7 +66,8 @@ io::ip::tcp::acceptor::acceptor(
 	io::bus_ptr io_bus,
 	const io::ip::v4 &address,
 	int tcp_backlog,
-	callback_t callback)
+	callback_t callback,
+	const io::ip::tcp::socket_options &options)
 	: io::ip::acceptor_base(io_bus, _open_socket()),
 	  _endpoint_address(address),
 	  _tcp_backlog(tcp_backlog)
@@ -127,6 +99,7 @@ io::ip::tcp::acceptor::acceptor(
 	{
 		throw io::error("failed to reuse acceptor port", sfd, errno);
 	}
+	io::ip::tcp::set_listener_options(sfd, options);
 
 	sockaddr_in sa = _get_sockaddr_in(address);
 	if (bind(sfd, reinterpret_cast<const sockaddr *>(&sa), sizeof(sa)) < 0)
@@ -139,6 +112,9 @@ io::ip::tcp::acceptor::acceptor(
 		throw io::error("failed to listen acceptor", sfd, errno);
 	}
 
+	// the io_uring bus accepts the connections itself with the requests kept in flight
+	get_bus()->accept_connections(sfd);
+
 	add_callback(std::move(callback));
 	scope_guard.reset();
 }
@@ -164,36 +140,46 @@ io::ip::tcp::acceptor::~acceptor() noexcept
 }
 // LCOV_EXCL_STOP
 
-std::pair<io::file_descriptor_t, io::ip::v4> io::ip::tcp::acceptor::_accept_new_client(io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask)
+std::pair<io::file_descriptor_t, io::ip::endpoint> io::ip::tcp::acceptor::_accept_new_client(io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask)
 {
 	IO_DEBUG((std::cout << "acceptor::_accept_new_client: fd = " << fd << "; mask = " << mask << "; errno = " << errno << std::endl));
 	if (mask.test(io::flags::error))
 	{
 		throw io::error("failed to accept", fd, errno);
 	}
-	sockaddr_storage clients;
-	socklen_t clients_size = sizeof(clients);
+	sockaddr_storage client;
+	socklen_t client_size = sizeof(client);
 
-	int conn = ::accept(get_fd(), reinterpret_cast<sockaddr *>(&clients), &clients_size);
+	const io::bus_ptr &bus = get_bus();
+	if (bus->is_accepting(fd))
+	{
+		const io::file_descriptor_t accepted = bus->take_accepted(fd, reinterpret_cast<sockaddr *>(&client), &client_size);
+		if (-1 == accepted)
+		{
+			// the queue is drained, the next connections come with the next completion
+			return std::make_pair(-1, io::ip::endpoint());
+		}
+		return std::make_pair(accepted, io::ip::endpoint(reinterpret_cast<const sockaddr *>(&client), client_size));
+	}
+
+	// the accepted connection is ready for the async I/O without the extra fcntl calls
+	int conn = ::accept4(get_fd(), reinterpret_cast<sockaddr *>(&client), &client_size, SOCK_NONBLOCK | SOCK_CLOEXEC);
 	if (-1 == conn)
 	{
 		switch (errno)
 		{
-		case EINTR:
 		case EAGAIN:
-		case EINPROGRESS:
+			// the backlog is drained, wait for the next edge
+			break;
+		case EINTR:
+		case ECONNABORTED:
+			// the backlog may have more connections
 			reciever->enqueue_event(fd, io::flags::in);
 			break;
 		default:
 			throw io::error("failed to accept", get_fd(), errno);
 		}
+		return std::make_pair(-1, io::ip::endpoint());
 	}
-	else
-	{
-		// EPOLLET workaround
-		reciever->enqueue_event(fd, io::flags::in);
-	}
-
-	io::ip::v4 address = make_v4(clients);
-	return std::make_pair(conn, address);
+	return std::make_pair(conn, io::ip::endpoint(reinterpret_cast<const sockaddr *>(&client), client_size));
 }
@@ -9,6 +9,7 @@
 #include "bus.hpp"
 #include "object.hpp"
 #include "acceptor_base.hpp"
+#include "socket_options.hpp"
 
 #include <vector>
 #include <memory>
@@ -36,11 +37,13 @@ namespace io
 				/// \param address The \ref ip::v4 address like `127.0.0.1`
 				/// \param tcp_backlog The TCP connections backlog value for the listening socket created
 				/// \param callback The callback function the accepted connections are reported with
+				/// \param options The listening socket options, see \ref io::ip::tcp::set_listener_options
 				acceptor(
 					io::bus_ptr io_bus,
 					const ip::v4 &address,
 					int tcp_backlog,
-					callback_t callback = nullptr);
+					callback_t callback = nullptr,
+					const io::ip::tcp::socket_options &options = {});
 				/// @brief The acceptor destructor
 				~acceptor() noexcept override;
 
@@ -49,8 +52,8 @@ namespace io
 				/// @param reciever The async I/O event_reciever abstraction
 				/// @param fd The file descriptor
 				/// @param mask The I/O event mask
-				/// @return The accepted client's address
-				std::pair<io::file_descriptor_t, io::ip::v4> _accept_new_client(io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask) override;
+				/// @return The accepted connection and the client's address or the negative file descriptor if the backlog is empty
+				std::pair<io::file_descriptor_t, io::ip::endpoint> _accept_new_client(io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask) override;
 
 			private:
 				/// \brief address The \ref ip::v4 address like `127.0.0.1`
@@ -3,7 +3,6 @@
 /// @copyright MIT
 
 #include "acceptor_base.hpp"
-#include "v4.hpp"
 #include "error.hpp"
 
 #include <algorithm>
@@ -11,22 +10,35 @@
 
 io::ip::acceptor_base::acceptor_base(const io::bus_ptr &io_bus, io::file_descriptor_t fd)
     : _io_bus(io_bus),
-      _fd(fd)
+      _fd(fd),
+      _accept_batch(DEFAULT_ACCEPT_BATCH)
 {
     add_bus_callback(
         [this](io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask)
         {
-            auto res = _accept_new_client(reciever, fd, mask);
-            io::file_descriptor_t conn = res.first;
-            if (0 < conn)
-            {
-                const io::ip::v4 &address = res.second;
-                for (const auto &callback : _callbacks)
-                {
-                    callback(conn, address);
-                }
-            }
-        });
+            _handle_accept_event(reciever, fd, mask);
+        },
+        io::callback_class::acceptor);
+}
+
+void io::ip::acceptor_base::_handle_accept_event(io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask)
+{
+    std::size_t accepted = 0;
+    do
+    {
+        const auto [conn, address] = _accept_new_client(reciever, fd, mask);
+        if (conn < 0)
+        {
+            // the backlog is drained, the next connection comes with the next edge
+            return;
+        }
+        for (const auto &callback : _callbacks)
+        {
+            callback(conn, address);
+        }
+    } while (++accepted < _accept_batch);
+    // the backlog may have more connections, accept them on the deferred event
+    reciever->enqueue_event(fd, io::flags::in);
 }
 
 io::file_descriptor_t io::ip::acceptor_base::_get_fd() const
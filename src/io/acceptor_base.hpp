@@ -7,10 +7,11 @@
 
 #include "bus.hpp"
 #include "object.hpp"
+#include "endpoint.hpp"
 
+#include <cstddef>
 #include <vector>
 #include <memory>
-#include <functional>
 #include <utility>
 
 /// \brief The input/output library namespace
@@ -19,20 +20,36 @@ namespace io
     /// \brief The ip subnamespace of the input/output library
     namespace ip
     {
-        class v4;
         /// \brief The incoming connection acceptor base class
-        /// It manages callback functions
+        /// It manages callback functions and accepts the connections in batches
         class acceptor_base
             : public io::object_base
         {
         public:
             /// \brief The callback function type the accepted connections are reported with
-            using callback_t = std::function<void(file_descriptor_t, const io::ip::v4 &)>;
+            using callback_t = io::delegate<void(file_descriptor_t, const io::ip::endpoint &)>;
 
             /// \brief Function to add more callbacks after the object already created
             /// \param callback The callback function the accepted connections are reported with
             void add_callback(callback_t callback);
 
+            /// @brief Set the maximal number of the connections accepted per one input event.
+            /// The rest of the backlog is accepted on the deferred input event to let the other objects run.
+            /// @param batch The connections count, at least one connection is accepted per input event
+            void set_accept_batch(std::size_t batch)
+            {
+                _accept_batch = batch;
+            }
+            /// @brief Get the maximal number of the connections accepted per one input event
+            /// @return The maximal number of the connections accepted per one input event
+            std::size_t get_accept_batch() const
+            {
+                return _accept_batch;
+            }
+
+            /// @brief The default maximal number of the connections accepted per one input event
+            static constexpr std::size_t DEFAULT_ACCEPT_BATCH = 32;
+
         protected:
             /// \brief Constructs new \ref acceptor_base object
             /// \param io_bus The \ref io::bus object instance to connect to the system level I/O
@@ -63,12 +80,18 @@ namespace io
             const io::bus_ptr &_get_bus() override;
 
         private:
-            /// \brief Handle the new client connection event
+            /// \brief Accept up to the \ref get_accept_batch connections and report them to the callbacks
+            /// @param reciever The async I/O event_reciever abstraction
+            /// @param fd The file descriptor
+            /// @param mask The I/O event mask
+            void _handle_accept_event(io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask);
+            /// \brief Accept one new client connection
             /// @param reciever The async I/O event_reciever abstraction
             /// @param fd The file descriptor
             /// @param mask The I/O event mask
-            /// @return The accepted client's address
-            virtual std::pair<io::file_descriptor_t, io::ip::v4> _accept_new_client(io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask) = 0;
+            /// @return The accepted connection and the client's address,
+            /// the negative file descriptor is returned when the backlog is empty
+            virtual std::pair<io::file_descriptor_t, io::ip::endpoint> _accept_new_client(io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask) = 0;
 
         private:
             /// \brief The callbacks collection type
@@ -80,6 +103,8 @@ namespace io
             file_descriptor_t _fd;
             /// \brief Callback functions the accepted connections are reported with
             callback_vec_t _callbacks;
+            /// @brief The maximal number of the connections accepted per one input event
+            std::size_t _accept_batch;
         };
         /// \brief The \ref io::ip::tcp::acceptor smart pointer alias
         using acceptor_ptr = std::shared_ptr<acceptor_base>;
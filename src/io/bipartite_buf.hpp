@@ -42,6 +42,7 @@
 #ifndef H_IO_UTIL_BIPARTITE_BUFFER_T
 #define H_IO_UTIL_BIPARTITE_BUFFER_T
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <type_traits>
@@ -102,6 +103,13 @@ namespace io
             static_assert(std::is_trivial<T>::value, "The type T must be trivial");
             static_assert(size > 2, "Buffer size must be bigger than 2");
 
+            /********************** PUBLIC TYPES **************************/
+        public:
+            /** The linear region: the pointer to the beginning and the elements count */
+            using region_t = std::pair<T *, size_t>;
+            /** The two linear regions, the second one is at the beginning of the buffer, the unused region is empty */
+            using regions_t = std::array<region_t, 2>;
+
             /********************** PUBLIC METHODS ************************/
         public:
             bipartite_buffer();
@@ -138,6 +146,40 @@ namespace io
              */
             void read_release(size_t read);
 
+            /**
+             * @brief Acquires all the free space in the bipartite buffer for writing
+             * as the linear region until the end of the buffer and the one from its beginning.
+             * Should only be called from the producer thread.
+             * @retval The regions to be filled in order, empty if the buffer is full
+             */
+            regions_t write_acquire_regions();
+
+            /**
+             * @brief Releases the bipartite buffer after a write to the regions
+             * acquired with \ref write_acquire_regions.
+             * Should only be called from the producer thread.
+             * @param[in] written Elements written to the regions in order
+             * @retval None
+             */
+            void write_release_regions(size_t written);
+
+            /**
+             * @brief Acquires all the data in the bipartite buffer for reading
+             * as the linear region until the end of the valid data and the one from the beginning of the buffer.
+             * Should only be called from the consumer thread.
+             * @retval The regions to be read in order, empty if the buffer is empty
+             */
+            regions_t read_acquire_regions();
+
+            /**
+             * @brief Releases the bipartite buffer after a read from the regions
+             * acquired with \ref read_acquire_regions.
+             * Should only be called from the consumer thread.
+             * @param[in] read Elements read from the regions in order
+             * @retval None
+             */
+            void read_release_regions(size_t read);
+
             /********************* PRIVATE METHODS ************************/
         private:
             static size_t _calc_free(const size_t w, const size_t r);
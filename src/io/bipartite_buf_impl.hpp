@@ -184,6 +184,81 @@ namespace io
             ThreadSafetyStrategy::store(_r, r, std::memory_order_release);
         }
 
+        template <typename T, size_t size, typename ThreadSafetyStrategy>
+        typename bipartite_buffer<T, size, ThreadSafetyStrategy>::regions_t
+        bipartite_buffer<T, size, ThreadSafetyStrategy>::write_acquire_regions()
+        {
+            /* Preload variables with adequate memory ordering */
+            const size_t w = ThreadSafetyStrategy::load(_w, std::memory_order_relaxed);
+            const size_t r = ThreadSafetyStrategy::load(_r, std::memory_order_acquire);
+
+            /* The space until the end of the buffer is used first, the rest is at the beginning */
+            const size_t free = _calc_free(w, r);
+            const size_t linear_free = (r > w) ? free : std::min(free, size - w);
+            return regions_t{region_t{&_data[w], linear_free}, region_t{&_data[0], free - linear_free}};
+        }
+
+        template <typename T, size_t size, typename ThreadSafetyStrategy>
+        void bipartite_buffer<T, size, ThreadSafetyStrategy>::write_release_regions(const size_t written)
+        {
+            const size_t linear_space = size - ThreadSafetyStrategy::load(_w, std::memory_order_relaxed);
+            if (written <= linear_space)
+            {
+                write_release(written);
+                return;
+            }
+
+            /* The whole space until the end of the buffer is valid, the write continues from the beginning */
+            assert(written - linear_space < size);
+            ThreadSafetyStrategy::store(_i, size, std::memory_order_relaxed);
+            ThreadSafetyStrategy::store(_w, written - linear_space, std::memory_order_release);
+        }
+
+        template <typename T, size_t size, typename ThreadSafetyStrategy>
+        typename bipartite_buffer<T, size, ThreadSafetyStrategy>::regions_t
+        bipartite_buffer<T, size, ThreadSafetyStrategy>::read_acquire_regions()
+        {
+            /* Preload variables with adequate memory ordering */
+            const size_t r = ThreadSafetyStrategy::load(_r, std::memory_order_relaxed);
+            const size_t w = ThreadSafetyStrategy::load(_w, std::memory_order_acquire);
+
+            if (r <= w)
+            {
+                return regions_t{region_t{&_data[r], w - r}, region_t{&_data[0], 0U}};
+            }
+
+            /* The data is until the invalidate index and from the beginning of the buffer to the write index */
+            const size_t i = ThreadSafetyStrategy::load(_i, std::memory_order_relaxed);
+            return regions_t{region_t{&_data[r], i - r}, region_t{&_data[0], w}};
+        }
+
+        template <typename T, size_t size, typename ThreadSafetyStrategy>
+        void bipartite_buffer<T, size, ThreadSafetyStrategy>::read_release_regions(const size_t read)
+        {
+            size_t r = ThreadSafetyStrategy::load(_r, std::memory_order_relaxed);
+            const size_t w = ThreadSafetyStrategy::load(_w, std::memory_order_acquire);
+
+            if (r <= w)
+            {
+                assert(r + read <= w);
+                r += read;
+            }
+            else
+            {
+                /* Skip to the beginning of the buffer when the data until the invalidate index is read */
+                const size_t linear_data = ThreadSafetyStrategy::load(_i, std::memory_order_relaxed) - r;
+                r = (read < linear_data) ? r + read : read - linear_data;
+            }
+            if (r == size)
+            {
+                r = 0U;
+            }
+            _read_wrapped = false;
+
+            /* Store the indexes with adequate memory ordering */
+            ThreadSafetyStrategy::store(_r, r, std::memory_order_release);
+        }
+
         /********************* PRIVATE METHODS ************************/
 
         template <typename T, size_t size, typename ThreadSafetyStrategy>
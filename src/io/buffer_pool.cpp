@@ -0,0 +1,114 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "buffer_pool.hpp"
+#include "error.hpp"
+#include "log.hpp"
+
+#include <cerrno>
+#include <iostream>
+
+#include <sys/mman.h> // mmap, munmap, madvise
+#include <unistd.h> // sysconf
+
+namespace
+{
+    /// @brief The blocks count of the slab mapped on demand
+    constexpr std::size_t grow_blocks_count = 16;
+
+    std::size_t round_up(std::size_t value, std::size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+io::buffer_pool::buffer_pool(std::size_t block_size)
+    : _block_size(round_up(block_size, static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)))),
+      _blocks_count(0),
+      _is_huge_pages(false)
+{
+}
+
+// LCOV_EXCL_START
+io::buffer_pool::~buffer_pool() noexcept
+{
+    IO_DEBUG((std::cout << "~buffer_pool: blocks = " << _blocks_count << "; free = " << _free.size() << std::endl));
+    for (const slab_t &slab : _slabs)
+    {
+        ::munmap(slab.addr, slab.len);
+    }
+}
+// LCOV_EXCL_STOP
+
+void io::buffer_pool::reserve(std::size_t count, bool huge_pages)
+{
+    _is_huge_pages = huge_pages;
+    if (0 != count)
+    {
+        _map_slab(count, true, huge_pages);
+    }
+}
+
+void *io::buffer_pool::acquire()
+{
+    if (_free.empty())
+    {
+        // the pages are faulted in by the first use of every block
+        _map_slab(grow_blocks_count, false, _is_huge_pages);
+    }
+    void *block = _free.back();
+    _free.pop_back();
+    return block;
+}
+
+void io::buffer_pool::release(void *block)
+{
+    _free.push_back(block);
+}
+
+void io::buffer_pool::discard(void *block)
+{
+    if (0 != ::munmap(block, _block_size))
+    {
+        // the huge page is unmapped only as a whole, the block is left unused
+        IO_DEBUG((std::cout << "buffer_pool::discard: munmap errno = " << errno << std::endl));
+    }
+    --_blocks_count;
+}
+
+void io::buffer_pool::_map_slab(std::size_t count, bool populate, bool huge_pages)
+{
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS | (populate ? MAP_POPULATE : 0);
+    std::size_t len = count * _block_size;
+    void *addr = MAP_FAILED;
+    if (huge_pages)
+    {
+        // the huge pages must be reserved with vm.nr_hugepages, otherwise the mapping fails
+        len = round_up(len, HUGE_PAGE_SZ);
+        addr = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+    }
+    if (MAP_FAILED == addr)
+    {
+        addr = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (MAP_FAILED == addr)
+        {
+            throw io::error("failed to map the buffer pool slab", -1, errno);
+        }
+        if (huge_pages)
+        {
+            // the transparent huge pages are a hint, the slab works without them
+            ::madvise(addr, len, MADV_HUGEPAGE);
+        }
+    }
+    _slabs.push_back(slab_t{addr, len});
+
+    const std::size_t slab_blocks = len / _block_size;
+    _free.reserve(_free.size() + slab_blocks);
+    // the first blocks are borrowed first
+    for (std::size_t i = slab_blocks; i > 0; --i)
+    {
+        _free.push_back(static_cast<char *>(addr) + (i - 1) * _block_size);
+    }
+    _blocks_count += slab_blocks;
+}
@@ -0,0 +1,112 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_IO_BUFFER_POOL_T
+#define H_IO_BUFFER_POOL_T
+
+#include <cstddef>
+#include <vector>
+
+/// \brief The input/output library namespace
+namespace io
+{
+    /// \brief The pool of the fixed size memory blocks.
+    /// The blocks are carved from the anonymous memory slabs which are never returned to the system
+    /// until the pool is destroyed, so the pool size follows the peak of the blocks in use.
+    /// The released blocks are reused in the LIFO order to keep them warm in the cache.
+    /// It is not thread safe: every reactor owns its own pool, see \ref io::bus::get_buffer_pool.
+    class buffer_pool
+    {
+    public:
+        /// @brief The default block size, it fits the \ref io::channel buffer
+        static constexpr std::size_t DEFAULT_BLOCK_SZ = 132 * 1024;
+        /// @brief The huge page size the slabs are rounded up to when the huge pages are requested
+        static constexpr std::size_t HUGE_PAGE_SZ = 2 * 1024 * 1024;
+
+        /// @brief Construct the empty pool
+        /// @param block_size The block size, rounded up to the page size
+        explicit buffer_pool(std::size_t block_size = DEFAULT_BLOCK_SZ);
+        /// @brief Unmap all the slabs, the blocks must not be in use
+        ~buffer_pool() noexcept;
+
+        /// @brief Map and prefault the slab of at least \p count blocks.
+        /// Call it on the reactor thread on start, so the memory is local to its NUMA node
+        /// and the first sessions do not pay for the page faults.
+        /// @param count The blocks count
+        /// @param huge_pages Back the slab with the huge pages if the system has them reserved,
+        /// the transparent huge pages are requested otherwise
+        void reserve(std::size_t count, bool huge_pages = false);
+
+        /// @brief Borrow the block, a new slab is mapped if there is no free block
+        /// @return The block of the \ref get_block_size bytes, page aligned
+        void *acquire();
+        /// @brief Return the block borrowed with the \ref acquire
+        /// @param block The block to return
+        void release(void *block);
+        /// @brief Drop the block borrowed with the \ref acquire without returning it to the free list.
+        /// The block still read by the system, like the zero-copy send buffer, must not be reused,
+        /// so its pages are unmapped and freed by the system when it drops the last reference.
+        /// The block of the huge pages slab can not be unmapped alone, it stays mapped and unused.
+        /// @param block The block to drop
+        void discard(void *block);
+
+        /// @brief Get the block size
+        /// @return The block size
+        std::size_t get_block_size() const
+        {
+            return _block_size;
+        }
+        /// @brief Get the blocks count of all the mapped slabs except the discarded ones
+        /// @return The blocks count of all the mapped slabs except the discarded ones
+        std::size_t get_blocks_count() const
+        {
+            return _blocks_count;
+        }
+        /// @brief Get the blocks count available to borrow
+        /// @return The blocks count available to borrow
+        std::size_t get_free_count() const
+        {
+            return _free.size();
+        }
+
+        /// \brief copy is prohibited
+        buffer_pool(const buffer_pool &) = delete;
+        /// \brief copy is prohibited
+        buffer_pool &operator=(const buffer_pool &) = delete;
+
+        /// \brief move is prohibited
+        buffer_pool(buffer_pool &&) noexcept = delete;
+        /// \brief move is prohibited
+        buffer_pool &operator=(buffer_pool &&) noexcept = delete;
+
+    private:
+        /// @brief Map the slab and add its blocks to the free list
+        /// @param count The minimum blocks count of the slab
+        /// @param populate Prefault the slab pages
+        /// @param huge_pages Try to back the slab with the huge pages
+        void _map_slab(std::size_t count, bool populate, bool huge_pages);
+
+        /// @brief The mapped memory region
+        struct slab_t
+        {
+            /// @brief The region start address
+            void *addr;
+            /// @brief The region length
+            std::size_t len;
+        };
+
+        /// @brief The block size
+        std::size_t _block_size;
+        /// @brief The blocks count of all the mapped slabs except the discarded ones
+        std::size_t _blocks_count;
+        /// @brief Are the huge pages requested for the slabs mapped on demand
+        bool _is_huge_pages;
+        /// @brief The mapped slabs
+        std::vector<slab_t> _slabs;
+        /// @brief The blocks available to borrow
+        std::vector<void *> _free;
+    };
+}
+
+#endif // H_IO_BUFFER_POOL_T
@@ -7,6 +7,35 @@
 
 #include <algorithm>
 #include <iostream>
+#include <utility>
+
+#include <fcntl.h> // O_CLOEXEC
+#include <sys/resource.h> // getrlimit
+#include <unistd.h> // dup3, close
+
+namespace
+{
+    /// @brief The file descriptors table initial size limit.
+    /// The table grows on demand up to the RLIMIT_NOFILE value.
+    constexpr std::size_t fd_table_initial_size = 4096;
+
+    std::size_t get_fd_table_initial_size()
+    {
+        struct rlimit limit = {};
+        if (0 == ::getrlimit(RLIMIT_NOFILE, &limit) && RLIM_INFINITY != limit.rlim_cur)
+        {
+            return std::min<std::size_t>(limit.rlim_cur, fd_table_initial_size);
+        }
+        return fd_table_initial_size; // LCOV_EXCL_LINE
+    }
+}
+
+io::bus::bus()
+    : _fd_table(get_fd_table_initial_size()),
+      _error_callback(nullptr),
+      _dispatched_count(0)
+{
+}
 
 // LCOV_EXCL_START
 io::bus::~bus() noexcept
@@ -15,98 +44,371 @@ io::bus::~bus() noexcept
 }
 // LCOV_EXCL_STOP
 
-void io::bus::add_fd(file_descriptor_t fd, callback_t callback)
+io::bus::fd_slot_t &io::bus::_get_slot(file_descriptor_t fd)
+{
+    if (fd < 0)
+    {
+        throw io::error("invalid file descriptor", fd, EBADF);
+    }
+    const std::size_t index = static_cast<std::size_t>(fd);
+    if (index >= _fd_table.size())
+    {
+        // references to the slots are not kept across callbacks, so reallocation is safe here
+        _fd_table.resize(std::max(index + 1, 2 * _fd_table.size()));
+    }
+    return _fd_table[index];
+}
+
+void io::bus::add_fd(file_descriptor_t fd, callback_t callback, [[maybe_unused]] io::callback_class cls)
 {
-    auto i = _callback_map.find(fd);
-    if (_callback_map.end() == i)
+    fd_slot_t &slot = _get_slot(fd);
+    if (!slot.registered)
     {
-        _callback_map.insert(std::make_pair(fd, std::vector<callback_t>()));
-        i = _callback_map.find(fd);
-        _add_fd(fd);
+        _add_fd(fd, make_handle(fd, slot.generation));
+        slot.registered = true;
     }
     if (callback)
     {
-        i->second.push_back(callback);
+#ifdef _IO_STATS_ENABLED
+        slot.callbacks.push_back(callback_entry_t{std::move(callback), cls});
+#else
+        slot.callbacks.push_back(callback_entry_t{std::move(callback)});
+#endif // _IO_STATS_ENABLED
+    }
+}
+
+void io::bus::_release_slot(file_descriptor_t fd)
+{
+    if (fd < 0 || static_cast<std::size_t>(fd) >= _fd_table.size())
+    {
+        return;
+    }
+    fd_slot_t &slot = _fd_table[fd];
+    if (slot.registered)
+    {
+        // the events already reported for the old registration become stale
+        ++slot.generation;
+        slot.registered = false;
+        slot.output_interest = 0;
+    }
+    slot.filter = nullptr;
+    if (!slot.callbacks.empty())
+    {
+        // the callbacks vector buffer is moved as a whole,
+        // so the currently executing callback object is not relocated
+        _released_callbacks.push_back(std::move(slot.callbacks));
+        slot.callbacks.clear();
+    }
+}
+
+void io::bus::_destroy_released_callbacks()
+{
+    // callbacks destruction can release objects that delete their file descriptors
+    while (!_released_callbacks.empty())
+    {
+        std::vector<callbacks_vec_t> released;
+        std::swap(released, _released_callbacks);
     }
 }
 
 void io::bus::del_fd_callbacks(file_descriptor_t fd)
 {
-    _callbacks_to_remove.insert(fd);
+    _release_slot(fd);
 }
 
 void io::bus::del_fd(file_descriptor_t fd)
 {
-    _callbacks_to_remove.insert(fd);
+    _release_slot(fd);
     _del_fd(fd);
 }
 
-void io::bus::wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size, io::bus::error_callback_t error_callback)
+void io::bus::set_event_filter(file_descriptor_t fd, event_filter_t filter)
 {
-    auto cb = [this, error_callback](event_reciever *reciever, file_descriptor_t fd, flags mask)
+    _get_slot(fd).filter = std::move(filter);
+}
+
+void io::bus::replace_fd(file_descriptor_t fd, file_descriptor_t new_fd)
+{
+    fd_slot_t &slot = _get_slot(fd);
+    if (slot.registered)
+    {
+        _del_fd(fd);
+        // the events already reported for the old file become stale
+        ++slot.generation;
+    }
+    const int result = ::dup3(new_fd, fd, O_CLOEXEC);
+    const int error = errno;
+    ::close(new_fd);
+    if (-1 == result)
+    {
+        slot.registered = false;
+        slot.output_interest = 0;
+        throw io::error("failed to replace file descriptor", fd, error);
+    }
+    if (slot.registered)
     {
-        auto i = _callback_map.find(fd);
-        if (_callback_map.end() != i)
+        _add_fd(fd, make_handle(fd, slot.generation));
+        if (0 < slot.output_interest)
         {
-            for (const auto &callback : i->second)
-            {
-                try
-                {
-                    if (_callbacks_to_remove.end() == _callbacks_to_remove.find(fd))
-                    {
-                        callback(reciever, fd, mask);
-                    }
-                }
-                catch (io::error &ex)
-                {
-                    error_callback(reciever, ex);
-                }
-                catch (std::exception &ex)
-                {
-                    error_callback(reciever, io::error(ex.what(), fd, errno));
-                }
-                catch (...)
-                {
-                    error_callback(reciever, io::error("unknown io error", fd, errno));
-                }
-            }
+            _set_output_interest(fd, make_handle(fd, slot.generation), true);
         }
+    }
+}
+
+void io::bus::add_output_interest(file_descriptor_t fd)
+{
+    fd_slot_t &slot = _get_slot(fd);
+    if (!slot.registered)
+    {
+        throw io::error("output interest for not registered file descriptor", fd, ENOENT);
+    }
+    if (0 == slot.output_interest++)
+    {
+        _set_output_interest(fd, make_handle(fd, slot.generation), true);
+    }
+}
+
+void io::bus::del_output_interest(file_descriptor_t fd)
+{
+    if (fd < 0 || static_cast<std::size_t>(fd) >= _fd_table.size())
+    {
+        return;
+    }
+    fd_slot_t &slot = _fd_table[fd];
+    // the interest of the released registration is already dropped
+    if (slot.registered && slot.output_interest > 0 && 0 == --slot.output_interest)
+    {
+        _set_output_interest(fd, make_handle(fd, slot.generation), false);
+    }
+}
 
-        // remove callbacks for closed connections
-        for (io::file_descriptor_t fd_to_remove : _callbacks_to_remove)
+void io::bus::accept_connections(file_descriptor_t fd)
+{
+    const fd_slot_t &slot = _get_slot(fd);
+    if (!slot.registered)
+    {
+        throw io::error("accept for not registered file descriptor", fd, ENOENT);
+    }
+    _accept_connections(fd, make_handle(fd, slot.generation));
+}
+
+bool io::bus::is_accepting(file_descriptor_t fd) const
+{
+    return _is_accepting(fd);
+}
+
+io::file_descriptor_t io::bus::take_accepted(file_descriptor_t fd, struct sockaddr *address, socklen_t *address_len)
+{
+    return _take_accepted(fd, address, address_len);
+}
+
+void io::bus::receive_data(file_descriptor_t fd)
+{
+    const fd_slot_t &slot = _get_slot(fd);
+    if (!slot.registered)
+    {
+        throw io::error("receive for not registered file descriptor", fd, ENOENT);
+    }
+    _receive_data(fd, make_handle(fd, slot.generation));
+}
+
+bool io::bus::is_receiving(file_descriptor_t fd) const
+{
+    return _is_receiving(fd);
+}
+
+ssize_t io::bus::take_received(file_descriptor_t fd, const struct iovec *iov, int iovcnt)
+{
+    return _take_received(fd, iov, iovcnt);
+}
+
+void io::bus::send_data(file_descriptor_t fd)
+{
+    const fd_slot_t &slot = _get_slot(fd);
+    if (!slot.registered)
+    {
+        throw io::error("send for not registered file descriptor", fd, ENOENT);
+    }
+    _send_data(fd, make_handle(fd, slot.generation));
+}
+
+bool io::bus::is_sending(file_descriptor_t fd) const
+{
+    return _is_sending(fd);
+}
+
+ssize_t io::bus::queue_send(file_descriptor_t fd, const struct iovec *iov, int iovcnt)
+{
+    return _queue_send(fd, iov, iovcnt);
+}
+
+std::size_t io::bus::get_unsent_bytes(file_descriptor_t fd) const
+{
+    return _get_unsent_bytes(fd);
+}
+
+void io::bus::_accept_connections(file_descriptor_t, handle_t)
+{
+}
+
+bool io::bus::_is_accepting(file_descriptor_t) const
+{
+    return false;
+}
+
+io::file_descriptor_t io::bus::_take_accepted(file_descriptor_t, struct sockaddr *, socklen_t *)
+{
+    return -1;
+}
+
+void io::bus::_receive_data(file_descriptor_t, handle_t)
+{
+}
+
+bool io::bus::_is_receiving(file_descriptor_t) const
+{
+    return false;
+}
+
+ssize_t io::bus::_take_received(file_descriptor_t, const struct iovec *, int)
+{
+    errno = EOPNOTSUPP;
+    return -1;
+}
+
+void io::bus::_send_data(file_descriptor_t, handle_t)
+{
+}
+
+bool io::bus::_is_sending(file_descriptor_t) const
+{
+    return false;
+}
+
+ssize_t io::bus::_queue_send(file_descriptor_t, const struct iovec *, int)
+{
+    errno = EOPNOTSUPP;
+    return -1;
+}
+
+std::size_t io::bus::_get_unsent_bytes(file_descriptor_t) const
+{
+    return 0;
+}
+
+void io::bus::dispatch_event(handle_t handle, io::flags mask)
+{
+    const file_descriptor_t fd = handle_to_fd(handle);
+    const std::uint32_t generation = static_cast<std::uint32_t>(handle >> 32);
+    if (static_cast<std::size_t>(fd) >= _fd_table.size() || _fd_table[fd].generation != generation)
+    {
+        IO_DEBUG((std::cout << "bus::dispatch_event: drop stale event for fd = " << fd << std::endl));
+        return;
+    }
+    if (_fd_table[fd].filter)
+    {
+        mask = _fd_table[fd].filter(fd, mask);
+        if (mask.test(io::flags::empty))
+        {
+            return;
+        }
+    }
+    ++_dispatched_count;
+    IO_STATS((_is_wait_end_set || (_wait_end = std::chrono::steady_clock::now(), _is_wait_end_set = true)));
+
+    // the callback can add file descriptors and reallocate the table,
+    // so the slot is looked up on each iteration
+    for (std::size_t i = 0; i < _fd_table[fd].callbacks.size() && _fd_table[fd].generation == generation; ++i)
+    {
+        IO_STATS(const auto callback_start = std::chrono::steady_clock::now());
+        IO_STATS(const auto cls = static_cast<std::size_t>(_fd_table[fd].callbacks[i].cls));
+        try
         {
-            _callback_map.erase(fd_to_remove);
+            _fd_table[fd].callbacks[i].callback(this, fd, mask);
         }
-        _callbacks_to_remove.clear();
-    };
+        catch (io::error &ex)
+        {
+            IO_STATS(++_stats.exceptions);
+            (*_error_callback)(this, ex);
+        }
+        catch (std::exception &ex)
+        {
+            IO_STATS(++_stats.exceptions);
+            (*_error_callback)(this, io::error(ex.what(), fd, errno));
+        }
+        catch (...)
+        {
+            IO_STATS(++_stats.exceptions);
+            (*_error_callback)(this, io::error("unknown io error", fd, errno));
+        }
+        IO_STATS(_stats.callback_ns[cls].record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - callback_start).count()));
+    }
+
+    // remove callbacks for closed connections
+    _destroy_released_callbacks();
+}
+
+std::size_t io::bus::wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size, const io::bus::error_callback_t &error_callback)
+{
+    _error_callback = &error_callback;
+    _dispatched_count = 0;
+    IO_STATS(const auto wait_start = std::chrono::steady_clock::now());
+    IO_STATS(_is_wait_end_set = false);
     try
     {
-        _wait_events(timeout_msec, events_buf_size, cb);
+        // do not block while the deferred events are pending
+        _wait_events(
+            _events.empty() ? _timers.get_timeout(timeout_msec) : std::chrono::milliseconds{0},
+            events_buf_size);
+        IO_STATS(_is_wait_end_set || (_wait_end = std::chrono::steady_clock::now(), _is_wait_end_set = true));
+        IO_STATS(_stats.events_per_wait.record(_dispatched_count));
+        _timers.advance(io::timer_wheel::clock_t::now());
+        // remove callbacks released by timers
+        _destroy_released_callbacks();
         // prevent infinite events generation loop
-        events_queue_t events;
-        std::swap(_events, events);
-        while (!events.empty())
+        _dispatched_events.clear();
+        std::swap(_events, _dispatched_events);
+        IO_STATS(_stats.deferred_per_wait.record(_dispatched_events.size()));
+        for (const event_t &event : _dispatched_events)
         {
-            const auto &event = events.front();
-            cb(this, event.fd, event.flags);
-            events.pop();
+            dispatch_event(event.handle, event.flags);
         }
     }
     catch (io::error &ex)
     {
+        IO_STATS(++_stats.exceptions);
         error_callback(this, ex);
     }
     catch (std::exception &ex)
     {
+        IO_STATS(++_stats.exceptions);
         error_callback(this, io::error(ex.what(), -1, errno));
     }
     catch (...)
     {
+        IO_STATS(++_stats.exceptions);
         error_callback(this, io::error("unknown io error", -1, errno));
     }
+    _error_callback = nullptr;
+#ifdef _IO_STATS_ENABLED
+    const auto wait_finish = std::chrono::steady_clock::now();
+    if (!_is_wait_end_set)
+    {
+        _wait_end = wait_finish;
+    }
+    _stats.wait_ns.record(std::chrono::duration_cast<std::chrono::nanoseconds>(_wait_end - wait_start).count());
+    _stats.processing_ns.record(std::chrono::duration_cast<std::chrono::nanoseconds>(wait_finish - _wait_end).count());
+#endif // _IO_STATS_ENABLED
+    return _dispatched_count;
 }
 
 void io::bus::_enqueue_event(file_descriptor_t fd, io::flags f)
 {
-    _events.push(event_t{fd, f});
-}
\ No newline at end of file
+    // the deferred event belongs to the current registration of the fd
+    std::uint32_t generation = 0;
+    if (fd >= 0 && static_cast<std::size_t>(fd) < _fd_table.size())
+    {
+        generation = _fd_table[fd].generation;
+    }
+    _events.push_back(event_t{make_handle(fd, generation), f});
+}
@@ -9,14 +9,19 @@
 #include "flags.hpp"
 #include "error.hpp"
 #include "event_reciever.hpp"
+#include "timer_wheel.hpp"
+#include "delegate.hpp"
+#include "stats.hpp"
+#include "buffer_pool.hpp"
 
-#include <functional>
-#include <unordered_map>
 #include <vector>
-#include <unordered_set>
 #include <memory>
-#include <queue>
 #include <chrono>
+#include <cstdint>
+
+#include <sys/socket.h> // struct sockaddr, socklen_t
+#include <sys/types.h> // ssize_t
+#include <sys/uio.h> // struct iovec
 
 /// \brief The input/output library namespace
 namespace io
@@ -32,53 +37,248 @@ namespace io
         /// The callback accepts the \ref io::event_reciever* event reciever pointer,
         /// \ref io::file_descriptor_t file descriptor and
         /// the \ref io::flags flags parameters
-        using callback_t = std::function<void(event_reciever *, file_descriptor_t, io::flags)>;
+        using callback_t = io::delegate<void(event_reciever *, file_descriptor_t, io::flags)>;
         /// \brief The I/O bus async error callback type
         /// The callback accepts the \ref io::event_reciever* event reciever pointer and
         /// the \ref io::error error object as parameter
-        using error_callback_t = std::function<void(event_reciever *, const io::error &)>;
+        using error_callback_t = io::delegate<void(event_reciever *, const io::error &)>;
+        /// @brief The event filter function type.
+        /// The file descriptor and the native event mask are provided,
+        /// the returned mask is passed to the callbacks, the empty mask drops the event.
+        using event_filter_t = io::delegate<io::flags(file_descriptor_t, io::flags)>;
+        /// \brief The file descriptor registration handle type.
+        /// The low 32 bits hold the file descriptor and the high 32 bits hold
+        /// the registration generation. The concrete bus stores it in the native event
+        /// user data, so an event for a closed and then reused file descriptor is dropped.
+        using handle_t = std::uint64_t;
 
         /// @brief Listen on the \p fd file descriptor and call the
         /// \p callback function on each bus event detected for this \p fd
         /// @param fd The file descriptor
         /// @param callback The bus event handler to call back user code
-        void add_fd(file_descriptor_t fd, callback_t callback = nullptr);
+        /// @param cls The callback kind to account the callback duration to, see \ref IO_STATS
+        void add_fd(file_descriptor_t fd, callback_t callback = nullptr, io::callback_class cls = io::callback_class::other);
         /// @brief Remove all callbacks registered for the \p fd file descriptor
         /// @param fd The file descriptor
         void del_fd_callbacks(file_descriptor_t fd);
         /// @brief Stop listening on the \p fd file descriptor
         /// @param fd The file descriptor
         void del_fd(file_descriptor_t fd);
+        /// @brief Set the \p filter applied to the \p fd events before the callbacks are called.
+        /// The filter is removed with the callbacks.
+        /// @param fd The file descriptor
+        /// @param filter The event filter
+        void set_event_filter(file_descriptor_t fd, event_filter_t filter);
+        /// @brief Replace the file behind the \p fd file descriptor with the \p new_fd one.
+        /// The callbacks and the output interest registered for the \p fd are kept,
+        /// the events already reported for the old file become stale.
+        /// The \p new_fd descriptor is closed.
+        /// @param fd The registered file descriptor
+        /// @param new_fd The file descriptor to move to the \p fd place
+        void replace_fd(file_descriptor_t fd, file_descriptor_t new_fd);
+        /// @brief Start watching the \p fd file descriptor for the output readiness.
+        /// The bus event mask given to the concrete bus constructor should not contain the output event then.
+        /// The interest is reference counted: the native watch is changed on the first call only.
+        /// It is dropped together with the \p fd callbacks by the \ref del_fd_callbacks and \ref del_fd.
+        /// @param fd The registered file descriptor
+        void add_output_interest(file_descriptor_t fd);
+        /// @brief Stop watching the \p fd file descriptor for the output readiness.
+        /// The native watch is changed when the last interest is removed.
+        /// @param fd The file descriptor
+        void del_output_interest(file_descriptor_t fd);
+        /// @brief Let the bus accept the connections of the registered listening socket \p fd itself.
+        /// The bus accepting the connections reports the input event when they are queued,
+        /// take them with the \ref take_accepted. The bus not able to do it keeps reporting the input readiness.
+        /// @param fd The registered listening socket file descriptor
+        void accept_connections(file_descriptor_t fd);
+        /// @brief Check if the bus accepts the connections of the listening socket \p fd itself
+        /// @param fd The listening socket file descriptor
+        /// @return true if the connections are taken with the \ref take_accepted, false if they are accepted by the caller
+        bool is_accepting(file_descriptor_t fd) const;
+        /// @brief Take the next connection the bus accepted on the listening socket \p fd.
+        /// The caller owns the connection, it is non-blocking and close-on-exec.
+        /// @param fd The listening socket file descriptor
+        /// @param address The buffer to write the connection peer address to as the accept4 call does, nullptr to skip it
+        /// @param address_len The \p address buffer size on input, the peer address size on output
+        /// @return The accepted connection file descriptor, -1 if there is no connection queued
+        file_descriptor_t take_accepted(file_descriptor_t fd, struct sockaddr *address = nullptr, socklen_t *address_len = nullptr);
+        /// @brief Let the bus receive the data of the registered stream socket \p fd itself.
+        /// The bus receiving the data reports the input event when it is queued,
+        /// take it with the \ref take_received. The bus not able to do it keeps reporting the input readiness.
+        /// @param fd The registered stream socket file descriptor
+        void receive_data(file_descriptor_t fd);
+        /// @brief Check if the bus receives the data of the stream socket \p fd itself
+        /// @param fd The stream socket file descriptor
+        /// @return true if the data is taken with the \ref take_received, false if it is read by the caller
+        bool is_receiving(file_descriptor_t fd) const;
+        /// @brief Move the data the bus received on the stream socket \p fd to the buffers in order.
+        /// @param fd The stream socket file descriptor
+        /// @param iov The buffers to write the data to
+        /// @param iovcnt The number of the \p iov buffers
+        /// @return The bytes count moved as the recvmsg call returns it: 0 at the end of the stream,
+        /// -1 with the EAGAIN errno if no data is queued or with the receive error errno
+        ssize_t take_received(file_descriptor_t fd, const struct iovec *iov, int iovcnt);
+        /// @brief Let the bus send the data of the registered stream socket \p fd itself.
+        /// The output readiness of the \p fd is not watched then: the bus reports the output event
+        /// when the data queued with the \ref queue_send is sent.
+        /// @param fd The registered stream socket file descriptor
+        void send_data(file_descriptor_t fd);
+        /// @brief Check if the bus sends the data of the stream socket \p fd itself
+        /// @param fd The stream socket file descriptor
+        /// @return true if the data is sent with the \ref queue_send, false if it is written by the caller
+        bool is_sending(file_descriptor_t fd) const;
+        /// @brief Queue the send of the buffers data on the stream socket \p fd.
+        /// One send is in flight per socket, the system reads the buffers until the bus reports its completion,
+        /// see \ref get_unsent_bytes.
+        /// @param fd The stream socket file descriptor
+        /// @param iov The buffers of data to send
+        /// @param iovcnt The number of the \p iov buffers
+        /// @return The bytes count queued, it may be less than the buffers length,
+        /// -1 with the EAGAIN errno if the previous send is in flight or with the send error errno
+        ssize_t queue_send(file_descriptor_t fd, const struct iovec *iov, int iovcnt);
+        /// @brief Get the bytes count queued with the \ref queue_send and not sent yet
+        /// @param fd The stream socket file descriptor
+        /// @return The last queued bytes count the system still reads from the caller buffers
+        std::size_t get_unsent_bytes(file_descriptor_t fd) const;
 
         /// @brief Wait for I/O events on this bus object.
         /// It waits for the \p timeout_msec milliseconds or
         /// while the \p events_buf_size events is read.
-        /// @param timeout_msec The maximum time to wait for events, in milliseconds. Or \ref std::chrono::milliseconds{0} for infinit wait.
+        /// The wait is shortened to the next timer expiry and the expired timers are called after it.
+        /// @param timeout_msec The maximum time to wait for events, in milliseconds. A negative value means infinite wait, zero means no wait.
         /// @param events_buf_size The events buffer size
         /// @param error_callback The function to be called in a case of an I/O error occured.
-        void wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size, error_callback_t error_callback = nullptr);
+        /// @return The number of the I/O events dispatched to the callbacks, the expired timers are not counted
+        std::size_t wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size, const error_callback_t &error_callback = nullptr);
+
+        /// @brief Get the timers of this bus.
+        /// The timers callbacks are called from the \ref wait_events on the bus thread.
+        /// @return The timing wheel driven by this bus
+        io::timer_wheel &get_timers()
+        {
+            return _timers;
+        }
+
+        /// @brief Get the memory blocks pool of this bus.
+        /// The I/O objects of the bus borrow the blocks on the bus thread only while they have data in flight.
+        /// @return The memory blocks pool of this reactor
+        io::buffer_pool &get_buffer_pool()
+        {
+            return _buffer_pool;
+        }
+
+#ifdef _IO_STATS_ENABLED
+        /// @brief Get the event loop statistics.
+        /// Call it on the bus thread, e.g. from a task posted to the \ref io::context.
+        /// @return The event loop statistics
+        io::stats::bus_stats &get_stats()
+        {
+            return _stats;
+        }
+#endif // _IO_STATS_ENABLED
 
     protected:
+        /// @brief Constructs the bus with the file descriptors table sized from the RLIMIT_NOFILE value
+        bus();
         /// @brief The bus destructor
         ~bus() noexcept override;
 
+        /// @brief Call all the callbacks registered for the \p handle.
+        /// The concrete bus calls it for each I/O event from the \ref _wait_events implementation.
+        /// Events for the stale handles are silently dropped.
+        /// @param handle The file descriptor registration handle passed to the \ref _add_fd
+        /// @param mask The I/O event mask
+        void dispatch_event(handle_t handle, io::flags mask);
+
+        /// @brief Extract the file descriptor from the \p handle
+        /// @param handle The file descriptor registration handle
+        /// @return The file descriptor
+        static file_descriptor_t handle_to_fd(handle_t handle)
+        {
+            return static_cast<file_descriptor_t>(handle & 0xFFFFFFFF);
+        }
+        /// @brief Make the file descriptor registration handle
+        /// @param fd The file descriptor
+        /// @param generation The registration generation
+        /// @return The file descriptor registration handle
+        static handle_t make_handle(file_descriptor_t fd, std::uint32_t generation)
+        {
+            return (static_cast<handle_t>(generation) << 32) | static_cast<std::uint32_t>(fd);
+        }
+
     private:
         /// @brief Listen on the \p fd file descriptor.
         /// Pure virtual function. Implement it in the inherited concrete bus class.
         /// @param fd The file descriptor
-        virtual void _add_fd(file_descriptor_t fd) = 0;
+        /// @param handle The registration handle to be passed to the \ref dispatch_event for each event on \p fd
+        virtual void _add_fd(file_descriptor_t fd, handle_t handle) = 0;
         /// @brief Stop listening on the \p fd file descriptor.
         /// Pure virtual function. Implement it in the inherited concrete bus class.
         /// @param fd The file descriptor
         virtual void _del_fd(file_descriptor_t fd) = 0;
+        /// @brief Change the output readiness watch of the \p fd file descriptor.
+        /// Pure virtual function. Implement it in the inherited concrete bus class.
+        /// @param fd The file descriptor
+        /// @param handle The registration handle passed to the \ref _add_fd for the \p fd
+        /// @param enabled Is the output readiness watched
+        virtual void _set_output_interest(file_descriptor_t fd, handle_t handle, bool enabled) = 0;
+        /// @brief Accept the connections of the listening socket \p fd by the bus itself.
+        /// Override it in the concrete bus class able to accept the connections without the caller system calls.
+        /// @param fd The file descriptor
+        /// @param handle The registration handle passed to the \ref _add_fd for the \p fd
+        virtual void _accept_connections(file_descriptor_t fd, handle_t handle);
+        /// @brief Check if the bus accepts the connections of the listening socket \p fd itself
+        /// @param fd The file descriptor
+        /// @return false by default
+        virtual bool _is_accepting(file_descriptor_t fd) const;
+        /// @brief Take the next connection the bus accepted on the listening socket \p fd
+        /// @param fd The file descriptor
+        /// @param address The buffer to write the connection peer address to, nullptr to skip it
+        /// @param address_len The \p address buffer size on input, the peer address size on output
+        /// @return -1 by default
+        virtual file_descriptor_t _take_accepted(file_descriptor_t fd, struct sockaddr *address, socklen_t *address_len);
+        /// @brief Receive the data of the stream socket \p fd by the bus itself.
+        /// Override it in the concrete bus class able to receive the data without the caller system calls.
+        /// @param fd The file descriptor
+        /// @param handle The registration handle passed to the \ref _add_fd for the \p fd
+        virtual void _receive_data(file_descriptor_t fd, handle_t handle);
+        /// @brief Check if the bus receives the data of the stream socket \p fd itself
+        /// @param fd The file descriptor
+        /// @return false by default
+        virtual bool _is_receiving(file_descriptor_t fd) const;
+        /// @brief Move the data the bus received on the stream socket \p fd to the buffers in order
+        /// @param fd The file descriptor
+        /// @param iov The buffers to write the data to
+        /// @param iovcnt The number of the \p iov buffers
+        /// @return -1 with the EOPNOTSUPP errno by default
+        virtual ssize_t _take_received(file_descriptor_t fd, const struct iovec *iov, int iovcnt);
+        /// @brief Send the data of the stream socket \p fd by the bus itself.
+        /// Override it in the concrete bus class able to send the data without the caller system calls.
+        /// @param fd The file descriptor
+        /// @param handle The registration handle passed to the \ref _add_fd for the \p fd
+        virtual void _send_data(file_descriptor_t fd, handle_t handle);
+        /// @brief Check if the bus sends the data of the stream socket \p fd itself
+        /// @param fd The file descriptor
+        /// @return false by default
+        virtual bool _is_sending(file_descriptor_t fd) const;
+        /// @brief Queue the send of the buffers data on the stream socket \p fd
+        /// @param fd The file descriptor
+        /// @param iov The buffers of data to send
+        /// @param iovcnt The number of the \p iov buffers
+        /// @return -1 with the EOPNOTSUPP errno by default
+        virtual ssize_t _queue_send(file_descriptor_t fd, const struct iovec *iov, int iovcnt);
+        /// @brief Get the bytes count queued and not sent yet
+        /// @param fd The file descriptor
+        /// @return 0 by default
+        virtual std::size_t _get_unsent_bytes(file_descriptor_t fd) const;
         /// @brief Wait for I/O events on this bus object.
         /// It waits for the \p timeout_msec milliseconds or
         /// while the \p events_buf_size events is read.
+        /// Call the \ref dispatch_event for each I/O event triggered.
         /// Pure virtual function. Implement it in the inherited concrete bus class.
-        /// @param timeout_msec The maximum time to wait for events, in milliseconds. Or \ref std::chrono::milliseconds{0} for infinit wait.
+        /// @param timeout_msec The maximum time to wait for events, in milliseconds. A negative value means infinite wait, zero means no wait.
         /// @param events_buf_size The events buffer size
-        /// @param callback The I/O bus async event callback function to be called for each I/O event triggered.
-        virtual void _wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size, callback_t callback) = 0;
+        virtual void _wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size) = 0;
 
     private:
         /// @brief Enqueue event on the \p fd file descriptor with the
@@ -88,22 +288,77 @@ namespace io
         void _enqueue_event(file_descriptor_t fd, io::flags mask) override;
 
     private:
-        /// @brief The I/O callbacks container type for fast file descriptor to callbacks lookup
-        using callback_map_t = std::unordered_map<file_descriptor_t, std::vector<callback_t>>;
-        /// @brief The I/O callbacks container for fast file descriptor to callbacks lookup
-        callback_map_t _callback_map;
-        /// @brief Auxiliary file descriptors container to defer actual file descriptor deletion
-        /// until the currently executing callback is finished.
-        /// It is necessary to prevent deletion from the io::bus::_callback_map while iterating it.
-        std::unordered_set<file_descriptor_t> _callbacks_to_remove;
+        /// @brief The registered I/O callback
+        struct callback_entry_t
+        {
+            /// @brief The I/O callback
+            callback_t callback;
+#ifdef _IO_STATS_ENABLED
+            /// @brief The callback kind
+            io::callback_class cls;
+#endif // _IO_STATS_ENABLED
+        };
+        /// @brief The I/O callbacks container type
+        using callbacks_vec_t = std::vector<callback_entry_t>;
+        /// @brief The file descriptor table slot
+        struct fd_slot_t
+        {
+            /// @brief The registration generation, incremented on each file descriptor deletion
+            std::uint32_t generation = 0;
+            /// @brief Is the file descriptor registered on this bus
+            bool registered = false;
+            /// @brief The output readiness interest reference counter
+            std::uint32_t output_interest = 0;
+            /// @brief The I/O callbacks
+            callbacks_vec_t callbacks;
+            /// @brief The event filter applied before the callbacks
+            event_filter_t filter;
+        };
+        /// @brief The dense file descriptor indexed table for O(1) event dispatch
+        std::vector<fd_slot_t> _fd_table;
+        /// @brief The callbacks of the deleted file descriptors.
+        /// The deletion is deferred until the currently executing callback is finished.
+        std::vector<callbacks_vec_t> _released_callbacks;
+        /// @brief The timers driven by this bus
+        io::timer_wheel _timers;
+        /// @brief The memory blocks pool of this bus
+        io::buffer_pool _buffer_pool;
+        /// @brief The error callback of the currently executing \ref wait_events call
+        const error_callback_t *_error_callback;
+        /// @brief The number of the I/O events dispatched by the currently executing \ref wait_events call
+        std::size_t _dispatched_count;
+#ifdef _IO_STATS_ENABLED
+        /// @brief The event loop statistics
+        io::stats::bus_stats _stats;
+        /// @brief The time the native wait of the currently executing \ref wait_events call has returned
+        std::chrono::steady_clock::time_point _wait_end;
+        /// @brief Is the \ref _wait_end set for the currently executing \ref wait_events call
+        bool _is_wait_end_set = false;
+#endif // _IO_STATS_ENABLED
+
+        /// @brief Get the table slot for the \p fd file descriptor, grow the table if needed
+        /// @param fd The file descriptor
+        /// @return The file descriptor slot
+        fd_slot_t &_get_slot(file_descriptor_t fd);
+        /// @brief Finish the \p fd file descriptor registration.
+        /// Its callbacks are released after the currently executing callback is finished.
+        /// @param fd The file descriptor
+        void _release_slot(file_descriptor_t fd);
+        /// @brief Destroy the callbacks released by the \ref _release_slot
+        void _destroy_released_callbacks();
 
         struct event_t
         {
-            file_descriptor_t fd;
+            handle_t handle;
             io::flags flags;
         };
-        using events_queue_t = std::queue<event_t>;
+        /// @brief The deferred events container type.
+        /// Two vectors are swapped to keep their capacity, so the steady state loop does not allocate.
+        using events_queue_t = std::vector<event_t>;
+        /// @brief The deferred events to be dispatched on the next \ref wait_events call
         events_queue_t _events;
+        /// @brief The deferred events being dispatched now
+        events_queue_t _dispatched_events;
     };
     /// \brief The async I/O bus abstraction smart pointer.
     using bus_ptr = std::shared_ptr<bus>;
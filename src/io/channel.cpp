@@ -7,6 +7,10 @@
 
 #include <iostream>
 #include <algorithm> // std::copy
+#include <new> // placement new
+
+#include <fcntl.h> // F_GETPIPE_SZ
+#include <unistd.h> // pipe2, close
 
 io::channel_ptr io::make_channel(
     const io::input_object_ptr &left,
@@ -21,21 +25,52 @@ io::channel_ptr io::make_channel(
 io::channel::channel(
     const io::input_object_ptr &left,
     const io::output_object_ptr &right)
-    : _left(left),
-      _right(right)
+    : _buffer(nullptr),
+      _buffer_pool(&left->get_bus()->get_buffer_pool()),
+      _left(left),
+      _right(right),
+      _is_output_interest(false),
+      _is_input_throttled(false),
+      _buffered_len(0),
+      _high_watermark(DEFAULT_HIGH_WATERMARK),
+      _low_watermark(DEFAULT_LOW_WATERMARK),
+      _throttled_count(0),
+      _read_budget(DEFAULT_READ_BUDGET),
+      _budget_exhausted_count(0),
+      _mode(transfer_mode::undefined),
+      _is_splice_enabled(true),
+      _is_bus_io_enabled(true),
+      _pipe{-1, -1},
+      _pipe_len(0),
+      _pipe_capacity(0),
+      _retained_len(0)
 {
 }
 
 void io::channel::_start()
 {
-    _left->add_bus_callback(_make_left_socket_callback());
-    _right->add_bus_callback(_make_right_socket_callback());
+    _left->add_bus_callback(_make_left_socket_callback(), io::callback_class::channel_left);
+    _right->add_bus_callback(_make_right_socket_callback(), io::callback_class::channel_right);
 }
 
 // LCOV_EXCL_START
 io::channel::~channel() noexcept
 {
     IO_DEBUG((std::cout << "~channel: from object id = " << _left->get_fd() << " to object id = " << _right->get_fd() << std::endl));
+    if (-1 != _pipe[0])
+    {
+        ::close(_pipe[0]);
+        ::close(_pipe[1]);
+    }
+    _release_written();
+    if (0 != _retained_len)
+    {
+        // the system still sends the retained bytes from the buffer, so it must not be reused
+        _buffer->~buffer_t();
+        _buffer_pool->discard(_buffer);
+        _buffer = nullptr;
+    }
+    _release_buffer();
 }
 // LCOV_EXCL_STOP
 
@@ -44,6 +79,12 @@ void io::channel::add_handler(input_callback_t &&cb)
     _handlers.push_back(std::move(cb));
 }
 
+void io::channel::set_watermarks(std::size_t high, std::size_t low)
+{
+    _high_watermark = std::clamp<std::size_t>(high, 1, BUFF_SZ - 1);
+    _low_watermark = std::min(low, _high_watermark - 1);
+}
+
 io::bus::callback_t io::channel::_make_left_socket_callback()
 {
     auto self(shared_from_this());
@@ -65,14 +106,17 @@ io::bus::callback_t io::channel::_make_right_socket_callback()
 namespace
 {
     /// @sa https://stackoverflow.com/a/49054086/1490653
-    void print_bytes_hex(const void *buf, std::size_t length)
+    void print_bytes_hex([[maybe_unused]] const struct iovec *iov, [[maybe_unused]] int iovcnt, [[maybe_unused]] std::size_t length)
     {
 #ifdef _IO_DEBUG_ENABLED
         std::cout << std::hex;
-        auto cbuf = static_cast<const unsigned char *>(buf);
-        for (std::size_t i = 0; i < length; ++i)
+        for (int i = 0; i < iovcnt && 0 != length; ++i)
         {
-            std::cout << (0xFF & cbuf[i]) << ' ';
+            auto cbuf = static_cast<const unsigned char *>(iov[i].iov_base);
+            for (std::size_t j = 0; j < iov[i].iov_len && 0 != length; ++j, --length)
+            {
+                std::cout << (0xFF & cbuf[j]) << ' ';
+            }
         }
         std::cout << std::dec;
 #endif // _IO_DEBUG_ENABLED
@@ -89,73 +133,225 @@ void io::channel::_handle_left_io_event(io::event_reciever *reciever, io::file_d
     }
     if (mask.test(io::flags::in))
     {
+        if (_is_input_throttled)
+        {
+            // the input readiness is checked again when the output drains the buffered data
+            IO_DEBUG((std::cout << "channel::_handle_left_io_event: the input is throttled for fd = " << fd << "\n"));
+            return;
+        }
+        if (transfer_mode::undefined == _mode)
+        {
+            _select_mode();
+            if (transfer_mode::copy == _mode && _is_bus_io_enabled)
+            {
+                // the data read by the bus comes with the next input events
+                _left->receive_with_bus();
+                _right->send_with_bus();
+            }
+        }
+        if (transfer_mode::splice == _mode)
+        {
+            _splice_pending(reciever, fd);
+        }
+        else
+        {
+            _read_pending(reciever, fd);
+        }
+    }
+}
+
+void io::channel::_select_mode()
+{
+    _mode = transfer_mode::copy;
+    if (!_is_splice_enabled || !_handlers.empty() || !_left->can_splice() || !_right->can_splice())
+    {
+        return;
+    }
+    if (-1 == ::pipe2(_pipe, O_NONBLOCK | O_CLOEXEC))
+    {
+        std::cerr << "failed to create the splice pipe; errno = " << errno << "; for fd = " << _left->get_fd() << std::endl;
+        _pipe[0] = _pipe[1] = -1;
+        return;
+    }
+    const int capacity = ::fcntl(_pipe[1], F_GETPIPE_SZ);
+    if (capacity < static_cast<int>(MIN_PIPE_SZ))
+    {
+        ::close(_pipe[0]);
+        ::close(_pipe[1]);
+        _pipe[0] = _pipe[1] = -1;
+        return;
+    }
+    _pipe_capacity = static_cast<std::size_t>(capacity);
+    _mode = transfer_mode::splice;
+}
+
+void io::channel::_splice_pending(io::event_reciever *reciever, io::file_descriptor_t fd)
+{
+    std::size_t budget = _read_budget;
+    for (;;)
+    {
+        if (0 != _pipe_len)
+        {
+            // the output is slower than the input, resume moving when the output is written
+            _throttle_input();
+            break;
+        }
+        // the pipe is empty, so no moved data means the input has no data
+        auto result = _left->async_splice_to(_pipe[1], _pipe_capacity);
+        if (std::holds_alternative<io::error>(result))
+        {
+            const io::error &err = std::get<io::error>(result);
+            std::cerr << err.what() << "; errno = " << err.get_errno() << "; for fd = " << err.get_fd() << std::endl;
+            // connection closed - force error handler call to close the session
+            reciever->enqueue_event(fd, io::flags::error);
+            break;
+        }
+        const std::size_t moved = std::get<io::input_object::success_result_type>(result).buf_len;
+        if (0 == moved)
+        {
+            break;
+        }
+        IO_DEBUG((std::cout << "channel splice: fd = " << fd << "; moved " << moved << " bytes\n"));
+        _pipe_len += moved;
+        _write_spliced();
+        if (moved >= budget)
+        {
+            // let the other objects run, the rest is moved on the deferred event
+            ++_budget_exhausted_count;
+            reciever->enqueue_event(fd, io::flags::in);
+            break;
+        }
+        budget -= moved;
+    }
+}
+
+void io::channel::_read_pending(io::event_reciever *reciever, io::file_descriptor_t fd)
+{
+    std::size_t budget = _read_budget;
+    for (;;)
+    {
+        // the free space wrapped around the buffer end is read with the single call
+        struct iovec iov[2];
+        const std::size_t max_len = _buffered_len < _high_watermark ? std::min(CHUNK_SZ, _high_watermark - _buffered_len) : 0;
+        const int iovcnt = 0 == max_len ? 0 : _acquire_free_space(iov, max_len);
+        if (0 == iovcnt)
         {
-            auto wbuf = _buffer.write_acquire(CHUNK_SZ);
-            if (nullptr != wbuf)
+            // the output is slower than the input, resume reading when the output drains the buffer
+            IO_DEBUG((std::cout << "channel::_read_pending: the high watermark is reached for fd = " << fd << "\n"));
+            _throttle_input();
+            break;
+        }
+        auto result = _left->async_readv(iov, iovcnt);
+        std::size_t recieved = 0;
+        auto v = io::make_visitor{
+            [&](const io::error &err)
+            {
+                std::cerr << err.what() << "; errno = " << err.get_errno() << "; for fd = " << err.get_fd() << std::endl;
+                // connection closed - force error handler call to close the session
+                IO_DEBUG((std::cout << "channel::_read_pending: error from recv: fd = " << fd << "; errno = " << errno << std::endl));
+                reciever->enqueue_event(fd, io::flags::error);
+            },
+            [&](const io::input_object::success_result_type &res)
             {
-                auto result = _left->async_read_some(wbuf, CHUNK_SZ);
-                auto v = io::make_visitor{
-                    [&](const io::error &err)
-                    {
-                        std::cerr << err.what() << "; errno = " << err.get_errno() << "; for fd = " << err.get_fd() << std::endl;
-                        // connection closed - force error handler call to close the session
-                        IO_DEBUG((std::cout << "channel::_handle_left_io_event: error from recv: fd = " << fd << "; mask = " << mask << "; errno = " << errno << std::endl));
-                        reciever->enqueue_event(fd, io::flags::error);
-                    },
-                    [&](const io::input_object::success_result_type &res)
-                    {
-                        _buffer.write_release(res.buf_len);
-                        IO_DEBUG((std::cout
-                                  << "channel read io handler: fd = " << fd << "; recieved " << res.buf_len << " bytes:\n"));
-                        print_bytes_hex(res.buf, res.buf_len);
-                        IO_DEBUG((std::cout << std::endl));
-                        IO_DEBUG((std::copy(static_cast<const char *>(res.buf), std::next(static_cast<const char *>(res.buf), res.buf_len), std::ostreambuf_iterator<char>(std::cout))));
-                        IO_DEBUG((std::cout << std::endl));
-                    }};
-                std::visit(v, result);
-                for (input_callback_t &handler : _handlers)
-                {
-                    handler(result);
-                }
+                _buffer->write_release_regions(res.buf_len);
+                _buffered_len += res.buf_len;
+                recieved = res.buf_len;
+                IO_DEBUG((std::cout
+                          << "channel read io handler: fd = " << fd << "; recieved " << res.buf_len << " bytes:\n"));
+                print_bytes_hex(iov, iovcnt, res.buf_len);
+                IO_DEBUG((std::cout << std::endl));
+            }};
+        std::visit(v, result);
+        if (0 == recieved && !std::holds_alternative<io::error>(result))
+        {
+            // EAGAIN: the input is drained, the new data comes with the next edge
+            struct iovec pending[2];
+            if (0 == _acquire_pending_data(pending) && 0 == _retained_len)
+            {
+                // the block borrowed for the empty read is returned, the idle channel keeps no buffer
+                _release_buffer();
             }
-            else
+            break;
+        }
+        if (recieved > iov[0].iov_len)
+        {
+            // the handlers see every linear region separately
+            const io::input_object::result_type head = io::input_object::success_result_type{fd, iov[0].iov_base, iov[0].iov_len};
+            const io::input_object::result_type tail = io::input_object::success_result_type{fd, iov[1].iov_base, recieved - iov[0].iov_len};
+            for (input_callback_t &handler : _handlers)
             {
-                IO_DEBUG((std::cout << "channel::_handle_left_io_event: write_acquire failed for fd = " << fd << "; mask = " << mask << "\n"));
+                handler(head);
+                handler(tail);
             }
         }
-        // try to write immediately if data recieved
+        else
         {
-            auto [rbuf, len] = _buffer.read_acquire();
-            if (nullptr != rbuf && len > 0)
+            for (input_callback_t &handler : _handlers)
             {
-                auto result = _right->async_write_some(rbuf, len);
-                size_t original_len = len;
-                auto v = io::make_visitor{
-                    [](const io::error &err)
-                    {
-                        std::cerr << err.what() << "; errno = " << err.get_errno() << "; for fd = " << err.get_fd() << std::endl;
-                    },
-                    [&](const io::output_object::success_result_type &res)
-                    {
-                        _buffer.read_release(res.buf_len);
-                        IO_DEBUG((std::cout << "channel read io handler: fd = " << fd << "; sent " << res.buf_len << " bytes:\n"));
-                        print_bytes_hex(res.buf, res.buf_len);
-                        IO_DEBUG((std::cout << std::endl));
-                        IO_DEBUG((std::copy(static_cast<const char *>(res.buf), std::next(static_cast<const char *>(res.buf), res.buf_len), std::ostreambuf_iterator<char>(std::cout))));
-                        IO_DEBUG((std::cout << std::endl));
-                        if (res.buf_len < original_len)
-                        {
-                            // try to write more
-                            reciever->enqueue_event(fd, io::flags::out);
-                        }
-                    }};
-                std::visit(v, result);
+                handler(result);
             }
         }
+        // try to write immediately if data recieved
+        _write_pending();
+        if (0 == recieved)
+        {
+            break;
+        }
+        if (recieved >= budget)
+        {
+            // let the other objects run, the rest is read on the deferred event
+            ++_budget_exhausted_count;
+            reciever->enqueue_event(fd, io::flags::in);
+            break;
+        }
+        budget -= recieved;
+    }
+}
+
+int io::channel::_acquire_free_space(struct iovec iov[2], std::size_t max_len)
+{
+    if (nullptr == _buffer)
+    {
+        // the idle channel keeps no buffer, the block is borrowed for the data in flight only
+        _buffer = new (_buffer_pool->acquire()) buffer_t();
+    }
+    const buffer_t::regions_t regions = _buffer->write_acquire_regions();
+    int iovcnt = 0;
+    for (const buffer_t::region_t &region : regions)
+    {
+        const std::size_t len = std::min(region.second, max_len);
+        if (0 != len)
+        {
+            iov[iovcnt++] = {region.first, len};
+            max_len -= len;
+        }
+    }
+    return iovcnt;
+}
+
+int io::channel::_acquire_pending_data(struct iovec iov[2])
+{
+    if (nullptr == _buffer)
+    {
+        return 0;
+    }
+    const buffer_t::regions_t regions = _buffer->read_acquire_regions();
+    // the leading retained bytes are written already, the output still reads them from the buffer
+    std::size_t skip = _retained_len;
+    int iovcnt = 0;
+    for (const buffer_t::region_t &region : regions)
+    {
+        const std::size_t skipped = std::min(region.second, skip);
+        skip -= skipped;
+        if (region.second != skipped)
+        {
+            iov[iovcnt++] = {region.first + skipped, region.second - skipped};
+        }
     }
+    return iovcnt;
 }
 
-void io::channel::_handle_right_io_event(io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask)
+void io::channel::_handle_right_io_event(io::event_reciever *, [[maybe_unused]] io::file_descriptor_t fd, io::flags mask)
 {
     IO_DEBUG((std::cout << "channel::_handle_right_io_event: fd = " << fd << "; mask = " << mask << "; errno = " << errno << std::endl));
     if (mask.test(io::flags::error))
@@ -165,31 +361,160 @@ void io::channel::_handle_right_io_event(io::event_reciever *reciever, io::file_
     }
     if (mask.test(io::flags::out))
     {
-        auto [rbuf, len] = _buffer.read_acquire();
-        if (nullptr != rbuf && len > 0)
-        {
-            auto result = _right->async_write_some(rbuf, len);
-            size_t original_len = len;
-            auto v = io::make_visitor{
-                [](const io::error &err)
-                {
-                    std::cerr << err.what() << "; errno = " << err.get_errno() << "; for fd = " << err.get_fd() << std::endl;
-                },
-                [&](const io::output_object::success_result_type &res)
-                {
-                    _buffer.read_release(res.buf_len);
-                    IO_DEBUG((std::cout << "channel read io handler: fd = " << fd << "; sent " << res.buf_len << " bytes:\n"));
-                    print_bytes_hex(res.buf, res.buf_len);
-                    IO_DEBUG((std::cout << std::endl));
-                    IO_DEBUG((std::copy(static_cast<const char *>(res.buf), std::next(static_cast<const char *>(res.buf), res.buf_len), std::ostreambuf_iterator<char>(std::cout))));
-                    IO_DEBUG((std::cout << std::endl));
-                    if (res.buf_len < original_len)
-                    {
-                        // try to write more
-                        reciever->enqueue_event(fd, io::flags::out);
-                    }
-                }};
-            std::visit(v, result);
+        _write();
+    }
+}
+
+void io::channel::_write_pending()
+{
+    // the output completed some of the retained data
+    _release_written();
+    bool is_output_full = false;
+    // the data wrapped around the buffer end is written with the single call
+    struct iovec iov[2];
+    const int iovcnt = _acquire_pending_data(iov);
+    if (0 != iovcnt)
+    {
+        const std::size_t pending_len = iov[0].iov_len + (2 == iovcnt ? iov[1].iov_len : 0);
+        auto result = _right->async_writev(iov, iovcnt);
+        auto v = io::make_visitor{
+            [](const io::error &err)
+            {
+                // the error is reported by the bus error event, do not wait for the output readiness
+                std::cerr << err.what() << "; errno = " << err.get_errno() << "; for fd = " << err.get_fd() << std::endl;
+            },
+            [&](const io::output_object::success_result_type &res)
+            {
+                _retained_len += res.buf_len;
+                _release_written();
+                is_output_full = res.buf_len < pending_len;
+                IO_DEBUG((std::cout << "channel write: fd = " << res.fd << "; sent " << res.buf_len << " bytes:\n"));
+                print_bytes_hex(iov, iovcnt, res.buf_len);
+                IO_DEBUG((std::cout << std::endl));
+            }};
+        std::visit(v, result);
+    }
+
+    if (0 == _acquire_pending_data(iov))
+    {
+        // the retained data is released on the output event reporting its completion
+        _set_output_interest(false);
+        if (0 == _retained_len)
+        {
+            _release_buffer();
+        }
+    }
+    else if (is_output_full)
+    {
+        // wait for the output readiness to write the rest
+        _set_output_interest(true);
+    }
+    _resume_input();
+}
+
+void io::channel::_release_written()
+{
+    if (0 == _retained_len)
+    {
+        return;
+    }
+    const std::size_t retained = std::min(_retained_len, _right->get_retained_bytes());
+    _buffer->read_release_regions(_retained_len - retained);
+    _buffered_len -= _retained_len - retained;
+    _retained_len = retained;
+}
+
+void io::channel::_release_buffer()
+{
+    if (nullptr == _buffer)
+    {
+        return;
+    }
+    _buffer->~buffer_t();
+    _buffer_pool->release(_buffer);
+    _buffer = nullptr;
+}
+
+void io::channel::_throttle_input()
+{
+    if (!_is_input_throttled)
+    {
+        _is_input_throttled = true;
+        ++_throttled_count;
+    }
+}
+
+void io::channel::_resume_input()
+{
+    const bool is_drained = transfer_mode::splice == _mode ? 0 == _pipe_len : _buffered_len <= _low_watermark;
+    if (!_is_input_throttled || !is_drained)
+    {
+        return;
+    }
+    // the input edge was consumed while the reading was stopped
+    _is_input_throttled = false;
+    _left->get_bus()->enqueue_event(_left->get_fd(), io::flags::in);
+}
+
+void io::channel::_write_spliced()
+{
+    bool is_output_full = false;
+    while (0 != _pipe_len)
+    {
+        auto result = _right->async_splice_from(_pipe[0], _pipe_len);
+        if (std::holds_alternative<io::error>(result))
+        {
+            const io::error &err = std::get<io::error>(result);
+            std::cerr << err.what() << "; errno = " << err.get_errno() << "; for fd = " << err.get_fd() << std::endl;
+            // the error is reported by the bus error event, do not wait for the output readiness
+            break;
+        }
+        const std::size_t moved = std::get<io::output_object::success_result_type>(result).buf_len;
+        if (0 == moved)
+        {
+            is_output_full = true;
+            break;
         }
+        _pipe_len -= moved;
+    }
+
+    if (0 == _pipe_len)
+    {
+        _set_output_interest(false);
+    }
+    else if (is_output_full)
+    {
+        // wait for the output readiness to write the rest
+        _set_output_interest(true);
+    }
+    _resume_input();
+}
+
+void io::channel::_write()
+{
+    if (transfer_mode::splice == _mode)
+    {
+        _write_spliced();
+    }
+    else
+    {
+        _write_pending();
+    }
+}
+
+void io::channel::_set_output_interest(bool enabled)
+{
+    if (enabled == _is_output_interest)
+    {
+        return;
+    }
+    if (enabled)
+    {
+        _right->add_bus_output_interest();
+    }
+    else
+    {
+        _right->del_bus_output_interest();
     }
+    _is_output_interest = enabled;
 }
@@ -8,8 +8,10 @@
 #include "object.hpp"
 #include "bus.hpp"
 #include "bipartite_buf.hpp"
+#include "buffer_pool.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 
 /// \brief The input/output library namespace
@@ -40,6 +42,7 @@ namespace io
 
         /// \brief Add an input object handler.
         /// The chain of responsibility pattern can be implemented with this function.
+        /// The handlers should be added before the first input event, see \ref set_splice_enabled.
         /// @param cb The \ref io::input_object callback to check or modify
         /// data before write it to \ref io::output_object
         void add_handler(input_callback_t &&cb);
@@ -57,8 +60,86 @@ namespace io
             return _right;
         }
 
+        /// @brief Set the bytes count read from the input object per one input event.
+        /// The channel drains the input object until it has no data or the budget is spent.
+        /// The rest is read on the deferred input event to let the other channels run.
+        /// @param budget The bytes count, at least one chunk is read per input event
+        void set_read_budget(std::size_t budget)
+        {
+            _read_budget = budget;
+        }
+        /// @brief Get the bytes count read from the input object per one input event
+        /// @return The bytes count read from the input object per one input event
+        std::size_t get_read_budget() const
+        {
+            return _read_budget;
+        }
+        /// @brief Get the number of the input events that spent the whole read budget
+        /// @return The number of the input events that spent the whole read budget
+        std::uint64_t get_budget_exhausted_count() const
+        {
+            return _budget_exhausted_count;
+        }
+
+        /// @brief Set the buffered bytes count bounds of the input flow control.
+        /// The input object reading is stopped when the buffered data reaches the \p high watermark
+        /// and resumed when the output drains it to the \p low watermark.
+        /// The input object readiness is checked again on resume, so no edge triggered event is lost.
+        /// The splice mode is bounded by the pipe capacity instead: it is resumed when the pipe is empty.
+        /// @param high The buffered bytes count to stop reading at, clamped to the buffer capacity
+        /// @param low The buffered bytes count to resume reading at, clamped below the \p high watermark
+        void set_watermarks(std::size_t high, std::size_t low);
+        /// @brief Get the buffered bytes count to stop reading at
+        /// @return The buffered bytes count to stop reading at
+        std::size_t get_high_watermark() const
+        {
+            return _high_watermark;
+        }
+        /// @brief Get the buffered bytes count to resume reading at
+        /// @return The buffered bytes count to resume reading at
+        std::size_t get_low_watermark() const
+        {
+            return _low_watermark;
+        }
+        /// @brief Get the number of times the input object reading was stopped by the output backpressure
+        /// @return The number of times the input object reading was stopped
+        std::uint64_t get_throttled_count() const
+        {
+            return _throttled_count;
+        }
+
+        /// @brief Allow or forbid the splice mode.
+        /// The channel without handlers moves the data between the objects supporting the splice
+        /// through a pipe, so the data never reaches the user space. The mode is selected on the first input event.
+        /// @param enabled Is the splice mode allowed, true by default
+        void set_splice_enabled(bool enabled)
+        {
+            _is_splice_enabled = enabled;
+        }
+        /// @brief Allow or forbid the bus to receive and send the copy mode data itself.
+        /// The objects are asked to move the data through the bus when the copy mode is selected,
+        /// so the bus able to do it saves the read and write system calls, see \ref io::bus::receive_data.
+        /// @param enabled Is the bus I/O allowed, true by default
+        void set_bus_io_enabled(bool enabled)
+        {
+            _is_bus_io_enabled = enabled;
+        }
+        /// @brief Check whether the data is moved with the splice calls
+        /// @return true if the splice mode is selected
+        bool is_splice_mode() const
+        {
+            return transfer_mode::splice == _mode;
+        }
+
         ~channel() noexcept;
 
+        /// @brief The default bytes count read from the input object per one input event
+        static constexpr std::size_t DEFAULT_READ_BUDGET = 256 * 1024;
+        /// @brief The default buffered bytes count to stop reading at, the whole buffer capacity
+        static constexpr std::size_t DEFAULT_HIGH_WATERMARK = 2 * (64 * 1024 - 1) - 1;
+        /// @brief The default buffered bytes count to resume reading at, the half of the buffer
+        static constexpr std::size_t DEFAULT_LOW_WATERMARK = 64 * 1024 - 1;
+
     private:
         /// \brief Construct the I/O channel/pipe/tube pattern implementation object.
         /// @param left Input object to read data from
@@ -92,14 +173,58 @@ namespace io
         /// @return The output object I/O bus async event callback
         io::bus::callback_t _make_right_socket_callback();
 
-        /// @brief The buffer size chunk
+        /// \brief Read the input object until it has no data, the buffer is full or the read budget is spent
+        /// @param reciever The async I/O event_reciever abstraction
+        /// @param fd The input object file descriptor
+        void _read_pending(io::event_reciever *reciever, io::file_descriptor_t fd);
+        /// \brief Write the buffered data to the output object until it is full or the buffer is empty.
+        /// The output readiness is watched only while the buffered data is pending.
+        void _write_pending();
+        /// \brief Get the buffer free space regions to read to
+        /// @param iov The free space regions
+        /// @param max_len The maximum total length of the regions
+        /// @return The number of the \p iov regions, 0 if the buffer is full
+        int _acquire_free_space(struct iovec iov[2], std::size_t max_len);
+        /// \brief Get the buffer data regions to write from, the retained data is skipped
+        /// @param iov The data regions
+        /// @return The number of the \p iov regions, 0 if there is no data to write
+        int _acquire_pending_data(struct iovec iov[2]);
+        /// \brief Release the written buffer data the output object does not retain
+        void _release_written();
+        /// \brief Return the drained buffer to the bus buffer pool
+        void _release_buffer();
+        /// \brief Stop reading the input object until the output drains the buffered data
+        void _throttle_input();
+        /// \brief Resume reading the input object if it was stopped and the buffered data is drained to the low watermark
+        void _resume_input();
+        /// \brief Select the copy or the splice mode on the first input event
+        void _select_mode();
+        /// \brief Move the input object data to the pipe until it has no data, the output is full or the read budget is spent
+        /// @param reciever The async I/O event_reciever abstraction
+        /// @param fd The input object file descriptor
+        void _splice_pending(io::event_reciever *reciever, io::file_descriptor_t fd);
+        /// \brief Move the pipe data to the output object until it is full or the pipe is empty.
+        /// The output readiness is watched only while the data is pending.
+        void _write_spliced();
+        /// \brief Write the pending data of the selected mode
+        void _write();
+        /// \brief Start or stop watching the output object for the output readiness
+        /// @param enabled Is the output readiness watched
+        void _set_output_interest(bool enabled);
+
+        /// @brief The maximum bytes count read at once
         static constexpr std::size_t CHUNK_SZ = 64 * 1024 - 1;
         /// @brief The buffer size
         static constexpr std::size_t BUFF_SZ = 2 * CHUNK_SZ;
+        static_assert(DEFAULT_HIGH_WATERMARK == BUFF_SZ - 1, "The default high watermark must be the buffer capacity");
         /// @brief The buffer type to read to and write from
         using buffer_t = io::util::bipartite_buffer<std::byte, BUFF_SZ, io::util::thread_safety_noop>;
-        /// @brief The buffer to read to and write from
-        buffer_t _buffer;
+        static_assert(sizeof(buffer_t) <= io::buffer_pool::DEFAULT_BLOCK_SZ, "The buffer must fit the bus buffer pool block");
+        /// @brief The buffer to read to and write from.
+        /// It is borrowed from the bus buffer pool while the data is in flight, nullptr when the channel is drained.
+        buffer_t *_buffer;
+        /// @brief The bus buffer pool to borrow the buffer from
+        io::buffer_pool *_buffer_pool;
 
         /// @brief Input object to read data from
         io::input_object_ptr _left;
@@ -108,6 +233,51 @@ namespace io
 
         /// @brief The I/O operation result callbacks
         std::vector<input_callback_t> _handlers;
+        /// @brief Is the output object watched for the output readiness
+        bool _is_output_interest;
+        /// @brief Is the input object reading stopped until the output drains the buffered data
+        bool _is_input_throttled;
+        /// @brief The buffered bytes count including the retained ones
+        std::size_t _buffered_len;
+        /// @brief The buffered bytes count to stop reading at
+        std::size_t _high_watermark;
+        /// @brief The buffered bytes count to resume reading at
+        std::size_t _low_watermark;
+        /// @brief The number of times the input object reading was stopped
+        std::uint64_t _throttled_count;
+        /// @brief The bytes count read from the input object per one input event
+        std::size_t _read_budget;
+        /// @brief The number of the input events that spent the whole read budget
+        std::uint64_t _budget_exhausted_count;
+
+        /// @brief The data transfer mode
+        enum class transfer_mode
+        {
+            /// @brief The mode is selected on the first input event
+            undefined,
+            /// @brief The data is read to the buffer and written from it
+            copy,
+            /// @brief The data is moved through the pipe
+            splice
+        };
+        /// @brief The pipe size below which the copy mode is used.
+        /// The pipes are shrunk when the user exceeds the pipe-user-pages-soft limit.
+        static constexpr std::size_t MIN_PIPE_SZ = 16 * 4096;
+        /// @brief The data transfer mode
+        transfer_mode _mode;
+        /// @brief Is the splice mode allowed
+        bool _is_splice_enabled;
+        /// @brief Is the bus allowed to receive and send the copy mode data
+        bool _is_bus_io_enabled;
+        /// @brief The splice mode pipe read and write ends
+        io::file_descriptor_t _pipe[2];
+        /// @brief The bytes count moved to the pipe and not written yet
+        std::size_t _pipe_len;
+        /// @brief The pipe capacity
+        std::size_t _pipe_capacity;
+        /// @brief The leading buffer bytes written and still retained by the output object,
+        /// see \ref io::output_object::get_retained_bytes
+        std::size_t _retained_len;
     };
 }
 #endif // H_SOCKET_PIPE_T
@@ -0,0 +1,247 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "connection_pool.hpp"
+#include "error.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <ostream>
+
+#include <unistd.h> // ::close
+#include <sys/socket.h>
+
+io::ip::tcp::connection_pool::connection_pool(
+    const io::bus_ptr &io_bus,
+    const io::ip::resolver_ptr &target,
+    const connection_pool_options &options)
+    : _io_bus(io_bus),
+      _target(target),
+      _options(options),
+      _is_upstream_down(false),
+      _sweep_timer(io::timer_wheel::invalid_timer_id)
+{
+    if (_options.size > 0)
+    {
+        _refill();
+        _arm_sweep_timer();
+    }
+}
+
+// LCOV_EXCL_START
+io::ip::tcp::connection_pool::~connection_pool() noexcept
+{
+    try
+    {
+        _io_bus->get_timers().cancel(_sweep_timer);
+        for (const entry_t &entry : _connecting)
+        {
+            _close(entry.fd);
+        }
+        for (const entry_t &entry : _ready)
+        {
+            _close(entry.fd);
+        }
+    }
+    catch (std::exception &ex)
+    {
+        std::cerr << "failed to close the connection pool: " << ex.what() << std::endl;
+    }
+}
+// LCOV_EXCL_STOP
+
+io::file_descriptor_t io::ip::tcp::connection_pool::acquire()
+{
+    const auto now = io::timer_wheel::clock_t::now();
+    while (!_ready.empty())
+    {
+        // the most recently established connection is the least likely to be dropped by the upstream
+        const entry_t entry = _ready.back();
+        _ready.pop_back();
+        if (now - entry.since > _options.max_idle)
+        {
+            ++_metrics.expired;
+            _close(entry.fd);
+            continue;
+        }
+        // the new owner registers the connection again
+        _io_bus->del_fd(entry.fd);
+        ++_metrics.hits;
+        if (!_is_upstream_down)
+        {
+            _refill();
+        }
+        return entry.fd;
+    }
+    if (_options.size > 0)
+    {
+        ++_metrics.misses;
+    }
+    if (!_is_upstream_down)
+    {
+        _refill();
+    }
+    return -1;
+}
+
+void io::ip::tcp::connection_pool::_refill()
+{
+    while (_ready.size() + _connecting.size() < _options.size)
+    {
+        if (!_connect())
+        {
+            break;
+        }
+    }
+}
+
+bool io::ip::tcp::connection_pool::_connect()
+{
+    const io::ip::resolver::endpoints_ptr endpoints = _target->get_endpoints();
+    for (const io::ip::endpoint &address : *endpoints)
+    {
+        io::file_descriptor_t fd = ::socket(address.family(), SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (-1 == fd)
+        {
+            continue;
+        }
+        if (-1 == ::connect(fd, address.data(), address.size()) && EINPROGRESS != errno)
+        {
+            ::close(fd);
+            continue;
+        }
+        _io_bus->add_fd(
+            fd,
+            [this](io::event_reciever *, io::file_descriptor_t fd, io::flags mask)
+            {
+                _handle_event(fd, mask);
+            });
+        // the connect completion is reported as the output readiness
+        _io_bus->add_output_interest(fd);
+        _connecting.push_back(entry_t{fd, io::timer_wheel::clock_t::now()});
+        return true;
+    }
+    ++_metrics.failures;
+    _is_upstream_down = true;
+    return false;
+}
+
+void io::ip::tcp::connection_pool::_handle_event(io::file_descriptor_t fd, io::flags mask)
+{
+    IO_DEBUG((std::cout << "connection_pool::_handle_event: fd = " << fd << "; mask = " << mask << std::endl));
+    const auto now = io::timer_wheel::clock_t::now();
+    auto connecting = std::find_if(
+        _connecting.begin(), _connecting.end(),
+        [fd](const entry_t &entry)
+        {
+            return entry.fd == fd;
+        });
+    if (connecting != _connecting.end())
+    {
+        if (!mask.test(io::flags::out) && !mask.test(io::flags::error))
+        {
+            return;
+        }
+        const entry_t entry = *connecting;
+        _connecting.erase(connecting);
+
+        int error = 0;
+        socklen_t error_len = sizeof(error);
+        if (mask.test(io::flags::error) || -1 == ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &error_len) || 0 != error)
+        {
+            // retry on the next sweep to avoid the reconnect loop while the upstream is down
+            ++_metrics.failures;
+            _is_upstream_down = true;
+            _close(fd);
+            return;
+        }
+        _io_bus->del_output_interest(fd);
+        _metrics.refill_us.record(std::chrono::duration_cast<std::chrono::microseconds>(now - entry.since).count());
+        _ready.push_back(entry_t{fd, now});
+        _is_upstream_down = false;
+        return;
+    }
+
+    auto ready = std::find_if(
+        _ready.begin(), _ready.end(),
+        [fd](const entry_t &entry)
+        {
+            return entry.fd == fd;
+        });
+    if (ready != _ready.end() && (mask.test(io::flags::in) || mask.test(io::flags::error)))
+    {
+        // the idle upstream connection is closed by the peer
+        _ready.erase(ready);
+        ++_metrics.expired;
+        _close(fd);
+        if (!_is_upstream_down)
+        {
+            _refill();
+        }
+    }
+}
+
+void io::ip::tcp::connection_pool::_sweep()
+{
+    const auto now = io::timer_wheel::clock_t::now();
+    auto is_expired = [&](const entry_t &entry)
+    {
+        return now - entry.since > _options.max_idle;
+    };
+    for (auto it = _ready.begin(); it != _ready.end();)
+    {
+        if (is_expired(*it))
+        {
+            ++_metrics.expired;
+            _close(it->fd);
+            it = _ready.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    for (auto it = _connecting.begin(); it != _connecting.end();)
+    {
+        if (is_expired(*it))
+        {
+            ++_metrics.failures;
+            _close(it->fd);
+            it = _connecting.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    _refill();
+}
+
+void io::ip::tcp::connection_pool::_arm_sweep_timer()
+{
+    _sweep_timer = _io_bus->get_timers().arm(
+        _options.refill_interval,
+        [this]()
+        {
+            _sweep_timer = io::timer_wheel::invalid_timer_id;
+            _sweep();
+            _arm_sweep_timer();
+        });
+}
+
+void io::ip::tcp::connection_pool::_close(io::file_descriptor_t fd)
+{
+    _io_bus->del_fd(fd);
+    ::close(fd);
+}
+
+std::ostream &io::ip::tcp::operator<<(std::ostream &os, const connection_pool_metrics &metrics)
+{
+    return os << "hits: " << metrics.hits
+              << "; misses: " << metrics.misses
+              << "; failures: " << metrics.failures
+              << "; expired: " << metrics.expired
+              << "; refill us: " << metrics.refill_us;
+}
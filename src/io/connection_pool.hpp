@@ -0,0 +1,168 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_IO_IP_TCP_CONNECTION_POOL_T
+#define H_IO_IP_TCP_CONNECTION_POOL_T
+
+#include "bus.hpp"
+#include "fd.hpp"
+#include "resolver.hpp"
+#include "stats.hpp"
+#include "timer_wheel.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+/// \brief The input/output library namespace
+namespace io
+{
+    /// \brief The IP protocol related abstractions namespace
+    namespace ip
+    {
+        /// \brief The TCP protocol related abstractions namespace
+        namespace tcp
+        {
+            /// \brief The upstream connection pool options
+            struct connection_pool_options
+            {
+                /// \brief The number of the established connections kept ready, the zero value disables the pool
+                std::size_t size = 0;
+                /// \brief The maximum time a ready connection is kept before it is replaced by a fresh one.
+                /// Keep it below the upstream idle or authentication timeout, 60 seconds for PostgreSQL.
+                std::chrono::milliseconds max_idle{std::chrono::seconds{30}};
+                /// \brief The period to expire the idle connections and to retry the failed connects with
+                std::chrono::milliseconds refill_interval{std::chrono::seconds{1}};
+            };
+
+            /// \brief The upstream connection pool metrics
+            struct connection_pool_metrics
+            {
+                /// \brief The ready connections handed out
+                std::uint64_t hits = 0;
+                /// \brief The acquire calls with no ready connection
+                std::uint64_t misses = 0;
+                /// \brief The failed or timed out connects
+                std::uint64_t failures = 0;
+                /// \brief The ready connections closed by the peer or expired while idle
+                std::uint64_t expired = 0;
+                /// \brief The connect to established time, in microseconds
+                io::stats::histogram refill_us;
+            };
+
+            /// @brief The output stream operator
+            /// to output the \p metrics value in a human readable format.
+            /// @param os The output stream object
+            /// @param metrics The metrics to output
+            /// @return The output stream object \p os
+            std::ostream &operator<<(std::ostream &os, const connection_pool_metrics &metrics);
+
+            class connection_pool;
+            /// \brief The \ref io::ip::tcp::connection_pool smart pointer alias
+            using connection_pool_ptr = std::shared_ptr<connection_pool>;
+
+            /// \brief The pool of the established non-blocking upstream connections of one \ref io::bus.
+            /// The connects are made asynchronously on the bus thread and the pool is refilled
+            /// as soon as a connection is handed out, so a new session does not wait for the handshake.
+            /// It is not thread safe: every reactor has its own pool.
+            class connection_pool final
+            {
+            public:
+                /// \brief Construct the pool and start connecting
+                /// \param io_bus The \ref io::bus object instance the connects are watched on
+                /// \param target The upstream address resolver
+                /// \param options The pool options
+                connection_pool(
+                    const io::bus_ptr &io_bus,
+                    const io::ip::resolver_ptr &target,
+                    const connection_pool_options &options);
+                /// \brief Close all the pooled connections
+                ~connection_pool() noexcept;
+
+                /// \brief copy is prohibited
+                connection_pool(const connection_pool &) = delete;
+                /// \brief copy is prohibited
+                connection_pool &operator=(const connection_pool &) = delete;
+                /// \brief move is prohibited
+                connection_pool(connection_pool &&) noexcept = delete;
+                /// \brief move is prohibited
+                connection_pool &operator=(connection_pool &&) noexcept = delete;
+
+                /// \brief Take an established connection out of the pool.
+                /// The caller owns the returned file descriptor, it is not registered on the bus anymore.
+                /// \return The established connection or -1 if no connection is ready
+                io::file_descriptor_t acquire();
+
+                /// \brief Get the number of the established connections ready to be acquired
+                /// \return The number of the ready connections
+                std::size_t get_ready_count() const
+                {
+                    return _ready.size();
+                }
+                /// \brief Get the number of the connects in progress
+                /// \return The number of the connects in progress
+                std::size_t get_connecting_count() const
+                {
+                    return _connecting.size();
+                }
+                /// \brief Get the pool metrics
+                /// \return The pool metrics
+                const connection_pool_metrics &get_metrics() const
+                {
+                    return _metrics;
+                }
+
+            private:
+                /// \brief The pooled connection
+                struct entry_t
+                {
+                    /// \brief The connection file descriptor
+                    io::file_descriptor_t fd;
+                    /// \brief The connect start time or the time the connection is established
+                    io::timer_wheel::time_point_t since;
+                };
+
+                /// \brief Start the connects to fill the pool up to its size
+                void _refill();
+                /// \brief Start one non-blocking connect
+                /// \return True if the connect is started
+                bool _connect();
+                /// \brief Handle the pooled connection event
+                /// \param fd The file descriptor
+                /// \param mask The I/O event mask
+                void _handle_event(io::file_descriptor_t fd, io::flags mask);
+                /// \brief Expire the idle connections and the stuck connects, then refill the pool
+                void _sweep();
+                /// \brief Arm the \ref _sweep timer
+                void _arm_sweep_timer();
+                /// \brief Remove the connection from the bus and close it
+                /// \param fd The file descriptor
+                void _close(io::file_descriptor_t fd);
+
+                /// \brief The \ref io::bus object instance the connects are watched on
+                io::bus_ptr _io_bus;
+                /// \brief The upstream address resolver
+                io::ip::resolver_ptr _target;
+                /// \brief The pool options
+                connection_pool_options _options;
+                /// \brief The connects in progress
+                std::vector<entry_t> _connecting;
+                /// \brief The established connections, the oldest first
+                std::deque<entry_t> _ready;
+                /// \brief The pool metrics
+                connection_pool_metrics _metrics;
+                /// \brief Is the last connect failed, the pool is refilled by the \ref _sweep only then
+                bool _is_upstream_down;
+                /// \brief The \ref _sweep timer
+                io::timer_wheel::timer_id_t _sweep_timer;
+            };
+        }
+    }
+}
+
+#endif // H_IO_IP_TCP_CONNECTION_POOL_T
@@ -3,6 +3,12 @@
 /// @copyright MIT
 
 #include "context.hpp"
+#include "error.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <ostream>
 
 io::context::context(
     const io::bus_ptr &io_bus,
@@ -11,19 +17,160 @@ io::context::context(
     : _io_bus(io_bus),
       _stop_requested(false),
       _timeout_msec(timeout_ms),
-      _events_buf_size(min_buf_size)
+      _events_buf_size(min_buf_size),
+      _max_spin(0)
 {
+    _io_bus->add_fd(
+        _wakeup.get_fd(),
+        [this](io::event_reciever *, io::file_descriptor_t, io::flags)
+        {
+            // the posted tasks are run after the events dispatch
+            _wakeup.reset();
+        },
+        io::callback_class::wakeup);
 }
 
+// LCOV_EXCL_START
+io::context::~context() noexcept
+{
+    try
+    {
+        _io_bus->del_fd(_wakeup.get_fd());
+    }
+    catch (io::error &ex)
+    {
+        std::cerr << "Failed to unregister the context wakeup eventfd: " << ex.what() << "; errno = " << ex.get_errno() << std::endl;
+    }
+}
+// LCOV_EXCL_STOP
+
 void io::context::stop()
 {
-    _stop_requested = true;
+    _stop_requested.store(true, std::memory_order_release);
+    _wakeup.notify();
+}
+
+void io::context::post(task_t task)
+{
+    _posted.push(std::move(task));
+    _wakeup.notify();
+}
+
+std::size_t io::context::_run_posted(const io::bus::error_callback_t &error_callback)
+{
+    std::size_t count = 0;
+    task_t task;
+    while (_posted.pop(task))
+    {
+        ++count;
+        try
+        {
+            task();
+        }
+        catch (io::error &ex)
+        {
+            if (error_callback)
+            {
+                error_callback(_io_bus.get(), ex);
+            }
+        }
+        catch (std::exception &ex)
+        {
+            if (error_callback)
+            {
+                error_callback(_io_bus.get(), io::error(ex.what(), -1, errno));
+            }
+        }
+        task = nullptr;
+    }
+    return count;
+}
+
+namespace
+{
+    /// @brief The maximum back-off between the empty polls, in the CPU relax instructions
+    constexpr unsigned max_relax_count = 64;
+
+    /// @brief Hint the CPU that it is the spin-wait loop
+    inline void cpu_relax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
 }
 
 void io::context::run(io::bus::error_callback_t error_callback)
 {
-    while (!_stop_requested)
+    if (_max_spin.count() > 0)
     {
+        _run_busy_poll(error_callback);
+        return;
+    }
+    while (!is_stop_requested())
+    {
+        ++_stats.blocking_waits;
         _io_bus->wait_events(_timeout_msec, _events_buf_size, error_callback);
+        _run_posted(error_callback);
+    }
+}
+
+void io::context::_run_busy_poll(const io::bus::error_callback_t &error_callback)
+{
+    using clock_t = std::chrono::steady_clock;
+    const std::chrono::microseconds min_spin = std::max(_max_spin / 16, std::chrono::microseconds{1});
+    std::chrono::microseconds spin = _max_spin;
+    while (!is_stop_requested())
+    {
+        bool is_hit = false;
+        unsigned relax_count = 1;
+        clock_t::time_point deadline = clock_t::now() + spin;
+        while (!is_stop_requested())
+        {
+            ++_stats.spin_polls;
+            const std::size_t events_count = _io_bus->wait_events(std::chrono::milliseconds{0}, _events_buf_size, error_callback);
+            if (0 != events_count + _run_posted(error_callback))
+            {
+                // keep spinning while the events come
+                ++_stats.spin_hits;
+                is_hit = true;
+                relax_count = 1;
+                deadline = clock_t::now() + spin;
+                continue;
+            }
+            if (clock_t::now() >= deadline)
+            {
+                break;
+            }
+            // exponential back-off between the empty polls
+            for (unsigned i = 0; i < relax_count; ++i)
+            {
+                cpu_relax();
+            }
+            relax_count = std::min(2 * relax_count, max_relax_count);
+        }
+        spin = is_hit ? std::min(2 * spin, _max_spin) : std::max(spin / 2, min_spin);
+
+        if (!is_stop_requested())
+        {
+            ++_stats.blocking_waits;
+            _io_bus->wait_events(_timeout_msec, _events_buf_size, error_callback);
+            _run_posted(error_callback);
+        }
+    }
+}
+
+std::ostream &io::operator<<(std::ostream &os, const context::run_stats &stats)
+{
+    os << "spin polls: " << stats.spin_polls
+       << "; spin hits: " << stats.spin_hits
+       << "; blocking waits: " << stats.blocking_waits
+       << "; spin/block ratio: ";
+    if (0 == stats.blocking_waits)
+    {
+        return os << "inf";
     }
+    return os << static_cast<double>(stats.spin_polls) / stats.blocking_waits;
 }
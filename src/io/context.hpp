@@ -6,9 +6,16 @@
 #define H_IO_CONTEXT_T
 
 #include "bus.hpp"
+#include "delegate.hpp"
+#include "eventfd.hpp"
+#include "mpsc_queue.hpp"
 
 #include <cstddef> // std::size_t
+#include <cstdint>
+#include <chrono>
 #include <memory>
+#include <atomic>
+#include <iosfwd>
 
 /// \brief The input/output library namespace
 namespace io
@@ -17,23 +24,74 @@ namespace io
 	class context
 	{
 	public:
-		/// @brief Construct the I/O reactor pattern object
+		/// @brief The event listening reactor pattern cycle statistics
+		struct run_stats
+		{
+			/// @brief The non-blocking polls count of the busy-poll mode
+			std::uint64_t spin_polls = 0;
+			/// @brief The non-blocking polls which dispatched I/O events
+			std::uint64_t spin_hits = 0;
+			/// @brief The blocking waits count
+			std::uint64_t blocking_waits = 0;
+		};
+
+		/// @brief The task posted to the reactor thread
+		using task_t = io::delegate<void()>;
+
+		/// @brief Construct the I/O reactor pattern object.
+		/// The wakeup eventfd is registered on the \p io_bus.
 		/// @param io_bus The shared pointer for an \ref io::bus object to listen on
-		/// @param timeout_msec The maximum time to wait for events, in milliseconds. Or \ref std::chrono::milliseconds{0} for infinit wait.
+		/// @param timeout_msec The maximum time to wait for events, in milliseconds. A negative value means infinite wait.
+		/// The reactor is woken up by the \ref post and \ref stop calls, so there is no need to poll.
 		/// @param events_buf_size The events buffer size
-		explicit context(const io::bus_ptr &io_bus, std::chrono::milliseconds timeout_msec = std::chrono::milliseconds{0}, std::size_t events_buf_size = 1024);
+		explicit context(const io::bus_ptr &io_bus, std::chrono::milliseconds timeout_msec = std::chrono::milliseconds{-1}, std::size_t events_buf_size = 1024);
+		/// @brief Unregister the wakeup eventfd from the bus
+		~context() noexcept;
 
 		/// @brief Start the event listening reactor pattern cycle
 		/// @param error_callback The I/O bus async error callback
 		void run(io::bus::error_callback_t error_callback = nullptr);
-		/// @brief Stop the event listening reactor pattern cycle
+		/// @brief Stop the event listening reactor pattern cycle.
+		/// It is safe to call it from another thread or from a signal handler.
 		void stop();
+		/// @brief Run the \p task on the reactor thread.
+		/// It is safe to call it from any thread but not from a signal handler.
+		/// The tasks are run in the posting order of each thread after the I/O events dispatch.
+		/// The tasks still queued when the reactor is destroyed are dropped without being run.
+		/// @param task The task to run
+		void post(task_t task);
+
+		/// @brief Enable the busy-poll mode of the event listening reactor pattern cycle.
+		/// The cycle spins on the non-blocking bus polls before it blocks for the configured timeout.
+		/// The spin time adapts between 1/16 of the \p max_spin and the \p max_spin:
+		/// it doubles when the spin finds events and halves when it does not.
+		/// It trades a CPU core for the scheduler wake-up latency. Call it before the \ref run.
+		/// @param max_spin The maximum spin time before blocking, zero disables the busy-poll mode
+		void set_busy_poll(std::chrono::microseconds max_spin)
+		{
+			_max_spin = max_spin;
+		}
+
+		/// @brief Get the event listening reactor pattern cycle statistics.
+		/// Call it on the reactor thread or after the \ref run is finished.
+		/// @return The spin and blocking waits counters
+		const run_stats &get_run_stats() const
+		{
+			return _stats;
+		}
 
 		/// @brief Check if stop the event listening reactor pattern cycle is requested
 		/// @return True if stop the event listening reactor pattern cycle is requested
 		bool is_stop_requested() const
 		{
-			return _stop_requested;
+			return _stop_requested.load(std::memory_order_acquire);
+		}
+
+		/// @brief Get the \ref io::bus object this reactor listens on
+		/// @return The \ref io::bus object this reactor listens on
+		const io::bus_ptr &get_bus() const
+		{
+			return _io_bus;
 		}
 
 		/// \brief copy is prohibited
@@ -46,17 +104,41 @@ namespace io
 		/// \brief move is prohibited
 		context &operator=(context &&) noexcept = delete;
 
+	private:
+		/// @brief The busy-poll mode of the event listening reactor pattern cycle
+		/// @param error_callback The I/O bus async error callback
+		void _run_busy_poll(const io::bus::error_callback_t &error_callback);
+		/// @brief Run the posted tasks
+		/// @param error_callback The I/O bus async error callback to report the tasks exceptions to
+		/// @return The number of the tasks run
+		std::size_t _run_posted(const io::bus::error_callback_t &error_callback);
+
 	private:
 		/// @brief The shared pointer for an \ref io::bus object to listen on
 		io::bus_ptr _io_bus;
 		/// @brief True if stop the event listening reactor pattern cycle is requested
-		bool _stop_requested;
+		std::atomic_bool _stop_requested;
 		/// @brief The maximum time to wait for events, in milliseconds
 		std::chrono::milliseconds _timeout_msec;
 		/// @brief The events buffer size
 		std::size_t _events_buf_size;
+		/// @brief The maximum spin time of the busy-poll mode, zero disables it
+		std::chrono::microseconds _max_spin;
+		/// @brief The event listening reactor pattern cycle statistics
+		run_stats _stats;
+		/// @brief The wakeup notification for the \ref post and \ref stop calls
+		io::system::eventfd _wakeup;
+		/// @brief The tasks posted from the other threads
+		io::util::mpsc_queue<task_t> _posted;
 	};
 	using context_ptr = std::shared_ptr<context>;
+
+	/// @brief The output stream operator
+	/// to output the \p stats value in a human readable format with the spin to block ratio.
+	/// @param os The output stream object
+	/// @param stats The \ref io::context::run_stats value to output
+	/// @return The output stream object \p os
+	std::ostream &operator<<(std::ostream &os, const context::run_stats &stats);
 }
 
 #endif // H_IO_CONTEXT_T
@@ -0,0 +1,77 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "context_pool.hpp"
+
+#include <algorithm> // std::max
+#include <exception>
+#include <mutex>
+#include <thread>
+
+io::context_pool::context_pool(
+    std::size_t threads_count,
+    const make_bus_callback_t &make_bus,
+    std::chrono::milliseconds timeout_msec,
+    std::size_t events_buf_size)
+{
+    if (0 == threads_count)
+    {
+        threads_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    _contexts.reserve(threads_count);
+    for (std::size_t i = 0; i < threads_count; ++i)
+    {
+        _contexts.push_back(std::make_shared<io::context>(make_bus(i), timeout_msec, events_buf_size));
+    }
+}
+
+void io::context_pool::stop()
+{
+    for (const auto &ctx : _contexts)
+    {
+        ctx->stop();
+    }
+}
+
+void io::context_pool::run(const thread_callback_t &thread_callback)
+{
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    auto thread_main = [&](std::size_t index)
+    {
+        try
+        {
+            thread_callback(index, _contexts[index]);
+        }
+        catch (...)
+        {
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+            // one failed reactor brings the whole service down
+            stop();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(_contexts.size() - 1);
+    for (std::size_t i = 1; i < _contexts.size(); ++i)
+    {
+        threads.emplace_back(thread_main, i);
+    }
+    thread_main(0);
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
@@ -0,0 +1,89 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_IO_CONTEXT_POOL_T
+#define H_IO_CONTEXT_POOL_T
+
+#include "bus.hpp"
+#include "context.hpp"
+
+#include <cstddef> // std::size_t
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/// \brief The input/output library namespace
+namespace io
+{
+	/// \brief The multi-reactor pattern object.
+	/// It owns one \ref io::bus and one \ref io::context per thread.
+	/// Every I/O object created on a thread uses that thread's bus only,
+	/// so sessions stay pinned to the reactor that accepted them.
+	class context_pool
+	{
+	public:
+		/// @brief The function to create the \ref io::bus object for the reactor thread
+		/// \param index The reactor thread index
+		/// \return The \ref io::bus object for the reactor thread
+		using make_bus_callback_t = std::function<io::bus_ptr(std::size_t index)>;
+		/// @brief The reactor thread body function.
+		/// It should create the thread's I/O objects and call \ref io::context::run
+		/// \param index The reactor thread index
+		/// \param io_context The reactor thread \ref io::context object
+		using thread_callback_t = std::function<void(std::size_t index, const io::context_ptr &io_context)>;
+
+		/// @brief Construct the multi-reactor pattern object
+		/// @param threads_count The reactor threads count. Zero means one thread per CPU core.
+		/// @param make_bus The function to create the \ref io::bus object for each reactor thread
+		/// @param timeout_msec The maximum time to wait for events, in milliseconds. A negative value means infinite wait,
+		/// the reactors are woken up by the \ref stop call.
+		/// @param events_buf_size The events buffer size
+		context_pool(
+			std::size_t threads_count,
+			const make_bus_callback_t &make_bus,
+			std::chrono::milliseconds timeout_msec = std::chrono::milliseconds{-1},
+			std::size_t events_buf_size = 1024);
+
+		/// @brief Run the \p thread_callback on every reactor thread and wait for all of them to finish.
+		/// The reactor with index zero is run on the calling thread.
+		/// If any reactor thread throws, all the other reactors are stopped and the exception is rethrown.
+		/// @param thread_callback The reactor thread body function
+		void run(const thread_callback_t &thread_callback);
+		/// @brief Stop all the reactors. Safe to call from any thread.
+		void stop();
+
+		/// @brief Get the reactors count
+		/// @return The reactors count
+		std::size_t size() const
+		{
+			return _contexts.size();
+		}
+		/// @brief Get the reactor \ref io::context object by index
+		/// @param index The reactor thread index
+		/// @return The reactor \ref io::context object
+		const io::context_ptr &get_context(std::size_t index) const
+		{
+			return _contexts.at(index);
+		}
+
+		/// \brief copy is prohibited
+		context_pool(const context_pool &) = delete;
+		/// \brief copy is prohibited
+		context_pool &operator=(const context_pool &) = delete;
+
+		/// \brief move is prohibited
+		context_pool(context_pool &&) noexcept = delete;
+		/// \brief move is prohibited
+		context_pool &operator=(context_pool &&) noexcept = delete;
+
+	private:
+		/// @brief The reactor objects, one per thread
+		std::vector<io::context_ptr> _contexts;
+	};
+	/// \brief The \ref io::context_pool smart pointer alias
+	using context_pool_ptr = std::shared_ptr<context_pool>;
+}
+
+#endif // H_IO_CONTEXT_POOL_T
@@ -0,0 +1,185 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_IO_DELEGATE_T
+#define H_IO_DELEGATE_T
+
+#include <cstddef>
+#include <functional> // std::bad_function_call
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// \brief The input/output library namespace
+namespace io
+{
+    /// \brief The default \ref io::delegate inline storage size.
+    /// It fits the `[this, self]` captures and the small functor objects,
+    /// so the whole delegate is one cache line.
+    constexpr std::size_t delegate_default_capacity = 48;
+
+    template <typename Signature, std::size_t Capacity = delegate_default_capacity>
+    class delegate;
+
+    /// \brief The move-only type erased callable with the fixed size inline storage.
+    /// Unlike the std::function it never allocates: the callable which does not fit
+    /// the \p Capacity bytes is rejected at compile time.
+    /// The empty delegate call throws the std::bad_function_call exception like std::function does.
+    /// @tparam R The return type
+    /// @tparam Args The arguments types
+    /// @tparam Capacity The inline storage size
+    template <typename R, typename... Args, std::size_t Capacity>
+    class delegate<R(Args...), Capacity>
+    {
+    public:
+        /// @brief Construct the empty delegate
+        delegate() noexcept = default;
+        /// @brief Construct the empty delegate
+        delegate(std::nullptr_t) noexcept
+        {
+        }
+
+        /// @brief Construct the delegate from the callable object
+        /// @tparam F The callable type
+        /// @param f The callable object
+        template <
+            typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, delegate> &&
+                std::is_invocable_r_v<R, std::decay_t<F> &, Args...>>>
+        delegate(F &&f)
+        {
+            using callable_t = std::decay_t<F>;
+            static_assert(sizeof(callable_t) <= Capacity, "the callable does not fit the delegate inline storage");
+            static_assert(alignof(callable_t) <= alignof(storage_t), "the callable alignment is not supported");
+            static_assert(std::is_nothrow_move_constructible_v<callable_t>, "the callable must be nothrow move constructible");
+            // the function reference decays to the pointer, but it is never null
+            if constexpr (std::is_pointer_v<std::remove_reference_t<F>> || std::is_member_pointer_v<std::remove_reference_t<F>>)
+            {
+                if (nullptr == f)
+                {
+                    return;
+                }
+            }
+            ::new (static_cast<void *>(&_storage)) callable_t(std::forward<F>(f));
+            _invoke = &_invoke_callable<callable_t>;
+            _manage = &_manage_callable<callable_t>;
+        }
+
+        /// @brief Move the callable from the \p other delegate
+        /// @param other The delegate to move from, it becomes empty
+        delegate(delegate &&other) noexcept
+        {
+            _move_from(other);
+        }
+        /// @brief Move the callable from the \p other delegate
+        /// @param other The delegate to move from, it becomes empty
+        /// @return This delegate
+        delegate &operator=(delegate &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                _move_from(other);
+            }
+            return *this;
+        }
+        /// @brief Destroy the stored callable
+        /// @return This delegate
+        delegate &operator=(std::nullptr_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+
+        /// \brief copy is prohibited
+        delegate(const delegate &) = delete;
+        /// \brief copy is prohibited
+        delegate &operator=(const delegate &) = delete;
+
+        /// @brief Destroy the stored callable
+        ~delegate()
+        {
+            reset();
+        }
+
+        /// @brief Destroy the stored callable
+        void reset() noexcept
+        {
+            if (nullptr != _manage)
+            {
+                _manage(&_storage, nullptr);
+            }
+            _invoke = &_invoke_empty;
+            _manage = nullptr;
+        }
+
+        /// @brief Check if the delegate stores a callable
+        explicit operator bool() const noexcept
+        {
+            return nullptr != _manage;
+        }
+
+        /// @brief Call the stored callable
+        /// @param args The call arguments
+        /// @return The callable result
+        R operator()(Args... args) const
+        {
+            return _invoke(&_storage, std::forward<Args>(args)...);
+        }
+
+    private:
+        /// @brief The inline storage type
+        using storage_t = std::aligned_storage_t<Capacity, alignof(std::max_align_t)>;
+        /// @brief The type erased call function type
+        using invoke_t = R (*)(void *, Args &&...);
+        /// @brief The type erased move and destroy function type.
+        /// Move constructs the callable to the second storage and destroys it in the first one,
+        /// or just destroys it if the second storage is nullptr.
+        using manage_t = void (*)(void *, void *);
+
+        template <typename T>
+        static R _invoke_callable(void *storage, Args &&...args)
+        {
+            return std::invoke(*static_cast<T *>(storage), std::forward<Args>(args)...);
+        }
+
+        static R _invoke_empty(void *, Args &&...)
+        {
+            throw std::bad_function_call();
+        }
+
+        template <typename T>
+        static void _manage_callable(void *from, void *to) noexcept
+        {
+            T *callable = static_cast<T *>(from);
+            if (nullptr != to)
+            {
+                ::new (to) T(std::move(*callable));
+            }
+            callable->~T();
+        }
+
+        void _move_from(delegate &other) noexcept
+        {
+            if (nullptr != other._manage)
+            {
+                other._manage(&other._storage, &_storage);
+                _invoke = other._invoke;
+                _manage = other._manage;
+                other._invoke = &_invoke_empty;
+                other._manage = nullptr;
+            }
+        }
+
+        /// @brief The callable inline storage
+        mutable storage_t _storage;
+        /// @brief The type erased call function
+        invoke_t _invoke = &_invoke_empty;
+        /// @brief The type erased move and destroy function, nullptr for the empty delegate
+        manage_t _manage = nullptr;
+    };
+}
+
+#endif // H_IO_DELEGATE_T
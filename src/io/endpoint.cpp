@@ -0,0 +1,86 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "endpoint.hpp"
+#include "v4.hpp"
+#include "error.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <ostream>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+io::ip::endpoint::endpoint() noexcept
+    : _storage{},
+      _size(0)
+{
+    _storage.ss_family = AF_UNSPEC;
+}
+
+io::ip::endpoint::endpoint(const sockaddr *address, socklen_t size) noexcept
+    : _storage{},
+      _size(std::min<socklen_t>(size, sizeof(_storage)))
+{
+    std::memcpy(&_storage, address, _size);
+}
+
+io::ip::endpoint::endpoint(const io::ip::v4 &address)
+    : _storage{},
+      _size(sizeof(sockaddr_in))
+{
+    sockaddr_in *sai = reinterpret_cast<sockaddr_in *>(&_storage);
+    sai->sin_family = AF_INET;
+    sai->sin_port = htons(address.port());
+    if (1 != ::inet_pton(AF_INET, address.host().c_str(), &sai->sin_addr))
+    {
+        throw io::error("invalid IPv4 address", -1, errno);
+    }
+}
+
+std::uint16_t io::ip::endpoint::port() const noexcept
+{
+    switch (_storage.ss_family)
+    {
+    case AF_INET:
+        return ntohs(reinterpret_cast<const sockaddr_in *>(&_storage)->sin_port);
+    case AF_INET6:
+        return ntohs(reinterpret_cast<const sockaddr_in6 *>(&_storage)->sin6_port);
+    default:
+        return 0;
+    }
+}
+
+std::string io::ip::endpoint::host() const
+{
+    std::array<char, INET6_ADDRSTRLEN> buf{0};
+    const void *addr = nullptr;
+    switch (_storage.ss_family)
+    {
+    case AF_INET:
+        addr = &reinterpret_cast<const sockaddr_in *>(&_storage)->sin_addr;
+        break;
+    case AF_INET6:
+        addr = &reinterpret_cast<const sockaddr_in6 *>(&_storage)->sin6_addr;
+        break;
+    default:
+        return std::string();
+    }
+    if (nullptr == ::inet_ntop(_storage.ss_family, addr, buf.data(), buf.size()))
+    {
+        return std::string(); // LCOV_EXCL_LINE
+    }
+    return std::string(buf.data());
+}
+
+std::ostream &io::ip::operator<<(std::ostream &os, const io::ip::endpoint &address)
+{
+    if (AF_INET6 == address.family())
+    {
+        return os << '[' << address.host() << "]:" << address.port();
+    }
+    return os << address.host() << ':' << address.port();
+}
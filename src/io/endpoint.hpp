@@ -0,0 +1,79 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_IO_IP_ENDPOINT_T
+#define H_IO_IP_ENDPOINT_T
+
+#include <cstdint>
+#include <string>
+#include <iosfwd>
+
+#include <sys/socket.h>
+
+/// \brief The input/output library namespace
+namespace io
+{
+	/// \brief The IP protocol related abstractions namespace
+	namespace ip
+	{
+		class v4;
+
+		/// @brief The binary socket address as returned by the system calls.
+		/// It is trivially copyable and is formatted to the text only on demand.
+		class endpoint
+		{
+		public:
+			/// @brief Construct the empty address of the AF_UNSPEC family
+			endpoint() noexcept;
+			/// @brief Construct the address from the system socket address
+			/// @param address The socket address
+			/// @param size The socket address size, truncated to the sockaddr_storage size
+			endpoint(const sockaddr *address, socklen_t size) noexcept;
+			/// @brief Construct the AF_INET address from the text address
+			/// @param address The IPv4 address
+			explicit endpoint(const io::ip::v4 &address);
+
+			/// @brief Get the address family
+			/// @return The address family like AF_INET
+			sa_family_t family() const noexcept
+			{
+				return _storage.ss_family;
+			}
+			/// @brief Get the port number in the host byte order
+			/// @return The port number or zero if the family has no port
+			std::uint16_t port() const noexcept;
+			/// @brief Format the host part of the address
+			/// @return The host string like "127.0.0.1" or an empty string if the family is unknown
+			std::string host() const;
+
+			/// @brief Get the system socket address
+			/// @return The system socket address
+			const sockaddr *data() const noexcept
+			{
+				return reinterpret_cast<const sockaddr *>(&_storage);
+			}
+			/// @brief Get the system socket address size
+			/// @return The system socket address size
+			socklen_t size() const noexcept
+			{
+				return _size;
+			}
+
+		private:
+			/// @brief The system socket address
+			sockaddr_storage _storage;
+			/// @brief The system socket address size
+			socklen_t _size;
+		};
+
+		/// @brief The std::ostream output operator overload
+		/// to output the \p address in a human readable format.
+		/// @param os The output stream object
+		/// @param address The \ref io::ip::endpoint value to output
+		/// @return The output stream object \p os
+		std::ostream &operator<<(std::ostream &os, const endpoint &address);
+	}
+}
+
+#endif // H_IO_IP_ENDPOINT_T
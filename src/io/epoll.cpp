@@ -13,7 +13,7 @@
 #include <sys/epoll.h>
 
 io::system::epoll::epoll(event_mask_t event_mask, native_callback_t callback)
-    : _epfd(0), _event_mask(event_mask), _native_callback(callback)
+    : _epfd(0), _event_mask(event_mask), _native_callback(std::move(callback))
 {
     int fd = epoll_create1(0);
     if (fd < 0)
@@ -38,11 +38,11 @@ io::system::epoll::~epoll() noexcept
 }
 // LCOV_EXCL_STOP
 
-void io::system::epoll::_add_fd(io::file_descriptor_t fd)
+void io::system::epoll::_add_fd(io::file_descriptor_t fd, handle_t handle)
 {
     struct epoll_event event = {};
     event.events = _event_mask;
-    event.data.fd = fd;
+    event.data.u64 = handle;
 
     int ret = epoll_ctl(_epfd, EPOLL_CTL_ADD, fd, &event);
     if (-1 == ret)
@@ -61,6 +61,20 @@ void io::system::epoll::_del_fd(io::file_descriptor_t fd)
     }
 }
 
+void io::system::epoll::_set_output_interest(io::file_descriptor_t fd, handle_t handle, bool enabled)
+{
+    struct epoll_event event = {};
+    event.events = enabled ? (_event_mask | EPOLLOUT) : _event_mask;
+    event.data.u64 = handle;
+
+    // the edge triggered EPOLLOUT is reported at once if the socket is writable already
+    int ret = epoll_ctl(_epfd, EPOLL_CTL_MOD, fd, &event);
+    if (-1 == ret)
+    {
+        throw io::error("failed to modify file descriptor in epoll", fd, errno);
+    }
+}
+
 namespace
 {
     io::flags epoll_mask_to_io_flags(io::system::epoll::event_mask_t mask)
@@ -82,7 +96,7 @@ namespace
     }
 }
 
-void io::system::epoll::_wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size, io::bus::callback_t callback)
+void io::system::epoll::_wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size)
 {
     _events_buff.resize(events_buf_size);
 
@@ -103,18 +117,15 @@ void io::system::epoll::_wait_events(std::chrono::milliseconds timeout_msec, std
         {
             if (_native_callback)
             {
-                _native_callback(event.data.fd, event.events);
+                _native_callback(handle_to_fd(event.data.u64), event.events);
             }
-            if (callback)
+            auto flags = epoll_mask_to_io_flags(event.events);
+            IO_DEBUG((std::cout << "epoll::_wait_events: fd = " << handle_to_fd(event.data.u64) << "; events = 0x" << std::hex << (0xFFFFFFFF & event.events) << std::dec << "; flags = " << flags << std::endl));
+            if (flags.test(io::flags::error))
             {
-                auto flags = epoll_mask_to_io_flags(event.events);
-                IO_DEBUG((std::cout << "epoll::_wait_events: fd = " << event.data.fd << "; events = 0x" << std::hex << (0xFFFFFFFF & event.events) << std::dec << "; flags = " << flags << std::endl));
-                if (flags.test(io::flags::error))
-                {
-                    IO_DEBUG((std::cout << "epoll::_wait_events error: fd = " << event.data.fd << "; events = 0x" << std::hex << (0xFFFFFFFF & event.events) << std::dec << std::endl));
-                }
-                callback(this, event.data.fd, flags);
+                IO_DEBUG((std::cout << "epoll::_wait_events error: fd = " << handle_to_fd(event.data.u64) << "; events = 0x" << std::hex << (0xFFFFFFFF & event.events) << std::dec << std::endl));
             }
+            dispatch_event(event.data.u64, flags);
         }
     }
 }
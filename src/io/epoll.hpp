@@ -9,7 +9,6 @@
 
 #include <cstddef>
 #include <vector>
-#include <functional>
 
 #include <sys/epoll.h> // struct epoll_event
 
@@ -30,7 +29,7 @@ namespace io
 			using event_t = struct epoll_event;
 			/// @brief The native epoll callback.
 			/// Accepts \ref file_descriptor_t and \ref event_mask_t
-			using native_callback_t = std::function<void(file_descriptor_t, event_mask_t)>;
+			using native_callback_t = io::delegate<void(file_descriptor_t, event_mask_t)>;
 
 			/// @brief Constructs new epoll \ref io::bus implementation object.
 			/// @param event_mask The native epoll event mask.
@@ -53,20 +52,26 @@ namespace io
 			/// @brief Listen on the \p fd file descriptor.
 			/// The \ref io::bus::_add_fd pure virtual function implementation.
 			/// @param fd The file descriptor
-			void _add_fd(file_descriptor_t fd) override;
+			/// @param handle The registration handle stored in the epoll event user data
+			void _add_fd(file_descriptor_t fd, handle_t handle) override;
 			/// @brief Stop listening on the \p fd file descriptor
 			/// The \ref io::bus::_del_fd pure virtual function implementation.
 			/// @param fd The file descriptor
 			void _del_fd(file_descriptor_t fd) override;
+			/// @brief Change the output readiness watch of the \p fd file descriptor with the EPOLL_CTL_MOD.
+			/// The \ref io::bus::_set_output_interest pure virtual function implementation.
+			/// @param fd The file descriptor
+			/// @param handle The registration handle stored in the epoll event user data
+			/// @param enabled Add the EPOLLOUT to the native event mask if true
+			void _set_output_interest(file_descriptor_t fd, handle_t handle, bool enabled) override;
 
 			/// @brief Wait for I/O events on this bus object.
 			/// It waits for the \p timeout_msec milliseconds or
 			/// while the \p events_buf_size events is read.
 			/// The \ref io::bus::_wait_events pure virtual function implementation.
-			/// @param timeout_msec The maximum time to wait for events, in milliseconds. Or \ref std::chrono::milliseconds{0} for infinit wait.
+			/// @param timeout_msec The maximum time to wait for events, in milliseconds. A negative value means infinite wait, zero means no wait.
 			/// @param events_buf_size The events buffer size
-			/// @param callback The I/O bus async event callback function to be called for each I/O event triggered.
-			void _wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size, io::bus::callback_t callback) override;
+			void _wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size) override;
 
 		private:
 			/// \brief The epoll file descriptor.
@@ -0,0 +1,71 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "eventfd.hpp"
+#include "error.hpp"
+#include "log.hpp"
+
+#include <cstdint>
+#include <iostream>
+
+#include <poll.h>
+#include <unistd.h> // ::close, ::read, ::write
+#include <sys/eventfd.h>
+
+io::system::eventfd::eventfd()
+    : _fd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      _is_notified(false)
+{
+    if (-1 == _fd)
+    {
+        throw io::error("failed to create eventfd", _fd, errno);
+    }
+}
+
+// LCOV_EXCL_START
+io::system::eventfd::~eventfd() noexcept
+{
+    IO_DEBUG((std::cout << "~eventfd: fd = " << _fd << std::endl));
+    if (-1 == ::close(_fd))
+    {
+        std::cerr << "Failed to close eventfd file descriptor: errno = " << errno << std::endl;
+    }
+}
+// LCOV_EXCL_STOP
+
+void io::system::eventfd::notify() noexcept
+{
+    if (!_is_notified.exchange(true, std::memory_order_acq_rel))
+    {
+        // only ::write here, it is async-signal-safe
+        const int saved_errno = errno;
+        const std::uint64_t value = 1;
+        [[maybe_unused]] const ssize_t ret = ::write(_fd, &value, sizeof(value));
+        errno = saved_errno;
+    }
+}
+
+void io::system::eventfd::reset() noexcept
+{
+    // the exchange synchronizes with the producer's one, so its data pushed before the notify is visible now
+    if (_is_notified.exchange(false, std::memory_order_acq_rel))
+    {
+        std::uint64_t value = 0;
+        [[maybe_unused]] const ssize_t ret = ::read(_fd, &value, sizeof(value));
+    }
+}
+
+bool io::system::eventfd::wait(std::chrono::milliseconds timeout)
+{
+    struct pollfd pfd = {};
+    pfd.fd = _fd;
+    pfd.events = POLLIN;
+    const int ret = ::poll(&pfd, 1, timeout.count() < 0 ? -1 : static_cast<int>(timeout.count()));
+    if (-1 == ret && EINTR != errno)
+    {
+        throw io::error("eventfd poll error", _fd, errno);
+    }
+    reset();
+    return ret > 0;
+}
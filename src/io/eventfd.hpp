@@ -0,0 +1,68 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_IO_EVENTFD_T
+#define H_IO_EVENTFD_T
+
+#include "fd.hpp"
+
+#include <atomic>
+#include <chrono>
+
+/// \brief The input/output library namespace
+namespace io
+{
+	/// \brief The system specific namespace
+	namespace system
+	{
+		/// \brief The cross thread wakeup notification based on the GNU/Linux kernel eventfd object.
+		/// The notifications are coalesced: only the first one after the \ref reset writes to the eventfd,
+		/// so the producers do not make a system call for every notification.
+		class eventfd
+		{
+		public:
+			/// @brief Create the non-blocking eventfd object
+			eventfd();
+			/// @brief Close the eventfd object
+			~eventfd() noexcept;
+
+			/// \brief copy is prohibited
+			eventfd(const eventfd &) = delete;
+			/// \brief copy is prohibited
+			eventfd &operator=(const eventfd &) = delete;
+
+			/// \brief move is prohibited
+			eventfd(eventfd &&) noexcept = delete;
+			/// \brief move is prohibited
+			eventfd &operator=(eventfd &&) noexcept = delete;
+
+			/// @brief Get the eventfd file descriptor to listen on for the input events
+			/// @return The eventfd file descriptor
+			file_descriptor_t get_fd() const
+			{
+				return _fd;
+			}
+
+			/// @brief Make the eventfd readable.
+			/// It is safe to call it from any thread and from a signal handler.
+			void notify() noexcept;
+			/// @brief Consume the notifications.
+			/// Call it on the consumer thread before the notified state is checked.
+			void reset() noexcept;
+			/// @brief Wait for the notification and consume it.
+			/// It is for the threads which do not run an \ref io::bus.
+			/// @param timeout The maximum time to wait, a negative value means infinity
+			/// @return True if notified, false on timeout
+			bool wait(std::chrono::milliseconds timeout);
+
+		private:
+			/// @brief The eventfd file descriptor
+			file_descriptor_t _fd;
+			/// @brief True if the eventfd is notified and not reset yet
+			std::atomic_bool _is_notified;
+		};
+	}
+}
+
+#endif // H_IO_EVENTFD_T
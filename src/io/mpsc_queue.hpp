@@ -0,0 +1,97 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_IO_UTIL_MPSC_QUEUE_T
+#define H_IO_UTIL_MPSC_QUEUE_T
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace io
+{
+    namespace util
+    {
+        /// @brief The unbounded multiple producers single consumer queue.
+        /// It is the Dmitry Vyukov's intrusive MPSC node based queue:
+        /// the push is one atomic exchange, the pop does not use atomic read-modify-write operations at all.
+        /// The pushed value is invisible to the consumer for the short time
+        /// between the producer's exchange and the link store, so the consumer can see
+        /// the queue empty while it is not. The producer should notify the consumer after the push.
+        /// @tparam T The value type
+        template <typename T>
+        class mpsc_queue
+        {
+        public:
+            mpsc_queue()
+                : _head(new node_t), _tail(_head.load(std::memory_order_relaxed))
+            {
+            }
+
+            ~mpsc_queue()
+            {
+                while (nullptr != _tail)
+                {
+                    node_t *next = _tail->next.load(std::memory_order_relaxed);
+                    delete _tail;
+                    _tail = next;
+                }
+            }
+
+            /// \brief copy is prohibited
+            mpsc_queue(const mpsc_queue &) = delete;
+            /// \brief copy is prohibited
+            mpsc_queue &operator=(const mpsc_queue &) = delete;
+
+            /// @brief Push the \p value to the queue. Can be called from any thread.
+            /// @param value The value to push
+            void push(T value)
+            {
+                node_t *node = new node_t;
+                node->value.emplace(std::move(value));
+                node_t *prev = _head.exchange(node, std::memory_order_acq_rel);
+                prev->next.store(node, std::memory_order_release);
+            }
+
+            /// @brief Pop the value from the queue. Should only be called from the consumer thread.
+            /// @param value The value popped
+            /// @return False if the queue is empty
+            bool pop(T &value)
+            {
+                node_t *next = _tail->next.load(std::memory_order_acquire);
+                if (nullptr == next)
+                {
+                    return false;
+                }
+                value = std::move(*next->value);
+                next->value.reset();
+                delete _tail;
+                // the popped node becomes the new stub node
+                _tail = next;
+                return true;
+            }
+
+            /// @brief Check if the queue is empty. Should only be called from the consumer thread.
+            /// @return True if the queue is empty
+            bool empty() const
+            {
+                return nullptr == _tail->next.load(std::memory_order_acquire);
+            }
+
+        private:
+            /// @brief The queue node
+            struct node_t
+            {
+                std::atomic<node_t *> next{nullptr};
+                std::optional<T> value;
+            };
+            /// @brief The last pushed node, the producers side
+            std::atomic<node_t *> _head;
+            /// @brief The stub node before the first value, the consumer side
+            node_t *_tail;
+        };
+    }
+}
+
+#endif // H_IO_UTIL_MPSC_QUEUE_T
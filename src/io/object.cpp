@@ -7,6 +7,9 @@
 
 #include <algorithm>
 #include <iostream>
+#include <utility>
+
+#include <cerrno> // EOPNOTSUPP
 
 io::file_descriptor_t io::object_base::get_fd() const
 {
@@ -16,14 +19,30 @@ const io::bus_ptr &io::object_base::get_bus()
 {
     return _get_bus();
 }
-void io::object_base::add_bus_callback(const io::bus::callback_t &cb)
+bool io::object_base::can_splice() const
+{
+    return _can_splice();
+}
+bool io::object_base::_can_splice() const
 {
-    _get_bus()->add_fd(_get_fd(), cb);
+    return false;
+}
+void io::object_base::add_bus_callback(io::bus::callback_t cb, io::callback_class cls)
+{
+    _get_bus()->add_fd(_get_fd(), std::move(cb), cls);
 }
 void io::object_base::del_bus_fd_callbacks()
 {
     _get_bus()->del_fd_callbacks(_get_fd());
 }
+void io::object_base::add_bus_output_interest()
+{
+    _get_bus()->add_output_interest(_get_fd());
+}
+void io::object_base::del_bus_output_interest()
+{
+    _get_bus()->del_output_interest(_get_fd());
+}
 void io::object_base::del_bus_fd()
 {
     IO_DEBUG((std::cout << "object_base::del_bus_fd: fd = " << _get_fd() << std::endl));
@@ -39,6 +58,55 @@ io::input_object::result_type io::input_object::async_read_some(value_t *buf, st
     return _async_read_some(buf, buf_len);
 }
 
+io::input_object::result_type io::input_object::async_readv(const struct iovec *iov, int iovcnt)
+{
+    return _async_readv(iov, iovcnt);
+}
+
+io::input_object::result_type io::input_object::_async_readv(const struct iovec *iov, int iovcnt)
+{
+    std::size_t total = 0;
+    for (int i = 0; i < iovcnt; ++i)
+    {
+        auto result = _async_read_some(iov[i].iov_base, iov[i].iov_len);
+        if (std::holds_alternative<io::error>(result))
+        {
+            if (0 == total)
+            {
+                return result;
+            }
+            // the data read is reported, the error repeats on the next read
+            break;
+        }
+        const std::size_t len = std::get<success_result_type>(result).buf_len;
+        total += len;
+        if (len < iov[i].iov_len)
+        {
+            break;
+        }
+    }
+    return success_result_type{get_fd(), 0 < iovcnt ? iov[0].iov_base : nullptr, total};
+}
+
+io::input_object::result_type io::input_object::async_splice_to(io::file_descriptor_t pipe_fd, std::size_t len)
+{
+    return _async_splice_to(pipe_fd, len);
+}
+
+io::input_object::result_type io::input_object::_async_splice_to(io::file_descriptor_t, std::size_t)
+{
+    return io::error("splice is not supported", get_fd(), EOPNOTSUPP);
+}
+
+void io::input_object::receive_with_bus()
+{
+    _receive_with_bus();
+}
+
+void io::input_object::_receive_with_bus()
+{
+}
+
 // LCOV_EXCL_START
 io::input_object::~input_object() noexcept {}
 // LCOV_EXCL_STOP
@@ -48,6 +116,65 @@ io::output_object::result_type io::output_object::async_write_some(const value_t
     return _async_write_some(buf, buf_len);
 }
 
+io::output_object::result_type io::output_object::async_writev(const struct iovec *iov, int iovcnt)
+{
+    return _async_writev(iov, iovcnt);
+}
+
+io::output_object::result_type io::output_object::_async_writev(const struct iovec *iov, int iovcnt)
+{
+    std::size_t total = 0;
+    for (int i = 0; i < iovcnt; ++i)
+    {
+        auto result = _async_write_some(iov[i].iov_base, iov[i].iov_len);
+        if (std::holds_alternative<io::error>(result))
+        {
+            if (0 == total)
+            {
+                return result;
+            }
+            // the data written is reported, the error repeats on the next write
+            break;
+        }
+        const std::size_t len = std::get<success_result_type>(result).buf_len;
+        total += len;
+        if (len < iov[i].iov_len)
+        {
+            break;
+        }
+    }
+    return success_result_type{get_fd(), 0 < iovcnt ? iov[0].iov_base : nullptr, total};
+}
+
+io::output_object::result_type io::output_object::async_splice_from(io::file_descriptor_t pipe_fd, std::size_t len)
+{
+    return _async_splice_from(pipe_fd, len);
+}
+
+io::output_object::result_type io::output_object::_async_splice_from(io::file_descriptor_t, std::size_t)
+{
+    return io::error("splice is not supported", get_fd(), EOPNOTSUPP);
+}
+
+std::size_t io::output_object::get_retained_bytes() const
+{
+    return _get_retained_bytes();
+}
+
+std::size_t io::output_object::_get_retained_bytes() const
+{
+    return 0;
+}
+
+void io::output_object::send_with_bus()
+{
+    _send_with_bus();
+}
+
+void io::output_object::_send_with_bus()
+{
+}
+
 // LCOV_EXCL_START
 io::output_object::~output_object() noexcept {}
 // LCOV_EXCL_STOP
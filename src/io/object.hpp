@@ -9,12 +9,15 @@
 #include "bus.hpp"
 #include "error.hpp" // io::error
 
+#include "delegate.hpp"
+
 #include <cstddef> // std::size_t
-#include <functional>
 #include <vector>
 #include <memory>
 #include <variant>
 
+#include <sys/uio.h> // iovec
+
 /// \brief The input/output library namespace
 namespace io
 {
@@ -34,14 +37,22 @@ namespace io
 		/// @brief Get the underlying \ref io::bus object for this I/O object
 		/// @return The underlying \ref io::bus object for this I/O object
 		const bus_ptr &get_bus();
+		/// @brief Check whether the data can be moved between this I/O object and a pipe with the splice call
+		/// @return true if the splice functions are implemented
+		bool can_splice() const;
 
 		/// @brief The convenience method to simplify \ref io::bus::add_fd method call
 		/// @param cb The callback function to handle I/O bus events
-		void add_bus_callback(const io::bus::callback_t &cb);
+		/// @param cls The callback kind to account the callback duration to
+		void add_bus_callback(io::bus::callback_t cb, io::callback_class cls = io::callback_class::other);
 		/// @brief The convenience method to simplify \ref io::bus::del_fd method call
 		void del_bus_fd();
 		/// @brief The convenience method to simplify \ref io::bus::del_fd_callbacks method call
 		void del_bus_fd_callbacks();
+		/// @brief The convenience method to simplify \ref io::bus::add_output_interest method call
+		void add_bus_output_interest();
+		/// @brief The convenience method to simplify \ref io::bus::del_output_interest method call
+		void del_bus_output_interest();
 
 	protected:
 		/// @brief Make sure the object is correctly destructed
@@ -56,6 +67,10 @@ namespace io
 		/// Pure virtual function. Implement it in the inherited concrete I/O object class.
 		/// @return The underlying \ref io::bus object for this I/O object
 		virtual const io::bus_ptr &_get_bus() = 0;
+		/// @brief Check whether the data can be moved between this I/O object and a pipe with the splice call.
+		/// Override it in the inherited concrete I/O object class implementing the splice functions.
+		/// @return false by default
+		virtual bool _can_splice() const;
 	};
 
 	/// \brief The async input object abstraction.
@@ -79,13 +94,26 @@ namespace io
 		/// The file descriptor,
 		/// data buffer pointer and bytes recieved or sent count
 		/// are provided for the callback when called
-		using callback_t = std::function<void(const result_type &)>;
+		using callback_t = io::delegate<void(const result_type &)>;
 
 		/// @brief Read available data asynchronously.
 		/// @param buf The buffer to write the recieved data to
 		/// @param buf_len The length of the \p buf
 		/// @return The \ref result_type with length of data read or error occured
 		result_type async_read_some(value_t *buf, std::size_t buf_len);
+		/// @brief Read available data to the buffers in order asynchronously.
+		/// @param iov The buffers to write the recieved data to
+		/// @param iovcnt The number of the \p iov buffers
+		/// @return The \ref result_type with the first buffer and the total length of data read or error occured
+		result_type async_readv(const struct iovec *iov, int iovcnt);
+		/// @brief Move the available data to the pipe asynchronously without the copy to the user space.
+		/// @param pipe_fd The pipe write end file descriptor
+		/// @param len The maximum length of data to move
+		/// @return The \ref result_type with the null buffer and the length of data moved or error occured
+		result_type async_splice_to(io::file_descriptor_t pipe_fd, std::size_t len);
+		/// @brief Let the \ref io::bus receive the data of this object itself if it can.
+		/// The reads take the data the bus received then, see \ref io::bus::receive_data.
+		void receive_with_bus();
 
 	protected:
 		/// @brief Make sure the object is correctly destructed
@@ -98,6 +126,22 @@ namespace io
 		/// @param buf_len The length of the \p buf
 		/// @return The \ref result_type with length of data read or error occured
 		virtual result_type _async_read_some(value_t *buf, std::size_t buf_len) = 0;
+		/// @brief Read available data to the buffers in order asynchronously.
+		/// The default implementation reads the buffers one by one until the short read.
+		/// @param iov The buffers to write the recieved data to
+		/// @param iovcnt The number of the \p iov buffers
+		/// @return The \ref result_type with the first buffer and the total length of data read or error occured
+		virtual result_type _async_readv(const struct iovec *iov, int iovcnt);
+		/// @brief Move the available data to the pipe asynchronously.
+		/// The default implementation reports the EOPNOTSUPP error, see \ref can_splice.
+		/// @param pipe_fd The pipe write end file descriptor
+		/// @param len The maximum length of data to move
+		/// @return The \ref result_type with length of data moved or error occured
+		virtual result_type _async_splice_to(io::file_descriptor_t pipe_fd, std::size_t len);
+		/// @brief Let the \ref io::bus receive the data of this object itself.
+		/// Override it in the inherited concrete I/O object class able to take the data from the bus.
+		/// Does nothing by default.
+		virtual void _receive_with_bus();
 	};
 	/// \brief The async input object abstraction smart pointer.
 	using input_object_ptr = std::shared_ptr<input_object>;
@@ -123,13 +167,32 @@ namespace io
 		/// The file descriptor,
 		/// data buffer pointer and bytes recieved or sent count
 		/// are provided for the callback when called
-		using callback_t = std::function<void(const result_type &)>;
+		using callback_t = io::delegate<void(const result_type &)>;
 
 		/// @brief Write data asynchronously.
 		/// @param buf The buffer of data to write from
 		/// @param buf_len The length of the \p buf
 		/// @return The \ref result_type with length of data written or error occured
 		result_type async_write_some(const value_t *buf, std::size_t buf_len);
+		/// @brief Write the data of the buffers in order asynchronously.
+		/// @param iov The buffers of data to write from
+		/// @param iovcnt The number of the \p iov buffers
+		/// @return The \ref result_type with the first buffer and the total length of data written or error occured
+		result_type async_writev(const struct iovec *iov, int iovcnt);
+		/// @brief Move the data from the pipe asynchronously without the copy to the user space.
+		/// @param pipe_fd The pipe read end file descriptor
+		/// @param len The maximum length of data to move
+		/// @return The \ref result_type with the null buffer and the length of data moved or error occured
+		result_type async_splice_from(io::file_descriptor_t pipe_fd, std::size_t len);
+		/// @brief Get the bytes count written and still referenced by this object.
+		/// The zero-copy write reports the data written while the system still reads it from the caller buffer,
+		/// so the last written bytes of that count should not be modified until it decreases.
+		/// @return The bytes count written and still referenced by this object
+		std::size_t get_retained_bytes() const;
+		/// @brief Let the \ref io::bus send the data of this object itself if it can.
+		/// The writes queue the data to the bus then and the written bytes stay retained until sent,
+		/// see \ref io::bus::send_data.
+		void send_with_bus();
 
 	protected:
 		/// @brief Make sure the object is correctly destructed
@@ -142,6 +205,26 @@ namespace io
 		/// @param buf_len The length of the \p buf
 		/// @return The \ref result_type with length of data written or error occured
 		virtual result_type _async_write_some(const value_t *buf, std::size_t buf_len) = 0;
+		/// @brief Write the data of the buffers in order asynchronously.
+		/// The default implementation writes the buffers one by one until the short write.
+		/// @param iov The buffers of data to write from
+		/// @param iovcnt The number of the \p iov buffers
+		/// @return The \ref result_type with the first buffer and the total length of data written or error occured
+		virtual result_type _async_writev(const struct iovec *iov, int iovcnt);
+		/// @brief Move the data from the pipe asynchronously.
+		/// The default implementation reports the EOPNOTSUPP error, see \ref can_splice.
+		/// @param pipe_fd The pipe read end file descriptor
+		/// @param len The maximum length of data to move
+		/// @return The \ref result_type with length of data moved or error occured
+		virtual result_type _async_splice_from(io::file_descriptor_t pipe_fd, std::size_t len);
+		/// @brief Get the bytes count written and still referenced by this object.
+		/// Override it in the inherited concrete I/O object class implementing the zero-copy write.
+		/// @return 0 by default
+		virtual std::size_t _get_retained_bytes() const;
+		/// @brief Let the \ref io::bus send the data of this object itself.
+		/// Override it in the inherited concrete I/O object class able to queue the data to the bus.
+		/// Does nothing by default.
+		virtual void _send_with_bus();
 	};
 	/// \brief The async output object abstraction smart pointer.
 	using output_object_ptr = std::shared_ptr<output_object>;
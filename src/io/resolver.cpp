@@ -0,0 +1,94 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "resolver.hpp"
+#include "addrinfo.hpp"
+#include "error.hpp"
+#include "log.hpp"
+
+#include <iostream>
+#include <utility>
+
+io::ip::resolver::resolver(
+    const io::ip::v4 &address,
+    std::chrono::milliseconds ttl,
+    resolve_t resolve)
+    : _address(address),
+      _ttl(ttl),
+      _resolve(std::move(resolve)),
+      _refresh_count(0),
+      _failure_count(0),
+      _stop_requested(false)
+{
+    _refresh();
+    _refresh_count.store(0, std::memory_order_relaxed);
+    if (_ttl.count() > 0)
+    {
+        _thread = std::thread(&io::ip::resolver::_run, this);
+    }
+}
+
+// LCOV_EXCL_START
+io::ip::resolver::~resolver() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop_requested = true;
+    }
+    _stop_cv.notify_all();
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+// LCOV_EXCL_STOP
+
+io::ip::resolver::endpoints_ptr io::ip::resolver::get_endpoints() const
+{
+    return std::atomic_load(&_endpoints);
+}
+
+io::ip::resolver::endpoints_t io::ip::resolver::resolve_addrinfo(const io::ip::v4 &address)
+{
+    const io::ip::system::addrinfo_t addrinfo(address);
+    endpoints_t endpoints;
+    for (const struct addrinfo &info : addrinfo)
+    {
+        endpoints.emplace_back(info.ai_addr, info.ai_addrlen);
+    }
+    return endpoints;
+}
+
+void io::ip::resolver::_refresh()
+{
+    auto endpoints = std::make_shared<const endpoints_t>(_resolve(_address));
+    if (endpoints->empty())
+    {
+        throw io::error("no endpoints resolved", -1, 0);
+    }
+    std::atomic_store(&_endpoints, endpoints_ptr(std::move(endpoints)));
+    _refresh_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void io::ip::resolver::_run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_stop_cv.wait_for(lock, _ttl, [this]
+                              { return _stop_requested; }))
+    {
+        // do not block the destructor while resolving
+        lock.unlock();
+        try
+        {
+            _refresh();
+        }
+        catch (std::exception &ex)
+        {
+            // keep the last resolved endpoints
+            _failure_count.fetch_add(1, std::memory_order_relaxed);
+            std::cerr << "failed to resolve " << _address << ": " << ex.what() << std::endl;
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,129 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_IO_IP_RESOLVER_T
+#define H_IO_IP_RESOLVER_T
+
+#include "v4.hpp"
+#include "endpoint.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// \brief The input/output library namespace
+namespace io
+{
+    /// \brief The IP protocol related abstractions namespace
+    namespace ip
+    {
+        /// \brief The cached address resolver.
+        /// The address is resolved once on construction and then refreshed every TTL on the helper thread,
+        /// so the reactor threads never block in the getaddrinfo call.
+        /// The refreshed endpoints replace the cached ones atomically, the readers keep the old list alive
+        /// until they drop it.
+        class resolver final
+        {
+        public:
+            /// @brief The resolved endpoints list type
+            using endpoints_t = std::vector<io::ip::endpoint>;
+            /// @brief The immutable resolved endpoints list smart pointer
+            using endpoints_ptr = std::shared_ptr<const endpoints_t>;
+            /// @brief The resolve function type
+            using resolve_t = std::function<endpoints_t(const io::ip::v4 &address)>;
+
+            /// @brief The default resolved endpoints time to live
+            static constexpr std::chrono::seconds DEFAULT_TTL{30};
+
+            /// @brief Resolve the \p address and start the refresh thread
+            /// @param address The address to resolve
+            /// @param ttl The resolved endpoints time to live, the zero value disables the refresh
+            /// @param resolve The resolve function, \ref resolve_addrinfo by default
+            /// @throw io::error if the address can not be resolved
+            explicit resolver(
+                const io::ip::v4 &address,
+                std::chrono::milliseconds ttl = DEFAULT_TTL,
+                resolve_t resolve = resolve_addrinfo);
+            /// @brief Stop the refresh thread
+            ~resolver() noexcept;
+
+            /// \brief copy is prohibited
+            resolver(const resolver &) = delete;
+            /// \brief copy is prohibited
+            resolver &operator=(const resolver &) = delete;
+            /// \brief move is prohibited
+            resolver(resolver &&) noexcept = delete;
+            /// \brief move is prohibited
+            resolver &operator=(resolver &&) noexcept = delete;
+
+            /// @brief Get the address resolved
+            /// @return The address resolved
+            const io::ip::v4 &get_address() const
+            {
+                return _address;
+            }
+            /// @brief Get the cached endpoints, it never blocks on the resolve.
+            /// It is safe to call from any thread.
+            /// @return The cached endpoints, never empty
+            endpoints_ptr get_endpoints() const;
+            /// @brief Get the number of the successful refreshes after the construction
+            /// @return The number of the successful refreshes
+            std::uint64_t get_refresh_count() const
+            {
+                return _refresh_count.load(std::memory_order_relaxed);
+            }
+            /// @brief Get the number of the failed refreshes, the cached endpoints are kept on failure
+            /// @return The number of the failed refreshes
+            std::uint64_t get_failure_count() const
+            {
+                return _failure_count.load(std::memory_order_relaxed);
+            }
+
+            /// @brief Resolve the \p address with the getaddrinfo call
+            /// @param address The address to resolve
+            /// @return The TCP endpoints of the address
+            /// @throw io::error if the address can not be resolved
+            static endpoints_t resolve_addrinfo(const io::ip::v4 &address);
+
+        private:
+            /// @brief Resolve the address and replace the cached endpoints
+            /// @throw io::error if the address can not be resolved
+            void _refresh();
+            /// @brief The refresh thread function
+            void _run();
+
+            /// @brief The address to resolve
+            io::ip::v4 _address;
+            /// @brief The resolved endpoints time to live
+            std::chrono::milliseconds _ttl;
+            /// @brief The resolve function
+            resolve_t _resolve;
+            /// @brief The cached endpoints, accessed with the std::atomic_load and std::atomic_store only
+            endpoints_ptr _endpoints;
+            /// @brief The number of the successful refreshes
+            std::atomic_uint64_t _refresh_count;
+            /// @brief The number of the failed refreshes
+            std::atomic_uint64_t _failure_count;
+
+            /// @brief The refresh thread stop guard
+            std::mutex _mutex;
+            /// @brief The refresh thread stop notification
+            std::condition_variable _stop_cv;
+            /// @brief Is the refresh thread stop requested
+            bool _stop_requested;
+            /// @brief The refresh thread
+            std::thread _thread;
+        };
+        /// @brief The \ref io::ip::resolver smart pointer alias
+        using resolver_ptr = std::shared_ptr<resolver>;
+    }
+}
+
+#endif // H_IO_IP_RESOLVER_T
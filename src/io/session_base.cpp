@@ -7,33 +7,116 @@
 #include <iostream>
 #include "log.hpp"
 
-io::ip::tcp::session_base::session_base(const io::bus_ptr &bus, io::file_descriptors_vec_t fds)
+#include <sys/socket.h> // ::getpeername
+
+io::ip::tcp::session_base::session_base(
+    const io::bus_ptr &bus,
+    io::file_descriptors_vec_t fds,
+    const session_timeouts &timeouts,
+    io::file_descriptors_vec_t connecting_fds)
     : _bus(bus),
-      _fds(fds)
+      _fds(fds),
+      _timeouts(timeouts),
+      _connecting_fds(connecting_fds),
+      _idle_timer(io::timer_wheel::invalid_timer_id),
+      _connect_timer(io::timer_wheel::invalid_timer_id)
 {
 }
 
 void io::ip::tcp::session_base::start()
 {
     auto self(shared_from_this());
+    _last_activity = _bus->get_timers().now();
     auto cb = [this, self](io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask)
     {
+        _last_activity = _bus->get_timers().now();
         if (mask.test(io::flags::error))
         {
-            for (io::file_descriptor_t fd : _fds)
-            {
-                _bus->del_fd_callbacks(fd);
-            }
+            close();
         }
     };
     for (io::file_descriptor_t fd : _fds)
     {
-        _bus->add_fd(fd, cb);
+        _bus->add_fd(fd, cb, io::callback_class::session);
+    }
+
+    if (_timeouts.connect.count() > 0 && !_connecting_fds.empty())
+    {
+        std::weak_ptr<session_base> weak_self = self;
+        _connect_timer = _bus->get_timers().arm(
+            _timeouts.connect,
+            [weak_self]()
+            {
+                if (auto session = weak_self.lock())
+                {
+                    session->_on_connect_timeout();
+                }
+            });
+    }
+    if (_timeouts.idle.count() > 0)
+    {
+        _arm_idle_timer(_timeouts.idle);
+    }
+}
+
+void io::ip::tcp::session_base::close()
+{
+    _bus->get_timers().cancel(_idle_timer);
+    _bus->get_timers().cancel(_connect_timer);
+    for (io::file_descriptor_t fd : _fds)
+    {
+        _bus->del_fd_callbacks(fd);
+    }
+}
+
+void io::ip::tcp::session_base::_arm_idle_timer(std::chrono::milliseconds delay)
+{
+    std::weak_ptr<session_base> weak_self = shared_from_this();
+    _idle_timer = _bus->get_timers().arm(
+        delay,
+        [weak_self]()
+        {
+            if (auto session = weak_self.lock())
+            {
+                session->_on_idle_timeout();
+            }
+        });
+}
+
+void io::ip::tcp::session_base::_on_idle_timeout()
+{
+    _idle_timer = io::timer_wheel::invalid_timer_id;
+    const auto idle_for = std::chrono::duration_cast<std::chrono::milliseconds>(_bus->get_timers().now() - _last_activity);
+    if (idle_for >= _timeouts.idle)
+    {
+        std::cerr << "[!] Session with fd: " << _fds.front() << " is idle for " << idle_for.count() << " ms, closing\n";
+        close();
+        return;
+    }
+    // there was an activity: check again when the rest of the idle timeout elapses
+    _arm_idle_timer(_timeouts.idle - idle_for);
+}
+
+void io::ip::tcp::session_base::_on_connect_timeout()
+{
+    _connect_timer = io::timer_wheel::invalid_timer_id;
+    for (io::file_descriptor_t fd : _connecting_fds)
+    {
+        struct sockaddr_storage address = {};
+        socklen_t address_len = sizeof(address);
+        if (-1 == ::getpeername(fd, reinterpret_cast<struct sockaddr *>(&address), &address_len))
+        {
+            std::cerr << "[!] Connection for fd: " << fd << " is not established in " << _timeouts.connect.count() << " ms, closing\n";
+            close();
+            return;
+        }
     }
 }
 
 // LCOV_EXCL_START
 io::ip::tcp::session_base::~session_base() noexcept
 {
+    _bus->get_timers().cancel(_idle_timer);
+    _bus->get_timers().cancel(_connect_timer);
 }
 // LCOV_EXCL_STOP
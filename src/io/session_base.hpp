@@ -7,7 +7,9 @@
 
 #include "bus.hpp"
 #include "fd.hpp"
+#include "timer_wheel.hpp"
 
+#include <chrono>
 #include <memory>
 
 /// \brief The input/output library namespace
@@ -23,6 +25,16 @@ namespace io
             /// \brief The TCP server class to manage new TCP sessions creation
             class session_manager;
 
+            /// \brief The TCP session timeouts. The zero value disables the timeout.
+            struct session_timeouts
+            {
+                /// \brief The maximum time for the outgoing connections of the session to be established
+                std::chrono::milliseconds connect{0};
+                /// \brief The maximum time without any I/O event on the session file descriptors.
+                /// It reaps the stuck sessions and the half-open peers which never report an error.
+                std::chrono::milliseconds idle{0};
+            };
+
             /// \brief The session base class for a TCP service
             class session_base
                 : public std::enable_shared_from_this<session_base>
@@ -41,6 +53,9 @@ namespace io
                     return _bus;
                 }
 
+                /// \brief Close the session: release all its \ref io::bus callbacks
+                void close();
+
                 /// \brief Session copying is prohibited
                 session_base(const session_base &) = delete;
                 /// \brief Session copying is prohibited
@@ -50,7 +65,13 @@ namespace io
                 /// \brief Construct the session base class for a TCP service
                 /// \param bus The \ref io::bus object instance to connect to the system level I/O
                 /// \param fds File descriptors related to this session
-                session_base(const io::bus_ptr &bus, io::file_descriptors_vec_t fds);
+                /// \param timeouts The session timeouts
+                /// \param connecting_fds The outgoing connections file descriptors to apply the connect timeout to
+                session_base(
+                    const io::bus_ptr &bus,
+                    io::file_descriptors_vec_t fds,
+                    const session_timeouts &timeouts = session_timeouts{},
+                    io::file_descriptors_vec_t connecting_fds = io::file_descriptors_vec_t{});
                 /// \brief Destruct the session base class for a TCP service
                 virtual ~session_base() noexcept;
 
@@ -60,11 +81,30 @@ namespace io
                 // Can not do it in constructor because of the \ref std::enable_shared_from_this limitations
                 void start();
 
+            private:
+                /// \brief Arm the idle timer
+                /// \param delay The time to check the session activity after
+                void _arm_idle_timer(std::chrono::milliseconds delay);
+                /// \brief The idle timer handler: close the session if there was no I/O activity
+                void _on_idle_timeout();
+                /// \brief The connect timer handler: close the session if the connections are not established
+                void _on_connect_timeout();
+
             private:
                 /// \brief The \ref io::bus object instance to connect to the system level I/O
                 io::bus_ptr _bus;
                 /// \brief File descriptors related to this session
                 io::file_descriptors_vec_t _fds;
+                /// \brief The session timeouts
+                session_timeouts _timeouts;
+                /// \brief The outgoing connections file descriptors
+                io::file_descriptors_vec_t _connecting_fds;
+                /// \brief The last I/O event time on the session file descriptors
+                io::timer_wheel::time_point_t _last_activity;
+                /// \brief The idle timer
+                io::timer_wheel::timer_id_t _idle_timer;
+                /// \brief The connect timer
+                io::timer_wheel::timer_id_t _connect_timer;
             };
             /// \brief The \ref session_base smart pointer alias
             using session_base_ptr = std::shared_ptr<session_base>;
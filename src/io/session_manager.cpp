@@ -14,7 +14,7 @@ io::ip::tcp::session_manager::session_manager(const acceptor_ptr &tcp_acceptor,
     : _tcp_acceptor(tcp_acceptor), _make_new_session_callback(make_new_session_callback)
 {
     _tcp_acceptor->add_callback(
-        [this](io::file_descriptor_t fd, const io::ip::v4 &address)
+        [this](io::file_descriptor_t fd, const io::ip::endpoint &address)
         {
             _make_new_session_callback(fd, address)->start();
         });
@@ -8,6 +8,7 @@
 #include "fd.hpp"
 #include "session_base.hpp"
 #include "acceptor_base.hpp"
+#include "endpoint.hpp"
 
 #include <functional>
 
@@ -17,7 +18,6 @@ namespace io
     /// \brief The IP protocol related abstractions namespace
     namespace ip
     {
-        class v4;
         /// \brief The TCP protocol related abstractions namespace
         namespace tcp
         {
@@ -29,7 +29,7 @@ namespace io
                 /// \param fd The new client connection file descriptor
                 /// \param address The new client connection address
                 /// \return The \ref io::ip::tcp::session_base derived object for the newly created session
-                using make_new_session_callback_t = std::function<session_base_ptr(io::file_descriptor_t fd, const io::ip::v4 &address)>;
+                using make_new_session_callback_t = std::function<session_base_ptr(io::file_descriptor_t fd, const io::ip::endpoint &address)>;
 
                 /// \brief Get the socket acceptor
                 /// \return The socket acceptor
@@ -11,15 +11,42 @@
 #include <iostream>
 #include <algorithm>
 #include <stdexcept>
+#include <cstring> // strerror
 
+#include <fcntl.h> // ::splice
 #include <unistd.h> // ::close
+#include <poll.h>
 #include <sys/socket.h>
+#include <netinet/in.h> // IP_RECVERR
+#include <netinet/tcp.h> // TCP_QUICKACK
+#include <linux/errqueue.h> // sock_extended_err
+
+#ifndef SO_ZEROCOPY
+// the values from the GNU/Linux uapi headers, they are missing in the older libc headers
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
 
 io::ip::tcp::socket::socket(
     io::bus_ptr io_bus,
     file_descriptor_t fd)
     : _io_bus(io_bus),
-      _fd(fd)
+      _fd(fd),
+      _next_address(0),
+      _connect_timeout(0),
+      _connect_timer(io::timer_wheel::invalid_timer_id),
+      _is_connecting(false),
+      _connect_error(0),
+      _retained_bytes(0),
+      _zerocopy_threshold(0),
+      _zerocopy_next_id(0),
+      _zerocopy_sends_count(0),
+      _zerocopy_copied_count(0),
+      _is_quick_ack(false),
+      _is_bus_receive(false),
+      _is_bus_send(false)
 {
 }
 
@@ -65,6 +92,179 @@ io::ip::tcp::socket::socket(
 {
 }
 
+io::ip::tcp::socket::socket(
+    io::bus_ptr io_bus,
+    const std::vector<io::ip::endpoint> &addresses,
+    std::chrono::milliseconds connect_timeout,
+    const io::ip::tcp::socket_options &options)
+    : io::ip::tcp::socket(io_bus, -1)
+{
+    _addresses = addresses;
+    _options = options;
+    _is_quick_ack = options.quick_ack;
+    _connect_timeout = connect_timeout;
+    _connect_deadline = _io_bus->get_timers().now() + connect_timeout;
+
+    const auto [fd, is_connected] = _open_next();
+    if (-1 == fd)
+    {
+        throw io::error("failed to connect", -1, errno);
+    }
+    _fd = fd;
+    if (is_connected)
+    {
+        return;
+    }
+
+    // registered before the channel and session callbacks,
+    // so the connect outcome is known before they see the event
+    _is_connecting = true;
+    add_bus_callback(
+        [this](io::event_reciever *, io::file_descriptor_t, io::flags mask)
+        {
+            _handle_connect_event(mask);
+        });
+    _io_bus->add_output_interest(_fd);
+    _arm_connect_timer();
+}
+
+std::pair<io::file_descriptor_t, bool> io::ip::tcp::socket::_open_next()
+{
+    while (_next_address < _addresses.size())
+    {
+        const io::ip::endpoint &address = _addresses[_next_address++];
+        int sockfd = ::socket(address.family(), SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (sockfd == -1)
+        {
+            std::cerr << "failed to create socket\n";
+            continue;
+        }
+
+        try
+        {
+            io::ip::tcp::set_socket_options(sockfd, _options);
+        }
+        catch (const io::error &ex)
+        {
+            std::cerr << ex.what() << "; errno = " << ex.get_errno() << "; for fd = " << ex.get_fd() << std::endl;
+            ::close(sockfd);
+            continue;
+        }
+
+        const int enabled = 1;
+        if (0 != _zerocopy_threshold && -1 == ::setsockopt(sockfd, SOL_SOCKET, SO_ZEROCOPY, &enabled, sizeof(enabled)))
+        {
+            std::cerr << "failed to set SO_ZEROCOPY socket option; errno = " << errno << "; for fd = " << sockfd << std::endl;
+            ::close(sockfd);
+            continue;
+        }
+
+        if (::connect(sockfd, address.data(), address.size()) == 0)
+        {
+            return {sockfd, true};
+        }
+        if (errno == EINPROGRESS)
+        {
+            return {sockfd, false};
+        }
+        ::close(sockfd);
+        std::cerr << "failed to connect socket to " << address << "\n";
+    }
+    return {-1, false};
+}
+
+void io::ip::tcp::socket::_handle_connect_event(io::flags mask)
+{
+    if (!_is_connecting || !(mask.test(io::flags::out) || mask.test(io::flags::error)))
+    {
+        return;
+    }
+
+    int error = 0;
+    socklen_t error_len = sizeof(error);
+    if (-1 == ::getsockopt(_fd, SOL_SOCKET, SO_ERROR, &error, &error_len))
+    {
+        error = errno;
+    }
+    if (0 == error && mask.test(io::flags::error))
+    {
+        // hang up without the pending error
+        error = ECONNRESET;
+    }
+    if (0 == error)
+    {
+        _finish_connect();
+        return;
+    }
+    _retry_connect(error);
+}
+
+void io::ip::tcp::socket::_finish_connect()
+{
+    IO_DEBUG((std::cout << "socket::_finish_connect: fd = " << _fd << std::endl));
+    _io_bus->get_timers().cancel(_connect_timer);
+    _connect_timer = io::timer_wheel::invalid_timer_id;
+    _is_connecting = false;
+    _io_bus->del_output_interest(_fd);
+    if (_is_bus_receive)
+    {
+        _io_bus->receive_data(_fd);
+    }
+    if (_is_bus_send)
+    {
+        _io_bus->send_data(_fd);
+    }
+}
+
+void io::ip::tcp::socket::_retry_connect(int error)
+{
+    _io_bus->get_timers().cancel(_connect_timer);
+    _connect_timer = io::timer_wheel::invalid_timer_id;
+    std::cerr << "failed to connect socket to " << _addresses[_next_address - 1] << ": " << ::strerror(error) << "\n";
+
+    const auto [fd, is_connected] = _open_next();
+    if (-1 == fd)
+    {
+        _is_connecting = false;
+        _connect_error = error;
+        // the owners close the socket on the error event
+        _io_bus->enqueue_event(_fd, io::flags::error);
+        return;
+    }
+
+    // the same file descriptor value is kept, so the callbacks registered for it stay valid
+    _io_bus->replace_fd(_fd, fd);
+    if (is_connected)
+    {
+        _finish_connect();
+        return;
+    }
+    _arm_connect_timer();
+}
+
+void io::ip::tcp::socket::_arm_connect_timer()
+{
+    if (_connect_timeout.count() <= 0)
+    {
+        return;
+    }
+
+    // the time left is shared equally by the current and the rest attempts
+    const std::size_t attempts_left = _addresses.size() - _next_address + 1;
+    const auto time_left = std::chrono::duration_cast<std::chrono::milliseconds>(_connect_deadline - _io_bus->get_timers().now());
+    const auto delay = std::max(std::chrono::milliseconds{1}, time_left / static_cast<long>(attempts_left));
+    _connect_timer = _io_bus->get_timers().arm(
+        delay,
+        [this]()
+        {
+            _connect_timer = io::timer_wheel::invalid_timer_id;
+            if (_is_connecting)
+            {
+                _retry_connect(ETIMEDOUT);
+            }
+        });
+}
+
 // LCOV_EXCL_START
 io::ip::tcp::socket::~socket() noexcept
 {
@@ -85,14 +285,33 @@ const io::bus_ptr &io::ip::tcp::socket::_get_bus()
 }
 
 io::input_object::result_type io::ip::tcp::socket::_async_read_some(value_t *buf, std::size_t buf_len)
+{
+    const struct iovec iov = {buf, buf_len};
+    return _async_readv(&iov, 1);
+}
+
+io::input_object::result_type io::ip::tcp::socket::_async_readv(const struct iovec *iov, int iovcnt)
 {
     if (-1 == _fd)
     {
         return io::error("closed socket used", _fd, errno);
     }
+    if (_is_connecting)
+    {
+        return io::input_object::success_result_type{_fd, iov[0].iov_base, 0};
+    }
+    if (0 != _connect_error)
+    {
+        return io::error("failed to connect", _fd, _connect_error);
+    }
 
+    struct msghdr msg = {};
+    msg.msg_iov = const_cast<struct iovec *>(iov);
+    msg.msg_iovlen = static_cast<std::size_t>(iovcnt);
     errno = 0;
-    const std::size_t bytes_recvd = ::recv(_fd, buf, buf_len, MSG_DONTWAIT);
+    const std::size_t bytes_recvd = _io_bus->is_receiving(_fd)
+                                        ? _io_bus->take_received(_fd, iov, iovcnt)
+                                        : ::recvmsg(_fd, &msg, MSG_DONTWAIT);
 
     switch (bytes_recvd)
     {
@@ -106,7 +325,7 @@ io::input_object::result_type io::ip::tcp::socket::_async_read_some(value_t *buf
         case EINTR:
         case EAGAIN:
         case EINPROGRESS:
-            return io::input_object::success_result_type{_fd, buf, 0};
+            return io::input_object::success_result_type{_fd, iov[0].iov_base, 0};
         default:
             IO_DEBUG((std::cout << "socket::_async_read_some_impl: recv() error. _close_connection()\n"));
             // _close_connection();
@@ -114,18 +333,58 @@ io::input_object::result_type io::ip::tcp::socket::_async_read_some(value_t *buf
         }
     }
 
-    return io::input_object::success_result_type{_fd, buf, bytes_recvd};
+    if (_is_quick_ack)
+    {
+        // the system returns to the delayed ACKs after a while, so the quick ACK mode is entered again
+        const int enabled = 1;
+        ::setsockopt(_fd, IPPROTO_TCP, TCP_QUICKACK, &enabled, sizeof(enabled));
+    }
+    return io::input_object::success_result_type{_fd, iov[0].iov_base, bytes_recvd};
 }
 
 io::output_object::result_type io::ip::tcp::socket::_async_write_some(const value_t *buf, std::size_t buf_len)
+{
+    const struct iovec iov = {const_cast<value_t *>(buf), buf_len};
+    return _async_writev(&iov, 1);
+}
+
+io::output_object::result_type io::ip::tcp::socket::_async_writev(const struct iovec *iov, int iovcnt)
 {
     if (-1 == _fd)
     {
         return io::error("closed socket used", _fd, errno);
     }
+    if (_is_connecting)
+    {
+        // the caller keeps the data until the connection is established
+        return io::output_object::success_result_type{_fd, iov[0].iov_base, 0};
+    }
+    if (0 != _connect_error)
+    {
+        return io::error("failed to connect", _fd, _connect_error);
+    }
 
+    std::size_t buf_len = 0;
+    for (int i = 0; i < iovcnt; ++i)
+    {
+        buf_len += iov[i].iov_len;
+    }
+    struct msghdr msg = {};
+    msg.msg_iov = const_cast<struct iovec *>(iov);
+    msg.msg_iovlen = static_cast<std::size_t>(iovcnt);
     errno = 0;
-    const std::size_t bytes_sent = ::send(_fd, buf, buf_len, MSG_DONTWAIT);
+    // the bus sends the data from the caller buffer after the return, see _get_retained_bytes
+    const bool is_bus_send = _io_bus->is_sending(_fd);
+    bool is_zerocopy = !is_bus_send && 0 != _zerocopy_threshold && buf_len >= _zerocopy_threshold;
+    std::size_t bytes_sent = is_bus_send
+                                 ? _io_bus->queue_send(_fd, iov, iovcnt)
+                                 : ::sendmsg(_fd, &msg, MSG_DONTWAIT | (is_zerocopy ? MSG_ZEROCOPY : 0));
+    if (bytes_sent == -1ul && is_zerocopy && ENOBUFS == errno)
+    {
+        // the pinned pages limit is reached, copy the data
+        is_zerocopy = false;
+        bytes_sent = ::sendmsg(_fd, &msg, MSG_DONTWAIT);
+    }
 
     if (bytes_sent == -1ul)
     {
@@ -134,14 +393,214 @@ io::output_object::result_type io::ip::tcp::socket::_async_write_some(const valu
         case EINTR:
         case EAGAIN:
         case EINPROGRESS:
-            return io::output_object::success_result_type{_fd, buf, 0};
+            return io::output_object::success_result_type{_fd, iov[0].iov_base, 0};
         default:
             IO_DEBUG((std::cout << "socket::_async_write_some_impl: send() error. _close_connection()\n"));
             // _close_connection();
             return io::error("send failed", _fd, errno);
         }
     }
-    return io::output_object::success_result_type{_fd, buf, bytes_sent};
+    if (is_zerocopy)
+    {
+        _retained_sends.push_back(retained_send_t{_zerocopy_next_id++, bytes_sent, false});
+        _retained_bytes += bytes_sent;
+        ++_zerocopy_sends_count;
+    }
+    else if (!_retained_sends.empty())
+    {
+        // the data is copied, but it follows the data the system still reads
+        _retained_sends.push_back(retained_send_t{0, bytes_sent, true});
+        _retained_bytes += bytes_sent;
+    }
+    return io::output_object::success_result_type{_fd, iov[0].iov_base, bytes_sent};
+}
+
+void io::ip::tcp::socket::set_quick_ack(bool enabled)
+{
+    _is_quick_ack = enabled;
+}
+
+void io::ip::tcp::socket::set_zerocopy_threshold(std::size_t threshold)
+{
+    if (0 != threshold && 0 == _zerocopy_threshold)
+    {
+        const int enabled = 1;
+        if (-1 == ::setsockopt(_fd, SOL_SOCKET, SO_ZEROCOPY, &enabled, sizeof(enabled)))
+        {
+            throw io::error("failed to set SO_ZEROCOPY socket option", _fd, errno);
+        }
+        _io_bus->set_event_filter(
+            _fd,
+            [this](io::file_descriptor_t, io::flags mask)
+            {
+                return _filter_event(mask);
+            });
+    }
+    _zerocopy_threshold = threshold;
+}
+
+std::size_t io::ip::tcp::socket::_get_retained_bytes() const
+{
+    return _retained_bytes + (-1 != _fd ? _io_bus->get_unsent_bytes(_fd) : 0);
+}
+
+void io::ip::tcp::socket::_receive_with_bus()
+{
+    _is_bus_receive = true;
+    if (-1 != _fd && !_is_connecting && 0 == _connect_error)
+    {
+        _io_bus->receive_data(_fd);
+    }
+}
+
+void io::ip::tcp::socket::_send_with_bus()
+{
+    _is_bus_send = true;
+    if (-1 != _fd && !_is_connecting && 0 == _connect_error)
+    {
+        _io_bus->send_data(_fd);
+    }
+}
+
+io::flags io::ip::tcp::socket::_filter_event(io::flags mask)
+{
+    if (!mask.test(io::flags::error) || !_reap_zerocopy_completions())
+    {
+        return mask;
+    }
+
+    // the completions may come with the real error
+    int error = 0;
+    socklen_t error_len = sizeof(error);
+    struct pollfd pfd = {_fd, POLLRDHUP, 0};
+    if (-1 == ::getsockopt(_fd, SOL_SOCKET, SO_ERROR, &error, &error_len) || 0 != error ||
+        -1 == ::poll(&pfd, 1, 0) || 0 != (pfd.revents & (POLLHUP | POLLRDHUP)))
+    {
+        return mask;
+    }
+    // the writers release the completed data on the output event
+    return (mask & io::flags::in) | io::flags::out;
+}
+
+bool io::ip::tcp::socket::_reap_zerocopy_completions()
+{
+    bool is_reaped = false;
+    for (;;)
+    {
+        char control[128];
+        struct msghdr msg = {};
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        if (-1 == ::recvmsg(_fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT))
+        {
+            break;
+        }
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); nullptr != cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if (!((SOL_IP == cmsg->cmsg_level && IP_RECVERR == cmsg->cmsg_type) ||
+                  (SOL_IPV6 == cmsg->cmsg_level && IPV6_RECVERR == cmsg->cmsg_type)))
+            {
+                continue;
+            }
+            const auto *err = reinterpret_cast<const struct sock_extended_err *>(CMSG_DATA(cmsg));
+            if (0 != err->ee_errno || SO_EE_ORIGIN_ZEROCOPY != err->ee_origin)
+            {
+                continue;
+            }
+            is_reaped = true;
+            _complete_zerocopy_sends(err->ee_info, err->ee_data, 0 != (err->ee_code & SO_EE_CODE_ZEROCOPY_COPIED));
+        }
+    }
+    return is_reaped;
+}
+
+void io::ip::tcp::socket::_complete_zerocopy_sends(std::uint32_t first, std::uint32_t last, bool is_copied)
+{
+    for (retained_send_t &send : _retained_sends)
+    {
+        // the ids wrap around
+        if (!send.is_completed && send.id - first <= last - first)
+        {
+            send.is_completed = true;
+            _zerocopy_copied_count += is_copied ? 1 : 0;
+        }
+    }
+    while (!_retained_sends.empty() && _retained_sends.front().is_completed)
+    {
+        _retained_bytes -= _retained_sends.front().len;
+        _retained_sends.pop_front();
+    }
+}
+
+bool io::ip::tcp::socket::_can_splice() const
+{
+    return true;
+}
+
+io::input_object::result_type io::ip::tcp::socket::_async_splice_to(io::file_descriptor_t pipe_fd, std::size_t len)
+{
+    if (-1 == _fd)
+    {
+        return io::error("closed socket used", _fd, errno);
+    }
+    if (_is_connecting)
+    {
+        return io::input_object::success_result_type{_fd, nullptr, 0};
+    }
+    if (0 != _connect_error)
+    {
+        return io::error("failed to connect", _fd, _connect_error);
+    }
+
+    const ssize_t bytes_moved = ::splice(_fd, nullptr, pipe_fd, nullptr, len, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (0 == bytes_moved)
+    {
+        return io::error("zero bytes read in splice", _fd, errno);
+    }
+    if (-1 == bytes_moved)
+    {
+        switch (errno)
+        {
+        case EINTR:
+        case EAGAIN:
+            // the socket has no data or the pipe is full
+            return io::input_object::success_result_type{_fd, nullptr, 0};
+        default:
+            return io::error("splice from socket failed", _fd, errno);
+        }
+    }
+    return io::input_object::success_result_type{_fd, nullptr, static_cast<std::size_t>(bytes_moved)};
+}
+
+io::output_object::result_type io::ip::tcp::socket::_async_splice_from(io::file_descriptor_t pipe_fd, std::size_t len)
+{
+    if (-1 == _fd)
+    {
+        return io::error("closed socket used", _fd, errno);
+    }
+    if (_is_connecting)
+    {
+        // the data stays in the pipe until the connection is established
+        return io::output_object::success_result_type{_fd, nullptr, 0};
+    }
+    if (0 != _connect_error)
+    {
+        return io::error("failed to connect", _fd, _connect_error);
+    }
+
+    const ssize_t bytes_moved = ::splice(pipe_fd, nullptr, _fd, nullptr, len, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (-1 == bytes_moved)
+    {
+        switch (errno)
+        {
+        case EINTR:
+        case EAGAIN:
+            return io::output_object::success_result_type{_fd, nullptr, 0};
+        default:
+            return io::error("splice to socket failed", _fd, errno);
+        }
+    }
+    return io::output_object::success_result_type{_fd, nullptr, static_cast<std::size_t>(bytes_moved)};
 }
 
 void io::ip::tcp::socket::_close_connection_noexcept() noexcept
@@ -173,6 +632,9 @@ void io::ip::tcp::socket::_close_connection()
     }
 
     IO_DEBUG((std::cout << "socket::_close_connection: fd = " << _fd << std::endl));
+    _io_bus->get_timers().cancel(_connect_timer);
+    _connect_timer = io::timer_wheel::invalid_timer_id;
+    _is_connecting = false;
     // prevent re-enter and double close
     const io::file_descriptor_t fd = _fd;
     _fd = -1;
@@ -187,7 +649,8 @@ void io::ip::tcp::socket::_close_connection()
         _fd = fd;
         throw;
     }
-    if (-1 == ::shutdown(fd, SHUT_RDWR))
+    // the never connected socket is closed as well
+    if (-1 == ::shutdown(fd, SHUT_RDWR) && ENOTCONN != errno)
     {
         // failed to close connection. restore fd
         _fd = fd;
@@ -7,11 +7,16 @@
 
 #include "object.hpp"
 #include "bus.hpp"
+#include "endpoint.hpp"
+#include "socket_options.hpp"
+#include "timer_wheel.hpp"
 // #include "async_state.hpp"
 
 #include <vector>
 #include <memory>
 #include <queue>
+#include <deque>
+#include <cstdint>
 
 /// \brief The input/output library namespace
 namespace io
@@ -42,6 +47,24 @@ namespace io
 				socket(
 					io::bus_ptr io_bus,
 					const io::ip::v4 &address);
+				/// @brief Construct new \ref io::ip::tcp::socket object
+				/// by connecting to the first of the \p addresses that accepts the connection.
+				/// The connect is completed asynchronously: the socket waits for the writability,
+				/// checks the SO_ERROR value and falls back to the next address on failure
+				/// keeping the same file descriptor value. The data written meanwhile is kept by the caller
+				/// since nothing is written until the connection is established.
+				/// The error event is enqueued when all the addresses fail.
+				/// It does not resolve anything, see \ref io::ip::resolver.
+				/// @param io_bus The I/O bus this socket works on
+				/// @param addresses The resolved socket addresses
+				/// @param connect_timeout The time for all the connect attempts, the zero value disables the deadline
+				/// @param options The socket options applied to every connect attempt
+				/// @throw io::error if no connect attempt can be started
+				socket(
+					io::bus_ptr io_bus,
+					const std::vector<io::ip::endpoint> &addresses,
+					std::chrono::milliseconds connect_timeout = std::chrono::milliseconds{0},
+					const io::ip::tcp::socket_options &options = {});
 
 				/// @brief Make sure the object is correctly destructed
 				~socket() noexcept override;
@@ -56,6 +79,51 @@ namespace io
 				/// \brief move is prohibited
 				socket &operator=(socket &&) noexcept = delete;
 
+				/// @brief Check whether the connect is still in progress
+				/// @return true until the connection is established or all the addresses fail
+				bool is_connecting() const
+				{
+					return _is_connecting;
+				}
+
+				/// @brief Send the writes of at least \p threshold bytes with the MSG_ZEROCOPY flag.
+				/// The system reads such data from the caller buffer after the write returns,
+				/// see \ref io::output_object::get_retained_bytes. The completions are read from the socket error queue
+				/// on the bus error event which is reported as the output event then.
+				/// @param threshold The minimum zero-copy write size, 0 disables the zero-copy writes
+				/// @throw io::error if the SO_ZEROCOPY socket option can not be set
+				void set_zerocopy_threshold(std::size_t threshold);
+				/// @brief Get the minimum zero-copy write size
+				/// @return The minimum zero-copy write size, 0 if the zero-copy writes are disabled
+				std::size_t get_zerocopy_threshold() const
+				{
+					return _zerocopy_threshold;
+				}
+				/// @brief Keep the socket in the quick ACK mode.
+				/// The system leaves the TCP_QUICKACK mode on its own, so the option is set again after every read.
+				/// It costs one setsockopt call per read.
+				/// @param enabled Acknowledge the received segments at once
+				void set_quick_ack(bool enabled);
+				/// @brief Check if the socket is kept in the quick ACK mode
+				/// @return true if the TCP_QUICKACK option is set after every read
+				bool is_quick_ack() const
+				{
+					return _is_quick_ack;
+				}
+				/// @brief Get the number of the zero-copy writes
+				/// @return The number of the zero-copy writes
+				std::uint64_t get_zerocopy_sends_count() const
+				{
+					return _zerocopy_sends_count;
+				}
+				/// @brief Get the number of the zero-copy writes the system copied the data for anyway,
+				/// it is the case for the loopback connections
+				/// @return The number of the copied zero-copy writes
+				std::uint64_t get_zerocopy_copied_count() const
+				{
+					return _zerocopy_copied_count;
+				}
+
 			private:
 				/// @brief Get the underlying file descriptor value for this socket
 				/// @return The underlying file descriptor value for this socket
@@ -74,6 +142,38 @@ namespace io
 				/// @param buf_len The length of the \p buf
 				/// @return The \ref result_type with length of data written or error occured
 				io::output_object::result_type _async_write_some(const value_t *buf, std::size_t buf_len) override;
+				/// @brief Read available data to the buffers in order asynchronously with the single system call.
+				/// @param iov The buffers to write the recieved data to
+				/// @param iovcnt The number of the \p iov buffers
+				/// @return The \ref result_type with the first buffer and the total length of data read or error occured
+				io::input_object::result_type _async_readv(const struct iovec *iov, int iovcnt) override;
+				/// @brief Write the data of the buffers in order asynchronously with the single system call.
+				/// @param iov The buffers of data to write from
+				/// @param iovcnt The number of the \p iov buffers
+				/// @return The \ref result_type with the first buffer and the total length of data written or error occured
+				io::output_object::result_type _async_writev(const struct iovec *iov, int iovcnt) override;
+				/// @brief The socket data can be spliced
+				/// @return true
+				bool _can_splice() const override;
+				/// @brief Move the available data to the pipe asynchronously.
+				/// @param pipe_fd The pipe write end file descriptor
+				/// @param len The maximum length of data to move
+				/// @return The \ref result_type with length of data moved or error occured
+				io::input_object::result_type _async_splice_to(io::file_descriptor_t pipe_fd, std::size_t len) override;
+				/// @brief Move the data from the pipe asynchronously.
+				/// @param pipe_fd The pipe read end file descriptor
+				/// @param len The maximum length of data to move
+				/// @return The \ref result_type with length of data moved or error occured
+				io::output_object::result_type _async_splice_from(io::file_descriptor_t pipe_fd, std::size_t len) override;
+				/// @brief Get the bytes count of the zero-copy writes not completed yet and the writes following them
+				/// @return The bytes count written and still referenced by this socket
+				std::size_t _get_retained_bytes() const override;
+				/// @brief Take the data received by the bus instead of reading the socket,
+				/// the connecting socket starts it when the connection is established
+				void _receive_with_bus() override;
+				/// @brief Queue the data to the bus instead of writing the socket,
+				/// the connecting socket starts it when the connection is established
+				void _send_with_bus() override;
 
 			private:
 				/// @brief Close this socket
@@ -82,11 +182,84 @@ namespace io
 				/// Useful in destructor
 				void _close_connection_noexcept() noexcept;
 
+				/// @brief Start the connect to the next address left
+				/// @return The connecting socket file descriptor and whether it is connected already,
+				/// the -1 file descriptor if no address is left
+				std::pair<io::file_descriptor_t, bool> _open_next();
+				/// @brief Handle the bus event on the connecting socket
+				/// @param mask The event mask
+				void _handle_connect_event(io::flags mask);
+				/// @brief Switch to the connected state
+				void _finish_connect();
+				/// @brief Try the next address or fail the connect
+				/// @param error The failed attempt errno value
+				void _retry_connect(int error);
+				/// @brief Arm the current connect attempt deadline
+				void _arm_connect_timer();
+
+				/// @brief Turn the bus error event caused by the zero-copy completions only into the output event
+				/// @param mask The event mask
+				/// @return The event mask for the callbacks
+				io::flags _filter_event(io::flags mask);
+				/// @brief Read the zero-copy completions from the socket error queue
+				/// @return true if any completion is read
+				bool _reap_zerocopy_completions();
+				/// @brief Mark the zero-copy writes completed and stop retaining the data of the leading completed ones
+				/// @param first The first completed write id
+				/// @param last The last completed write id
+				/// @param is_copied The system copied the data
+				void _complete_zerocopy_sends(std::uint32_t first, std::uint32_t last, bool is_copied);
+
 			private:
 				/// \brief The \ref io::bus object instance to connect to the system level I/O
 				io::bus_ptr _io_bus;
 				/// \brief This socket object file descriptor
 				file_descriptor_t _fd;
+				/// \brief The addresses to connect to
+				std::vector<io::ip::endpoint> _addresses;
+				/// \brief The next address to try in the \ref _addresses
+				std::size_t _next_address;
+				/// \brief The socket options applied to every connect attempt
+				io::ip::tcp::socket_options _options;
+				/// \brief The time all the connect attempts should complete by
+				io::timer_wheel::time_point_t _connect_deadline;
+				/// \brief The time for all the connect attempts, the zero value disables the deadline
+				std::chrono::milliseconds _connect_timeout;
+				/// \brief The current connect attempt deadline timer
+				io::timer_wheel::timer_id_t _connect_timer;
+				/// \brief The connect is in progress
+				bool _is_connecting;
+				/// \brief The errno value of the last failed connect attempt when all the addresses fail
+				int _connect_error;
+
+				/// \brief The write retained until the zero-copy writes preceding it and itself are completed
+				struct retained_send_t
+				{
+					/// \brief The zero-copy write id, the system counts the zero-copy writes from 0
+					std::uint32_t id;
+					/// \brief The bytes written
+					std::size_t len;
+					/// \brief Is the write completed, the copied writes are completed already
+					bool is_completed;
+				};
+				/// \brief The writes since the first not completed zero-copy write
+				std::deque<retained_send_t> _retained_sends;
+				/// \brief The total bytes count of the \ref _retained_sends
+				std::size_t _retained_bytes;
+				/// \brief The minimum zero-copy write size, 0 if the zero-copy writes are disabled
+				std::size_t _zerocopy_threshold;
+				/// \brief The next zero-copy write id
+				std::uint32_t _zerocopy_next_id;
+				/// \brief The number of the zero-copy writes
+				std::uint64_t _zerocopy_sends_count;
+				/// \brief The number of the zero-copy writes the system copied the data for
+				std::uint64_t _zerocopy_copied_count;
+				/// \brief Is the TCP_QUICKACK option set after every read
+				bool _is_quick_ack;
+				/// \brief Should the bus receive the data, see \ref io::bus::receive_data
+				bool _is_bus_receive;
+				/// \brief Should the bus send the data, see \ref io::bus::send_data
+				bool _is_bus_send;
 			};
 			/// \brief The TCP socket abstraction smart pointer
 			using socket_ptr = std::shared_ptr<socket>;
@@ -0,0 +1,261 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "socket_options.hpp"
+#include "error.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#ifndef SO_PREFER_BUSY_POLL
+// the value from the GNU/Linux uapi headers, it is missing in the older libc headers
+#define SO_PREFER_BUSY_POLL 69
+#endif
+
+#ifndef TCP_FASTOPEN_CONNECT
+// the value from the GNU/Linux uapi headers, it is missing in the older libc headers
+#define TCP_FASTOPEN_CONNECT 30
+#endif
+
+namespace
+{
+    void set_option(io::file_descriptor_t fd, int level, int name, int value, const char *option_name)
+    {
+        if (-1 == ::setsockopt(fd, level, name, &value, sizeof(value)))
+        {
+            throw io::error(std::string("failed to set ") + option_name + " socket option", fd, errno);
+        }
+    }
+
+    /// @brief Set the option the unprivileged process may be refused, it is skipped with the single warning then
+    void set_privileged_option(io::file_descriptor_t fd, int level, int name, int value, const char *option_name, std::atomic<bool> &is_warned)
+    {
+        if (-1 != ::setsockopt(fd, level, name, &value, sizeof(value)))
+        {
+            return;
+        }
+        if (EPERM != errno)
+        {
+            throw io::error(std::string("failed to set ") + option_name + " socket option", fd, errno);
+        }
+        if (!is_warned.exchange(true, std::memory_order_relaxed))
+        {
+            std::cerr << "[!] " << option_name << " socket option requires the CAP_NET_ADMIN capability, skipped" << std::endl;
+        }
+    }
+
+    /// @brief The SO_BUSY_POLL refusal is reported once for all the reactors
+    std::atomic<bool> busy_poll_warned{false};
+    /// @brief The SO_PREFER_BUSY_POLL refusal is reported once for all the reactors
+    std::atomic<bool> prefer_busy_poll_warned{false};
+
+    std::vector<std::string> split(const std::string &value, char delimiter)
+    {
+        std::vector<std::string> items;
+        std::istringstream stream(value);
+        std::string item;
+        while (std::getline(stream, item, delimiter))
+        {
+            items.push_back(item);
+        }
+        return items;
+    }
+
+    int parse_int(const std::string &value, const std::string &item)
+    {
+        std::size_t parsed = 0;
+        int result = -1;
+        try
+        {
+            result = std::stoi(value, &parsed);
+        }
+        catch (const std::exception &)
+        {
+            parsed = 0;
+        }
+        if (value.empty() || parsed != value.size() || result < 0)
+        {
+            throw std::invalid_argument("invalid socket option value: " + item);
+        }
+        return result;
+    }
+}
+
+void io::ip::tcp::set_socket_options(io::file_descriptor_t fd, const socket_options &options)
+{
+    if (options.busy_poll.count() > 0)
+    {
+        set_privileged_option(fd, SOL_SOCKET, SO_BUSY_POLL, static_cast<int>(options.busy_poll.count()), "SO_BUSY_POLL", busy_poll_warned);
+    }
+    if (options.prefer_busy_poll)
+    {
+        set_privileged_option(fd, SOL_SOCKET, SO_PREFER_BUSY_POLL, 1, "SO_PREFER_BUSY_POLL", prefer_busy_poll_warned);
+    }
+    if (options.no_delay)
+    {
+        set_option(fd, IPPROTO_TCP, TCP_NODELAY, 1, "TCP_NODELAY");
+    }
+    if (options.quick_ack)
+    {
+        set_option(fd, IPPROTO_TCP, TCP_QUICKACK, 1, "TCP_QUICKACK");
+    }
+    if (options.receive_buffer > 0)
+    {
+        set_option(fd, SOL_SOCKET, SO_RCVBUF, options.receive_buffer, "SO_RCVBUF");
+    }
+    if (options.send_buffer > 0)
+    {
+        set_option(fd, SOL_SOCKET, SO_SNDBUF, options.send_buffer, "SO_SNDBUF");
+    }
+    if (options.not_sent_low_watermark > 0)
+    {
+        set_option(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT, options.not_sent_low_watermark, "TCP_NOTSENT_LOWAT");
+    }
+    if (options.keep_alive)
+    {
+        set_option(fd, SOL_SOCKET, SO_KEEPALIVE, 1, "SO_KEEPALIVE");
+        if (options.keep_alive_idle.count() > 0)
+        {
+            set_option(fd, IPPROTO_TCP, TCP_KEEPIDLE, static_cast<int>(options.keep_alive_idle.count()), "TCP_KEEPIDLE");
+        }
+        if (options.keep_alive_interval.count() > 0)
+        {
+            set_option(fd, IPPROTO_TCP, TCP_KEEPINTVL, static_cast<int>(options.keep_alive_interval.count()), "TCP_KEEPINTVL");
+        }
+        if (options.keep_alive_count > 0)
+        {
+            set_option(fd, IPPROTO_TCP, TCP_KEEPCNT, options.keep_alive_count, "TCP_KEEPCNT");
+        }
+    }
+    if (options.incoming_cpu >= 0)
+    {
+        set_option(fd, SOL_SOCKET, SO_INCOMING_CPU, options.incoming_cpu, "SO_INCOMING_CPU");
+    }
+    if (options.fast_open_connect)
+    {
+        set_option(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, 1, "TCP_FASTOPEN_CONNECT");
+    }
+}
+
+void io::ip::tcp::set_listener_options(io::file_descriptor_t fd, const socket_options &options)
+{
+    // the window scale is negotiated in the handshake, so the buffer sizes are set before the listen call
+    if (options.receive_buffer > 0)
+    {
+        set_option(fd, SOL_SOCKET, SO_RCVBUF, options.receive_buffer, "SO_RCVBUF");
+    }
+    if (options.send_buffer > 0)
+    {
+        set_option(fd, SOL_SOCKET, SO_SNDBUF, options.send_buffer, "SO_SNDBUF");
+    }
+    if (options.incoming_cpu >= 0)
+    {
+        set_option(fd, SOL_SOCKET, SO_INCOMING_CPU, options.incoming_cpu, "SO_INCOMING_CPU");
+    }
+    if (options.defer_accept.count() > 0)
+    {
+        set_option(fd, IPPROTO_TCP, TCP_DEFER_ACCEPT, static_cast<int>(options.defer_accept.count()), "TCP_DEFER_ACCEPT");
+    }
+    if (options.fast_open_queue > 0)
+    {
+        set_option(fd, IPPROTO_TCP, TCP_FASTOPEN, options.fast_open_queue, "TCP_FASTOPEN");
+    }
+}
+
+io::ip::tcp::socket_options io::ip::tcp::parse_socket_options(const std::string &list, socket_options options)
+{
+    for (const std::string &item : split(list, ','))
+    {
+        const std::size_t delimiter = item.find('=');
+        const std::string key = item.substr(0, delimiter);
+        const std::string value = std::string::npos == delimiter ? std::string() : item.substr(delimiter + 1);
+        if (std::string::npos != delimiter && value.empty())
+        {
+            throw std::invalid_argument("invalid socket option value: " + item);
+        }
+
+        if (key.empty() || "default" == key)
+        {
+            continue;
+        }
+        if ("nodelay" == key && value.empty())
+        {
+            options.no_delay = true;
+        }
+        else if ("quickack" == key && value.empty())
+        {
+            options.quick_ack = true;
+        }
+        else if ("rcvbuf" == key)
+        {
+            options.receive_buffer = parse_int(value, item);
+        }
+        else if ("sndbuf" == key)
+        {
+            options.send_buffer = parse_int(value, item);
+        }
+        else if ("notsent_lowat" == key)
+        {
+            options.not_sent_low_watermark = parse_int(value, item);
+        }
+        else if ("keepalive" == key)
+        {
+            options.keep_alive = true;
+            const std::vector<std::string> values = split(value, ':');
+            if (values.size() > 3)
+            {
+                throw std::invalid_argument("invalid socket option value: " + item);
+            }
+            if (values.size() > 0)
+            {
+                options.keep_alive_idle = std::chrono::seconds{parse_int(values[0], item)};
+            }
+            if (values.size() > 1)
+            {
+                options.keep_alive_interval = std::chrono::seconds{parse_int(values[1], item)};
+            }
+            if (values.size() > 2)
+            {
+                options.keep_alive_count = parse_int(values[2], item);
+            }
+        }
+        else if ("incoming_cpu" == key)
+        {
+            options.incoming_cpu = parse_int(value, item);
+        }
+        else if ("fastopen_connect" == key && value.empty())
+        {
+            options.fast_open_connect = true;
+        }
+        else if ("defer_accept" == key)
+        {
+            options.defer_accept = std::chrono::seconds{parse_int(value, item)};
+        }
+        else if ("fastopen" == key)
+        {
+            options.fast_open_queue = parse_int(value, item);
+        }
+        else if ("busy_poll" == key)
+        {
+            options.busy_poll = std::chrono::microseconds{parse_int(value, item)};
+        }
+        else if ("prefer_busy_poll" == key && value.empty())
+        {
+            options.prefer_busy_poll = true;
+        }
+        else
+        {
+            throw std::invalid_argument("unknown socket option: " + item);
+        }
+    }
+    return options;
+}
@@ -0,0 +1,103 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_IO_IP_TCP_SOCKET_OPTIONS_T
+#define H_IO_IP_TCP_SOCKET_OPTIONS_T
+
+#include "fd.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/// \brief The input/output library namespace
+namespace io
+{
+	/// \brief The IP protocol related abstractions namespace
+	namespace ip
+	{
+		/// \brief The TCP protocol related abstractions namespace
+		namespace tcp
+		{
+			/// \brief The TCP socket options applied to the proxied connections.
+			/// The zero, false and negative values leave the system defaults.
+			/// The proxy servers take one set for the client side and one for the backend side.
+			struct socket_options
+			{
+				/// \brief The SO_BUSY_POLL value: the time the kernel busy polls the device queue on a blocking receive or poll.
+				/// Raising it above the net.core.busy_read sysctl value requires the CAP_NET_ADMIN capability,
+				/// the refused option is skipped with the warning.
+				std::chrono::microseconds busy_poll{0};
+				/// \brief The SO_PREFER_BUSY_POLL value: prefer the busy polling over the softirq processing.
+				/// It requires the CAP_NET_ADMIN capability, the refused option is skipped with the warning.
+				bool prefer_busy_poll = false;
+				/// \brief The minimum write size sent with the MSG_ZEROCOPY flag, 0 disables the zero-copy writes.
+				/// It is applied by the \ref io::ip::tcp::socket::set_zerocopy_threshold, not by the \ref set_socket_options.
+				std::size_t zerocopy_threshold = 0;
+				/// \brief The TCP_NODELAY value: send the small segments at once instead of coalescing them
+				/// until the previous ones are acknowledged (the Nagle algorithm)
+				bool no_delay = false;
+				/// \brief The TCP_QUICKACK value: acknowledge the segments at once instead of delaying the ACK.
+				/// The system leaves the quick ACK mode after a while, so the \ref set_socket_options call is one-shot;
+				/// \ref io::ip::tcp::socket::set_quick_ack keeps the mode by setting it again after every read.
+				bool quick_ack = false;
+				/// \brief The SO_RCVBUF value in bytes, setting it disables the receive buffer auto-tuning
+				int receive_buffer = 0;
+				/// \brief The SO_SNDBUF value in bytes, setting it disables the send buffer auto-tuning
+				int send_buffer = 0;
+				/// \brief The TCP_NOTSENT_LOWAT value: the socket is writable only while its not yet sent bytes
+				/// are below that count, so the data waits in the proxy buffers where the backpressure sees it
+				int not_sent_low_watermark = 0;
+				/// \brief The SO_KEEPALIVE value: probe the idle connection to detect the dead peer
+				bool keep_alive = false;
+				/// \brief The TCP_KEEPIDLE value: the idle time before the first keep-alive probe
+				std::chrono::seconds keep_alive_idle{0};
+				/// \brief The TCP_KEEPINTVL value: the time between the keep-alive probes
+				std::chrono::seconds keep_alive_interval{0};
+				/// \brief The TCP_KEEPCNT value: the unanswered keep-alive probes count to drop the connection after
+				int keep_alive_count = 0;
+				/// \brief The SO_INCOMING_CPU value: the CPU the connection packets are expected to be processed on.
+				/// On the listening sockets with SO_REUSEPORT it selects the reactor by the CPU handling the packets.
+				int incoming_cpu = -1;
+				/// \brief The TCP_FASTOPEN_CONNECT value: the connect is deferred to the first write,
+				/// which is sent in the SYN if the server has given the Fast Open cookie before.
+				/// The connect looks complete at once, so the address fallback and the connect timeout are skipped.
+				/// It is applied to the connecting sockets only, see \ref set_socket_options.
+				bool fast_open_connect = false;
+				/// \brief The TCP_DEFER_ACCEPT value: the connection is accepted when its first data arrives
+				/// or the time is elapsed. It is applied to the listening sockets only, see \ref set_listener_options.
+				std::chrono::seconds defer_accept{0};
+				/// \brief The TCP_FASTOPEN value: the pending Fast Open requests queue length of the listening socket.
+				/// It is applied to the listening sockets only, see \ref set_listener_options.
+				int fast_open_queue = 0;
+			};
+
+			/// \brief Apply the \p options to the \p fd connection socket.
+			/// The TCP_FASTOPEN_CONNECT option is applied too, so call it before the connect for the connecting socket.
+			/// \param fd The socket file descriptor
+			/// \param options The socket options
+			/// \throw io::error if the option can not be set, except the busy polling ones refused for the missing capability
+			void set_socket_options(io::file_descriptor_t fd, const socket_options &options);
+			/// \brief Apply the \p options to the \p fd listening socket before the listen call.
+			/// The accepted sockets inherit the buffer sizes, the rest is applied with the \ref set_socket_options.
+			/// \param fd The socket file descriptor
+			/// \param options The socket options
+			/// \throw io::error if the option can not be set
+			void set_listener_options(io::file_descriptor_t fd, const socket_options &options);
+
+			/// \brief Parse the comma separated options list over the \p options values.
+			/// The list items are: `nodelay`, `quickack`, `rcvbuf=BYTES`, `sndbuf=BYTES`, `notsent_lowat=BYTES`,
+			/// `keepalive[=IDLE_SEC:INTERVAL_SEC:COUNT]`, `incoming_cpu=CPU`, `fastopen_connect`,
+			/// `defer_accept=SEC`, `fastopen=QUEUE_LENGTH`, `busy_poll=USEC` and `prefer_busy_poll`, e.g. `nodelay,keepalive=60:10:3,rcvbuf=262144`.
+			/// The empty list and the `default` keep the \p options unchanged.
+			/// \param list The comma separated options list
+			/// \param options The options to start from
+			/// \return The options with the list items applied
+			/// \throw std::invalid_argument if the list item is unknown or its value is invalid
+			socket_options parse_socket_options(const std::string &list, socket_options options = {});
+		}
+	}
+}
+
+#endif // H_IO_IP_TCP_SOCKET_OPTIONS_T
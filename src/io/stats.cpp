@@ -0,0 +1,78 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "stats.hpp"
+
+#include <algorithm>
+#include <ostream>
+
+const char *io::to_string(callback_class cls)
+{
+    switch (cls)
+    {
+    case callback_class::acceptor:
+        return "acceptor";
+    case callback_class::channel_left:
+        return "channel_left";
+    case callback_class::channel_right:
+        return "channel_right";
+    case callback_class::session:
+        return "session";
+    case callback_class::wakeup:
+        return "wakeup";
+    default:
+        return "other";
+    }
+}
+
+std::uint64_t io::stats::histogram::percentile(double p) const noexcept
+{
+    if (0 == _count)
+    {
+        return 0;
+    }
+    const double rank = std::clamp(p, 0.0, 1.0) * static_cast<double>(_count);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+        seen += _buckets[i];
+        if (seen > 0 && static_cast<double>(seen) >= rank)
+        {
+            // the bucket i holds the values below 2^i
+            const std::uint64_t upper = (0 == i) ? 0 : (i >= 64 ? _max : (std::uint64_t{1} << i) - 1);
+            return std::min(upper, _max);
+        }
+    }
+    return _max; // LCOV_EXCL_LINE
+}
+
+std::ostream &io::stats::operator<<(std::ostream &os, const histogram &h)
+{
+    os << "count: " << h.count();
+    if (0 == h.count())
+    {
+        return os;
+    }
+    return os << "; mean: " << h.sum() / h.count()
+              << "; min: " << h.min()
+              << "; p50: " << h.percentile(0.5)
+              << "; p99: " << h.percentile(0.99)
+              << "; max: " << h.max();
+}
+
+std::ostream &io::stats::operator<<(std::ostream &os, const bus_stats &stats)
+{
+    os << "events per wait: " << stats.events_per_wait << "\n"
+       << "deferred per wait: " << stats.deferred_per_wait << "\n"
+       << "wait ns: " << stats.wait_ns << "\n"
+       << "processing ns: " << stats.processing_ns << "\n";
+    for (std::size_t i = 0; i < stats.callback_ns.size(); ++i)
+    {
+        if (0 != stats.callback_ns[i].count())
+        {
+            os << to_string(static_cast<callback_class>(i)) << " callback ns: " << stats.callback_ns[i] << "\n";
+        }
+    }
+    return os << "exceptions: " << stats.exceptions << "\n";
+}
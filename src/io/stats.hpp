@@ -0,0 +1,177 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_IO_STATS_T
+#define H_IO_STATS_T
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+/// The event loop instrumentation is compiled in with the _IO_STATS_ENABLED definition only.
+#ifdef _IO_STATS_ENABLED
+#define IO_STATS(L) L
+#else
+#define IO_STATS(L)
+#endif
+
+/// \brief The input/output library namespace
+namespace io
+{
+    /// \brief The kind of the \ref io::bus callback, the callback durations are accounted per kind
+    enum class callback_class : std::uint8_t
+    {
+        /// \brief The callback of unknown kind
+        other,
+        /// \brief The listening socket callback accepting new connections
+        acceptor,
+        /// \brief The \ref io::channel input object callback
+        channel_left,
+        /// \brief The \ref io::channel output object callback
+        channel_right,
+        /// \brief The TCP session bookkeeping callback
+        session,
+        /// \brief The \ref io::context wakeup callback
+        wakeup,
+        /// \brief The number of the callback kinds
+        count
+    };
+
+    /// @brief Get the human readable callback kind name
+    /// @param cls The callback kind
+    /// @return The callback kind name
+    const char *to_string(callback_class cls);
+
+    /// \brief The statistics namespace
+    namespace stats
+    {
+        /// \brief The histogram with the power of two buckets.
+        /// The bucket 0 counts the zero values, the bucket i counts the values in [2^(i-1), 2^i).
+        /// The record is a few arithmetic operations without branches on the bucket search.
+        class histogram
+        {
+        public:
+            /// @brief The buckets count
+            static constexpr std::size_t BUCKETS = 65;
+
+            /// @brief Record the \p value
+            /// @param value The value to record
+            void record(std::uint64_t value) noexcept
+            {
+                ++_buckets[bucket_of(value)];
+                ++_count;
+                _sum += value;
+                if (value < _min || 1 == _count)
+                {
+                    _min = value;
+                }
+                if (value > _max)
+                {
+                    _max = value;
+                }
+            }
+
+            /// @brief Get the bucket index for the \p value
+            /// @param value The value
+            /// @return The bucket index
+            static constexpr std::size_t bucket_of(std::uint64_t value) noexcept
+            {
+                return 0 == value ? 0 : 64 - __builtin_clzll(value);
+            }
+
+            /// @brief Get the values count
+            /// @return The values count
+            std::uint64_t count() const noexcept
+            {
+                return _count;
+            }
+            /// @brief Get the values sum
+            /// @return The values sum
+            std::uint64_t sum() const noexcept
+            {
+                return _sum;
+            }
+            /// @brief Get the minimal value
+            /// @return The minimal value or zero if empty
+            std::uint64_t min() const noexcept
+            {
+                return _min;
+            }
+            /// @brief Get the maximal value
+            /// @return The maximal value or zero if empty
+            std::uint64_t max() const noexcept
+            {
+                return _max;
+            }
+            /// @brief Get the bucket counters
+            /// @return The bucket counters
+            const std::array<std::uint64_t, BUCKETS> &buckets() const noexcept
+            {
+                return _buckets;
+            }
+            /// @brief Get the upper bound estimation of the \p p percentile
+            /// @param p The percentile in the [0, 1] range
+            /// @return The upper bound of the bucket the percentile falls into, clamped to the maximal value
+            std::uint64_t percentile(double p) const noexcept;
+
+            /// @brief Reset all the counters
+            void reset() noexcept
+            {
+                *this = histogram{};
+            }
+
+        private:
+            /// @brief The bucket counters
+            std::array<std::uint64_t, BUCKETS> _buckets{};
+            /// @brief The values count
+            std::uint64_t _count = 0;
+            /// @brief The values sum
+            std::uint64_t _sum = 0;
+            /// @brief The minimal value
+            std::uint64_t _min = 0;
+            /// @brief The maximal value
+            std::uint64_t _max = 0;
+        };
+
+        /// @brief The output stream operator
+        /// to output the \p h histogram summary in a human readable format.
+        /// @param os The output stream object
+        /// @param h The histogram to output
+        /// @return The output stream object \p os
+        std::ostream &operator<<(std::ostream &os, const histogram &h);
+
+        /// \brief The \ref io::bus event loop statistics
+        struct bus_stats
+        {
+            /// @brief The native I/O events per the \ref io::bus::wait_events call
+            histogram events_per_wait;
+            /// @brief The deferred events drained per the \ref io::bus::wait_events call
+            histogram deferred_per_wait;
+            /// @brief The time blocked in the native wait, in nanoseconds
+            histogram wait_ns;
+            /// @brief The time spent in the callbacks and timers after the native wait, in nanoseconds
+            histogram processing_ns;
+            /// @brief The callback durations per callback kind, in nanoseconds
+            std::array<histogram, static_cast<std::size_t>(callback_class::count)> callback_ns;
+            /// @brief The exceptions caught by the \ref io::bus::wait_events
+            std::uint64_t exceptions = 0;
+
+            /// @brief Reset all the counters
+            void reset() noexcept
+            {
+                *this = bus_stats{};
+            }
+        };
+
+        /// @brief The output stream operator
+        /// to output the \p stats value in a human readable format.
+        /// @param os The output stream object
+        /// @param stats The statistics to output
+        /// @return The output stream object \p os
+        std::ostream &operator<<(std::ostream &os, const bus_stats &stats);
+    }
+}
+
+#endif // H_IO_STATS_T
@@ -0,0 +1,242 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "timer_wheel.hpp"
+
+#include <exception>
+#include <utility>
+
+io::timer_wheel::timer_wheel(time_point_t now)
+    : _free_head(NIL),
+      _start(now),
+      _now(now),
+      _tick(0),
+      _size(0)
+{
+    _slots.fill(NIL);
+    _occupied.fill(0);
+}
+
+std::uint64_t io::timer_wheel::_to_tick(time_point_t time) const
+{
+    if (time <= _start)
+    {
+        return 0;
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time - _start).count();
+}
+
+io::timer_wheel::timer_id_t io::timer_wheel::arm(std::chrono::milliseconds delay, callback_t callback)
+{
+    index_t index = _free_head;
+    if (NIL == index)
+    {
+        index = static_cast<index_t>(_nodes.size());
+        _nodes.emplace_back();
+    }
+    else
+    {
+        _free_head = _nodes[index].next;
+    }
+
+    // the current tick is already processed, so the timer expires in the next one at least
+    const std::uint64_t ticks = delay.count() > 0 ? static_cast<std::uint64_t>(delay.count()) : 1;
+    node_t &node = _nodes[index];
+    node.expires = _tick + ticks;
+    node.callback = std::move(callback);
+    _insert(index);
+    ++_size;
+    return (static_cast<timer_id_t>(node.generation) << 32) | index;
+}
+
+bool io::timer_wheel::cancel(timer_id_t id)
+{
+    const index_t index = static_cast<index_t>(id & 0xFFFFFFFF);
+    const std::uint32_t generation = static_cast<std::uint32_t>(id >> 32);
+    if (index >= _nodes.size() || _nodes[index].generation != generation || !_nodes[index].armed)
+    {
+        return false;
+    }
+    _unlink(index);
+    _release(index);
+    return true;
+}
+
+void io::timer_wheel::_insert(index_t index)
+{
+    node_t &node = _nodes[index];
+    std::uint64_t diff = node.expires > _tick ? node.expires - _tick : 0;
+    constexpr std::uint64_t max_diff = (std::uint64_t{1} << (LEVELS * SLOT_BITS)) - 1;
+    if (diff > max_diff)
+    {
+        diff = max_diff;
+        node.expires = _tick + diff;
+    }
+
+    std::size_t level = 0;
+    std::uint64_t expires = (0 == diff) ? _tick : node.expires;
+    while (level + 1 < LEVELS && diff >= (std::uint64_t{1} << ((level + 1) * SLOT_BITS)))
+    {
+        ++level;
+    }
+    const std::size_t bucket = level * SLOTS + ((expires >> (level * SLOT_BITS)) & SLOT_MASK);
+
+    node.bucket = static_cast<std::uint16_t>(bucket);
+    node.prev = NIL;
+    node.next = _slots[bucket];
+    if (NIL != node.next)
+    {
+        _nodes[node.next].prev = index;
+    }
+    _slots[bucket] = index;
+    _occupied[bucket >> 6] |= std::uint64_t{1} << (bucket & 63);
+    node.armed = true;
+}
+
+void io::timer_wheel::_unlink(index_t index)
+{
+    node_t &node = _nodes[index];
+    if (NIL != node.prev)
+    {
+        _nodes[node.prev].next = node.next;
+    }
+    else
+    {
+        _slots[node.bucket] = node.next;
+        if (NIL == node.next)
+        {
+            _occupied[node.bucket >> 6] &= ~(std::uint64_t{1} << (node.bucket & 63));
+        }
+    }
+    if (NIL != node.next)
+    {
+        _nodes[node.next].prev = node.prev;
+    }
+    node.prev = node.next = NIL;
+    node.armed = false;
+}
+
+void io::timer_wheel::_release(index_t index)
+{
+    node_t &node = _nodes[index];
+    node.callback = nullptr;
+    ++node.generation;
+    if (0 == node.generation)
+    {
+        // keep the timer identifier different from the invalid_timer_id
+        node.generation = 1;
+    }
+    node.next = _free_head;
+    _free_head = index;
+    --_size;
+}
+
+void io::timer_wheel::_cascade(std::size_t level, std::size_t slot)
+{
+    const std::size_t bucket = level * SLOTS + slot;
+    index_t index = _slots[bucket];
+    _slots[bucket] = NIL;
+    _occupied[bucket >> 6] &= ~(std::uint64_t{1} << (bucket & 63));
+    while (NIL != index)
+    {
+        const index_t next = _nodes[index].next;
+        _insert(index);
+        index = next;
+    }
+}
+
+void io::timer_wheel::advance(time_point_t now)
+{
+    if (now > _now)
+    {
+        _now = now;
+    }
+    const std::uint64_t target = _to_tick(_now);
+    std::exception_ptr error;
+    while (_tick < target)
+    {
+        if (0 == _size)
+        {
+            _tick = target;
+            break;
+        }
+        ++_tick;
+        if (0 == (_tick & SLOT_MASK))
+        {
+            // cascade from the highest level wrapped, so the lower levels get their nodes in time
+            std::size_t top = 1;
+            while (top + 1 < LEVELS && 0 == ((_tick >> (top * SLOT_BITS)) & SLOT_MASK))
+            {
+                ++top;
+            }
+            for (std::size_t level = top; level > 0; --level)
+            {
+                _cascade(level, (_tick >> (level * SLOT_BITS)) & SLOT_MASK);
+            }
+        }
+
+        const std::size_t bucket = _tick & SLOT_MASK;
+        while (NIL != _slots[bucket])
+        {
+            const index_t index = _slots[bucket];
+            _unlink(index);
+            callback_t callback = std::move(_nodes[index].callback);
+            _release(index);
+            try
+            {
+                if (callback)
+                {
+                    callback();
+                }
+            }
+            catch (...)
+            {
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+        }
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+std::uint64_t io::timer_wheel::_next_expiry_distance() const
+{
+    for (std::uint64_t distance = 1; distance <= SLOTS;)
+    {
+        const std::size_t slot = (_tick + distance) & SLOT_MASK;
+        const std::uint64_t word = _occupied[slot >> 6] >> (slot & 63);
+        if (0 != word)
+        {
+            distance += __builtin_ctzll(word);
+            return distance <= SLOTS ? distance : 0;
+        }
+        distance += 64 - (slot & 63);
+    }
+    return 0;
+}
+
+std::chrono::milliseconds io::timer_wheel::get_timeout(std::chrono::milliseconds max_timeout) const
+{
+    if (0 == _size || 0 == max_timeout.count())
+    {
+        return max_timeout;
+    }
+    std::uint64_t distance = _next_expiry_distance();
+    if (0 == distance)
+    {
+        // only the higher levels are armed: wake up on the next lowest level rotation to cascade
+        distance = SLOTS - (_tick & SLOT_MASK);
+    }
+    const std::chrono::milliseconds timeout{static_cast<std::chrono::milliseconds::rep>(distance)};
+    if (max_timeout.count() < 0 || timeout < max_timeout)
+    {
+        return timeout;
+    }
+    return max_timeout;
+}
@@ -0,0 +1,146 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_IO_TIMER_WHEEL_T
+#define H_IO_TIMER_WHEEL_T
+
+#include "delegate.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \brief The input/output library namespace
+namespace io
+{
+    /// \brief The hierarchical timing wheel.
+    /// Four levels of 256 slots with the 1 ms tick cover about 49 days,
+    /// longer delays are clamped. Arm and cancel are O(1), the expired timers
+    /// are cascaded to the lower levels once per slot rotation.
+    /// The timer nodes are pooled, so the steady state arm/cancel does not allocate.
+    /// It is not thread safe: it is driven by the \ref io::bus::wait_events of its reactor.
+    class timer_wheel
+    {
+    public:
+        /// \brief The clock type used to drive the wheel
+        using clock_t = std::chrono::steady_clock;
+        /// \brief The time point type
+        using time_point_t = clock_t::time_point;
+        /// \brief The timer callback type
+        using callback_t = io::delegate<void()>;
+        /// \brief The timer identifier type.
+        /// The generation tag makes the identifier of the expired or cancelled timer stale,
+        /// so it is safe to cancel it even if the node is reused.
+        using timer_id_t = std::uint64_t;
+        /// \brief The invalid timer identifier value
+        static constexpr timer_id_t invalid_timer_id = 0;
+
+        /// @brief Construct the timing wheel
+        /// @param now The wheel start time
+        explicit timer_wheel(time_point_t now = clock_t::now());
+
+        /// @brief Arm the timer
+        /// @param delay The delay to call the \p callback after, counted from the last \ref advance time.
+        /// It is rounded up to the 1 ms tick.
+        /// @param callback The function to call when the timer expires
+        /// @return The timer identifier to cancel the timer with
+        timer_id_t arm(std::chrono::milliseconds delay, callback_t callback);
+        /// @brief Cancel the armed timer
+        /// @param id The timer identifier
+        /// @return True if the timer was armed and is cancelled now, false for the stale identifier
+        bool cancel(timer_id_t id);
+
+        /// @brief Advance the wheel to the \p now time and call the expired timers callbacks.
+        /// All the expired callbacks are called even if some of them throw,
+        /// the first exception is rethrown after that.
+        /// @param now The current time
+        void advance(time_point_t now);
+
+        /// @brief Get the time to wait for until the next timer expiry check
+        /// @param max_timeout The maximum time to wait, negative value means infinity
+        /// @return The \p max_timeout clamped to the next expiry check time
+        std::chrono::milliseconds get_timeout(std::chrono::milliseconds max_timeout) const;
+
+        /// @brief Get the time the wheel was advanced to last time
+        /// @return The time the wheel was advanced to last time
+        time_point_t now() const
+        {
+            return _now;
+        }
+        /// @brief Get the armed timers count
+        /// @return The armed timers count
+        std::size_t size() const
+        {
+            return _size;
+        }
+
+    private:
+        /// @brief The index of the timer node
+        using index_t = std::uint32_t;
+        /// @brief The empty list index value
+        static constexpr index_t NIL = ~index_t{0};
+        /// @brief The wheel levels count
+        static constexpr std::size_t LEVELS = 4;
+        /// @brief The number of bits of the slot index
+        static constexpr std::size_t SLOT_BITS = 8;
+        /// @brief The slots count in every level
+        static constexpr std::size_t SLOTS = std::size_t{1} << SLOT_BITS;
+        /// @brief The slot index mask
+        static constexpr std::uint64_t SLOT_MASK = SLOTS - 1;
+
+        /// @brief The timer node
+        struct node_t
+        {
+            /// @brief The expiry tick
+            std::uint64_t expires = 0;
+            /// @brief The timer callback
+            callback_t callback;
+            /// @brief The previous node in the slot list or in the free list
+            index_t prev = NIL;
+            /// @brief The next node in the slot list or in the free list
+            index_t next = NIL;
+            /// @brief The node generation, incremented on each node release
+            std::uint32_t generation = 1;
+            /// @brief The flattened level and slot index of the list the node is linked to
+            std::uint16_t bucket = 0;
+            /// @brief Is the node linked to a slot list
+            bool armed = false;
+        };
+
+        /// @brief Convert the time point to the wheel tick
+        std::uint64_t _to_tick(time_point_t time) const;
+        /// @brief Link the armed node to the slot list by its expiry tick
+        void _insert(index_t index);
+        /// @brief Unlink the node from its slot list
+        void _unlink(index_t index);
+        /// @brief Release the node to the free list
+        void _release(index_t index);
+        /// @brief Move the nodes of the \p level slot to the lower levels
+        void _cascade(std::size_t level, std::size_t slot);
+        /// @brief Find the next not empty slot of the lowest level
+        /// @return The distance in ticks or 0 if the lowest level is empty
+        std::uint64_t _next_expiry_distance() const;
+
+        /// @brief The timer nodes pool
+        std::vector<node_t> _nodes;
+        /// @brief The free nodes list head
+        index_t _free_head;
+        /// @brief The slot list heads of all levels
+        std::array<index_t, LEVELS * SLOTS> _slots;
+        /// @brief The not empty slots bitmap of all levels
+        std::array<std::uint64_t, LEVELS * SLOTS / 64> _occupied;
+        /// @brief The wheel start time
+        time_point_t _start;
+        /// @brief The time the wheel was advanced to
+        time_point_t _now;
+        /// @brief The current tick
+        std::uint64_t _tick;
+        /// @brief The armed timers count
+        std::size_t _size;
+    };
+}
+
+#endif // H_IO_TIMER_WHEEL_T
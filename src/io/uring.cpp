@@ -0,0 +1,977 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "uring.hpp"
+#include "error.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <csignal>     // _NSIG
+#include <unistd.h>    // ::close, ::syscall
+#include <sys/mman.h>  // ::mmap
+#include <sys/syscall.h>
+#include <sys/epoll.h> // EPOLL* event mask values
+#include <sys/socket.h> // SOCK_NONBLOCK, SOCK_CLOEXEC
+
+namespace
+{
+    int io_uring_setup(unsigned entries, struct io_uring_params *params)
+    {
+        return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int io_uring_enter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags, const void *arg, std::size_t arg_size)
+    {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, arg, arg_size));
+    }
+
+    int io_uring_register(int ring_fd, unsigned opcode, const void *arg, unsigned nr_args)
+    {
+        return static_cast<int>(::syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+    }
+
+    unsigned load_acquire(const unsigned *p)
+    {
+        return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+    }
+
+    void store_release(unsigned *p, unsigned value)
+    {
+        __atomic_store_n(p, value, __ATOMIC_RELEASE);
+    }
+
+    /// @brief The user data of the requests which completions are ignored
+    constexpr io::bus::handle_t ignored_user_data = ~io::bus::handle_t{0};
+    /// @brief The empty \ref io::system::uring::_handles slot value
+    constexpr io::bus::handle_t no_handle = ~io::bus::handle_t{0};
+    /// @brief The user data tag of the accept requests.
+    /// The file descriptors are not negative, so the sign bit of the handle low half is free.
+    constexpr io::bus::handle_t accept_tag = io::bus::handle_t{1} << 31;
+    /// @brief The accept request index position in the user data, the listening sockets file descriptors are below it
+    constexpr unsigned accept_index_shift = 24;
+    /// @brief The accept request index bits of the user data
+    constexpr io::bus::handle_t accept_index_mask = io::bus::handle_t{0xF} << accept_index_shift;
+    static_assert(io::system::uring::ACCEPT_REQUESTS <= (accept_index_mask >> accept_index_shift) + 1, "The accept request index must fit the user data");
+    /// @brief The user data tag of the receive requests, it is above the accept request index bits
+    constexpr io::bus::handle_t recv_tag = io::bus::handle_t{1} << 30;
+    /// @brief The user data tag of the send requests
+    constexpr io::bus::handle_t send_tag = io::bus::handle_t{1} << 29;
+    /// @brief The user data tag of the poll events update requests
+    constexpr io::bus::handle_t update_tag = io::bus::handle_t{1} << 28;
+    /// @brief The provided receive buffer ring group id
+    constexpr std::uint16_t receive_buffer_group = 0;
+    static_assert(0 == (io::system::uring::RECEIVE_BUFFERS & (io::system::uring::RECEIVE_BUFFERS - 1)), "The provided buffer ring size must be the power of 2");
+
+    io::flags poll_mask_to_io_flags(int mask)
+    {
+        io::flags f = io::flags::empty;
+        if (mask & (EPOLLERR | EPOLLHUP))
+        {
+            f |= io::flags::error;
+        }
+        if (mask & (EPOLLIN))
+        {
+            f |= io::flags::in;
+        }
+        if (mask & (EPOLLOUT))
+        {
+            f |= io::flags::out;
+        }
+        return f;
+    }
+}
+
+io::system::uring::uring(event_mask_t event_mask, unsigned entries)
+    : _ring_fd(-1), _event_mask(event_mask)
+{
+    struct io_uring_params params = {};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = 4 * entries;
+    const int fd = io_uring_setup(entries, &params);
+    if (fd < 0)
+    {
+        throw io::error("failed to create io_uring", fd, errno);
+    }
+    _ring_fd = fd;
+
+    if (!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_NODROP))
+    {
+        ::close(_ring_fd);
+        throw io::error("io_uring is too old: EXT_ARG and NODROP features are required", fd, ENOSYS);
+    }
+
+    _sq.size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cq.size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        _sq.size = _cq.size = std::max(_sq.size, _cq.size);
+    }
+    _sq.ptr = ::mmap(nullptr, _sq.size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == _sq.ptr)
+    {
+        const int err = errno;
+        ::close(_ring_fd);
+        throw io::error("failed to map io_uring submission queue", fd, err);
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        _cq.ptr = _sq.ptr;
+    }
+    else
+    {
+        _cq.ptr = ::mmap(nullptr, _cq.size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_CQ_RING);
+        if (MAP_FAILED == _cq.ptr)
+        {
+            const int err = errno;
+            ::munmap(_sq.ptr, _sq.size);
+            ::close(_ring_fd);
+            throw io::error("failed to map io_uring completion queue", fd, err);
+        }
+    }
+    _sq.sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    void *sqes = ::mmap(nullptr, _sq.sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQES);
+    if (MAP_FAILED == sqes)
+    {
+        const int err = errno;
+        if (_cq.ptr != _sq.ptr)
+        {
+            ::munmap(_cq.ptr, _cq.size);
+        }
+        ::munmap(_sq.ptr, _sq.size);
+        ::close(_ring_fd);
+        throw io::error("failed to map io_uring submission queue entries", fd, err);
+    }
+
+    auto sq_ptr = static_cast<char *>(_sq.ptr);
+    _sq.head = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.head);
+    _sq.tail = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.tail);
+    _sq.mask = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.ring_mask);
+    _sq.array = reinterpret_cast<unsigned *>(sq_ptr + params.sq_off.array);
+    _sq.entries = params.sq_entries;
+    _sq.sqes = static_cast<struct io_uring_sqe *>(sqes);
+
+    auto cq_ptr = static_cast<char *>(_cq.ptr);
+    _cq.head = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.head);
+    _cq.tail = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.tail);
+    _cq.mask = reinterpret_cast<unsigned *>(cq_ptr + params.cq_off.ring_mask);
+    _cq.cqes = reinterpret_cast<struct io_uring_cqe *>(cq_ptr + params.cq_off.cqes);
+}
+
+// LCOV_EXCL_START
+io::system::uring::~uring() noexcept
+{
+    IO_DEBUG((std::cout << "~uring" << std::endl));
+    for (const std::unique_ptr<accept_queue_t> &queue : _accept_queues)
+    {
+        for (const accepted_t &conn : queue->conns)
+        {
+            ::close(conn.fd);
+        }
+    }
+    ::munmap(_sq.sqes, _sq.sqes_size);
+    if (_cq.ptr != _sq.ptr)
+    {
+        ::munmap(_cq.ptr, _cq.size);
+    }
+    ::munmap(_sq.ptr, _sq.size);
+    if (-1 == ::close(_ring_fd))
+    {
+        std::cerr << "Failed to close io_uring file descriptor: errno = " << errno << std::endl;
+    }
+    else
+    {
+        _ring_fd = -1;
+    }
+    // the kernel drops the provided buffer ring with the io_uring
+    if (nullptr != _buf_ring)
+    {
+        ::munmap(_receive_buffers, RECEIVE_BUFFERS * RECEIVE_BUFFER_SZ);
+        ::munmap(_buf_ring, RECEIVE_BUFFERS * sizeof(struct io_uring_buf));
+    }
+}
+// LCOV_EXCL_STOP
+
+int io::system::uring::_enter(unsigned min_complete, unsigned flags, const void *arg)
+{
+    const unsigned to_submit = *_sq.tail - load_acquire(_sq.head);
+    errno = 0;
+    const int ret = io_uring_enter(
+        _ring_fd, to_submit, min_complete, flags,
+        arg, arg ? sizeof(struct io_uring_getevents_arg) : 0);
+    if (-1 == ret && ETIME != errno && EINTR != errno && EAGAIN != errno && EBUSY != errno)
+    {
+        throw io::error("io_uring enter error", _ring_fd, errno);
+    }
+    return ret;
+}
+
+struct io_uring_sqe *io::system::uring::_get_sqe()
+{
+    unsigned tail = *_sq.tail;
+    if (tail - load_acquire(_sq.head) >= _sq.entries)
+    {
+        // the submission queue is full, flush it to the kernel
+        _enter(0, 0, nullptr);
+        if (tail - load_acquire(_sq.head) >= _sq.entries)
+        {
+            throw io::error("io_uring submission queue is full", _ring_fd, EBUSY);
+        }
+    }
+    const unsigned index = tail & *_sq.mask;
+    struct io_uring_sqe *sqe = &_sq.sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    _sq.array[index] = index;
+    return sqe;
+}
+
+void io::system::uring::_arm(io::file_descriptor_t fd, handle_t handle)
+{
+    struct io_uring_sqe *sqe = _get_sqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->len = IORING_POLL_ADD_MULTI;
+    sqe->poll32_events = _poll_events(fd);
+    sqe->user_data = handle;
+    store_release(_sq.tail, *_sq.tail + 1);
+}
+
+void io::system::uring::_arm_accept(accept_queue_t &queue, std::size_t index)
+{
+    // the multishot accept would share the single peer address buffer between all the connections
+    accept_request_t &request = queue.requests[index];
+    request.address_len = sizeof(request.address);
+    struct io_uring_sqe *sqe = _get_sqe();
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = queue.fd;
+    sqe->addr = reinterpret_cast<std::uint64_t>(&request.address);
+    sqe->addr2 = reinterpret_cast<std::uint64_t>(&request.address_len);
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->user_data = queue.handle | accept_tag | (static_cast<handle_t>(index) << accept_index_shift);
+    store_release(_sq.tail, *_sq.tail + 1);
+    ++queue.in_flight;
+}
+
+std::vector<std::unique_ptr<io::system::uring::accept_queue_t>>::iterator io::system::uring::_find_accept_queue(io::file_descriptor_t fd)
+{
+    return std::find_if(
+        _accept_queues.begin(), _accept_queues.end(),
+        [fd](const std::unique_ptr<accept_queue_t> &queue)
+        {
+            return queue->fd == fd;
+        });
+}
+
+void io::system::uring::_add_fd(io::file_descriptor_t fd, handle_t handle)
+{
+    if (static_cast<handle_t>(fd) >= update_tag)
+    {
+        // the request tags are stored above the file descriptor in the user data
+        throw io::error("failed to add file descriptor to io_uring", fd, EMFILE);
+    }
+    if (static_cast<std::size_t>(fd) >= _handles.size())
+    {
+        _handles.resize(std::max<std::size_t>(fd + 1, 2 * _handles.size()), no_handle);
+        _masks.resize(_handles.size(), 0);
+        _receive_queues.resize(_handles.size());
+        _send_queues.resize(_handles.size());
+    }
+    if (no_handle != _handles[fd])
+    {
+        throw io::error("failed to add file descriptor to io_uring", fd, EEXIST);
+    }
+    _masks[fd] = _event_mask;
+    _arm(fd, handle);
+    _handles[fd] = handle;
+}
+
+void io::system::uring::_del_fd(io::file_descriptor_t fd)
+{
+    IO_DEBUG((std::cout << "Delete io_uring file descriptor: fd = " << fd << std::endl));
+    if (fd < 0 || static_cast<std::size_t>(fd) >= _handles.size() || no_handle == _handles[fd])
+    {
+        throw io::error("failed to delete file descriptor from io_uring", fd, ENOENT);
+    }
+    std::unique_ptr<receive_queue_t> &receive_queue = _receive_queues[fd];
+    if (receive_queue)
+    {
+        if (receive_queue->is_armed)
+        {
+            // the buffers received after the removal are returned on the completion
+            struct io_uring_sqe *sqe = _get_sqe();
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->addr = _handles[fd] | recv_tag;
+            sqe->user_data = ignored_user_data;
+            store_release(_sq.tail, *_sq.tail + 1);
+        }
+        for (const chunk_t &chunk : receive_queue->chunks)
+        {
+            _return_buffer(chunk.bid);
+        }
+        receive_queue.reset();
+        _publish_buffers();
+    }
+    std::unique_ptr<send_queue_t> &send_queue = _send_queues[fd];
+    if (send_queue && 0 != send_queue->len)
+    {
+        struct io_uring_sqe *sqe = _get_sqe();
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = _handles[fd] | send_tag;
+        sqe->user_data = ignored_user_data;
+        store_release(_sq.tail, *_sq.tail + 1);
+        // the kernel may still read the message header, so the queue is freed on the completion
+        _closed_sends.push_back(std::move(send_queue));
+    }
+    send_queue.reset();
+    const auto queue = _find_accept_queue(fd);
+    if (_accept_queues.end() != queue)
+    {
+        for (std::size_t i = 0; i < ACCEPT_REQUESTS; ++i)
+        {
+            struct io_uring_sqe *sqe = _get_sqe();
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->addr = _handles[fd] | accept_tag | (static_cast<handle_t>(i) << accept_index_shift);
+            sqe->user_data = ignored_user_data;
+            store_release(_sq.tail, *_sq.tail + 1);
+        }
+        for (const accepted_t &conn : (*queue)->conns)
+        {
+            ::close(conn.fd);
+        }
+        // the kernel may still write the address buffers, so the queue is freed on the last completion
+        (*queue)->conns.clear();
+        (*queue)->fd = -1;
+    }
+    else
+    {
+        struct io_uring_sqe *sqe = _get_sqe();
+        sqe->opcode = IORING_OP_POLL_REMOVE;
+        sqe->fd = -1;
+        sqe->addr = _handles[fd];
+        sqe->user_data = ignored_user_data;
+        store_release(_sq.tail, *_sq.tail + 1);
+    }
+    _handles[fd] = no_handle;
+}
+
+void io::system::uring::_set_output_interest(io::file_descriptor_t fd, handle_t handle, bool enabled)
+{
+    if (fd < 0 || static_cast<std::size_t>(fd) >= _handles.size() || handle != _handles[fd])
+    {
+        throw io::error("failed to modify file descriptor in io_uring", fd, ENOENT);
+    }
+    // the poll re-armed after termination uses the stored mask too
+    _masks[fd] = enabled ? (_event_mask | EPOLLOUT) : _event_mask;
+    _update_poll(fd, handle);
+}
+
+void io::system::uring::_update_poll(io::file_descriptor_t fd, handle_t handle)
+{
+    struct io_uring_sqe *sqe = _get_sqe();
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    // the events update without the multishot flag would turn the poll request into the one-shot one
+    sqe->len = IORING_POLL_UPDATE_EVENTS | IORING_POLL_ADD_MULTI;
+    sqe->addr = handle;
+    sqe->poll32_events = _poll_events(fd);
+    sqe->user_data = handle | update_tag;
+    store_release(_sq.tail, *_sq.tail + 1);
+}
+
+io::system::uring::event_mask_t io::system::uring::_poll_events(io::file_descriptor_t fd) const
+{
+    event_mask_t mask = _masks[fd];
+    if (_receive_queues[fd])
+    {
+        mask &= ~static_cast<event_mask_t>(EPOLLIN);
+    }
+    if (_send_queues[fd])
+    {
+        mask &= ~static_cast<event_mask_t>(EPOLLOUT);
+    }
+    return mask;
+}
+
+void io::system::uring::_accept_connections(io::file_descriptor_t fd, handle_t handle)
+{
+    if (fd < 0 || static_cast<std::size_t>(fd) >= _handles.size() || handle != _handles[fd])
+    {
+        throw io::error("failed to accept on file descriptor in io_uring", fd, ENOENT);
+    }
+    if (_accept_queues.end() != _find_accept_queue(fd) || static_cast<handle_t>(fd) >= (handle_t{1} << accept_index_shift))
+    {
+        // the listening socket is accepted by the caller on the poll events
+        return;
+    }
+    // the canceled poll completion is not dispatched
+    struct io_uring_sqe *sqe = _get_sqe();
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = handle;
+    sqe->user_data = ignored_user_data;
+    store_release(_sq.tail, *_sq.tail + 1);
+    _accept_queues.push_back(std::make_unique<accept_queue_t>());
+    accept_queue_t &queue = *_accept_queues.back();
+    queue.fd = fd;
+    queue.handle = handle;
+    queue.in_flight = 0;
+    for (std::size_t i = 0; i < ACCEPT_REQUESTS; ++i)
+    {
+        _arm_accept(queue, i);
+    }
+}
+
+bool io::system::uring::_is_accepting(io::file_descriptor_t fd) const
+{
+    return std::any_of(
+        _accept_queues.begin(), _accept_queues.end(),
+        [fd](const std::unique_ptr<accept_queue_t> &queue)
+        {
+            return queue->fd == fd;
+        });
+}
+
+io::file_descriptor_t io::system::uring::_take_accepted(io::file_descriptor_t fd, struct sockaddr *address, socklen_t *address_len)
+{
+    const auto queue = _find_accept_queue(fd);
+    if (_accept_queues.end() == queue || (*queue)->conns.empty())
+    {
+        return -1;
+    }
+    const accepted_t &conn = (*queue)->conns.front();
+    if (nullptr != address && nullptr != address_len)
+    {
+        // the address is truncated to the buffer size as the accept call does
+        std::memcpy(address, &conn.address, std::min(*address_len, conn.address_len));
+        *address_len = conn.address_len;
+    }
+    const io::file_descriptor_t result = conn.fd;
+    (*queue)->conns.pop_front();
+    return result;
+}
+
+bool io::system::uring::_setup_receive_buffers()
+{
+    const std::size_t ring_size = RECEIVE_BUFFERS * sizeof(struct io_uring_buf);
+    const std::size_t buffers_size = RECEIVE_BUFFERS * RECEIVE_BUFFER_SZ;
+    void *ring = ::mmap(nullptr, ring_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    void *buffers = ::mmap(nullptr, buffers_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    struct io_uring_buf_reg reg = {};
+    reg.ring_addr = reinterpret_cast<std::uint64_t>(ring);
+    reg.ring_entries = RECEIVE_BUFFERS;
+    reg.bgid = receive_buffer_group;
+    if (MAP_FAILED == ring || MAP_FAILED == buffers || -1 == io_uring_register(_ring_fd, IORING_REGISTER_PBUF_RING, &reg, 1))
+    {
+        std::cerr << "failed to register io_uring provided buffer ring, the sockets are read on the input readiness; errno = " << errno << std::endl;
+        if (MAP_FAILED != ring)
+        {
+            ::munmap(ring, ring_size);
+        }
+        if (MAP_FAILED != buffers)
+        {
+            ::munmap(buffers, buffers_size);
+        }
+        _is_receive_supported = false;
+        return false;
+    }
+    _buf_ring = static_cast<struct io_uring_buf_ring *>(ring);
+    _receive_buffers = static_cast<char *>(buffers);
+    for (std::size_t bid = 0; bid < RECEIVE_BUFFERS; ++bid)
+    {
+        _return_buffer(static_cast<std::uint16_t>(bid));
+    }
+    _publish_buffers();
+    return true;
+}
+
+void io::system::uring::_return_buffer(std::uint16_t bid)
+{
+    // the ring tail overlays the first entry reserved field, so it is never written here.
+    // The entries start at the ring start, the C++ flexible array declaration of the bufs member is shifted
+    struct io_uring_buf &buf = reinterpret_cast<struct io_uring_buf *>(_buf_ring)[_buf_tail & (RECEIVE_BUFFERS - 1)];
+    buf.addr = reinterpret_cast<std::uint64_t>(_receive_buffers + bid * RECEIVE_BUFFER_SZ);
+    buf.len = RECEIVE_BUFFER_SZ;
+    buf.bid = bid;
+    ++_buf_tail;
+}
+
+void io::system::uring::_publish_buffers()
+{
+    if (_published_tail == _buf_tail)
+    {
+        return;
+    }
+    __atomic_store_n(&_buf_ring->tail, _buf_tail, __ATOMIC_RELEASE);
+    _published_tail = _buf_tail;
+    std::vector<handle_t> starved;
+    starved.swap(_starved_receives);
+    for (const handle_t handle : starved)
+    {
+        const io::file_descriptor_t fd = handle_to_fd(handle);
+        if (_receive_queues[fd] && handle == _receive_queues[fd]->handle)
+        {
+            _resume_receive(*_receive_queues[fd]);
+        }
+    }
+}
+
+void io::system::uring::_arm_receive(receive_queue_t &queue)
+{
+    struct io_uring_sqe *sqe = _get_sqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = handle_to_fd(queue.handle);
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = receive_buffer_group;
+    sqe->user_data = queue.handle | recv_tag;
+    store_release(_sq.tail, *_sq.tail + 1);
+    queue.is_armed = true;
+}
+
+void io::system::uring::_resume_receive(receive_queue_t &queue)
+{
+    if (!queue.is_armed && !queue.is_eof && 0 == queue.error && queue.chunks.size() < RECEIVE_QUEUE_LIMIT)
+    {
+        _arm_receive(queue);
+    }
+}
+
+void io::system::uring::_receive_data(io::file_descriptor_t fd, handle_t handle)
+{
+    if (fd < 0 || static_cast<std::size_t>(fd) >= _handles.size() || handle != _handles[fd])
+    {
+        throw io::error("failed to receive on file descriptor in io_uring", fd, ENOENT);
+    }
+    if (_receive_queues[fd] || !_is_receive_supported || _is_accepting(fd) || static_cast<handle_t>(fd) >= (handle_t{1} << accept_index_shift))
+    {
+        // the socket is read by the caller on the poll events
+        return;
+    }
+    if (nullptr == _buf_ring && !_setup_receive_buffers())
+    {
+        return;
+    }
+    _receive_queues[fd] = std::make_unique<receive_queue_t>(receive_queue_t{handle, {}, false, false, false, 0});
+    _arm_receive(*_receive_queues[fd]);
+    _update_poll(fd, handle);
+}
+
+bool io::system::uring::_is_receiving(io::file_descriptor_t fd) const
+{
+    return 0 <= fd && static_cast<std::size_t>(fd) < _receive_queues.size() && _receive_queues[fd];
+}
+
+ssize_t io::system::uring::_take_received(io::file_descriptor_t fd, const struct iovec *iov, int iovcnt)
+{
+    if (!_is_receiving(fd))
+    {
+        errno = EOPNOTSUPP;
+        return -1;
+    }
+    receive_queue_t &queue = *_receive_queues[fd];
+    std::size_t total = 0;
+    std::size_t iov_offset = 0;
+    for (int i = 0; i < iovcnt && !queue.chunks.empty();)
+    {
+        // the kernel wrote the data to the provided buffer, it is copied out to free the buffer at once
+        chunk_t &chunk = queue.chunks.front();
+        const std::size_t len = std::min(chunk.len, iov[i].iov_len - iov_offset);
+        std::memcpy(
+            static_cast<char *>(iov[i].iov_base) + iov_offset,
+            _receive_buffers + chunk.bid * RECEIVE_BUFFER_SZ + chunk.offset,
+            len);
+        total += len;
+        chunk.offset += len;
+        chunk.len -= len;
+        iov_offset += len;
+        if (0 == chunk.len)
+        {
+            _return_buffer(chunk.bid);
+            queue.chunks.pop_front();
+        }
+        if (iov[i].iov_len == iov_offset)
+        {
+            ++i;
+            iov_offset = 0;
+        }
+    }
+    _publish_buffers();
+    _resume_receive(queue);
+    if (0 != total || queue.is_eof)
+    {
+        return static_cast<ssize_t>(total);
+    }
+    errno = 0 != queue.error ? queue.error : EAGAIN;
+    return -1;
+}
+
+bool io::system::uring::_complete_receive(handle_t handle, int res, unsigned cqe_flags)
+{
+    const io::file_descriptor_t fd = handle_to_fd(handle);
+    receive_queue_t *queue = _receive_queues[fd] && handle == _receive_queues[fd]->handle ? _receive_queues[fd].get() : nullptr;
+    const bool has_buffer = cqe_flags & IORING_CQE_F_BUFFER;
+    const auto bid = static_cast<std::uint16_t>(cqe_flags >> IORING_CQE_BUFFER_SHIFT);
+    if (nullptr == queue || res <= 0)
+    {
+        if (has_buffer)
+        {
+            _return_buffer(bid);
+        }
+        if (nullptr == queue)
+        {
+            // the socket is removed
+            return false;
+        }
+    }
+    else if (has_buffer)
+    {
+        queue->chunks.push_back(chunk_t{bid, 0, static_cast<std::size_t>(res)});
+    }
+    if (cqe_flags & IORING_CQE_F_MORE)
+    {
+        if (queue->chunks.size() >= RECEIVE_QUEUE_LIMIT && !queue->is_canceling)
+        {
+            // the slow consumer should not take all the buffers, the request is armed again on the take
+            struct io_uring_sqe *sqe = _get_sqe();
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->addr = handle | recv_tag;
+            sqe->user_data = ignored_user_data;
+            store_release(_sq.tail, *_sq.tail + 1);
+            queue->is_canceling = true;
+        }
+        return res > 0;
+    }
+
+    // the request is terminated
+    queue->is_armed = false;
+    queue->is_canceling = false;
+    if (0 == res)
+    {
+        queue->is_eof = true;
+        return true;
+    }
+    switch (-res)
+    {
+    case ENOBUFS:
+        // armed again when the buffers are returned
+        _starved_receives.push_back(handle);
+        return false;
+    case ECANCELED:
+    case EINTR:
+    case EAGAIN:
+        _resume_receive(*queue);
+        return false;
+    case EINVAL:
+        if (queue->chunks.empty())
+        {
+            // the kernel has no multishot receive, the socket is read by the caller
+            std::cerr << "io_uring multishot receive is not supported, the sockets are read on the input readiness" << std::endl;
+            _is_receive_supported = false;
+            _receive_queues[fd].reset();
+            _update_poll(fd, handle);
+            return true;
+        }
+        break;
+    default:
+        break;
+    }
+    if (res > 0)
+    {
+        // the kernel terminated the multishot receive (e.g. on overflow)
+        _resume_receive(*queue);
+        return true;
+    }
+    // the input event handlers take the error with the data
+    queue->error = -res;
+    return true;
+}
+
+void io::system::uring::_send_data(io::file_descriptor_t fd, handle_t handle)
+{
+    if (fd < 0 || static_cast<std::size_t>(fd) >= _handles.size() || handle != _handles[fd])
+    {
+        throw io::error("failed to send on file descriptor in io_uring", fd, ENOENT);
+    }
+    if (_send_queues[fd] || _is_accepting(fd) || static_cast<handle_t>(fd) >= (handle_t{1} << accept_index_shift))
+    {
+        return;
+    }
+    _send_queues[fd] = std::make_unique<send_queue_t>();
+    _send_queues[fd]->handle = handle;
+    _update_poll(fd, handle);
+}
+
+bool io::system::uring::_is_sending(io::file_descriptor_t fd) const
+{
+    return 0 <= fd && static_cast<std::size_t>(fd) < _send_queues.size() && _send_queues[fd];
+}
+
+ssize_t io::system::uring::_queue_send(io::file_descriptor_t fd, const struct iovec *iov, int iovcnt)
+{
+    if (!_is_sending(fd))
+    {
+        errno = EOPNOTSUPP;
+        return -1;
+    }
+    send_queue_t &queue = *_send_queues[fd];
+    if (0 != queue.error || 0 != queue.len)
+    {
+        errno = 0 != queue.error ? queue.error : EAGAIN;
+        return -1;
+    }
+    queue.first = 0;
+    queue.count = 0;
+    queue.sent = 0;
+    for (int i = 0; i < iovcnt && queue.count < queue.iov.size(); ++i)
+    {
+        if (0 != iov[i].iov_len)
+        {
+            queue.iov[queue.count++] = iov[i];
+            queue.len += iov[i].iov_len;
+        }
+    }
+    if (0 != queue.len)
+    {
+        _submit_send(queue);
+    }
+    return static_cast<ssize_t>(queue.len);
+}
+
+std::size_t io::system::uring::_get_unsent_bytes(io::file_descriptor_t fd) const
+{
+    return _is_sending(fd) ? _send_queues[fd]->len - _send_queues[fd]->sent : 0;
+}
+
+void io::system::uring::_submit_send(send_queue_t &queue)
+{
+    // submitted with the next io_uring_enter call together with the other requests
+    struct io_uring_sqe *sqe = _get_sqe();
+    sqe->fd = handle_to_fd(queue.handle);
+    sqe->msg_flags = MSG_NOSIGNAL;
+    if (1 == queue.count - queue.first)
+    {
+        sqe->opcode = IORING_OP_SEND;
+        sqe->addr = reinterpret_cast<std::uint64_t>(queue.iov[queue.first].iov_base);
+        sqe->len = static_cast<std::uint32_t>(queue.iov[queue.first].iov_len);
+    }
+    else
+    {
+        queue.msg = {};
+        queue.msg.msg_iov = &queue.iov[queue.first];
+        queue.msg.msg_iovlen = queue.count - queue.first;
+        sqe->opcode = IORING_OP_SENDMSG;
+        sqe->addr = reinterpret_cast<std::uint64_t>(&queue.msg);
+        sqe->len = 1;
+    }
+    sqe->user_data = queue.handle | send_tag;
+    store_release(_sq.tail, *_sq.tail + 1);
+}
+
+io::flags io::system::uring::_complete_send(handle_t handle, int res)
+{
+    const io::file_descriptor_t fd = handle_to_fd(handle);
+    if (!_send_queues[fd] || handle != _send_queues[fd]->handle)
+    {
+        // the socket is removed, its message header is not used anymore
+        _closed_sends.erase(
+            std::remove_if(
+                _closed_sends.begin(), _closed_sends.end(),
+                [handle](const std::unique_ptr<send_queue_t> &queue)
+                {
+                    return queue->handle == handle;
+                }),
+            _closed_sends.end());
+        return io::flags::empty;
+    }
+    send_queue_t &queue = *_send_queues[fd];
+    if (-EINTR == res || -EAGAIN == res)
+    {
+        _submit_send(queue);
+        return io::flags::empty;
+    }
+    if (res <= 0)
+    {
+        queue.error = 0 == res ? EPIPE : -res;
+        queue.len = queue.sent = 0;
+        // the error event handlers read the error code from the errno
+        errno = queue.error;
+        return io::flags::error;
+    }
+    queue.sent += static_cast<std::size_t>(res);
+    if (queue.sent == queue.len)
+    {
+        queue.len = queue.sent = 0;
+        return io::flags::out;
+    }
+    // the short send, the rest is sent by the next request
+    for (std::size_t left = static_cast<std::size_t>(res); 0 != left;)
+    {
+        struct iovec &part = queue.iov[queue.first];
+        const std::size_t len = std::min(left, part.iov_len);
+        part.iov_base = static_cast<char *>(part.iov_base) + len;
+        part.iov_len -= len;
+        left -= len;
+        if (0 == part.iov_len)
+        {
+            ++queue.first;
+        }
+    }
+    _submit_send(queue);
+    return io::flags::empty;
+}
+
+bool io::system::uring::_complete_accept(handle_t handle, std::size_t index, int res)
+{
+    const auto queue = std::find_if(
+        _accept_queues.begin(), _accept_queues.end(),
+        [handle](const std::unique_ptr<accept_queue_t> &queue)
+        {
+            return queue->handle == handle;
+        });
+    if (_accept_queues.end() == queue)
+    {
+        return false;
+    }
+    --(*queue)->in_flight;
+    if (-1 == (*queue)->fd)
+    {
+        // the connection accepted before the listening socket removal is not reported
+        if (res >= 0)
+        {
+            ::close(res);
+        }
+        if (0 == (*queue)->in_flight)
+        {
+            _accept_queues.erase(queue);
+        }
+        return false;
+    }
+    if (res >= 0)
+    {
+        const accept_request_t &request = (*queue)->requests[index];
+        (*queue)->conns.push_back(accepted_t{res, request.address, request.address_len});
+    }
+    // the request is re-armed at once, the copied address buffer is free
+    _arm_accept(**queue, index);
+    switch (-res)
+    {
+    case EAGAIN:
+    case EINTR:
+    case ECONNABORTED:
+        // the aborted connection is skipped as the caller does for the accept call
+        return false;
+    default:
+        break;
+    }
+    if (res < 0)
+    {
+        // the error event handlers read the error code from the errno
+        errno = -res;
+    }
+    return true;
+}
+
+void io::system::uring::_wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size)
+{
+    struct __kernel_timespec ts = {};
+    struct io_uring_getevents_arg arg = {};
+    const void *arg_ptr = nullptr;
+    unsigned min_complete = 0;
+    unsigned flags = IORING_ENTER_GETEVENTS;
+    if (timeout_msec.count() > 0)
+    {
+        ts.tv_sec = timeout_msec.count() / 1000;
+        ts.tv_nsec = (timeout_msec.count() % 1000) * 1000000;
+        arg.sigmask_sz = _NSIG / 8;
+        arg.ts = reinterpret_cast<std::uint64_t>(&ts);
+        arg_ptr = &arg;
+        flags |= IORING_ENTER_EXT_ARG;
+        min_complete = 1;
+    }
+    else if (timeout_msec.count() < 0)
+    {
+        min_complete = 1;
+    }
+    // the single syscall submits the batch of queued requests and waits for completions
+    _enter(min_complete, flags, arg_ptr);
+
+    unsigned head = *_cq.head;
+    const unsigned tail = load_acquire(_cq.tail);
+    for (std::size_t count = 0; head != tail && count < events_buf_size; ++count)
+    {
+        const struct io_uring_cqe *cqe = &_cq.cqes[head & *_cq.mask];
+        const handle_t handle = cqe->user_data;
+        const int res = cqe->res;
+        const unsigned cqe_flags = cqe->flags;
+        // release the entry before any callback can submit new requests
+        store_release(_cq.head, ++head);
+
+        if (ignored_user_data == handle)
+        {
+            continue;
+        }
+        if (handle & accept_tag)
+        {
+            const handle_t accept_handle = handle & ~(accept_tag | accept_index_mask);
+            if (_complete_accept(accept_handle, (handle & accept_index_mask) >> accept_index_shift, res))
+            {
+                dispatch_event(accept_handle, res < 0 ? io::flags::error : io::flags::in);
+            }
+            continue;
+        }
+        if (handle & recv_tag)
+        {
+            const handle_t recv_handle = handle & ~recv_tag;
+            if (_complete_receive(recv_handle, res, cqe_flags))
+            {
+                dispatch_event(recv_handle, io::flags::in);
+            }
+            continue;
+        }
+        if (handle & send_tag)
+        {
+            const handle_t send_handle = handle & ~send_tag;
+            const io::flags f = _complete_send(send_handle, res);
+            if (!f.test(io::flags::empty))
+            {
+                dispatch_event(send_handle, f);
+            }
+            continue;
+        }
+        if (handle & update_tag)
+        {
+            const handle_t poll_handle = handle & ~update_tag;
+            const io::file_descriptor_t fd = handle_to_fd(poll_handle);
+            if (-EALREADY == res && static_cast<std::size_t>(fd) < _handles.size() && poll_handle == _handles[fd])
+            {
+                // the poll request was completing an event, the update is lost
+                _update_poll(fd, poll_handle);
+            }
+            continue;
+        }
+        if (-ECANCELED == res)
+        {
+            // the poll request is removed or replaced by the accept request
+            continue;
+        }
+        const io::file_descriptor_t fd = handle_to_fd(handle);
+        const bool is_active = static_cast<std::size_t>(fd) < _handles.size() && handle == _handles[fd];
+        if (res >= 0 && is_active && !(cqe_flags & IORING_CQE_F_MORE))
+        {
+            // the kernel terminated the multishot poll (e.g. on overflow), re-arm it
+            _arm(fd, handle);
+        }
+        const io::flags f = (res < 0) ? io::flags::error : poll_mask_to_io_flags(res);
+        IO_DEBUG((std::cout << "uring::_wait_events: fd = " << fd << "; res = 0x" << std::hex << res << std::dec << "; flags = " << f << std::endl));
+        dispatch_event(handle, f);
+    }
+    // the buffers returned by the completions of the removed sockets
+    _publish_buffers();
+}
@@ -0,0 +1,367 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_IO_URING_T
+#define H_IO_URING_T
+
+#include "bus.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <sys/socket.h> // struct sockaddr_storage, struct msghdr
+#include <linux/io_uring.h> // struct io_uring_sqe, struct io_uring_cqe
+
+/// \brief The input/output library namespace
+namespace io
+{
+	/// \brief The system specific namespace
+	namespace system
+	{
+		/// \brief The \ref io::bus implementation based on the GNU/Linux kernel io_uring async I/O API.
+		/// Every file descriptor is watched by one multishot poll request,
+		/// the poll requests registration and removal are submitted in batches
+		/// together with the completions wait in a single io_uring_enter call.
+		/// The listening sockets passed to the \ref io::bus::accept_connections are served
+		/// by the accept requests kept in flight instead, so no accept call is made per connection.
+		/// Every request has its own peer address buffer, so the address comes with the completion.
+		/// The stream sockets passed to the \ref io::bus::receive_data are read by the multishot receive request
+		/// selecting the buffers of the provided buffer ring registered on the first use, and the data passed
+		/// to the \ref io::bus::queue_send is sent by the send request queued to the next io_uring_enter call,
+		/// so no system call is made per read or write. The poll request stops watching the input
+		/// or the output readiness of such sockets. The kernels without the provided buffer rings
+		/// or the multishot receive leave the sockets read on the input readiness.
+		class uring
+			: public io::bus
+		{
+		public:
+			/// \brief The native poll event mask type.
+			/// The same EPOLL* values as for the \ref io::system::epoll are accepted, including EPOLLET.
+			using event_mask_t = unsigned;
+
+			/// @brief Constructs new io_uring \ref io::bus implementation object.
+			/// @param event_mask The native poll event mask.
+			/// @param entries The submission queue size.
+			explicit uring(event_mask_t event_mask, unsigned entries = 4096);
+			/// @brief Make sure the object is correctly destructed
+			~uring() noexcept override;
+
+			/// \brief The number of the accept requests kept in flight for every listening socket
+			static constexpr std::size_t ACCEPT_REQUESTS = 16;
+			/// \brief The number of the provided receive buffers shared by all the receiving sockets, the power of 2
+			static constexpr std::size_t RECEIVE_BUFFERS = 512;
+			/// \brief The provided receive buffer size
+			static constexpr std::size_t RECEIVE_BUFFER_SZ = 16 * 1024;
+			/// \brief The number of the received buffers queued for one socket the receive request is paused at
+			static constexpr std::size_t RECEIVE_QUEUE_LIMIT = 8;
+
+			/// \brief copy is prohibited
+			uring(const uring &) = delete; // non construction-copyable
+			/// \brief copy is prohibited
+			uring &operator=(const uring &) = delete; // non copyable
+
+			/// \brief move is prohibited
+			uring(uring &&) noexcept = delete;
+			/// \brief move is prohibited
+			uring &operator=(uring &&) noexcept = delete;
+
+		private:
+			/// @brief Listen on the \p fd file descriptor.
+			/// The \ref io::bus::_add_fd pure virtual function implementation.
+			/// @param fd The file descriptor
+			/// @param handle The registration handle stored in the poll request user data
+			void _add_fd(file_descriptor_t fd, handle_t handle) override;
+			/// @brief Stop listening on the \p fd file descriptor
+			/// The \ref io::bus::_del_fd pure virtual function implementation.
+			/// @param fd The file descriptor
+			void _del_fd(file_descriptor_t fd) override;
+			/// @brief Change the output readiness watch of the \p fd file descriptor.
+			/// The active multishot poll request events are updated in place.
+			/// The \ref io::bus::_set_output_interest pure virtual function implementation.
+			/// @param fd The file descriptor
+			/// @param handle The registration handle
+			/// @param enabled Add the EPOLLOUT to the poll event mask if true
+			void _set_output_interest(file_descriptor_t fd, handle_t handle, bool enabled) override;
+			/// @brief Replace the poll request of the listening socket \p fd with the accept requests.
+			/// The \ref io::bus::_accept_connections virtual function implementation.
+			/// @param fd The file descriptor
+			/// @param handle The registration handle
+			void _accept_connections(file_descriptor_t fd, handle_t handle) override;
+			/// @brief Check if the accept requests serve the listening socket \p fd
+			/// The \ref io::bus::_is_accepting virtual function implementation.
+			/// @param fd The file descriptor
+			/// @return true if the connections are accepted by the accept requests
+			bool _is_accepting(file_descriptor_t fd) const override;
+			/// @brief Take the next connection accepted on the listening socket \p fd
+			/// The \ref io::bus::_take_accepted virtual function implementation.
+			/// @param fd The file descriptor
+			/// @param address The buffer to write the connection peer address to, nullptr to skip it
+			/// @param address_len The \p address buffer size on input, the peer address size on output
+			/// @return The accepted connection file descriptor, -1 if there is no connection queued
+			file_descriptor_t _take_accepted(file_descriptor_t fd, struct sockaddr *address, socklen_t *address_len) override;
+			/// @brief Start the multishot receive request of the stream socket \p fd.
+			/// The \ref io::bus::_receive_data virtual function implementation.
+			/// @param fd The file descriptor
+			/// @param handle The registration handle
+			void _receive_data(file_descriptor_t fd, handle_t handle) override;
+			/// @brief Check if the receive request reads the stream socket \p fd
+			/// The \ref io::bus::_is_receiving virtual function implementation.
+			/// @param fd The file descriptor
+			/// @return true if the data is taken with the \ref io::bus::take_received
+			bool _is_receiving(file_descriptor_t fd) const override;
+			/// @brief Copy the data received on the stream socket \p fd to the buffers and return the drained provided buffers
+			/// The \ref io::bus::_take_received virtual function implementation.
+			/// @param fd The file descriptor
+			/// @param iov The buffers to write the data to
+			/// @param iovcnt The number of the \p iov buffers
+			/// @return The bytes count copied, 0 at the end of the stream, -1 with the errno set if nothing is copied
+			ssize_t _take_received(file_descriptor_t fd, const struct iovec *iov, int iovcnt) override;
+			/// @brief Send the data queued for the stream socket \p fd with the send requests.
+			/// The \ref io::bus::_send_data virtual function implementation.
+			/// @param fd The file descriptor
+			/// @param handle The registration handle
+			void _send_data(file_descriptor_t fd, handle_t handle) override;
+			/// @brief Check if the send requests write the stream socket \p fd
+			/// The \ref io::bus::_is_sending virtual function implementation.
+			/// @param fd The file descriptor
+			/// @return true if the data is sent with the \ref io::bus::queue_send
+			bool _is_sending(file_descriptor_t fd) const override;
+			/// @brief Queue the send request of the first two buffers
+			/// The \ref io::bus::_queue_send virtual function implementation.
+			/// @param fd The file descriptor
+			/// @param iov The buffers of data to send
+			/// @param iovcnt The number of the \p iov buffers
+			/// @return The bytes count queued, -1 with the errno set if the send is in flight or failed
+			ssize_t _queue_send(file_descriptor_t fd, const struct iovec *iov, int iovcnt) override;
+			/// @brief Get the bytes count of the send request in flight not sent yet
+			/// The \ref io::bus::_get_unsent_bytes virtual function implementation.
+			/// @param fd The file descriptor
+			/// @return The bytes count the kernel still reads from the caller buffers
+			std::size_t _get_unsent_bytes(file_descriptor_t fd) const override;
+
+			/// @brief Submit the queued requests and wait for I/O events on this bus object.
+			/// It waits for the \p timeout_msec milliseconds or
+			/// while the \p events_buf_size events is read.
+			/// The \ref io::bus::_wait_events pure virtual function implementation.
+			/// @param timeout_msec The maximum time to wait for events, in milliseconds. A negative value means infinite wait, zero means no wait.
+			/// @param events_buf_size The events buffer size
+			void _wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size) override;
+
+		private:
+			/// @brief Get the next free submission queue entry.
+			/// The queued entries are submitted if the queue is full.
+			/// @return The zero filled submission queue entry
+			struct io_uring_sqe *_get_sqe();
+			/// @brief Queue the multishot poll request for the \p fd file descriptor
+			/// @param fd The file descriptor
+			/// @param handle The registration handle
+			void _arm(file_descriptor_t fd, handle_t handle);
+			struct accept_queue_t;
+			/// @brief Queue the accept request of the \p queue listening socket
+			/// @param queue The listening socket accept queue
+			/// @param index The request index in the \p queue
+			void _arm_accept(accept_queue_t &queue, std::size_t index);
+			/// @brief Queue the connection accepted by the accept request completion
+			/// @param handle The registration handle without the accept tag
+			/// @param index The request index
+			/// @param res The completion result, the connection or the negative error code
+			/// @return true if the input or error event should be dispatched for the \p handle
+			bool _complete_accept(handle_t handle, std::size_t index, int res);
+			/// @brief Queue the update of the multishot poll request events of the \p fd file descriptor
+			/// @param fd The file descriptor
+			/// @param handle The registration handle
+			void _update_poll(file_descriptor_t fd, handle_t handle);
+			/// @brief Get the poll events of the \p fd file descriptor.
+			/// The input and output readiness is not watched for the sockets read and written by the requests.
+			/// @param fd The file descriptor
+			/// @return The poll event mask
+			event_mask_t _poll_events(file_descriptor_t fd) const;
+			/// @brief Map and register the provided receive buffer ring
+			/// @return true if the receive requests can select the buffers
+			bool _setup_receive_buffers();
+			/// @brief Put the provided buffer back to the ring, it is seen by the kernel after the \ref _publish_buffers
+			/// @param bid The buffer id
+			void _return_buffer(std::uint16_t bid);
+			/// @brief Make the returned buffers seen by the kernel and resume the receive requests starved of them
+			void _publish_buffers();
+			struct receive_queue_t;
+			/// @brief Queue the multishot receive request of the \p queue socket
+			/// @param queue The socket receive queue
+			void _arm_receive(receive_queue_t &queue);
+			/// @brief Queue the receive request again if it is terminated and the \p queue is below the limit
+			/// @param queue The socket receive queue
+			void _resume_receive(receive_queue_t &queue);
+			/// @brief Queue the buffer received by the receive request completion
+			/// @param handle The registration handle without the receive tag
+			/// @param res The completion result, the bytes count or the negative error code
+			/// @param cqe_flags The completion flags with the buffer id
+			/// @return true if the input event should be dispatched for the \p handle
+			bool _complete_receive(handle_t handle, int res, unsigned cqe_flags);
+			struct send_queue_t;
+			/// @brief Queue the send request of the unsent \p queue data
+			/// @param queue The socket send queue
+			void _submit_send(send_queue_t &queue);
+			/// @brief Account the data sent by the send request completion and send the rest
+			/// @param handle The registration handle without the send tag
+			/// @param res The completion result, the bytes count or the negative error code
+			/// @return The event to dispatch for the \p handle, the empty flags if none
+			io::flags _complete_send(handle_t handle, int res);
+			/// @brief Submit the queued requests and optionally wait for completions
+			/// @param min_complete The number of completions to wait for
+			/// @param flags The io_uring_enter flags
+			/// @param arg The io_uring_enter extended argument
+			/// @return The io_uring_enter result
+			int _enter(unsigned min_complete, unsigned flags, const void *arg);
+
+		private:
+			/// \brief The io_uring file descriptor.
+			int _ring_fd;
+
+			/// \brief The native poll event mask
+			event_mask_t _event_mask;
+
+			/// \brief The submission queue ring
+			struct sq_ring_t
+			{
+				void *ptr = nullptr;
+				std::size_t size = 0;
+				unsigned *head = nullptr;
+				unsigned *tail = nullptr;
+				unsigned *mask = nullptr;
+				unsigned *array = nullptr;
+				unsigned entries = 0;
+				struct io_uring_sqe *sqes = nullptr;
+				std::size_t sqes_size = 0;
+			} _sq;
+
+			/// \brief The completion queue ring
+			struct cq_ring_t
+			{
+				void *ptr = nullptr;
+				std::size_t size = 0;
+				unsigned *head = nullptr;
+				unsigned *tail = nullptr;
+				unsigned *mask = nullptr;
+				struct io_uring_cqe *cqes = nullptr;
+			} _cq;
+
+			/// \brief The active poll request handles indexed by the file descriptor
+			std::vector<handle_t> _handles;
+			/// \brief The active poll request event masks indexed by the file descriptor
+			std::vector<event_mask_t> _masks;
+
+			/// \brief The connection accepted and its peer address
+			struct accepted_t
+			{
+				/// \brief The connection file descriptor
+				file_descriptor_t fd;
+				/// \brief The peer address
+				struct sockaddr_storage address;
+				/// \brief The peer address size
+				socklen_t address_len;
+			};
+			/// \brief The accept request peer address buffer, the kernel writes it on the completion
+			struct accept_request_t
+			{
+				/// \brief The peer address
+				struct sockaddr_storage address;
+				/// \brief The peer address size
+				socklen_t address_len;
+			};
+			/// \brief The listening socket served by the accept requests
+			struct accept_queue_t
+			{
+				/// \brief The listening socket file descriptor, -1 after its removal
+				file_descriptor_t fd;
+				/// \brief The registration handle
+				handle_t handle;
+				/// \brief The requests peer address buffers
+				std::array<accept_request_t, ACCEPT_REQUESTS> requests;
+				/// \brief The number of the requests in flight, the queue is kept until their completion
+				std::size_t in_flight;
+				/// \brief The accepted connections not taken yet
+				std::deque<accepted_t> conns;
+			};
+			/// \brief The listening sockets served by the accept requests, there are few of them.
+			/// The kernel writes the address buffers, so the queues are never moved.
+			std::vector<std::unique_ptr<accept_queue_t>> _accept_queues;
+			/// @brief Find the accept queue of the listening socket \p fd
+			/// @param fd The file descriptor
+			/// @return The accept queue iterator or the end one
+			std::vector<std::unique_ptr<accept_queue_t>>::iterator _find_accept_queue(file_descriptor_t fd);
+
+			/// \brief The provided buffer data received and not taken yet
+			struct chunk_t
+			{
+				/// \brief The buffer id
+				std::uint16_t bid;
+				/// \brief The offset of the data not taken yet
+				std::size_t offset;
+				/// \brief The bytes count not taken yet
+				std::size_t len;
+			};
+			/// \brief The stream socket read by the multishot receive request
+			struct receive_queue_t
+			{
+				/// \brief The registration handle
+				handle_t handle;
+				/// \brief The buffers received and not taken yet
+				std::deque<chunk_t> chunks;
+				/// \brief Is the receive request in flight
+				bool is_armed;
+				/// \brief Is the receive request paused by the cancel request
+				bool is_canceling;
+				/// \brief Is the end of the stream received
+				bool is_eof;
+				/// \brief The receive errno value, 0 if no error
+				int error;
+			};
+			/// \brief The receive queues indexed by the file descriptor, null for the sockets read by the caller
+			std::vector<std::unique_ptr<receive_queue_t>> _receive_queues;
+			/// \brief The handles of the receive requests terminated as the provided buffers ran out
+			std::vector<handle_t> _starved_receives;
+			/// \brief The provided receive buffer ring shared with the kernel, null until the first receive
+			struct io_uring_buf_ring *_buf_ring = nullptr;
+			/// \brief The provided receive buffers memory
+			char *_receive_buffers = nullptr;
+			/// \brief The ring tail including the buffers returned and not published yet
+			std::uint16_t _buf_tail = 0;
+			/// \brief The ring tail seen by the kernel
+			std::uint16_t _published_tail = 0;
+			/// \brief Can the receive requests be used, false if the kernel rejects them
+			bool _is_receive_supported = true;
+
+			/// \brief The stream socket written by the send requests
+			struct send_queue_t
+			{
+				/// \brief The registration handle
+				handle_t handle;
+				/// \brief The send request message header, the kernel reads it until the completion
+				struct msghdr msg;
+				/// \brief The unsent parts of the buffers queued
+				std::array<struct iovec, 2> iov;
+				/// \brief The first unsent buffer index
+				std::size_t first;
+				/// \brief The number of the buffers queued
+				std::size_t count;
+				/// \brief The bytes count queued, 0 if no send is in flight
+				std::size_t len;
+				/// \brief The bytes count sent of the \ref len
+				std::size_t sent;
+				/// \brief The send errno value, 0 if no error
+				int error;
+			};
+			/// \brief The send queues indexed by the file descriptor, null for the sockets written by the caller
+			std::vector<std::unique_ptr<send_queue_t>> _send_queues;
+			/// \brief The send queues of the removed sockets kept until the completion of their send requests in flight
+			std::vector<std::unique_ptr<send_queue_t>> _closed_sends;
+		};
+	}
+}
+
+#endif // H_IO_URING_T
@@ -7,6 +7,7 @@
 #include <string>
 #include <array>
 #include <cstring>
+#include <utility>
 #include <ostream>
 
 #include <arpa/inet.h>
@@ -0,0 +1,26 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "backend_handler.hpp"
+
+#include <variant>
+
+psql_proxy::backend_handler::backend_handler(const std::shared_ptr<query_tracker> &tracker)
+    : _tracker(tracker)
+{
+}
+
+void psql_proxy::backend_handler::operator()(const io::input_object::result_type &result)
+{
+    auto v = io::make_visitor{
+        [](const io::error &)
+        {
+            ; // ignore errors
+        },
+        [&](const io::input_object::success_result_type &res)
+        {
+            _tracker->on_backend_data(static_cast<const std::byte *>(res.buf), res.buf_len);
+        }};
+    std::visit(v, result);
+}
@@ -0,0 +1,35 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_PSQL_PROXY_BACKEND_HANDLER_T
+#define H_PSQL_PROXY_BACKEND_HANDLER_T
+
+#include "query_tracker.hpp"
+
+#include <io/object.hpp>
+
+#include <memory>
+
+/// @brief The PostgreSQL Proxy service namespace
+namespace psql_proxy
+{
+    /// @brief The \ref io::input_object::callback_t callback of the backend to client channel
+    class backend_handler
+    {
+    public:
+        /// @brief Construct the \ref io::input_object::callback_t callback
+        /// @param tracker The session queries tracker shared with the client messages \ref handler
+        explicit backend_handler(const std::shared_ptr<query_tracker> &tracker);
+
+        /// @brief The I/O operation result callback.
+        /// @sa \ref io::input_object::callback_t
+        void operator()(const io::input_object::result_type &result);
+
+    private:
+        /// @brief The session queries tracker
+        std::shared_ptr<query_tracker> _tracker;
+    };
+}
+
+#endif // H_PSQL_PROXY_BACKEND_HANDLER_T
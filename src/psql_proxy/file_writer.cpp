@@ -5,48 +5,77 @@
 #include "file_writer.hpp"
 
 #include <chrono>
-#include <thread>
+#include <utility> // std::move
 
 psql_proxy::file_writer::file_writer(
-    const io::context_ptr &io_context,
-    data_processor *data_processor,
-    std::ofstream *ofs)
-    : _io_context(io_context),
-      _data_processor(data_processor),
-      _ofs(ofs)
+    const io::context_pool_ptr &io_contexts,
+    data_processors_vec_t data_processors,
+    std::ofstream *ofs,
+    io::system::eventfd *notifier)
+    : _io_contexts(io_contexts),
+      _data_processors(std::move(data_processors)),
+      _ofs(ofs),
+      _notifier(notifier)
 {
 }
 
+bool psql_proxy::file_writer::_is_stop_requested() const
+{
+    for (std::size_t i = 0; i < _io_contexts->size(); ++i)
+    {
+        if (!_io_contexts->get_context(i)->is_stop_requested())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 void psql_proxy::file_writer::operator()()
 {
     using timer = std::chrono::system_clock;
     auto tm = timer::now();
-    while (!_io_context->is_stop_requested())
+    auto write_chunk = [&](const char *buf, std::size_t buf_len) -> std::size_t
     {
-        // std::cout << "writer thread" << std::endl;
-        const int written_chars = _data_processor->process(
-            [&](const char *buf, std::size_t buf_len) -> std::size_t
-            {
-                auto written_chars = _ofs->rdbuf()->sputn(buf, buf_len);
-                return written_chars;
-            });
-        if (0 == written_chars)
+        auto written_chars = _ofs->rdbuf()->sputn(buf, buf_len);
+        return written_chars;
+    };
+    bool is_flush_needed = false;
+    while (!_is_stop_requested())
+    {
+        std::size_t written_chars = 0;
+        for (data_processor *processor : _data_processors)
         {
-            // An alternative is a conditional with a mutex, but it would add significant overhead
-            // while this task can safely wait for 100 msec if no data available.
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            written_chars += processor->process(write_chunk);
         }
-        else
+        if (0 == written_chars)
         {
-            // std::cout << "writer thread written_chars = " << written_chars << std::endl;
+            if (is_flush_needed)
+            {
+                _ofs->flush();
+                is_flush_needed = false;
+                tm = timer::now();
+            }
+            // block until the reactors log something or the stop is requested
+            _notifier->wait(std::chrono::milliseconds{-1});
+            continue;
         }
+        is_flush_needed = true;
         auto now = timer::now();
         auto elapsed = now - tm;
         if (100 <= std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count())
         {
             _ofs->flush();
+            is_flush_needed = false;
             tm = now;
         }
     }
+    // drain whatever the reactors logged before they stopped
+    for (data_processor *processor : _data_processors)
+    {
+        while (0 < processor->process(write_chunk))
+        {
+        }
+    }
     _ofs->flush();
-}
\ No newline at end of file
+}
@@ -7,8 +7,10 @@
 
 #include "data_processor.hpp"
 
-#include <io/context.hpp>
+#include <io/context_pool.hpp>
+#include <io/eventfd.hpp>
 #include <fstream>
+#include <vector>
 
 /// @brief The PostgreSQL Proxy service namespace
 namespace psql_proxy
@@ -17,22 +19,33 @@ namespace psql_proxy
     class file_writer
     {
     public:
+        /// @brief The PostgreSQL messages processor objects collection type
+        using data_processors_vec_t = std::vector<data_processor *>;
+
         /// @brief Construct the thread function object to dump SQL queries to a file
-        /// @param io_context The I/O reactor pattern object. Uset to check for exit condition.
-        /// @param data_processor The PostgreSQL messages processor object.
+        /// @param io_contexts The I/O reactor pattern objects. Used to check for exit condition.
+        /// @param data_processors The PostgreSQL messages processor objects, one per reactor thread.
         /// @param ofs The file stream object to dump queries to.
-        file_writer(const io::context_ptr &io_context, data_processor *data_processor, std::ofstream *ofs);
+        /// @param notifier The notification that the data is available or the stop is requested.
+        /// The writer thread blocks on it while there is no data.
+        file_writer(const io::context_pool_ptr &io_contexts, data_processors_vec_t data_processors, std::ofstream *ofs, io::system::eventfd *notifier);
 
         /// @brief The thread body function
         void operator()();
 
     private:
-        /// @brief The I/O reactor pattern object. Uset to check for exit condition.
-        io::context_ptr _io_context;
-        /// @brief The PostgreSQL messages processor object.
-        data_processor *_data_processor;
+        /// @brief Check if all the I/O reactors are requested to stop
+        /// @return True if all the I/O reactors are requested to stop
+        bool _is_stop_requested() const;
+
+        /// @brief The I/O reactor pattern objects. Used to check for exit condition.
+        io::context_pool_ptr _io_contexts;
+        /// @brief The PostgreSQL messages processor objects, one per reactor thread.
+        data_processors_vec_t _data_processors;
         /// @brief The file stream object to dump queries to.
         std::ofstream *_ofs;
+        /// @brief The notification that the data is available or the stop is requested.
+        io::system::eventfd *_notifier;
     };
 }
 
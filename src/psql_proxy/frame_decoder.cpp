@@ -0,0 +1,237 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "frame_decoder.hpp"
+
+#include <io/endianness.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+    /// @brief The message length field size, the length includes the field itself
+    constexpr std::size_t length_sz = sizeof(std::uint32_t);
+}
+
+psql::frame_decoder::frame_decoder(
+    const codes_t &inspected_codes,
+    callback_t callback,
+    std::size_t max_payload_len)
+    : frame_decoder(stream::frontend, inspected_codes, codes_t{}, std::move(callback), max_payload_len)
+{
+}
+
+psql::frame_decoder::frame_decoder(
+    stream direction,
+    const codes_t &inspected_codes,
+    const codes_t &counted_codes,
+    callback_t callback,
+    std::size_t max_payload_len)
+    : _inspected_codes(inspected_codes),
+      _counted_codes(counted_codes),
+      _callback(std::move(callback)),
+      _max_payload_len(max_payload_len),
+      _header{},
+      _header_len(0),
+      _code{0},
+      _payload_len(0),
+      _skip_len(0),
+      _state(state::header),
+      _is_untyped(stream::frontend == direction),
+      _is_broken(false),
+      _is_copy_in(false),
+      _frames_count(0),
+      _oversized_count(0),
+      _reassembled_bytes(0),
+      _copy_count(0),
+      _copy_data_count(0)
+{
+}
+
+void psql::frame_decoder::decode(const std::byte *data, std::size_t len)
+{
+    while (0 != len && !_is_broken)
+    {
+        switch (_state)
+        {
+        case state::header:
+        {
+            if (_is_copy_in && 0 == _header_len && !_inspected_codes.test(std::to_integer<std::size_t>(COPY_DATA_CODE)) &&
+                !_counted_codes.test(std::to_integer<std::size_t>(COPY_DATA_CODE)))
+            {
+                // the bulk load is passed through by walking the headers only
+                const std::size_t n = _skip_copy_data(data, len);
+                data += n;
+                len -= n;
+                if (0 == len || state::header != _state || _is_broken)
+                {
+                    break;
+                }
+            }
+            const std::size_t header_sz = _is_untyped ? length_sz : MAX_HEADER_SZ;
+            if (0 == _header_len && len >= header_sz)
+            {
+                // the common case: the whole header is in the chunk
+                data += header_sz;
+                len -= header_sz;
+                _start_frame(data - header_sz);
+                break;
+            }
+            const std::size_t n = std::min(header_sz - _header_len, len);
+            std::memcpy(_header.data() + _header_len, data, n);
+            _header_len += n;
+            _reassembled_bytes += n;
+            data += n;
+            len -= n;
+            if (header_sz == _header_len)
+            {
+                _header_len = 0;
+                _start_frame(_header.data());
+            }
+            break;
+        }
+        case state::payload:
+        {
+            if (_payload.empty() && len >= _payload_len)
+            {
+                // the common case: the whole payload is in the chunk
+                data += _payload_len;
+                len -= _payload_len;
+                _finish_frame(data - _payload_len);
+                break;
+            }
+            if (_payload.empty())
+            {
+                _payload.reserve(_payload_len);
+            }
+            const std::size_t n = std::min(_payload_len - _payload.size(), len);
+            _payload.insert(_payload.end(), data, data + n);
+            _reassembled_bytes += n;
+            data += n;
+            len -= n;
+            if (_payload_len == _payload.size())
+            {
+                _finish_frame(_payload.data());
+                _payload.clear();
+                if (_payload.capacity() > KEPT_PAYLOAD_CAPACITY)
+                {
+                    // a rare huge message should not pin its memory for the session lifetime
+                    _payload.shrink_to_fit();
+                }
+            }
+            break;
+        }
+        case state::skip:
+        {
+            const std::size_t n = std::min(_skip_len, len);
+            _skip_len -= n;
+            data += n;
+            len -= n;
+            if (0 == _skip_len)
+            {
+                _state = state::header;
+            }
+            break;
+        }
+        }
+    }
+}
+
+std::size_t psql::frame_decoder::_skip_copy_data(const std::byte *data, std::size_t len)
+{
+    // the local counter is kept in a register, the member one may alias the data bytes
+    std::uint64_t count = 0;
+    std::size_t pos = 0;
+    while (len - pos >= MAX_HEADER_SZ && COPY_DATA_CODE == data[pos])
+    {
+        const std::uint32_t length = io::decode_uint32_be(data + pos + 1);
+        if (length < length_sz)
+        {
+            // the state machine reports the malformed message
+            break;
+        }
+        ++count;
+        pos += MAX_HEADER_SZ;
+        const std::size_t payload_len = length - length_sz;
+        if (len - pos < payload_len)
+        {
+            _skip_len = payload_len - (len - pos);
+            _state = state::skip;
+            pos = len;
+            break;
+        }
+        pos += payload_len;
+    }
+    _frames_count += count;
+    _copy_data_count += count;
+    return pos;
+}
+
+void psql::frame_decoder::_start_frame(const std::byte *header)
+{
+    const std::size_t header_sz = _is_untyped ? length_sz : MAX_HEADER_SZ;
+    _code = _is_untyped ? std::byte{0} : header[0];
+    // the protocol uses the network byte order for all integers
+    const std::uint32_t length = io::decode_uint32_be(header + header_sz - length_sz);
+    // the untyped messages start with the protocol version or the request code
+    if (length < length_sz || (_is_untyped && length < 2 * length_sz))
+    {
+        _is_broken = true;
+        return;
+    }
+    _payload_len = length - length_sz;
+    // the client sends the data until it finishes or aborts the COPY FROM STDIN
+    if (COPY_DATA_CODE == _code && !_is_untyped)
+    {
+        _copy_count += _is_copy_in ? 0 : 1;
+        _copy_data_count += 1;
+        _is_copy_in = true;
+    }
+    else if (COPY_DONE_CODE == _code || COPY_FAIL_CODE == _code)
+    {
+        _is_copy_in = false;
+    }
+
+    const bool is_inspected = _is_untyped || _inspected_codes.test(std::to_integer<std::size_t>(_code));
+    if (is_inspected && _payload_len <= _max_payload_len)
+    {
+        _state = state::payload;
+        if (0 == _payload_len)
+        {
+            _finish_frame(header + header_sz);
+        }
+        return;
+    }
+    if (is_inspected)
+    {
+        ++_oversized_count;
+    }
+    else if (_counted_codes.test(std::to_integer<std::size_t>(_code)))
+    {
+        _callback(frame{_code, nullptr, _payload_len});
+    }
+    ++_frames_count;
+    _is_untyped = false;
+    _skip_len = _payload_len;
+    _state = 0 == _skip_len ? state::header : state::skip;
+}
+
+void psql::frame_decoder::_finish_frame(const std::byte *payload)
+{
+    ++_frames_count;
+    _state = state::header;
+    const bool was_untyped = _is_untyped;
+    // the client sends the untyped startup message again after the encryption request is answered
+    if (_is_untyped)
+    {
+        const std::uint32_t request_code = length_sz == _payload_len ? io::decode_uint32_be(payload) : 0;
+        _is_untyped = SSL_REQUEST_CODE == request_code || GSSENC_REQUEST_CODE == request_code;
+    }
+    if (!was_untyped || _inspected_codes.test(0))
+    {
+        _callback(frame{_code, payload, _payload_len});
+    }
+}
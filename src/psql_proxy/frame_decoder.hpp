@@ -0,0 +1,207 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_PSQL_FRAME_DECODER_T
+#define H_PSQL_FRAME_DECODER_T
+
+#include <io/delegate.hpp>
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief The general PostgreSQL related namespace
+namespace psql
+{
+    /// @brief The incremental PostgreSQL frontend or backend messages stream decoder.
+    /// The stream is fed in chunks of any size as it is read from the socket.
+    /// The message headers are read in place, only the header split between chunks is copied.
+    /// The payloads of the inspected message types are passed to the callback in place
+    /// when they fit the chunk and are reassembled otherwise.
+    /// The other messages are skipped by counting their bytes, so their size does not affect the memory use.
+    /// The counted message types are skipped the same way and passed to the callback without the payload.
+    /// https://www.postgresql.org/docs/current/protocol-overview.html#PROTOCOL-MESSAGE-CONCEPTS
+    class frame_decoder
+    {
+    public:
+        /// @brief The decoded message
+        struct frame
+        {
+            /// @brief The message type code, zero for the untyped startup phase messages
+            std::byte code;
+            /// @brief The message payload without the type code and the length, nullptr for the counted messages
+            const std::byte *payload;
+            /// @brief The message payload length
+            std::size_t payload_len;
+        };
+        /// @brief The inspected message callback type.
+        /// The payload is valid during the call only.
+        using callback_t = io::delegate<void(const frame &)>;
+        /// @brief The set of the message type codes to inspect
+        using codes_t = std::bitset<256>;
+        /// @brief The decoded stream direction
+        enum class stream
+        {
+            /// @brief The client messages starting with the untyped startup phase messages
+            frontend,
+            /// @brief The server messages, all of them are typed
+            backend
+        };
+
+        /// @brief The default maximum inspected payload length, the longer messages are skipped
+        static constexpr std::size_t DEFAULT_MAX_PAYLOAD_LEN = 1024 * 1024;
+
+        /// @brief Construct the decoder expecting the startup message first
+        /// @param inspected_codes The message type codes to pass to the \p callback
+        /// @param callback The inspected message callback
+        /// @param max_payload_len The maximum inspected payload length, the longer messages are skipped
+        frame_decoder(
+            const codes_t &inspected_codes,
+            callback_t callback,
+            std::size_t max_payload_len = DEFAULT_MAX_PAYLOAD_LEN);
+        /// @brief Construct the decoder of the \p direction stream
+        /// @param direction The stream direction
+        /// @param inspected_codes The message type codes to pass to the \p callback
+        /// @param counted_codes The message type codes to pass to the \p callback without the payload
+        /// @param callback The inspected and counted message callback
+        /// @param max_payload_len The maximum inspected payload length, the longer messages are skipped
+        frame_decoder(
+            stream direction,
+            const codes_t &inspected_codes,
+            const codes_t &counted_codes,
+            callback_t callback,
+            std::size_t max_payload_len = DEFAULT_MAX_PAYLOAD_LEN);
+
+        /// @brief Decode the next chunk of the stream
+        /// @param data The chunk
+        /// @param len The chunk length
+        void decode(const std::byte *data, std::size_t len);
+
+        /// @brief Check whether the stream is malformed.
+        /// The broken decoder ignores the rest of the stream.
+        /// @return true if a message length was invalid
+        bool is_broken() const
+        {
+            return _is_broken;
+        }
+        /// @brief Get the decoded messages count
+        /// @return The decoded messages count
+        std::uint64_t get_frames_count() const
+        {
+            return _frames_count;
+        }
+        /// @brief Get the inspected messages skipped for exceeding the maximum payload length
+        /// @return The inspected messages skipped for exceeding the maximum payload length
+        std::uint64_t get_oversized_count() const
+        {
+            return _oversized_count;
+        }
+        /// @brief Check whether the COPY FROM STDIN or the COPY TO STDOUT data is streamed
+        /// @return true if the CopyData message was sent and the CopyDone or CopyFail was not yet
+        bool is_copy_in() const
+        {
+            return _is_copy_in;
+        }
+        /// @brief Get the COPY FROM STDIN operations count
+        /// @return The COPY FROM STDIN operations count
+        std::uint64_t get_copy_count() const
+        {
+            return _copy_count;
+        }
+        /// @brief Get the CopyData messages count
+        /// @return The CopyData messages count
+        std::uint64_t get_copy_data_count() const
+        {
+            return _copy_data_count;
+        }
+        /// @brief Get the bytes copied to reassemble the split headers and payloads
+        /// @return The bytes copied to reassemble the split headers and payloads
+        std::uint64_t get_reassembled_bytes() const
+        {
+            return _reassembled_bytes;
+        }
+
+        /// @brief The protocol code of the untyped SSLRequest message
+        static constexpr std::uint32_t SSL_REQUEST_CODE = 80877103;
+        /// @brief The protocol code of the untyped GSSENCRequest message
+        static constexpr std::uint32_t GSSENC_REQUEST_CODE = 80877104;
+        /// @brief The CopyData message type code
+        static constexpr std::byte COPY_DATA_CODE = std::byte{'d'};
+        /// @brief The CopyDone message type code
+        static constexpr std::byte COPY_DONE_CODE = std::byte{'c'};
+        /// @brief The CopyFail message type code
+        static constexpr std::byte COPY_FAIL_CODE = std::byte{'f'};
+
+    private:
+        /// @brief Skip the CopyData messages with the headers in the chunk without the state machine
+        /// @param data The chunk, the next message header starts it
+        /// @param len The chunk length
+        /// @return The bytes skipped
+        std::size_t _skip_copy_data(const std::byte *data, std::size_t len);
+        /// @brief Start the message with the complete \p header
+        /// @param header The type code, if any, and the length
+        void _start_frame(const std::byte *header);
+        /// @brief Finish the message with the complete payload
+        /// @param payload The message payload
+        void _finish_frame(const std::byte *payload);
+
+        /// @brief The decoder state
+        enum class state
+        {
+            /// @brief Reading the message header
+            header,
+            /// @brief Reading the inspected message payload
+            payload,
+            /// @brief Skipping the message payload
+            skip
+        };
+        /// @brief The type code and the length size
+        static constexpr std::size_t MAX_HEADER_SZ = 5;
+        /// @brief The reassembled payload capacity kept after the message is finished
+        static constexpr std::size_t KEPT_PAYLOAD_CAPACITY = 64 * 1024;
+
+        /// @brief The message type codes to inspect
+        codes_t _inspected_codes;
+        /// @brief The message type codes to count
+        codes_t _counted_codes;
+        /// @brief The inspected message callback
+        callback_t _callback;
+        /// @brief The maximum inspected payload length
+        std::size_t _max_payload_len;
+        /// @brief The split header bytes
+        std::array<std::byte, MAX_HEADER_SZ> _header;
+        /// @brief The split header bytes count
+        std::size_t _header_len;
+        /// @brief The split inspected payload bytes
+        std::vector<std::byte> _payload;
+        /// @brief The current message type code
+        std::byte _code;
+        /// @brief The current message payload length
+        std::size_t _payload_len;
+        /// @brief The skipped payload bytes left
+        std::size_t _skip_len;
+        /// @brief The decoder state
+        state _state;
+        /// @brief Are the messages untyped: the startup message and the one following the SSL or GSS encryption request
+        bool _is_untyped;
+        /// @brief Is the stream malformed
+        bool _is_broken;
+        /// @brief Is the COPY data streamed
+        bool _is_copy_in;
+        /// @brief The decoded messages count
+        std::uint64_t _frames_count;
+        /// @brief The inspected messages skipped for exceeding the maximum payload length
+        std::uint64_t _oversized_count;
+        /// @brief The bytes copied to reassemble the split headers and payloads
+        std::uint64_t _reassembled_bytes;
+        /// @brief The COPY FROM STDIN operations count
+        std::uint64_t _copy_count;
+        /// @brief The CopyData messages count
+        std::uint64_t _copy_data_count;
+    };
+}
+
+#endif // H_PSQL_FRAME_DECODER_T
@@ -3,207 +3,166 @@
 /// @copyright MIT
 
 #include "handler.hpp"
-#include "endianness.hpp"
-
-#include "io/bipartite_buf.hpp"
+#include "message.hpp"
 
 #include <iostream>
-#include <iomanip>
-#include <algorithm>
-#include <iterator>
 #include <type_traits>
-
-psql_proxy::handler::handler(
-    message_logger *logger,
-    io::file_descriptor_t fd,
-    io::bus *bus)
-    : _first_msg_handled(false),
-      _message_logger(logger),
-      _fd(fd),
-      _bus(bus)
-{
-}
+#include <variant>
 
 namespace
 {
     struct PSQL_Message_Visitor
     {
         PSQL_Message_Visitor(
-            psql_proxy::message_logger *logger,
+            psql_proxy::statement_cache *statements,
+            psql_proxy::query_tracker *tracker,
             io::file_descriptor_t fd,
             io::bus *bus)
-            : _message_logger(logger),
+            : _statements(statements),
+              _tracker(tracker),
               _fd(fd),
               _bus(bus)
         {
         }
 
-        void operator()(const psql::StartupMessage &m) const
+        void operator()(const psql::StartupMessage &m)
         {
             std::cout << "protocol version " << m.protocol_version.major << '.' << m.protocol_version.minor << '\n';
+            // the startup is finished with the ReadyForQuery like the Sync
+            _tracker->on_sync();
         }
         void operator()(const psql::Query &m)
         {
             // std::cout << m.query << '\n';
-            _message_logger->add_message(m.query);
+            _tracker->on_query(m.query);
+        }
+        void operator()(const psql::Parse &m)
+        {
+            _statements->parse(m.statement, m.query);
+        }
+        void operator()(const psql::Bind &m)
+        {
+            _statements->bind(m.portal, m.statement);
+        }
+        void operator()(const psql::Execute &m)
+        {
+            std::optional<psql_proxy::statement_cache::execution> execution = _statements->execute(m.portal);
+            if (execution)
+            {
+                _tracker->on_execute(execution->statement_id, execution->query);
+            }
+            else
+            {
+                // the backend answers the unknown portal with the error to correlate still
+                _tracker->on_execute(0, std::nullopt);
+            }
+        }
+        void operator()(const psql::Sync &)
+        {
+            _tracker->on_sync();
         }
-        void operator()(const psql::Terminate &m)
+        void operator()(const psql::FunctionCall &)
+        {
+            // the function call is answered with the ReadyForQuery like the Sync
+            _tracker->on_sync();
+        }
+        void operator()(const psql::SSLRequest &)
+        {
+            _tracker->on_encryption_request();
+        }
+        void operator()(const psql::GSSENCRequest &)
+        {
+            _tracker->on_encryption_request();
+        }
+        void operator()(const psql::Close &m)
+        {
+            if (std::byte{'S'} == m.kind)
+            {
+                _statements->close_statement(m.name);
+            }
+            else
+            {
+                _statements->close_portal(m.name);
+            }
+        }
+        void operator()(const psql::Terminate &)
         {
             std::cout << "Terminate message recieved" << '\n';
             errno = 0;
             _bus->enqueue_event(_fd, io::flags::error);
         }
-        void operator()(const psql::ParameterStatus &m) const
+        template <typename T>
+        void operator()(const T &) const
         {
-            std::cout << "ParameterStatus" << '\n';
+            ; // the messages not in the inspected_codes are never decoded
         }
 
     private:
-        psql_proxy::message_logger *_message_logger;
+        psql_proxy::statement_cache *_statements;
+        psql_proxy::query_tracker *_tracker;
         io::file_descriptor_t _fd;
         io::bus *_bus;
     };
+
+    /// @brief Collect the codes of the messages the visitor handles, the rest are passed through undecoded
+    template <typename... Ts>
+    psql::frame_decoder::codes_t inspected_codes()
+    {
+        psql::frame_decoder::codes_t codes;
+        (codes.set(std::to_integer<std::size_t>(Ts::MESSAGE_CODE)), ...);
+        return codes;
+    }
 }
-// @see http://www.prog.org.ru/index.php?topic=33504.msg247481#msg247481
+
+psql_proxy::handler::handler(
+    const std::shared_ptr<query_tracker> &tracker,
+    io::file_descriptor_t fd,
+    io::bus *bus)
+    : _statements(std::make_unique<statement_cache>()),
+      _tracker(tracker),
+      _decoder(std::make_unique<psql::frame_decoder>(
+          inspected_codes<
+              psql::StartupMessage, // the encryption requests share the untyped code
+              psql::Query,
+              psql::Parse,
+              psql::Bind,
+              psql::Execute,
+              psql::Close,
+              psql::Sync,
+              psql::FunctionCall,
+              psql::Terminate>(),
+          [statements = _statements.get(), tracker = _tracker.get(), fd, bus](const psql::frame_decoder::frame &frame)
+          {
+              std::optional<psql::message> msg = psql::make_message(frame.code, frame.payload, frame.payload_len);
+              if (msg)
+              {
+                  std::visit(PSQL_Message_Visitor(statements, tracker, fd, bus), *msg);
+              }
+          })),
+      _fd(fd),
+      _broken_reported(false)
+{
+}
+
+// @see https://www.postgresql.org/docs/current/protocol-overview.html#PROTOCOL-MESSAGE-CONCEPTS
 // uint8_t type;
 // uint32_t length;
 // uint8_t payload[length - sizeof(length)];
 void psql_proxy::handler::operator()(const io::input_object::result_type &result)
 {
     auto v = io::make_visitor{
-        [](const io::error &err)
+        [](const io::error &)
         {
             ; // ignore errors
         },
         [&](const io::input_object::success_result_type &res)
         {
-            // TODO: use std::ranges library from c++20
-            // to merge these two branches and simplify code logic
-
-            // avoid copying whenever possible
-            if (_buffer.empty())
+            _decoder->decode(static_cast<const std::byte *>(res.buf), res.buf_len);
+            if (_decoder->is_broken() && !_broken_reported)
             {
-                auto *pos_orig = static_cast<const std::byte *>(res.buf);
-                auto *pos = pos_orig;
-                auto *end = std::next(pos, res.buf_len);
-                while (0ul < std::distance(pos, end))
-                {
-                    std::byte msg_code{'\0'};
-                    if (_first_msg_handled)
-                    {
-                        msg_code = *pos;
-                        pos = std::next(pos);
-                    }
-
-                    if (std::distance(pos, end) < sizeof(uint32_t))
-                    {
-                        // need to read more data to process
-                        std::cout
-                            << "need to read more data to process" << std::endl;
-                        _buffer.resize(std::distance(pos_orig, end));
-                        std::copy(pos_orig, end, _buffer.begin());
-                        break;
-                    }
-                    io::endianness endianness = psql::check_endianness_by_uint32(pos);
-                    const uint32_t payload_length_with_length = io::decode_uint32(pos, endianness);
-                    if (payload_length_with_length < sizeof(uint32_t))
-                    {
-                        std::cout
-                            << "empty payload: payload_length_with_length = " << payload_length_with_length << "; packet type: " << std::hex << (0xFF & std::to_integer<int>(msg_code)) << std::dec << '(' << std::to_integer<char>(msg_code) << ')' << std::endl;
-                        _buffer.resize(std::distance(pos_orig, end));
-                        std::copy(pos_orig, end, _buffer.begin());
-                        break;
-                    }
-                    const uint32_t payload_length = payload_length_with_length - sizeof(uint32_t);
-
-                    pos = std::next(pos, sizeof(uint32_t));
-                    if (std::distance(pos, end) < payload_length)
-                    {
-                        // need to read more data to process
-                        std::cout << "fd = " << res.fd << "; " << "not enough data to read payload: " << std::distance(pos, end) << " < " << payload_length << std::endl;
-                        _buffer.resize(std::distance(pos_orig, end));
-                        std::copy(pos_orig, end, _buffer.begin());
-                        break;
-                    }
-                    std::optional<psql::message> msg = psql::make_message(msg_code, pos, payload_length, endianness);
-                    _first_msg_handled = true;
-                    pos = std::next(pos, payload_length);
-                    pos_orig = pos;
-                    if (msg)
-                    {
-                        std::visit(PSQL_Message_Visitor(_message_logger, _fd, _bus), *msg);
-                    }
-                };
-            }
-            else
-            {
-                // this code is not used normally
-
-                const auto prev_sz = _buffer.size();
-                _buffer.resize(_buffer.size() + res.buf_len);
-                auto bytes = static_cast<const std::byte *>(res.buf);
-                std::copy(bytes, std::next(bytes, res.buf_len), std::next(_buffer.begin(), prev_sz));
-
-                bool do_continue = false;
-                do
-                {
-                    do_continue = false;
-                    const std::size_t sz = _buffer.size();
-                    if (0 == sz)
-                    {
-                        break;
-                    }
-                    auto *pos = _buffer.data();
-                    auto *end = std::next(pos, sz);
-
-                    std::byte msg_code{'\0'};
-                    if (_first_msg_handled)
-                    {
-                        msg_code = *pos;
-                        pos = std::next(pos);
-                    }
-
-                    if (std::distance(pos, end) < sizeof(uint32_t))
-                    {
-                        // need to read more data to process
-                        std::cout << "fd = " << res.fd << "; " << "not enough data to read payload length\n";
-                        break;
-                    }
-                    io::endianness endianness = psql::check_endianness_by_uint32(pos);
-                    const uint32_t payload_length_with_length = io::decode_uint32(pos, endianness);
-                    if (payload_length_with_length < sizeof(uint32_t))
-                    {
-                        std::cout
-                            << "empty payload: payload_length_with_length = " << payload_length_with_length << "; packet type: " << std::hex << (0xFF & std::to_integer<int>(msg_code)) << std::dec << '(' << std::to_integer<char>(msg_code) << ')' << std::endl;
-                        break;
-                    }
-                    const uint32_t payload_length = payload_length_with_length - sizeof(uint32_t);
-
-                    pos = std::next(pos, sizeof(uint32_t));
-                    if (std::distance(pos, end) < payload_length)
-                    {
-                        // need to read more data to process
-                        // std::cout << "fd = " << res.fd << "; " << "not enough data to read payload: " << std::distance(pos, end) << " < " << payload_length << std::endl;
-                        break;
-                    }
-                    std::optional<psql::message> msg = psql::make_message(msg_code, pos, payload_length, endianness);
-                    _first_msg_handled = true;
-                    pos = std::next(pos, payload_length);
-                    if (std::distance(pos, end) > 0)
-                    {
-                        std::vector<std::byte> new_buffer(pos, end);
-                        _buffer.swap(new_buffer);
-                        do_continue = true;
-                    }
-                    else
-                    {
-                        _buffer.clear();
-                    }
-                    if (msg)
-                    {
-                        std::visit(PSQL_Message_Visitor(_message_logger, _fd, _bus), *msg);
-                    }
-                } while (do_continue);
+                // the rest of the stream is forwarded without inspection
+                std::cerr << "fd = " << _fd << "; malformed PostgreSQL message length, inspection stopped" << std::endl;
+                _broken_reported = true;
             }
         }};
     std::visit(v, result);
@@ -5,15 +5,15 @@
 #ifndef H_PSQL_PROXY_HANDLER_T
 #define H_PSQL_PROXY_HANDLER_T
 
-#include "message.hpp"
-#include "message_logger.hpp"
+#include "frame_decoder.hpp"
+#include "query_tracker.hpp"
+#include "statement_cache.hpp"
 
 #include <io/fd.hpp>
 #include <io/object.hpp>
 #include <io/bus.hpp>
 
-#include <cstddef>
-#include <vector>
+#include <memory>
 
 /// @brief The PostgreSQL Proxy service namespace
 namespace psql_proxy
@@ -23,11 +23,11 @@ namespace psql_proxy
     {
     public:
         /// @brief Construct the \ref io::input_object::callback_t callback
-        /// @param logger The \ref message_logger object to interpret PostgreSQL messages
+        /// @param tracker The session queries tracker to log and track the client requests
         /// @param fd The file descriptor of the client connection socket to report disconnect message to
         /// @param bus The \ref io::bus object pointer to report disconnect message to
         handler(
-            message_logger *logger,
+            const std::shared_ptr<query_tracker> &tracker,
             io::file_descriptor_t fd,
             io::bus *bus);
 
@@ -36,16 +36,17 @@ namespace psql_proxy
         void operator()(const io::input_object::result_type &result);
 
     private:
-        /// @brief The temporary buffer for data processing
-        std::vector<std::byte> _buffer;
-        /// @brief True if the first message was already handled
-        bool _first_msg_handled;
-        /// @brief The \ref message_logger object to interpret PostgreSQL messages
-        message_logger *_message_logger;
-        /// @brief The file descriptor of the client connection socket to report disconnect message to
+        // the members are allocated to keep the object small enough for the io::delegate inline storage
+        /// @brief The session prepared statements to resolve the executed queries
+        std::unique_ptr<statement_cache> _statements;
+        /// @brief The session queries tracker, shared with the \ref backend_handler
+        std::shared_ptr<query_tracker> _tracker;
+        /// @brief The client messages stream decoder
+        std::unique_ptr<psql::frame_decoder> _decoder;
+        /// @brief The file descriptor of the client connection socket to report the malformed stream for
         io::file_descriptor_t _fd;
-        /// @brief The \ref io::bus object pointer to report disconnect message to
-        io::bus *_bus;
+        /// @brief True if the malformed stream was already reported
+        bool _broken_reported;
     };
 }
 
@@ -8,30 +8,56 @@
 
 #include <io/error.hpp>
 #include <io/epoll.hpp>
-#include <io/context.hpp>
+#include <io/uring.hpp>
+#include <io/context_pool.hpp>
+#include <io/resolver.hpp>
+#include <io/eventfd.hpp>
 
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 #include <signal.h>
 #include <memory>
 #include <chrono>
 #include <thread>
 #include <fstream>
+#include <vector>
 
 namespace
 {
-    /// \brief The I/O reactor pattern object
-    io::context_ptr io_context;
+    /// \brief The I/O reactor pattern objects, one per thread
+    io::context_pool_ptr io_contexts;
     void _cleanup(int signo)
     {
         std::cerr << "\nInterrupted with signal: " << signo << std::endl;
-        if (io_context)
+        if (io_contexts)
         {
-            io_context->stop();
+            io_contexts->stop();
         }
     }
 }
 
-/// @brief psql_proxy [PROXY_HOST(127.0.0.1) [PROXY_PORT(1235) [TARGET_HOST(127.0.0.1) [TARGET_PORT(5432) [QUERY_LOG_FILE_PATH(/tmp/query.log)]]]]]
+/// @brief psql_proxy [PROXY_HOST(127.0.0.1) [PROXY_PORT(1235) [TARGET_HOST(127.0.0.1) [TARGET_PORT(5432) [QUERY_LOG_FILE_PATH(/tmp/query.log) [THREADS(1) [BUS(epoll) [BUSY_POLL_USEC(0) [UPSTREAM_POOL(0) [ZEROCOPY_THRESHOLD(0) [BUFFER_POOL(0) [CLIENT_SOCKET_OPTIONS(nodelay) [BACKEND_SOCKET_OPTIONS(nodelay) [HUGE_PAGES(0) [CONNECT_TIMEOUT_SEC(10) [IDLE_TIMEOUT_SEC(0) [TRACK_QUERIES(1)]]]]]]]]]]]]]]]]]
+/// The THREADS value of 0 means one reactor thread per CPU core.
+/// The BUS value is the I/O bus implementation: epoll or uring.
+/// The BUSY_POLL_USEC value enables the reactors busy-poll mode with that maximum spin time, 0 disables it.
+/// The SO_BUSY_POLL and SO_PREFER_BUSY_POLL options of the proxied sockets are set separately
+/// with the `busy_poll=USEC` and `prefer_busy_poll` socket options, they require the CAP_NET_ADMIN capability.
+/// The UPSTREAM_POOL value is the number of the pre-connected target connections every reactor keeps ready, 0 disables it.
+/// The ZEROCOPY_THRESHOLD value is the minimum size of the proxied socket writes sent with MSG_ZEROCOPY, 0 disables it.
+/// The BUFFER_POOL value is the number of the channel buffers every reactor maps and prefaults on start.
+/// The pool grows on demand beyond that.
+/// The CLIENT_SOCKET_OPTIONS and BACKEND_SOCKET_OPTIONS values are the comma separated TCP options lists
+/// of the client and the target sides, see io::ip::tcp::parse_socket_options. The `default` keeps the system defaults.
+/// The `defer_accept` and `fastopen` listening socket options are applied on the client side only,
+/// the `fastopen_connect` option is accepted on the backend side only.
+/// The HUGE_PAGES value of 1 backs the buffer pool with the huge pages if the system has them reserved,
+/// the transparent huge pages are requested otherwise, 0 keeps the regular pages.
+/// The CONNECT_TIMEOUT_SEC value is the time for the target connection to be established, 0 disables it.
+/// The IDLE_TIMEOUT_SEC value is the time a session without I/O is closed after, 0 disables it:
+/// the client pools keep their idle connections open on purpose.
+/// The TRACK_QUERIES value of 1 correlates the backend responses with the queries to log their latency,
+/// 0 only logs the queries and splices the backend stream to the client.
 int main(int argc, char *argv[])
 {
     signal(SIGINT, _cleanup);
@@ -72,40 +98,121 @@ int main(int argc, char *argv[])
             query_log_path = argv[5];
         }
 
+        std::size_t threads_count = 1;
+        if (argc > 6)
+        {
+            threads_count = std::stoul(argv[6]);
+        }
+
+        std::string bus_type = "epoll";
+        if (argc > 7)
+        {
+            bus_type = argv[7];
+        }
+        if ("epoll" != bus_type && "uring" != bus_type)
+        {
+            throw std::invalid_argument("unknown BUS value: " + bus_type + "; epoll or uring expected");
+        }
+
+        std::chrono::microseconds busy_poll{0};
+        if (argc > 8)
+        {
+            busy_poll = std::chrono::microseconds{std::stol(argv[8])};
+        }
+        io::ip::tcp::connection_pool_options pool_options;
+        if (argc > 9)
+        {
+            pool_options.size = std::stoul(argv[9]);
+        }
+        io::ip::tcp::socket_options socket_options;
+        if (argc > 10)
+        {
+            socket_options.zerocopy_threshold = std::stoul(argv[10]);
+        }
+        std::size_t buffer_pool_size = 0;
+        if (argc > 11)
+        {
+            buffer_pool_size = std::stoul(argv[11]);
+        }
+        // the Nagle algorithm delays the small request and response messages on both proxy hops
+        const io::ip::tcp::socket_options client_socket_options = io::ip::tcp::parse_socket_options(argc > 12 ? argv[12] : "nodelay", socket_options);
+        if (client_socket_options.fast_open_connect)
+        {
+            throw std::invalid_argument("the fastopen_connect option is not applicable to the client connections");
+        }
+        const io::ip::tcp::socket_options backend_socket_options = io::ip::tcp::parse_socket_options(argc > 13 ? argv[13] : "nodelay", socket_options);
+        bool huge_pages = false;
+        if (argc > 14)
+        {
+            huge_pages = 0 != std::stoul(argv[14]);
+        }
+        // the backend connect timeout and the idle timeout to reap dead clients and half-open connections
+        io::ip::tcp::session_timeouts timeouts;
+        timeouts.connect = std::chrono::seconds{10};
+        if (argc > 15)
+        {
+            timeouts.connect = std::chrono::seconds{std::stoul(argv[15])};
+        }
+        if (argc > 16)
+        {
+            timeouts.idle = std::chrono::seconds{std::stoul(argv[16])};
+        }
+        bool track_queries = true;
+        if (argc > 17)
+        {
+            track_queries = 0 != std::stoul(argv[17]);
+        }
+
         std::cout << "host: " << host << std::endl;
         std::cout << "port: " << port << std::endl;
         std::cout << "target_host: " << target_host << std::endl;
         std::cout << "target_port: " << target_port << std::endl;
         std::cout << "query_log_path: " << query_log_path << std::endl;
+        std::cout << "bus: " << bus_type << std::endl;
+        std::cout << "busy_poll: " << busy_poll.count() << " us" << std::endl;
+        std::cout << "connect_timeout: " << timeouts.connect.count() << " ms; idle_timeout: " << timeouts.idle.count() << " ms" << std::endl;
+        std::cout << "track_queries: " << track_queries << std::endl;
 
         /// \brief The endpoint this server is listening to
         const io::ip::v4 endpoint_address(host, port);
         /// \brief The address to proxy traffic to
         const io::ip::v4 target_address(target_host, target_port);
+        // resolved once here and refreshed off the reactors to follow the DNS based failover
+        const auto target = std::make_shared<io::ip::resolver>(target_address);
         /// \brief The tcp backlog queue length
         const uint32_t tcp_backlog = 1024;
 
-        /// \brief The \ref io::bus implementation based on the GNU/Linux kernel epoll async I/O API.
-        io::bus_ptr io_bus =
-            std::make_shared<io::system::epoll>(EPOLLIN | EPOLLOUT | EPOLLPRI | EPOLLET);
+        /// \brief The I/O reactor pattern objects, one per thread.
+        /// Each one has its own \ref io::bus implementation based on the GNU/Linux kernel epoll or io_uring async I/O API.
+        io_contexts = std::make_shared<io::context_pool>(
+            threads_count,
+            [&bus_type](std::size_t) -> io::bus_ptr
+            {
+                // the output readiness is watched only while a channel has pending data
+                const int event_mask = EPOLLIN | EPOLLPRI | EPOLLET;
+                if ("uring" == bus_type)
+                {
+                    return std::make_shared<io::system::uring>(event_mask);
+                }
+                return std::make_shared<io::system::epoll>(event_mask);
+            });
+        std::cout << "threads: " << io_contexts->size() << std::endl;
 
-        /// \brief The I/O reactor pattern object
-        io_context = std::make_shared<io::context>(io_bus, std::chrono::milliseconds{10});
-
-        /// @brief The PostgreSQL messages processor object
-        psql_proxy::query_processor query_processor('\n');
-
-        /// \brief The server for the PostgreSQL Proxy service
-        psql_proxy::server tcp_server(
-            io_bus,
-            endpoint_address,
-            target_address,
-            tcp_backlog,
-            &query_processor);
+        /// @brief The PostgreSQL messages processor objects.
+        /// The processor buffer is single producer so every reactor thread gets its own one.
+        /// The log writer thread sleeps on the notifier while the processors are empty.
+        io::system::eventfd query_log_notifier;
+        std::vector<std::unique_ptr<psql_proxy::query_processor>> query_processors;
+        psql_proxy::file_writer::data_processors_vec_t data_processors;
+        for (std::size_t i = 0; i < io_contexts->size(); ++i)
+        {
+            query_processors.push_back(std::make_unique<psql_proxy::query_processor>('\n', &query_log_notifier));
+            data_processors.push_back(query_processors.back().get());
+        }
 
         /// @brief The file stream object to dump queries to.
         std::ofstream query_log_file(query_log_path, std::ios::trunc);
-        psql_proxy::file_writer sql_queries_writer(io_context, &query_processor, &query_log_file);
+        psql_proxy::file_writer sql_queries_writer(io_contexts, data_processors, &query_log_file, &query_log_notifier);
         std::thread writer_thread(sql_queries_writer);
 
         auto error_handler = [](io::event_reciever *reciever, io::error const &ex)
@@ -115,7 +222,53 @@ int main(int argc, char *argv[])
                       << "; for fd = " << ex.get_fd()
                       << std::endl;
         };
-        io_context->run(error_handler);
+        try
+        {
+            io_contexts->run(
+                [&](std::size_t index, const io::context_ptr &io_context)
+                {
+                    /// \brief The server for the PostgreSQL Proxy service.
+                    /// All the reactors listen on the same endpoint with SO_REUSEPORT
+                    /// and the kernel balances new connections between them.
+                    /// \brief The completed queries metrics of the reactor sessions
+                    psql_proxy::query_metrics query_metrics;
+                    psql_proxy::server tcp_server(
+                        io_context->get_bus(),
+                        endpoint_address,
+                        target,
+                        tcp_backlog,
+                        query_processors[index].get(),
+                        &query_metrics,
+                        timeouts,
+                        client_socket_options,
+                        backend_socket_options,
+                        pool_options,
+                        track_queries);
+                    // prefaulted on the reactor thread to be local to its NUMA node
+                    io_context->get_bus()->get_buffer_pool().reserve(buffer_pool_size, huge_pages);
+                    io_context->set_busy_poll(busy_poll);
+                    io_context->run(error_handler);
+                    std::ostringstream stats;
+                    stats << "reactor " << index << ": " << io_context->get_run_stats() << "\n";
+                    if (pool_options.size > 0)
+                    {
+                        stats << "reactor " << index << " upstream pool: " << tcp_server.get_upstream_pool_metrics() << "\n";
+                    }
+                    const io::buffer_pool &buffer_pool = io_context->get_bus()->get_buffer_pool();
+                    stats << "reactor " << index << " buffer pool: blocks " << buffer_pool.get_blocks_count() << "; free " << buffer_pool.get_free_count() << "\n";
+                    stats << "reactor " << index << " queries:\n" << query_metrics;
+                    IO_STATS((stats << "reactor " << index << " bus:\n" << io_context->get_bus()->get_stats()));
+                    std::cout << stats.str();
+                });
+        }
+        catch (...)
+        {
+            query_log_notifier.notify();
+            writer_thread.join();
+            throw;
+        }
+        // the reactors are stopped, wake the writer up to drain the processors and exit
+        query_log_notifier.notify();
         writer_thread.join();
 
         std::cout << "psql_proxy service finish" << std::endl;
@@ -4,26 +4,91 @@
 
 #include "message.hpp"
 
-std::optional<psql::message> psql::make_message(std::byte msg_code, const void *payload, const std::size_t payload_len, io::endianness endianness)
+#include <io/endianness.hpp>
+
+#include <array>
+
+namespace
 {
-    std::optional<psql::message> msg;
+    /// @brief The message decoder function type
+    using decoder_t = std::optional<psql::message> (*)(const std::byte *, std::size_t);
+
+    /// @brief Decode the \p T message
+    template <typename T>
+    std::optional<psql::message> decode(const std::byte *payload, std::size_t payload_len)
+    {
+        std::optional<T> msg = T::decode(payload, payload_len);
+        if (!msg)
+        {
+            return std::nullopt;
+        }
+        return psql::message(std::in_place_type<T>, *msg);
+    }
+
+    /// @brief Decode the untyped message by the request code or the protocol version it starts with
+    std::optional<psql::message> decode_untyped(const std::byte *payload, std::size_t payload_len)
+    {
+        if (payload_len < sizeof(std::int32_t))
+        {
+            return std::nullopt;
+        }
+        switch (static_cast<std::int32_t>(io::decode_uint32_be(payload)))
+        {
+        case psql::SSLRequest::REQUEST_CODE:
+            return decode<psql::SSLRequest>(payload, payload_len);
+        case psql::GSSENCRequest::REQUEST_CODE:
+            return decode<psql::GSSENCRequest>(payload, payload_len);
+        case psql::CancelRequest::REQUEST_CODE:
+            return decode<psql::CancelRequest>(payload, payload_len);
+        default:
+            return decode<psql::StartupMessage>(payload, payload_len);
+        }
+    }
 
-    switch (msg_code)
+    /// @brief The message code to the decoder table of the \ref psql::message alternatives
+    template <typename T>
+    struct dispatch_table;
+
+    template <typename... Ts>
+    struct dispatch_table<std::variant<Ts...>>
+    {
+        /// @brief Make the table, the untyped messages share the zero code
+        static constexpr std::array<decoder_t, 256> make()
+        {
+            std::array<decoder_t, 256> table{};
+            ((table[std::to_integer<std::size_t>(Ts::MESSAGE_CODE)] = &decode<Ts>), ...);
+            table[0] = &decode_untyped;
+            return table;
+        }
+
+        /// @brief Check that every typed message has its own code
+        static constexpr bool has_unique_codes()
+        {
+            std::array<std::size_t, 256> count{};
+            ((++count[std::to_integer<std::size_t>(Ts::MESSAGE_CODE)]), ...);
+            for (std::size_t code = 1; code < count.size(); ++code)
+            {
+                if (count[code] > 1)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    static_assert(dispatch_table<psql::message>::has_unique_codes(), "the typed messages must have the unique codes");
+
+    /// @brief The message decoders indexed by the message code
+    constexpr std::array<decoder_t, 256> decoders = dispatch_table<psql::message>::make();
+}
+
+std::optional<psql::message> psql::make_message(std::byte msg_code, const std::byte *payload, const std::size_t payload_len)
+{
+    const decoder_t decoder = decoders[std::to_integer<std::size_t>(msg_code)];
+    if (nullptr == decoder)
     {
-    case psql::StartupMessage::MESSAGE_CODE:
-        msg = make_startup_msg(payload, payload_len, endianness);
-        break;
-    case psql::ParameterStatus::MESSAGE_CODE:
-        msg = make_param_status_msg(payload, payload_len);
-        break;
-    case psql::Query::MESSAGE_CODE:
-        msg = make_query_msg(payload, payload_len);
-        break;
-    case psql::Terminate::MESSAGE_CODE:
-        msg = make_terminate_msg(payload, payload_len);
-        break;
-    default:
-        break;
+        return std::nullopt;
     }
-    return msg;
+    return decoder(payload, payload_len);
 }
@@ -5,10 +5,12 @@
 #ifndef H_PSQL_MESSAGE_T
 #define H_PSQL_MESSAGE_T
 
-#include <io/endianness.hpp>
 #include "protocol/startup_message.hpp"
-#include "protocol/parameter_status.hpp"
 #include "protocol/query.hpp"
+#include "protocol/extended_query.hpp"
+#include "protocol/copy.hpp"
+#include "protocol/password_message.hpp"
+#include "protocol/function_call.hpp"
 #include "protocol/terminate.hpp"
 
 #include <cstddef> // std::byte
@@ -19,23 +21,38 @@
 /// @brief The general PostgreSQL related namespace
 namespace psql
 {
-    /// @brief Make the PostgreSQL protocol message type
+    /// @brief The PostgreSQL frontend protocol message type.
+    /// The messages are the views into the payload they are decoded from,
+    /// the consumer copies the fields it keeps beyond the callback.
     using message = std::variant<
         StartupMessage,
-        ParameterStatus,
+        SSLRequest,
+        GSSENCRequest,
+        CancelRequest,
         Query,
+        Parse,
+        Bind,
+        Execute,
+        Describe,
+        Close,
+        Sync,
+        Flush,
+        CopyData,
+        CopyDone,
+        CopyFail,
+        PasswordMessage,
+        FunctionCall,
         Terminate>;
 
-    /// @brief Make the PostgreSQL \ref Terminate object
-    /// @param msg_code The PostgreSQL protocol message code
-    /// @param payload The raw data buffer to construct message from
-    /// @param payload_len The raw data buffer length to construct message from
-    /// @param endianness The raw data endianness
-    /// @return The \ref psql::message object if created or \ref std::nullopt
+    /// @brief Make the PostgreSQL frontend protocol message
+    /// @param msg_code The PostgreSQL protocol message code, zero for the untyped startup phase messages
+    /// @param payload The message payload the message fields refer to
+    /// @param payload_len The message payload length
+    /// @return The \ref psql::message object or \ref std::nullopt if the code is unknown or the payload is malformed
     std::optional<message> make_message(
-        std::byte msg_code, const void *payload,
-        const std::size_t payload_len,
-        io::endianness endianness);
+        std::byte msg_code,
+        const std::byte *payload,
+        const std::size_t payload_len);
 }
 
 #endif // H_PSQL_MESSAGE_T
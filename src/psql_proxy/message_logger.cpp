@@ -4,9 +4,14 @@
 
 #include "message_logger.hpp"
 
-void psql_proxy::message_logger::add_message(const std::string &message)
+void psql_proxy::message_logger::add_message(std::string_view message)
 {
-    _add_message(message);
+    _add_message(std::string_view(), message);
+}
+
+void psql_proxy::message_logger::add_message(std::string_view prefix, std::string_view message)
+{
+    _add_message(prefix, message);
 }
 
 // LCOV_EXCL_START
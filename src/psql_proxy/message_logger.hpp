@@ -5,7 +5,7 @@
 #ifndef H_PSQL_PROXY_MESSAGE_LOGGER_T
 #define H_PSQL_PROXY_MESSAGE_LOGGER_T
 
-#include <string>
+#include <string_view>
 
 /// @brief The PostgreSQL Proxy service namespace
 namespace psql_proxy
@@ -16,16 +16,21 @@ namespace psql_proxy
     public:
         /// @brief Log the \p message string
         /// @param message The message string to log
-        void add_message(const std::string &message);
+        void add_message(std::string_view message);
+        /// @brief Log the \p message string preceded by the \p prefix
+        /// @param prefix The message prefix, like the query id reference
+        /// @param message The message string to log
+        void add_message(std::string_view prefix, std::string_view message);
 
     protected:
         /// @brief Destruct the PostgreSQL message logger object
         virtual ~message_logger();
 
     private:
-        /// @brief Log the \p message string
+        /// @brief Log the \p message string preceded by the \p prefix
+        /// @param prefix The message prefix, may be empty
         /// @param message The message string to log
-        virtual void _add_message(const std::string &message) = 0;
+        virtual void _add_message(std::string_view prefix, std::string_view message) = 0;
     };
 }
 
@@ -0,0 +1,32 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "copy.hpp"
+#include "payload_reader.hpp"
+
+std::optional<psql::CopyData> psql::CopyData::decode(const std::byte *payload, std::size_t payload_len)
+{
+    psql::payload_reader reader(payload, payload_len);
+    return psql::CopyData{reader.read_rest()};
+}
+
+std::optional<psql::CopyDone> psql::CopyDone::decode(const std::byte *, std::size_t payload_len)
+{
+    if (0 != payload_len)
+    {
+        return std::nullopt;
+    }
+    return psql::CopyDone{};
+}
+
+std::optional<psql::CopyFail> psql::CopyFail::decode(const std::byte *payload, std::size_t payload_len)
+{
+    psql::payload_reader reader(payload, payload_len);
+    psql::CopyFail msg;
+    if (!reader.read_string(msg.message) || !reader.is_end())
+    {
+        return std::nullopt;
+    }
+    return msg;
+}
@@ -0,0 +1,66 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_PSQL_PROTOCOL_COPY_T
+#define H_PSQL_PROTOCOL_COPY_T
+
+#include <cstddef> // std::byte
+#include <cstdint> // std::size_t
+#include <optional>
+#include <string_view>
+
+/// @brief The general PostgreSQL related namespace
+namespace psql
+{
+    /// \brief The CopyData message to the backend.
+    /// The message carries the COPY FROM STDIN data stream chunk, the message boundaries are not required to coincide with the row boundaries.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-COPYDATA
+    struct CopyData
+    {
+        /// \brief Identifies the message as COPY data.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'d'};
+
+        /// \brief The data that forms part of the COPY data stream.
+        std::string_view data;
+
+        /// @brief Decode the Byten data
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref CopyData object
+        static std::optional<CopyData> decode(const std::byte *payload, std::size_t payload_len);
+    };
+
+    /// \brief The CopyDone message to the backend.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-COPYDONE
+    struct CopyDone
+    {
+        /// \brief Identifies the message as a COPY-complete indicator.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'c'};
+
+        /// @brief Decode the empty payload
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref CopyDone object or std::nullopt if the payload is malformed
+        static std::optional<CopyDone> decode(const std::byte *payload, std::size_t payload_len);
+    };
+
+    /// \brief The CopyFail message to the backend.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-COPYFAIL
+    struct CopyFail
+    {
+        /// \brief Identifies the message as a COPY-failure indicator.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'f'};
+
+        /// \brief An error message to report as the cause of failure.
+        std::string_view message;
+
+        /// @brief Decode the String message
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref CopyFail object or std::nullopt if the payload is malformed
+        static std::optional<CopyFail> decode(const std::byte *payload, std::size_t payload_len);
+    };
+}
+
+#endif // H_PSQL_PROTOCOL_COPY_T
@@ -0,0 +1,95 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "extended_query.hpp"
+#include "payload_reader.hpp"
+
+std::optional<psql::Parse> psql::Parse::decode(const std::byte *payload, std::size_t payload_len)
+{
+    psql::payload_reader reader(payload, payload_len);
+    psql::Parse msg;
+    if (!reader.read_string(msg.statement) ||
+        !reader.read_string(msg.query) ||
+        !reader.read_array(msg.parameter_types) ||
+        !reader.is_end())
+    {
+        return std::nullopt;
+    }
+    return msg;
+}
+
+std::optional<psql::Bind> psql::Bind::decode(const std::byte *payload, std::size_t payload_len)
+{
+    psql::payload_reader reader(payload, payload_len);
+    psql::Bind msg;
+    if (!reader.read_string(msg.portal) ||
+        !reader.read_string(msg.statement) ||
+        !reader.read_array(msg.parameter_formats) ||
+        !reader.read_values(msg.parameters) ||
+        !reader.read_array(msg.result_formats) ||
+        !reader.is_end())
+    {
+        return std::nullopt;
+    }
+    return msg;
+}
+
+std::optional<psql::Execute> psql::Execute::decode(const std::byte *payload, std::size_t payload_len)
+{
+    psql::payload_reader reader(payload, payload_len);
+    psql::Execute msg;
+    if (!reader.read_string(msg.portal) ||
+        !reader.read_int32(msg.max_rows) ||
+        !reader.is_end())
+    {
+        return std::nullopt;
+    }
+    return msg;
+}
+
+std::optional<psql::Describe> psql::Describe::decode(const std::byte *payload, std::size_t payload_len)
+{
+    psql::payload_reader reader(payload, payload_len);
+    psql::Describe msg;
+    if (!reader.read_byte(msg.kind) ||
+        (std::byte{'S'} != msg.kind && std::byte{'P'} != msg.kind) ||
+        !reader.read_string(msg.name) ||
+        !reader.is_end())
+    {
+        return std::nullopt;
+    }
+    return msg;
+}
+
+std::optional<psql::Close> psql::Close::decode(const std::byte *payload, std::size_t payload_len)
+{
+    psql::payload_reader reader(payload, payload_len);
+    psql::Close msg;
+    if (!reader.read_byte(msg.kind) ||
+        (std::byte{'S'} != msg.kind && std::byte{'P'} != msg.kind) ||
+        !reader.read_string(msg.name) ||
+        !reader.is_end())
+    {
+        return std::nullopt;
+    }
+    return msg;
+}
+
+std::optional<psql::Sync> psql::Sync::decode(const std::byte *, std::size_t payload_len)
+{
+    if (0 != payload_len)
+    {
+        return std::nullopt;
+    }
+    return psql::Sync{};
+}
+
+std::optional<psql::Flush> psql::Flush::decode(const std::byte *, std::size_t payload_len)
+{
+    if (0 != payload_len)
+    {
+        return std::nullopt;
+    }
+    return psql::Flush{};
+}
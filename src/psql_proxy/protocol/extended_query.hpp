@@ -0,0 +1,155 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_PSQL_PROTOCOL_EXTENDED_QUERY_T
+#define H_PSQL_PROTOCOL_EXTENDED_QUERY_T
+
+#include "views.hpp"
+
+#include <cstddef> // std::byte
+#include <cstdint> // std::size_t
+#include <optional>
+#include <string_view>
+
+/// @brief The general PostgreSQL related namespace
+namespace psql
+{
+    /// \brief The Parse message to the backend.
+    /// The message creates the prepared statement from the query string.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-PARSE
+    struct Parse
+    {
+        /// \brief Identifies the message as a Parse command.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'P'};
+
+        /// \brief The name of the destination prepared statement, the empty string selects the unnamed one.
+        std::string_view statement;
+        /// \brief The query string to be parsed.
+        std::string_view query;
+        /// \brief The object IDs of the parameter data types, zero leaves the type unspecified.
+        be_array_view<std::int32_t> parameter_types;
+
+        /// @brief Decode the String statement, the String query and the Int16 counted Int32 types
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref Parse object or std::nullopt if the payload is malformed
+        static std::optional<Parse> decode(const std::byte *payload, std::size_t payload_len);
+    };
+
+    /// \brief The Bind message to the backend.
+    /// The message creates the portal from the prepared statement and the parameter values.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-BIND
+    struct Bind
+    {
+        /// \brief Identifies the message as a Bind command.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'B'};
+
+        /// \brief The name of the destination portal, the empty string selects the unnamed one.
+        std::string_view portal;
+        /// \brief The name of the source prepared statement, the empty string selects the unnamed one.
+        std::string_view statement;
+        /// \brief The parameter format codes: 0 for text, 1 for binary, the single code applies to all parameters.
+        be_array_view<std::int16_t> parameter_formats;
+        /// \brief The parameter values, NULL is std::nullopt.
+        value_list_view parameters;
+        /// \brief The result column format codes, the single code applies to all columns.
+        be_array_view<std::int16_t> result_formats;
+
+        /// @brief Decode the String portal, the String statement, the Int16 counted Int16 formats,
+        /// the Int16 counted Int32 length prefixed values and the Int16 counted Int16 result formats
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref Bind object or std::nullopt if the payload is malformed
+        static std::optional<Bind> decode(const std::byte *payload, std::size_t payload_len);
+    };
+
+    /// \brief The Execute message to the backend.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-EXECUTE
+    struct Execute
+    {
+        /// \brief Identifies the message as an Execute command.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'E'};
+
+        /// \brief The name of the portal to execute, the empty string selects the unnamed one.
+        std::string_view portal;
+        /// \brief The maximum number of rows to return, zero denotes no limit.
+        std::int32_t max_rows;
+
+        /// @brief Decode the String portal and the Int32 rows limit
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref Execute object or std::nullopt if the payload is malformed
+        static std::optional<Execute> decode(const std::byte *payload, std::size_t payload_len);
+    };
+
+    /// \brief The Describe message to the backend.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-DESCRIBE
+    struct Describe
+    {
+        /// \brief Identifies the message as a Describe command.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'D'};
+
+        /// \brief 'S' to describe a prepared statement; or 'P' to describe a portal.
+        std::byte kind;
+        /// \brief The name of the prepared statement or portal to describe.
+        std::string_view name;
+
+        /// @brief Decode the Byte1 kind and the String name
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref Describe object or std::nullopt if the payload is malformed
+        static std::optional<Describe> decode(const std::byte *payload, std::size_t payload_len);
+    };
+
+    /// \brief The Close message to the backend.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-CLOSE
+    struct Close
+    {
+        /// \brief Identifies the message as a Close command.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'C'};
+
+        /// \brief 'S' to close a prepared statement; or 'P' to close a portal.
+        std::byte kind;
+        /// \brief The name of the prepared statement or portal to close.
+        std::string_view name;
+
+        /// @brief Decode the Byte1 kind and the String name
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref Close object or std::nullopt if the payload is malformed
+        static std::optional<Close> decode(const std::byte *payload, std::size_t payload_len);
+    };
+
+    /// \brief The Sync message to the backend.
+    /// The message closes the current transaction if it is not inside a BEGIN/COMMIT transaction block.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-SYNC
+    struct Sync
+    {
+        /// \brief Identifies the message as a Sync command.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'S'};
+
+        /// @brief Decode the empty payload
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref Sync object or std::nullopt if the payload is malformed
+        static std::optional<Sync> decode(const std::byte *payload, std::size_t payload_len);
+    };
+
+    /// \brief The Flush message to the backend.
+    /// The message forces the backend to deliver any data pending in its output buffers.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-FLUSH
+    struct Flush
+    {
+        /// \brief Identifies the message as a Flush command.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'H'};
+
+        /// @brief Decode the empty payload
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref Flush object or std::nullopt if the payload is malformed
+        static std::optional<Flush> decode(const std::byte *payload, std::size_t payload_len);
+    };
+}
+
+#endif // H_PSQL_PROTOCOL_EXTENDED_QUERY_T
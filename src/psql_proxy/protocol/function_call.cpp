@@ -0,0 +1,21 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "function_call.hpp"
+#include "payload_reader.hpp"
+
+std::optional<psql::FunctionCall> psql::FunctionCall::decode(const std::byte *payload, std::size_t payload_len)
+{
+    psql::payload_reader reader(payload, payload_len);
+    psql::FunctionCall msg;
+    if (!reader.read_int32(msg.function_id) ||
+        !reader.read_array(msg.argument_formats) ||
+        !reader.read_values(msg.arguments) ||
+        !reader.read_int16(msg.result_format) ||
+        !reader.is_end())
+    {
+        return std::nullopt;
+    }
+    return msg;
+}
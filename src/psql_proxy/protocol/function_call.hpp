@@ -0,0 +1,42 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_PSQL_PROTOCOL_FUNCTION_CALL_T
+#define H_PSQL_PROTOCOL_FUNCTION_CALL_T
+
+#include "views.hpp"
+
+#include <cstddef> // std::byte
+#include <cstdint> // std::size_t
+#include <optional>
+
+/// @brief The general PostgreSQL related namespace
+namespace psql
+{
+    /// \brief The FunctionCall message to the backend.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-FUNCTIONCALL
+    struct FunctionCall
+    {
+        /// \brief Identifies the message as a function call.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'F'};
+
+        /// \brief The object ID of the function to call.
+        std::int32_t function_id;
+        /// \brief The argument format codes: 0 for text, 1 for binary, the single code applies to all arguments.
+        be_array_view<std::int16_t> argument_formats;
+        /// \brief The argument values, NULL is std::nullopt.
+        value_list_view arguments;
+        /// \brief The format code for the function result.
+        std::int16_t result_format;
+
+        /// @brief Decode the Int32 function ID, the Int16 counted Int16 formats,
+        /// the Int16 counted Int32 length prefixed values and the Int16 result format
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref FunctionCall object or std::nullopt if the payload is malformed
+        static std::optional<FunctionCall> decode(const std::byte *payload, std::size_t payload_len);
+    };
+}
+
+#endif // H_PSQL_PROTOCOL_FUNCTION_CALL_T
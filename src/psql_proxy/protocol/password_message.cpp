@@ -0,0 +1,12 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "password_message.hpp"
+#include "payload_reader.hpp"
+
+std::optional<psql::PasswordMessage> psql::PasswordMessage::decode(const std::byte *payload, std::size_t payload_len)
+{
+    psql::payload_reader reader(payload, payload_len);
+    return psql::PasswordMessage{reader.read_rest()};
+}
@@ -0,0 +1,37 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_PSQL_PROTOCOL_PASSWORD_MESSAGE_T
+#define H_PSQL_PROTOCOL_PASSWORD_MESSAGE_T
+
+#include <cstddef> // std::byte
+#include <cstdint> // std::size_t
+#include <optional>
+#include <string_view>
+
+/// @brief The general PostgreSQL related namespace
+namespace psql
+{
+    /// \brief The PasswordMessage to the backend.
+    /// The same message code is used by the GSSResponse, the SASLInitialResponse and the SASLResponse,
+    /// the layout depends on the authentication request the backend sent, so the payload is kept raw.
+    /// The payload carries the credentials and must never be logged.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-PASSWORDMESSAGE
+    struct PasswordMessage
+    {
+        /// \brief Identifies the message as a password or an authentication exchange response.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'p'};
+
+        /// \brief The authentication response data.
+        std::string_view data;
+
+        /// @brief Decode the Byten data
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref PasswordMessage object
+        static std::optional<PasswordMessage> decode(const std::byte *payload, std::size_t payload_len);
+    };
+}
+
+#endif // H_PSQL_PROTOCOL_PASSWORD_MESSAGE_T
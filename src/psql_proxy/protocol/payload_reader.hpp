@@ -0,0 +1,177 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_PSQL_PROTOCOL_PAYLOAD_READER_T
+#define H_PSQL_PROTOCOL_PAYLOAD_READER_T
+
+#include "views.hpp"
+
+#include <io/endianness.hpp>
+
+#include <cstddef> // std::byte
+#include <cstdint> // std::size_t
+#include <cstring> // std::memchr
+#include <string_view>
+
+/// @brief The general PostgreSQL related namespace
+namespace psql
+{
+    /// @brief The bounds checked reader of the message payload fields.
+    /// The fields are read in the order of the message layout, the strings and the arrays
+    /// are the views into the payload. Every read fails once the payload is exhausted.
+    class payload_reader
+    {
+    public:
+        /// @brief Construct the reader of the \p payload
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        payload_reader(const std::byte *payload, std::size_t payload_len)
+            : _pos(payload),
+              _end(payload + payload_len)
+        {
+        }
+
+        /// @brief Read the Byte1 field
+        /// @param value The field value
+        /// @return true if the field is read
+        bool read_byte(std::byte &value)
+        {
+            if (_end - _pos < 1)
+            {
+                return false;
+            }
+            value = *_pos++;
+            return true;
+        }
+        /// @brief Read the Int16 field
+        /// @param value The field value
+        /// @return true if the field is read
+        bool read_int16(std::int16_t &value)
+        {
+            if (_end - _pos < 2)
+            {
+                return false;
+            }
+            value = static_cast<std::int16_t>(io::decode_uint16_be(_pos));
+            _pos += 2;
+            return true;
+        }
+        /// @brief Read the Int16 field as unsigned, like the server reads the counts up to 65535
+        /// @param value The field value
+        /// @return true if the field is read
+        bool read_uint16(std::uint16_t &value)
+        {
+            if (_end - _pos < 2)
+            {
+                return false;
+            }
+            value = io::decode_uint16_be(_pos);
+            _pos += 2;
+            return true;
+        }
+        /// @brief Read the Int32 field
+        /// @param value The field value
+        /// @return true if the field is read
+        bool read_int32(std::int32_t &value)
+        {
+            if (_end - _pos < 4)
+            {
+                return false;
+            }
+            value = static_cast<std::int32_t>(io::decode_uint32_be(_pos));
+            _pos += 4;
+            return true;
+        }
+        /// @brief Read the null terminated String field
+        /// @param value The field value without the terminator
+        /// @return true if the field is read
+        bool read_string(std::string_view &value)
+        {
+            const void *terminator = std::memchr(_pos, 0, _end - _pos);
+            if (nullptr == terminator)
+            {
+                return false;
+            }
+            const std::byte *last = static_cast<const std::byte *>(terminator);
+            value = std::string_view(reinterpret_cast<const char *>(_pos), last - _pos);
+            _pos = last + 1;
+            return true;
+        }
+        /// @brief Read the Byten field
+        /// @param len The field length
+        /// @param value The field value
+        /// @return true if the field is read
+        bool read_bytes(std::size_t len, std::string_view &value)
+        {
+            if (static_cast<std::size_t>(_end - _pos) < len)
+            {
+                return false;
+            }
+            value = std::string_view(reinterpret_cast<const char *>(_pos), len);
+            _pos += len;
+            return true;
+        }
+        /// @brief Read the Int16 counted array of the Int16 or Int32 fields
+        /// @tparam T The array item type
+        /// @param value The array view
+        /// @return true if the array is read
+        template <typename T>
+        bool read_array(be_array_view<T> &value)
+        {
+            std::uint16_t count = 0;
+            if (!read_uint16(count) || static_cast<std::size_t>(_end - _pos) < count * sizeof(T))
+            {
+                return false;
+            }
+            value = be_array_view<T>(_pos, count);
+            _pos += count * sizeof(T);
+            return true;
+        }
+        /// @brief Read the Int16 counted list of the Int32 length prefixed values, the length -1 is NULL
+        /// @param value The list view
+        /// @return true if the list is read
+        bool read_values(value_list_view &value)
+        {
+            std::uint16_t count = 0;
+            if (!read_uint16(count))
+            {
+                return false;
+            }
+            const std::byte *beg = _pos;
+            for (std::uint16_t i = 0; i < count; ++i)
+            {
+                std::int32_t len = 0;
+                std::string_view ignored;
+                if (!read_int32(len) || len < -1 || (len > 0 && !read_bytes(static_cast<std::size_t>(len), ignored)))
+                {
+                    return false;
+                }
+            }
+            value = value_list_view(beg, count);
+            return true;
+        }
+        /// @brief Read the rest of the payload
+        /// @return The rest of the payload
+        std::string_view read_rest()
+        {
+            const std::string_view rest(reinterpret_cast<const char *>(_pos), _end - _pos);
+            _pos = _end;
+            return rest;
+        }
+        /// @brief Check whether the whole payload is read
+        /// @return true if the whole payload is read
+        bool is_end() const
+        {
+            return _pos == _end;
+        }
+
+    private:
+        /// @brief The next field position
+        const std::byte *_pos;
+        /// @brief The payload end
+        const std::byte *_end;
+    };
+}
+
+#endif // H_PSQL_PROTOCOL_PAYLOAD_READER_T
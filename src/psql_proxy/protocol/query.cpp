@@ -3,18 +3,15 @@
 /// @copyright MIT
 
 #include "query.hpp"
+#include "payload_reader.hpp"
 
-#include <algorithm> // std::max
-#include <iterator>  // std::next
-
-psql::Query psql::make_query_msg(const void *payload, const std::size_t payload_len)
+std::optional<psql::Query> psql::Query::decode(const std::byte *payload, std::size_t payload_len)
 {
+    psql::payload_reader reader(payload, payload_len);
     psql::Query msg;
-
-    const char *beg = static_cast<const char *>(payload);
-    const char *end = std::next(beg, std::max(0ul, payload_len - 1));
-
-    msg.query = std::string(beg, end);
-
+    if (!reader.read_string(msg.query) || !reader.is_end())
+    {
+        return std::nullopt;
+    }
     return msg;
 }
@@ -7,7 +7,8 @@
 
 #include <cstddef> // std::byte
 #include <cstdint> // std::size_t
-#include <string>
+#include <optional>
+#include <string_view>
 
 /// @brief The general PostgreSQL related namespace
 namespace psql
@@ -21,13 +22,14 @@ namespace psql
         static constexpr std::byte MESSAGE_CODE = std::byte{'Q'};
 
         /// \brief The query string itself.
-        std::string query;
+        std::string_view query;
+
+        /// @brief Decode the String query
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref Query object or std::nullopt if the payload is malformed
+        static std::optional<Query> decode(const std::byte *payload, std::size_t payload_len);
     };
-    /// @brief Make the PostgreSQL \ref Query object
-    /// @param payload The raw data buffer to construct message from
-    /// @param payload_len The raw data buffer length to construct message from
-    /// @return The \ref Query object created
-    Query make_query_msg(const void *payload, const std::size_t payload_len);
 }
 
 #endif // H_PSQL_PROTOCOL_QUERY_T
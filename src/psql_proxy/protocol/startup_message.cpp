@@ -3,43 +3,74 @@
 /// @copyright MIT
 
 #include "startup_message.hpp"
+#include "payload_reader.hpp"
 
-#include <stdexcept>
-#include <optional>
+namespace
+{
+    /// @brief Check the untyped request payload consisting of the request code only
+    bool is_request(const std::byte *payload, std::size_t payload_len, std::int32_t request_code)
+    {
+        psql::payload_reader reader(payload, payload_len);
+        std::int32_t code = 0;
+        return reader.read_int32(code) && request_code == code && reader.is_end();
+    }
+}
 
-psql::StartupMessage psql::make_startup_msg(const void *payload, const std::size_t payload_len, io::endianness endianness)
+std::optional<psql::StartupMessage> psql::StartupMessage::decode(const std::byte *payload, std::size_t payload_len)
 {
+    psql::payload_reader reader(payload, payload_len);
     psql::StartupMessage msg;
-
-    if (payload_len < sizeof(uint32_t))
+    if (!reader.read_int16(msg.protocol_version.major) || !reader.read_int16(msg.protocol_version.minor))
     {
-        throw std::runtime_error("startup message bad length");
+        return std::nullopt;
     }
 
-    msg.protocol_version.major = io::decode_uint16(static_cast<const std::byte *>(payload), endianness);
-    msg.protocol_version.minor = io::decode_uint16(static_cast<const std::byte *>(payload) + sizeof(uint16_t), endianness);
-    const char *params_beg = static_cast<const char *>(payload) + sizeof(uint32_t);
-    const char *params_cur = params_beg;
-    const char *params_end = params_beg + payload_len;
-
-    std::optional<std::string> param_name;
-    for (; params_end != params_cur; ++params_cur)
+    const char *params_beg = reinterpret_cast<const char *>(payload) + sizeof(std::int32_t);
+    std::string_view name;
+    std::string_view value;
+    do
     {
-        if ('\0' == *params_cur)
+        if (!reader.read_string(name) || (!name.empty() && !reader.read_string(value)))
         {
-            if (!param_name)
-            {
-                param_name = std::string(params_beg, params_cur);
-            }
-            else
-            {
-                psql::configuration_parameter param{*param_name, std::string(params_beg, params_cur)};
-                msg.parameters.push_back(std::move(param));
-                param_name.reset();
-            }
-            params_beg = params_cur + 1;
+            return std::nullopt;
         }
+    } while (!name.empty());
+    // the list is closed by the empty name, nothing follows it
+    if (!reader.is_end())
+    {
+        return std::nullopt;
+    }
+    msg.parameters = psql::string_pairs_view(params_beg, name.data());
+    return msg;
+}
+
+std::optional<psql::SSLRequest> psql::SSLRequest::decode(const std::byte *payload, std::size_t payload_len)
+{
+    if (!is_request(payload, payload_len, REQUEST_CODE))
+    {
+        return std::nullopt;
     }
+    return psql::SSLRequest{};
+}
 
+std::optional<psql::GSSENCRequest> psql::GSSENCRequest::decode(const std::byte *payload, std::size_t payload_len)
+{
+    if (!is_request(payload, payload_len, REQUEST_CODE))
+    {
+        return std::nullopt;
+    }
+    return psql::GSSENCRequest{};
+}
+
+std::optional<psql::CancelRequest> psql::CancelRequest::decode(const std::byte *payload, std::size_t payload_len)
+{
+    psql::payload_reader reader(payload, payload_len);
+    psql::CancelRequest msg;
+    std::int32_t code = 0;
+    if (!reader.read_int32(code) || REQUEST_CODE != code || !reader.read_int32(msg.process_id))
+    {
+        return std::nullopt;
+    }
+    msg.secret_key = reader.read_rest();
     return msg;
 }
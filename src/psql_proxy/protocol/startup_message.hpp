@@ -5,25 +5,16 @@
 #ifndef H_PSQL_PROTOCOL_STARTUP_MESSAGE_T
 #define H_PSQL_PROTOCOL_STARTUP_MESSAGE_T
 
-#include <io/endianness.hpp>
+#include "views.hpp"
 
 #include <cstddef> // std::byte
 #include <cstdint> // std::size_t
-#include <vector>
-#include <string>
+#include <optional>
+#include <string_view>
 
 /// @brief The general PostgreSQL related namespace
 namespace psql
 {
-    /// @brief The PostgreSQL configuration parameter struct
-    struct configuration_parameter
-    {
-        /// @brief The parameter name
-        std::string name;
-        /// @brief The parameter value
-        std::string value;
-    };
-
     /// @brief The PostgreSQL \ref StartupMessage object.
     /// To begin a session, a frontend opens a connection to the server and sends a startup message.
     /// This message includes the names of the user and of the database the user wants to connect to;
@@ -35,26 +26,78 @@ namespace psql
         static constexpr std::byte MESSAGE_CODE = std::byte{'\0'};
 
         /// \brief The protocol version number.
-        union
+        struct
         {
-            int32_t _raw;
-            struct
-            {
-                /// \brief The most significant 16 bits are the major version number (3 for the protocol described here).
-                int16_t major;
-                /// \brief The least significant 16 bits are the minor version number (0 for the protocol described here).
-                int16_t minor;
-            };
+            /// \brief The most significant 16 bits are the major version number (3 for the protocol described here).
+            int16_t major;
+            /// \brief The least significant 16 bits are the minor version number (0 for the protocol described here).
+            int16_t minor;
         } protocol_version;
-        /// @brief The PostgreSQL configuration parameters
-        std::vector<configuration_parameter> parameters;
+        /// @brief The PostgreSQL configuration parameters name and value pairs
+        string_pairs_view parameters;
+
+        /// @brief Decode the Int32 version, the (String name, String value)* pairs and the closing empty name
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref StartupMessage object or std::nullopt if the payload is malformed
+        static std::optional<StartupMessage> decode(const std::byte *payload, std::size_t payload_len);
+    };
+
+    /// @brief The PostgreSQL \ref SSLRequest object.
+    /// The frontend asks for the SSL encryption before the \ref StartupMessage.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-SSLREQUEST
+    struct SSLRequest
+    {
+        /// \brief The untyped message, identified by the request code.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'\0'};
+        /// \brief The SSL request code: 1234 in the most significant 16 bits, and 5679 in the least significant 16 bits.
+        static constexpr std::int32_t REQUEST_CODE = 80877103;
+
+        /// @brief Decode the Int32 request code
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref SSLRequest object or std::nullopt if the payload is malformed
+        static std::optional<SSLRequest> decode(const std::byte *payload, std::size_t payload_len);
+    };
+
+    /// @brief The PostgreSQL \ref GSSENCRequest object.
+    /// The frontend asks for the GSSAPI encryption before the \ref StartupMessage.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-GSSENCREQUEST
+    struct GSSENCRequest
+    {
+        /// \brief The untyped message, identified by the request code.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'\0'};
+        /// \brief The GSSAPI encryption request code: 1234 in the most significant 16 bits, and 5680 in the least significant 16 bits.
+        static constexpr std::int32_t REQUEST_CODE = 80877104;
+
+        /// @brief Decode the Int32 request code
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref GSSENCRequest object or std::nullopt if the payload is malformed
+        static std::optional<GSSENCRequest> decode(const std::byte *payload, std::size_t payload_len);
+    };
+
+    /// @brief The PostgreSQL \ref CancelRequest object.
+    /// The frontend opens a new connection to cancel the query in progress in the other session.
+    /// https://www.postgresql.org/docs/current/protocol-message-formats.html#PROTOCOL-MESSAGE-FORMATS-CANCELREQUEST
+    struct CancelRequest
+    {
+        /// \brief The untyped message, identified by the request code.
+        static constexpr std::byte MESSAGE_CODE = std::byte{'\0'};
+        /// \brief The cancel request code: 1234 in the most significant 16 bits, and 5678 in the least significant 16 bits.
+        static constexpr std::int32_t REQUEST_CODE = 80877102;
+
+        /// \brief The process ID of the target backend.
+        std::int32_t process_id;
+        /// \brief The secret key for the target backend, 4 bytes long before the protocol 3.2.
+        std::string_view secret_key;
+
+        /// @brief Decode the Int32 request code, the Int32 process ID and the Byten secret key
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref CancelRequest object or std::nullopt if the payload is malformed
+        static std::optional<CancelRequest> decode(const std::byte *payload, std::size_t payload_len);
     };
-    /// @brief Make the PostgreSQL \ref StartupMessage object
-    /// @param payload The raw data buffer to construct message from
-    /// @param payload_len The raw data buffer length to construct message from
-    /// @param endianness The raw data endianness
-    /// @return The \ref StartupMessage object created
-    StartupMessage make_startup_msg(const void *payload, const std::size_t payload_len, io::endianness endianness);
 }
 
 #endif // H_PSQL_PROTOCOL_STARTUP_MESSAGE_T
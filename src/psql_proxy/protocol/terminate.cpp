@@ -4,8 +4,11 @@
 
 #include "terminate.hpp"
 
-psql::Terminate psql::make_terminate_msg(const void *payload, const std::size_t payload_len)
+std::optional<psql::Terminate> psql::Terminate::decode(const std::byte *, std::size_t payload_len)
 {
-    psql::Terminate msg;
-    return msg;
+    if (0 != payload_len)
+    {
+        return std::nullopt;
+    }
+    return psql::Terminate{};
 }
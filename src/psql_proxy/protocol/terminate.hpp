@@ -7,6 +7,7 @@
 
 #include <cstddef> // std::byte
 #include <cstdint> // std::size_t
+#include <optional>
 
 /// @brief The general PostgreSQL related namespace
 namespace psql
@@ -18,12 +19,13 @@ namespace psql
     {
         /// \brief Identifies the message as a Terminate command.
         static constexpr std::byte MESSAGE_CODE = std::byte{'X'};
+
+        /// @brief Decode the empty payload
+        /// @param payload The message payload
+        /// @param payload_len The message payload length
+        /// @return The \ref Terminate object or std::nullopt if the payload is malformed
+        static std::optional<Terminate> decode(const std::byte *payload, std::size_t payload_len);
     };
-    /// @brief Make the PostgreSQL \ref Terminate object
-    /// @param payload The raw data buffer to construct message from
-    /// @param payload_len The raw data buffer length to construct message from
-    /// @return The \ref Terminate object created
-    Terminate make_terminate_msg(const void *payload, const std::size_t payload_len);
 }
 
 #endif // H_PSQL_PROTOCOL_TERMINATE_T
@@ -0,0 +1,258 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_PSQL_PROTOCOL_VIEWS_T
+#define H_PSQL_PROTOCOL_VIEWS_T
+
+#include <io/endianness.hpp>
+
+#include <cstddef> // std::byte
+#include <cstdint> // std::size_t
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/// @brief The general PostgreSQL related namespace
+namespace psql
+{
+    /// @brief The non-owning view of the big endian Int16 or Int32 array in the message payload
+    /// @tparam T The array item type
+    template <typename T>
+    class be_array_view
+    {
+        static_assert(std::is_same_v<T, std::int16_t> || std::is_same_v<T, std::int32_t>, "the protocol arrays are of Int16 or Int32");
+
+    public:
+        /// @brief Construct the empty view
+        be_array_view() = default;
+        /// @brief Construct the view of the \p size items at \p data
+        /// @param data The first item
+        /// @param size The items count
+        be_array_view(const std::byte *data, std::size_t size)
+            : _data(data),
+              _size(size)
+        {
+        }
+
+        /// @brief Get the items count
+        /// @return The items count
+        std::size_t size() const
+        {
+            return _size;
+        }
+        /// @brief Get the item
+        /// @param i The item index
+        /// @return The item value
+        T operator[](std::size_t i) const
+        {
+            if constexpr (std::is_same_v<T, std::int16_t>)
+            {
+                return static_cast<T>(io::decode_uint16_be(_data + i * sizeof(T)));
+            }
+            else
+            {
+                return static_cast<T>(io::decode_uint32_be(_data + i * sizeof(T)));
+            }
+        }
+
+    private:
+        /// @brief The first item
+        const std::byte *_data = nullptr;
+        /// @brief The items count
+        std::size_t _size = 0;
+    };
+
+    /// @brief The non-owning view of the Int32 length prefixed values in the message payload,
+    /// like the Bind parameters. The NULL value is std::nullopt.
+    class value_list_view
+    {
+    public:
+        /// @brief The value iterator
+        class iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::optional<std::string_view>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type *;
+            using reference = value_type;
+
+            /// @brief Construct the iterator
+            /// @param pos The value length position
+            /// @param left The values left
+            iterator(const std::byte *pos, std::size_t left)
+                : _pos(pos),
+                  _left(left)
+            {
+            }
+            /// @brief Get the value
+            /// @return The value or std::nullopt for NULL
+            value_type operator*() const
+            {
+                const std::int32_t len = static_cast<std::int32_t>(io::decode_uint32_be(_pos));
+                if (len < 0)
+                {
+                    return std::nullopt;
+                }
+                return std::string_view(reinterpret_cast<const char *>(_pos + sizeof(len)), static_cast<std::size_t>(len));
+            }
+            /// @brief Move to the next value
+            /// @return The iterator
+            iterator &operator++()
+            {
+                const std::int32_t len = static_cast<std::int32_t>(io::decode_uint32_be(_pos));
+                _pos += sizeof(len) + (len > 0 ? static_cast<std::size_t>(len) : 0);
+                --_left;
+                return *this;
+            }
+            /// @brief Compare the iterators
+            /// @param other The other iterator
+            /// @return true if the iterators differ
+            bool operator!=(const iterator &other) const
+            {
+                return _left != other._left;
+            }
+
+        private:
+            /// @brief The value length position
+            const std::byte *_pos;
+            /// @brief The values left
+            std::size_t _left;
+        };
+
+        /// @brief Construct the empty view
+        value_list_view() = default;
+        /// @brief Construct the view of the validated values
+        /// @param data The first value length
+        /// @param size The values count
+        value_list_view(const std::byte *data, std::size_t size)
+            : _data(data),
+              _size(size)
+        {
+        }
+
+        /// @brief Get the values count
+        /// @return The values count
+        std::size_t size() const
+        {
+            return _size;
+        }
+        /// @brief Get the first value iterator
+        /// @return The first value iterator
+        iterator begin() const
+        {
+            return iterator(_data, _size);
+        }
+        /// @brief Get the past the last value iterator
+        /// @return The past the last value iterator
+        iterator end() const
+        {
+            return iterator(nullptr, 0);
+        }
+
+    private:
+        /// @brief The first value length
+        const std::byte *_data = nullptr;
+        /// @brief The values count
+        std::size_t _size = 0;
+    };
+
+    /// @brief The non-owning view of the null terminated name and value strings pairs
+    /// closed by the empty name, like the StartupMessage parameters
+    class string_pairs_view
+    {
+    public:
+        /// @brief The pair iterator
+        class iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = std::pair<std::string_view, std::string_view>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type *;
+            using reference = value_type;
+
+            /// @brief Construct the iterator
+            /// @param pos The pair name position
+            explicit iterator(const char *pos)
+                : _pos(pos)
+            {
+            }
+            /// @brief Get the pair
+            /// @return The name and the value
+            value_type operator*() const
+            {
+                const std::string_view name(_pos);
+                return value_type(name, std::string_view(_pos + name.size() + 1));
+            }
+            /// @brief Move to the next pair
+            /// @return The iterator
+            iterator &operator++()
+            {
+                const value_type pair = **this;
+                _pos = pair.second.data() + pair.second.size() + 1;
+                return *this;
+            }
+            /// @brief Compare the iterators
+            /// @param other The other iterator
+            /// @return true if the iterators differ
+            bool operator!=(const iterator &other) const
+            {
+                return _pos != other._pos;
+            }
+
+        private:
+            /// @brief The pair name position
+            const char *_pos;
+        };
+
+        /// @brief Construct the empty view
+        string_pairs_view() = default;
+        /// @brief Construct the view of the validated pairs
+        /// @param data The first pair name
+        /// @param end The closing empty name
+        string_pairs_view(const char *data, const char *end)
+            : _data(data),
+              _end(end)
+        {
+        }
+
+        /// @brief Get the first pair iterator
+        /// @return The first pair iterator
+        iterator begin() const
+        {
+            return iterator(_data);
+        }
+        /// @brief Get the past the last pair iterator
+        /// @return The past the last pair iterator
+        iterator end() const
+        {
+            return iterator(_end);
+        }
+        /// @brief Find the value by the name
+        /// @param name The pair name
+        /// @return The value or std::nullopt
+        std::optional<std::string_view> find(std::string_view name) const
+        {
+            for (const auto &[pair_name, value] : *this)
+            {
+                if (name == pair_name)
+                {
+                    return value;
+                }
+            }
+            return std::nullopt;
+        }
+
+    private:
+        /// @brief The first pair name
+        const char *_data = nullptr;
+        /// @brief The closing empty name
+        const char *_end = nullptr;
+    };
+}
+
+#endif // H_PSQL_PROTOCOL_VIEWS_T
@@ -4,8 +4,9 @@
 
 #include "query_processor.hpp"
 
-psql_proxy::query_processor::query_processor(char separator)
-    : _separator(separator)
+psql_proxy::query_processor::query_processor(char separator, io::system::eventfd *notifier)
+    : _separator(separator),
+      _notifier(notifier)
 {
 }
 
@@ -13,14 +14,34 @@ psql_proxy::query_processor::~query_processor() noexcept
 {
 }
 
-void psql_proxy::query_processor::_add_message(const std::string &message)
+void psql_proxy::query_processor::_add_message(std::string_view prefix, std::string_view message)
 {
-    auto pos = message.begin();
-    auto end = message.end();
+    if (!prefix.empty())
+    {
+        _write(prefix);
+    }
+    _write(message);
+
+    auto wbuf = _query_buffer.write_acquire(1);
+    if (nullptr != wbuf)
+    {
+        *wbuf = _separator;
+        _query_buffer.write_release(1);
+    }
+    if (nullptr != _notifier)
+    {
+        _notifier->notify();
+    }
+}
+
+void psql_proxy::query_processor::_write(std::string_view text)
+{
+    auto pos = text.begin();
+    auto end = text.end();
     do
     {
         auto last = end;
-        if (CHUNK_SZ < std::distance(pos, end))
+        if (CHUNK_SZ < static_cast<std::size_t>(std::distance(pos, end)))
         {
             last = std::next(pos + CHUNK_SZ);
         }
@@ -33,13 +54,6 @@ void psql_proxy::query_processor::_add_message(const std::string &message)
         }
         pos = last;
     } while (pos != end);
-
-    auto wbuf = _query_buffer.write_acquire(1);
-    if (nullptr != wbuf)
-    {
-        *wbuf = _separator;
-        _query_buffer.write_release(1);
-    }
 }
 
 std::size_t psql_proxy::query_processor::_process(const data_processor::processor_callback_t &callback)
@@ -9,9 +9,10 @@
 #include "data_processor.hpp"
 
 #include <io/bipartite_buf.hpp>
+#include <io/eventfd.hpp>
 
 #include <cstddef>
-#include <string>
+#include <string_view>
 #include <functional>
 
 /// @brief The PostgreSQL Proxy service namespace
@@ -27,22 +28,27 @@ namespace psql_proxy
     {
     public:
         /// @brief Construct the PostgreSQL messages processor object
-        /// @param query_log The file stream object to dump queries to.
         /// @param separator The separator character for messages concatenation.
-        explicit query_processor(char separator);
+        /// @param notifier The notification for the consumer thread that the messages are available.
+        explicit query_processor(char separator, io::system::eventfd *notifier = nullptr);
         ~query_processor() noexcept override;
 
     private:
-        /// @brief Log the \p message string
+        /// @brief Log the \p message string preceded by the \p prefix
+        /// @param prefix The message prefix, may be empty
         /// @param message The message string to log
         void
-        _add_message(const std::string &message) override;
+        _add_message(std::string_view prefix, std::string_view message) override;
         /// @brief Flush the output buffer to the output stream
         /// @param callback The callback function to provide actual messages processing code
         /// @return The processed messages buffer length
         std::size_t _process(const data_processor::processor_callback_t &callback) override;
 
     private:
+        /// @brief Copy the \p text to the buffer by chunks, the chunks not fitting the buffer are dropped
+        /// @param text The text to copy
+        void _write(std::string_view text);
+
         /// @brief The buffer size chunk
         static constexpr std::size_t CHUNK_SZ = 1024;
         /// @brief The buffer size
@@ -54,6 +60,8 @@ namespace psql_proxy
         query_buffer_t _query_buffer;
         /// @brief The separator character for messages concatenation.
         char _separator;
+        /// @brief The notification for the consumer thread that the messages are available.
+        io::system::eventfd *_notifier;
     };
 }
 
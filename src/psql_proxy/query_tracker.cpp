@@ -0,0 +1,335 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "query_tracker.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <ostream>
+
+namespace
+{
+    /// @brief The backend message type code and length size
+    constexpr std::size_t header_sz = 5;
+
+    /// @brief Make the set of the message type codes
+    psql::frame_decoder::codes_t make_codes(std::initializer_list<std::byte> codes)
+    {
+        psql::frame_decoder::codes_t result;
+        for (std::byte code : codes)
+        {
+            result.set(std::to_integer<std::size_t>(code));
+        }
+        return result;
+    }
+
+    /// @brief Append the \p text to the \p buf
+    char *append(char *buf, std::string_view text)
+    {
+        return std::copy(text.begin(), text.end(), buf);
+    }
+
+    /// @brief Append the \p value to the \p buf, the buffer is large enough for any value
+    char *append(char *buf, std::uint64_t value)
+    {
+        return std::to_chars(buf, buf + 20, value).ptr;
+    }
+}
+
+psql_proxy::query_tracker::query_tracker(message_logger *logger, query_metrics *metrics, std::uint64_t session_id, bool is_tracking)
+    : _logger(logger),
+      _metrics(metrics),
+      _session_id(session_id),
+      _last_query_id(0),
+      _head(0),
+      _encryption_replies(0),
+      _decoder(
+          psql::frame_decoder::stream::backend,
+          make_codes({COMMAND_COMPLETE_CODE, ERROR_RESPONSE_CODE, EMPTY_QUERY_RESPONSE_CODE, PORTAL_SUSPENDED_CODE, READY_FOR_QUERY_CODE}),
+          // the result rows are only counted, so their size does not matter
+          make_codes({DATA_ROW_CODE, ROW_DESCRIPTION_CODE}),
+          [this](const psql::frame_decoder::frame &frame)
+          {
+              _on_backend_frame(frame);
+          }),
+      _data_rows(0),
+      _tag_rows(0),
+      _bytes(0),
+      _sqlstate{},
+      _has_tag_rows(false),
+      _has_error(false),
+      _is_stopped(!is_tracking)
+{
+    _sqlstate.fill('0');
+}
+
+void psql_proxy::query_tracker::on_query(std::string_view query)
+{
+    if (_is_stopped)
+    {
+        _logger->add_message(query);
+        return;
+    }
+    _push(request_kind::query, ++_last_query_id);
+    std::array<char, 64> prefix;
+    char *end = append(prefix.data(), "/* ");
+    end = _format_ref(end, request_kind::query, _last_query_id);
+    end = append(end, " */ ");
+    _logger->add_message(std::string_view(prefix.data(), end - prefix.data()), query);
+}
+
+void psql_proxy::query_tracker::on_execute(std::uint64_t statement_id, std::optional<std::string_view> query)
+{
+    if (!_is_stopped)
+    {
+        _push(request_kind::execute, statement_id);
+    }
+    if (0 == statement_id)
+    {
+        // the backend rejects the Execute of the unknown portal
+        return;
+    }
+    // the statement ids do not depend on the backend stream, so every execution refers to its statement
+    std::array<char, 64> prefix;
+    char *end = append(prefix.data(), "/* ");
+    end = _format_ref(end, request_kind::execute, statement_id);
+    end = append(end, query ? " */ " : " */");
+    _logger->add_message(std::string_view(prefix.data(), end - prefix.data()), query.value_or(std::string_view()));
+}
+
+void psql_proxy::query_tracker::on_sync()
+{
+    if (!_is_stopped)
+    {
+        _push(request_kind::sync, 0);
+    }
+}
+
+void psql_proxy::query_tracker::on_encryption_request()
+{
+    ++_encryption_replies;
+}
+
+void psql_proxy::query_tracker::on_backend_data(const std::byte *data, std::size_t len)
+{
+    // the server answers the encryption request with the single byte before any message
+    for (; _encryption_replies > 0 && 0 != len && !_is_stopped; ++data, --len)
+    {
+        if (ERROR_RESPONSE_CODE == *data)
+        {
+            // the server not supporting the encryption may answer with the error message
+            _encryption_replies = 0;
+            break;
+        }
+        --_encryption_replies;
+        if (std::byte{'N'} != *data)
+        {
+            // the rest of the session is encrypted
+            _stop();
+        }
+    }
+    if (_is_stopped)
+    {
+        return;
+    }
+    _decoder.decode(data, len);
+    if (_decoder.is_broken())
+    {
+        _stop();
+    }
+}
+
+void psql_proxy::query_tracker::_push(request_kind kind, std::uint64_t id)
+{
+    if (get_pending_count() >= MAX_PENDING)
+    {
+        // the client does not read the results, so the memory would grow unbounded
+        _stop();
+        return;
+    }
+    if (_head > 0 && _head * 2 >= _pending.size())
+    {
+        // the pipelining client may never let the queue drain
+        _pending.erase(_pending.begin(), _pending.begin() + _head);
+        _head = 0;
+    }
+    // the Sync is never measured, so the clock is not read for it
+    _pending.push_back(pending_request{request_kind::sync == kind ? clock_type::time_point{} : clock_type::now(), id, kind});
+}
+
+void psql_proxy::query_tracker::_on_backend_frame(const psql::frame_decoder::frame &frame)
+{
+    if (_is_stopped)
+    {
+        return;
+    }
+    const bool is_pending = _head != _pending.size();
+    const bool is_execute = is_pending && request_kind::execute == _pending[_head].kind;
+    switch (std::to_integer<char>(frame.code))
+    {
+    case std::to_integer<char>(DATA_ROW_CODE):
+        ++_data_rows;
+        _bytes += header_sz + frame.payload_len;
+        break;
+    case std::to_integer<char>(ROW_DESCRIPTION_CODE):
+        _bytes += header_sz + frame.payload_len;
+        break;
+    case std::to_integer<char>(COMMAND_COMPLETE_CODE):
+    {
+        // the tag like "INSERT 0 5" or "SELECT 5" ends with the rows count, "CREATE TABLE" has none
+        std::string_view tag(reinterpret_cast<const char *>(frame.payload), frame.payload_len);
+        tag = tag.substr(0, tag.find('\0'));
+        const std::string_view count = tag.substr(tag.rfind(' ') + 1);
+        std::uint64_t rows = 0;
+        const std::from_chars_result result = std::from_chars(count.data(), count.data() + count.size(), rows);
+        if (std::errc() == result.ec && count.data() + count.size() == result.ptr)
+        {
+            _tag_rows += rows;
+            _has_tag_rows = true;
+        }
+        if (is_execute)
+        {
+            _complete();
+        }
+        break;
+    }
+    case std::to_integer<char>(EMPTY_QUERY_RESPONSE_CODE):
+    case std::to_integer<char>(PORTAL_SUSPENDED_CODE):
+        if (is_execute)
+        {
+            _complete();
+        }
+        break;
+    case std::to_integer<char>(ERROR_RESPONSE_CODE):
+    {
+        // the fields are the type code and the string pairs closed by the zero code, 'C' is the SQLSTATE
+        const char *field = reinterpret_cast<const char *>(frame.payload);
+        const char *end = field + frame.payload_len;
+        while (field < end && '\0' != *field)
+        {
+            const char *value = field + 1;
+            const char *value_end = static_cast<const char *>(std::memchr(value, '\0', end - value));
+            if (nullptr == value_end)
+            {
+                break;
+            }
+            if ('C' == *field)
+            {
+                std::memcpy(_sqlstate.data(), value, std::min<std::size_t>(_sqlstate.size(), value_end - value));
+            }
+            field = value_end + 1;
+        }
+        _has_error = true;
+        if (is_execute)
+        {
+            // the backend skips the rest of the executions up to the Sync
+            _complete();
+        }
+        break;
+    }
+    case std::to_integer<char>(READY_FOR_QUERY_CODE):
+        // the ReadyForQuery answers the oldest Query or Sync, the executions before it were skipped
+        while (_head != _pending.size())
+        {
+            const request_kind kind = _pending[_head].kind;
+            if (request_kind::query == kind)
+            {
+                _complete();
+                break;
+            }
+            _pop();
+            if (request_kind::sync == kind)
+            {
+                break;
+            }
+        }
+        if (_head == _pending.size())
+        {
+            // the ReadyForQuery of the request not seen, like the startup after the encryption refused
+            _pop();
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void psql_proxy::query_tracker::_complete()
+{
+    const pending_request &request = _pending[_head];
+    const std::uint64_t latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - request.start).count();
+    const std::uint64_t rows = _has_tag_rows ? _tag_rows : _data_rows;
+    _metrics->latency_ns.record(latency_ns);
+    _metrics->rows.record(rows);
+    _metrics->bytes.record(_bytes);
+    _metrics->errors += _has_error ? 1 : 0;
+
+    if (0 != request.id)
+    {
+        // -- 12.s3: 153 us; rows 10; bytes 530; error 42P01
+        std::array<char, 160> record;
+        char *end = append(record.data(), "-- ");
+        end = _format_ref(end, request.kind, request.id);
+        end = append(end, ": ");
+        end = append(end, latency_ns / 1000);
+        end = append(end, " us; rows ");
+        end = append(end, rows);
+        end = append(end, "; bytes ");
+        end = append(end, _bytes);
+        if (_has_error)
+        {
+            end = append(end, "; error ");
+            end = append(end, std::string_view(_sqlstate.data(), _sqlstate.size()));
+        }
+        _logger->add_message(std::string_view(record.data(), end - record.data()));
+    }
+    _pop();
+}
+
+void psql_proxy::query_tracker::_pop()
+{
+    if (_head != _pending.size())
+    {
+        ++_head;
+    }
+    if (_head == _pending.size())
+    {
+        _pending.clear();
+        _head = 0;
+    }
+    _data_rows = 0;
+    _tag_rows = 0;
+    _bytes = 0;
+    _sqlstate.fill('0');
+    _has_tag_rows = false;
+    _has_error = false;
+}
+
+void psql_proxy::query_tracker::_stop()
+{
+    if (!_is_stopped)
+    {
+        _is_stopped = true;
+        ++_metrics->untracked_sessions;
+        _pending.clear();
+        _pending.shrink_to_fit();
+        _head = 0;
+    }
+}
+
+char *psql_proxy::query_tracker::_format_ref(char *buf, request_kind kind, std::uint64_t id) const
+{
+    buf = append(buf, _session_id);
+    buf = append(buf, request_kind::query == kind ? ".q" : ".s");
+    return append(buf, id);
+}
+
+std::ostream &psql_proxy::operator<<(std::ostream &os, const query_metrics &metrics)
+{
+    return os << "latency ns: " << metrics.latency_ns << "\n"
+              << "rows: " << metrics.rows << "\n"
+              << "bytes: " << metrics.bytes << "\n"
+              << "errors: " << metrics.errors << "; untracked sessions: " << metrics.untracked_sessions << "\n";
+}
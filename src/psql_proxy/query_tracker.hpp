@@ -0,0 +1,196 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_PSQL_PROXY_QUERY_TRACKER_T
+#define H_PSQL_PROXY_QUERY_TRACKER_T
+
+#include "frame_decoder.hpp"
+#include "message_logger.hpp"
+
+#include <io/stats.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+/// @brief The PostgreSQL Proxy service namespace
+namespace psql_proxy
+{
+    /// @brief The completed queries metrics of the reactor sessions
+    struct query_metrics
+    {
+        /// @brief The time from reading the request to reading its completion, in nanoseconds
+        io::stats::histogram latency_ns;
+        /// @brief The rows returned or affected per query
+        io::stats::histogram rows;
+        /// @brief The RowDescription and DataRow bytes returned per query
+        io::stats::histogram bytes;
+        /// @brief The queries completed with the ErrorResponse
+        std::uint64_t errors = 0;
+        /// @brief The sessions the responses could not be correlated for
+        std::uint64_t untracked_sessions = 0;
+    };
+
+    /// @brief The output stream operator
+    /// to output the \p metrics value in a human readable format.
+    /// @param os The output stream object
+    /// @param metrics The metrics to output
+    /// @return The output stream object \p os
+    std::ostream &operator<<(std::ostream &os, const query_metrics &metrics);
+
+    /// @brief The session queries tracker correlating the backend responses with the client requests.
+    /// The frontend handler registers the simple queries, the executions and the Sync points in the order
+    /// the client sends them, the backend answers in the same order, so every completion
+    /// (CommandComplete, EmptyQueryResponse, PortalSuspended, ErrorResponse or ReadyForQuery)
+    /// belongs to the oldest pending request. The executions skipped by the backend after an error
+    /// are dropped at the ReadyForQuery answering the Sync.
+    /// The backend stream is decoded by the headers, only the completion messages payloads are read.
+    class query_tracker
+    {
+    public:
+        /// @brief The clock the latency is measured with
+        using clock_type = std::chrono::steady_clock;
+
+        /// @brief The pending requests limit, the tracking stops for the session exceeding it
+        static constexpr std::size_t MAX_PENDING = 4096;
+
+        /// @brief Construct the session queries tracker
+        /// @param logger The query log to write the query texts and the completed queries metrics to
+        /// @param metrics The reactor metrics to record the completed queries to
+        /// @param session_id The process unique session id the log records refer to
+        /// @param is_tracking The backend responses are correlated, only the requests are logged otherwise
+        query_tracker(message_logger *logger, query_metrics *metrics, std::uint64_t session_id, bool is_tracking = true);
+
+        /// \brief copy is prohibited, the decoder callback refers to this object
+        query_tracker(const query_tracker &) = delete; // non construction-copyable
+        /// \brief copy is prohibited
+        query_tracker &operator=(const query_tracker &) = delete; // non copyable
+
+        /// @brief Log and track the simple Query message
+        /// @param query The query text
+        void on_query(std::string_view query);
+        /// @brief Track and log the Execute message, every execution of the known statement is logged
+        /// with the statement reference, the first one with the query text
+        /// @param statement_id The executed statement id, zero if unknown
+        /// @param query The query text to log on the first execution of the statement or std::nullopt
+        void on_execute(std::uint64_t statement_id, std::optional<std::string_view> query);
+        /// @brief Track the StartupMessage, the Sync or the FunctionCall message answered with the ReadyForQuery
+        void on_sync();
+        /// @brief Track the SSLRequest or the GSSENCRequest answered with the single byte
+        void on_encryption_request();
+
+        /// @brief Decode the next chunk of the backend stream
+        /// @param data The chunk
+        /// @param len The chunk length
+        void on_backend_data(const std::byte *data, std::size_t len);
+
+        /// @brief Get the pending requests count
+        /// @return The pending requests count
+        std::size_t get_pending_count() const
+        {
+            return _pending.size() - _head;
+        }
+        /// @brief Check whether the responses are correlated
+        /// @return false if the session is encrypted, the stream is malformed or too many requests are pending
+        bool is_tracking() const
+        {
+            return !_is_stopped;
+        }
+
+        /// @brief The CommandComplete message type code
+        static constexpr std::byte COMMAND_COMPLETE_CODE = std::byte{'C'};
+        /// @brief The DataRow message type code
+        static constexpr std::byte DATA_ROW_CODE = std::byte{'D'};
+        /// @brief The ErrorResponse message type code
+        static constexpr std::byte ERROR_RESPONSE_CODE = std::byte{'E'};
+        /// @brief The EmptyQueryResponse message type code
+        static constexpr std::byte EMPTY_QUERY_RESPONSE_CODE = std::byte{'I'};
+        /// @brief The PortalSuspended message type code
+        static constexpr std::byte PORTAL_SUSPENDED_CODE = std::byte{'s'};
+        /// @brief The RowDescription message type code
+        static constexpr std::byte ROW_DESCRIPTION_CODE = std::byte{'T'};
+        /// @brief The ReadyForQuery message type code
+        static constexpr std::byte READY_FOR_QUERY_CODE = std::byte{'Z'};
+
+    private:
+        /// @brief The pending request kind
+        enum class request_kind : std::uint8_t
+        {
+            /// @brief The simple Query, completed by the ReadyForQuery
+            query,
+            /// @brief The Execute, completed by the CommandComplete, EmptyQueryResponse, PortalSuspended or ErrorResponse
+            execute,
+            /// @brief The StartupMessage, the Sync or the FunctionCall, answered by the ReadyForQuery
+            sync
+        };
+        /// @brief The pending request
+        struct pending_request
+        {
+            /// @brief The time the request was read, not set for the Sync
+            clock_type::time_point start;
+            /// @brief The query or the statement id, zero if unknown
+            std::uint64_t id;
+            /// @brief The request kind
+            request_kind kind;
+        };
+
+        /// @brief Register the request
+        /// @param kind The request kind
+        /// @param id The query or the statement id
+        void _push(request_kind kind, std::uint64_t id);
+        /// @brief Handle the backend message
+        /// @param frame The message, the payload is nullptr for the counted ones
+        void _on_backend_frame(const psql::frame_decoder::frame &frame);
+        /// @brief Record and log the oldest pending request completion, then remove it
+        void _complete();
+        /// @brief Remove the oldest pending request
+        void _pop();
+        /// @brief Stop the tracking for the rest of the session
+        void _stop();
+        /// @brief Format the query reference like 12.s3
+        /// @param buf The output buffer
+        /// @param kind The query kind
+        /// @param id The query or the statement id
+        /// @return The end of the reference in \p buf
+        char *_format_ref(char *buf, request_kind kind, std::uint64_t id) const;
+
+        /// @brief The query log
+        message_logger *_logger;
+        /// @brief The reactor metrics
+        query_metrics *_metrics;
+        /// @brief The process unique session id
+        std::uint64_t _session_id;
+        /// @brief The last simple query id
+        std::uint64_t _last_query_id;
+        /// @brief The pending requests, the ones before the \ref _head are completed
+        std::vector<pending_request> _pending;
+        /// @brief The oldest pending request index
+        std::size_t _head;
+        /// @brief The single byte answers to the encryption requests expected
+        std::size_t _encryption_replies;
+        /// @brief The backend messages stream decoder
+        psql::frame_decoder _decoder;
+        /// @brief The DataRow messages of the oldest pending request
+        std::uint64_t _data_rows;
+        /// @brief The rows reported by the CommandComplete tags of the oldest pending request
+        std::uint64_t _tag_rows;
+        /// @brief The RowDescription and DataRow bytes of the oldest pending request
+        std::uint64_t _bytes;
+        /// @brief The SQLSTATE of the oldest pending request error
+        std::array<char, 5> _sqlstate;
+        /// @brief Has the CommandComplete with the rows count completed the oldest pending request
+        bool _has_tag_rows;
+        /// @brief Has the oldest pending request failed
+        bool _has_error;
+        /// @brief Is the tracking stopped
+        bool _is_stopped;
+    };
+}
+
+#endif // H_PSQL_PROXY_QUERY_TRACKER_T
@@ -17,26 +17,57 @@ using socket_t = io::ip::tcp::socket;
 psql_proxy::server::server(
 	io::bus_ptr io_bus,
 	const io::ip::v4 &address,
-	const io::ip::v4 &target_address,
+	const io::ip::resolver_ptr &target,
 	int tcp_backlog,
-	message_logger *logger)
+	message_logger *logger,
+	query_metrics *metrics,
+	const io::ip::tcp::session_timeouts &timeouts,
+	const io::ip::tcp::socket_options &client_socket_options,
+	const io::ip::tcp::socket_options &backend_socket_options,
+	const io::ip::tcp::connection_pool_options &pool_options,
+	bool is_tracking_queries)
 	: _session_manager(
-		  std::make_shared<io::ip::tcp::acceptor>(io_bus, address, tcp_backlog),
-		  [this](io::file_descriptor_t fd, const io::ip::v4 &address) -> io::ip::tcp::session_base_ptr
+		  std::make_shared<io::ip::tcp::acceptor>(io_bus, address, tcp_backlog, nullptr, client_socket_options),
+		  [this](io::file_descriptor_t fd, const io::ip::endpoint &address) -> io::ip::tcp::session_base_ptr
 		  {
 			  return _make_new_session(fd, address);
 		  }),
-	  _target_address(target_address),
-	  _message_logger(logger)
+	  _target(target),
+	  _upstream_pool(io_bus, target, pool_options),
+	  _timeouts(timeouts),
+	  _client_socket_options(client_socket_options),
+	  _backend_socket_options(backend_socket_options),
+	  _message_logger(logger),
+	  _query_metrics(metrics),
+	  _is_tracking_queries(is_tracking_queries)
 {
 	std::cout << "[+] Listening on " << address << std::endl;
-	std::cout << "[+] Proxying to " << target_address << std::endl;
+	std::cout << "[+] Proxying to " << _target->get_address() << std::endl;
 }
 
-io::ip::tcp::session_base_ptr psql_proxy::server::_make_new_session(io::file_descriptor_t fd, const io::ip::v4 &address)
+io::ip::tcp::session_base_ptr psql_proxy::server::_make_new_session(io::file_descriptor_t fd, const io::ip::endpoint &address)
 {
 	std::cout << "[+] Got connection from: " << address << " --> fd: " << fd << "\n";
 	auto from = std::make_shared<socket_t>(_session_manager.get_acceptor()->get_bus(), fd);
-	auto to = std::make_shared<socket_t>(_session_manager.get_acceptor()->get_bus(), _target_address);
-	return std::make_shared<psql_proxy::session>(from, to, _message_logger);
+	// the warm connection skips the handshake, the cached endpoints are used on the pool miss,
+	// so the reactor never blocks on the address resolution
+	const io::file_descriptor_t upstream = _upstream_pool.acquire();
+	auto to = (-1 != upstream)
+				  ? std::make_shared<socket_t>(_session_manager.get_acceptor()->get_bus(), upstream)
+				  : std::make_shared<socket_t>(_session_manager.get_acceptor()->get_bus(), *_target->get_endpoints(), _timeouts.connect, _backend_socket_options);
+	// the sockets own their file descriptors already, so they are closed if the options fail
+	io::ip::tcp::set_socket_options(from->get_fd(), _client_socket_options);
+	if (-1 != upstream)
+	{
+		// the connecting socket applies the options to every connect attempt itself,
+		// the warm connection is established already, so its connect can not be deferred
+		io::ip::tcp::socket_options upstream_options = _backend_socket_options;
+		upstream_options.fast_open_connect = false;
+		io::ip::tcp::set_socket_options(upstream, upstream_options);
+	}
+	from->set_zerocopy_threshold(_client_socket_options.zerocopy_threshold);
+	to->set_zerocopy_threshold(_backend_socket_options.zerocopy_threshold);
+	from->set_quick_ack(_client_socket_options.quick_ack);
+	to->set_quick_ack(_backend_socket_options.quick_ack);
+	return std::make_shared<psql_proxy::session>(from, to, _message_logger, _query_metrics, _timeouts, _is_tracking_queries);
 }
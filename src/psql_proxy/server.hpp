@@ -10,10 +10,14 @@
 
 #include <io/fd.hpp>
 #include <io/v4.hpp>
+#include <io/endpoint.hpp>
+#include <io/resolver.hpp>
+#include <io/connection_pool.hpp>
 #include <io/bus.hpp>
 #include <io/acceptor.hpp>
 #include <io/bipartite_buf.hpp>
 #include <io/session_manager.hpp>
+#include <io/socket_options.hpp>
 
 #include <cstddef>
 #include <memory>
@@ -30,30 +34,61 @@ namespace psql_proxy
 		/// \brief Create the server for the TCP proxy service
 		/// \param io_bus The \ref io::bus object instance to connect to the system level I/O
 		/// \param address The \ref io::ip::v4 address like `127.0.0.1`
-		/// \param target_address The target address
+		/// \param target The target address resolver shared by the reactors
 		/// \param tcp_backlog The TCP connections backlog value for the listening socket created
 		/// \param logger The PostgreSQL messages interpreter object
+		/// \param metrics The completed queries metrics of the reactor sessions
+		/// \param timeouts The proxy sessions connect and idle timeouts
+		/// \param client_socket_options The options applied to the listening socket and the client connections
+		/// \param backend_socket_options The options applied to the target connections
+		/// \param pool_options The pre-connected target connections pool options
+		/// \param is_tracking_queries The backend responses are correlated with the queries, the backend stream is spliced otherwise
 		server(
 			io::bus_ptr io_bus,
 			const io::ip::v4 &address,
-			const io::ip::v4 &target_address,
+			const io::ip::resolver_ptr &target,
 			int tcp_backlog,
-			message_logger *logger);
+			message_logger *logger,
+			query_metrics *metrics,
+			const io::ip::tcp::session_timeouts &timeouts = io::ip::tcp::session_timeouts{},
+			const io::ip::tcp::socket_options &client_socket_options = io::ip::tcp::socket_options{},
+			const io::ip::tcp::socket_options &backend_socket_options = io::ip::tcp::socket_options{},
+			const io::ip::tcp::connection_pool_options &pool_options = io::ip::tcp::connection_pool_options{},
+			bool is_tracking_queries = true);
+
+		/// \brief Get the pre-connected target connections pool metrics
+		/// \return The pre-connected target connections pool metrics
+		const io::ip::tcp::connection_pool_metrics &get_upstream_pool_metrics() const
+		{
+			return _upstream_pool.get_metrics();
+		}
 
 	private:
 		/// \brief The function to create new \ref io::ip::tcp::session_base object for the \p fd
 		/// \param fd The new client connection file descriptor
 		/// \param address The new client connection address
 		/// \return The \ref io::ip::tcp::session_base derived object for the newly created session
-		io::ip::tcp::session_base_ptr _make_new_session(io::file_descriptor_t fd, const io::ip::v4 &address);
+		io::ip::tcp::session_base_ptr _make_new_session(io::file_descriptor_t fd, const io::ip::endpoint &address);
 
 	private:
 		/// \brief The TCP server class to manage new TCP sessions creation
 		io::ip::tcp::session_manager _session_manager;
-		/// \brief The target address
-		io::ip::v4 _target_address;
+		/// \brief The target address resolver
+		io::ip::resolver_ptr _target;
+		/// \brief The pre-connected target connections
+		io::ip::tcp::connection_pool _upstream_pool;
+		/// \brief The proxy sessions timeouts
+		io::ip::tcp::session_timeouts _timeouts;
+		/// \brief The options applied to the client connections
+		io::ip::tcp::socket_options _client_socket_options;
+		/// \brief The options applied to the target connections
+		io::ip::tcp::socket_options _backend_socket_options;
 		/// \brief The PostgreSQL messages interpreter object
 		message_logger *_message_logger;
+		/// \brief The completed queries metrics of the reactor sessions
+		query_metrics *_query_metrics;
+		/// \brief The backend responses are correlated with the queries
+		bool _is_tracking_queries;
 	};
 }
 
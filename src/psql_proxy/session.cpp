@@ -4,21 +4,43 @@
 
 #include "session.hpp"
 #include "handler.hpp"
+#include "backend_handler.hpp"
 
 #include <io/log.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <iterator>
 
+namespace
+{
+    /// @brief The sessions count of all the reactors to number the query log records
+    std::atomic<std::uint64_t> sessions_count{0};
+}
+
 psql_proxy::session::session(
     const socket_ptr_t &socket,
     const socket_ptr_t &target_socket,
-    message_logger *logger)
-    : io::ip::tcp::session_base(socket->get_bus(), io::file_descriptors_vec_t{socket->get_fd(), target_socket->get_fd()}),
+    message_logger *logger,
+    query_metrics *metrics,
+    const io::ip::tcp::session_timeouts &timeouts,
+    bool is_tracking_queries)
+    : io::ip::tcp::session_base(
+          socket->get_bus(),
+          io::file_descriptors_vec_t{socket->get_fd(), target_socket->get_fd()},
+          timeouts,
+          io::file_descriptors_vec_t{target_socket->get_fd()}),
       _socket_pipe_lr(io::make_channel(socket, target_socket)),
       _socket_pipe_rl(io::make_channel(target_socket, socket))
 {
-    _socket_pipe_lr->add_handler(handler(logger, socket->get_fd(), socket->get_bus().get()));
+    auto tracker = std::make_shared<query_tracker>(logger, metrics, sessions_count.fetch_add(1, std::memory_order_relaxed) + 1, is_tracking_queries);
+    _socket_pipe_lr->add_handler(handler(tracker, socket->get_fd(), socket->get_bus().get()));
+    if (is_tracking_queries)
+    {
+        // the backend stream is read to correlate the responses, so it is not spliced
+        _socket_pipe_rl->add_handler(backend_handler(tracker));
+    }
 }
 
 psql_proxy::session::~session()
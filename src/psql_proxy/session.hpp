@@ -6,6 +6,7 @@
 #define H_PSQL_PROXY_SESSION_T
 
 #include "message_logger.hpp"
+#include "query_tracker.hpp"
 
 #include <io/socket.hpp>
 #include <io/channel.hpp>
@@ -25,7 +26,10 @@ namespace psql_proxy
         session(
             const socket_ptr_t &socket,
             const socket_ptr_t &target_socket,
-            message_logger *logger);
+            message_logger *logger,
+            query_metrics *metrics,
+            const io::ip::tcp::session_timeouts &timeouts = io::ip::tcp::session_timeouts{},
+            bool is_tracking_queries = true);
         ~session() override;
 
     private:
@@ -0,0 +1,110 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include "statement_cache.hpp"
+
+#include <iterator>
+
+psql_proxy::statement_cache::statement_cache()
+    : _last_id(0)
+{
+}
+
+void psql_proxy::statement_cache::parse(std::string_view statement, std::string_view query)
+{
+    auto it = _statements.find(statement);
+    if (_statements.end() != it)
+    {
+        // the backend rejects the named statement defined again and keeps the old one,
+        // the drivers parse the unnamed statement again for every query
+        if (!statement.empty() || query == it->second->query)
+        {
+            return;
+        }
+        _statements.erase(it);
+    }
+    auto stmt = std::make_shared<psql_proxy::statement_cache::statement>();
+    stmt->name = statement;
+    stmt->query = query;
+    stmt->id = ++_last_id;
+    stmt->is_reported = false;
+    const std::string_view name = stmt->name;
+    _statements.emplace(name, std::move(stmt));
+}
+
+void psql_proxy::statement_cache::bind(std::string_view portal, std::string_view statement)
+{
+    auto stmt = _statements.find(statement);
+    auto it = _portals.find(portal);
+    if (_statements.end() == stmt)
+    {
+        // the backend rejects the Bind, so the portal is gone
+        if (_portals.end() != it)
+        {
+            _portals.erase(it);
+        }
+        return;
+    }
+    if (_portals.end() != it)
+    {
+        it->second->source = stmt->second;
+        return;
+    }
+    auto p = std::make_unique<psql_proxy::statement_cache::portal>();
+    p->name = portal;
+    p->source = stmt->second;
+    const std::string_view name = p->name;
+    _portals.emplace(name, std::move(p));
+}
+
+std::optional<psql_proxy::statement_cache::execution> psql_proxy::statement_cache::execute(std::string_view portal)
+{
+    auto it = _portals.find(portal);
+    if (_portals.end() == it)
+    {
+        return std::nullopt;
+    }
+    psql_proxy::statement_cache::statement &stmt = *it->second->source;
+    psql_proxy::statement_cache::execution result{stmt.id, std::nullopt};
+    if (!stmt.is_reported)
+    {
+        stmt.is_reported = true;
+        result.query = stmt.query;
+    }
+    return result;
+}
+
+void psql_proxy::statement_cache::close_statement(std::string_view statement)
+{
+    auto stmt = _statements.find(statement);
+    if (_statements.end() == stmt)
+    {
+        return;
+    }
+    // closing the statement closes the portals constructed from it
+    for (auto it = _portals.begin(); _portals.end() != it;)
+    {
+        it = it->second->source == stmt->second ? _portals.erase(it) : std::next(it);
+    }
+    _statements.erase(stmt);
+}
+
+void psql_proxy::statement_cache::close_portal(std::string_view portal)
+{
+    auto it = _portals.find(portal);
+    if (_portals.end() != it)
+    {
+        _portals.erase(it);
+    }
+}
+
+std::size_t psql_proxy::statement_cache::get_statements_count() const
+{
+    return _statements.size();
+}
+
+std::size_t psql_proxy::statement_cache::get_portals_count() const
+{
+    return _portals.size();
+}
@@ -0,0 +1,99 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#ifndef H_PSQL_PROXY_STATEMENT_CACHE_T
+#define H_PSQL_PROXY_STATEMENT_CACHE_T
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/// @brief The PostgreSQL Proxy service namespace
+namespace psql_proxy
+{
+    /// @brief The session prepared statements and portals of the extended query protocol.
+    /// The Execute message names the portal only, the portal is bound to the prepared statement
+    /// and the statement keeps the query text copied from the Parse message.
+    /// The query text is reported once per statement, the parameters stay the $n placeholders.
+    /// Every statement has the session unique id the executions refer to it by.
+    class statement_cache
+    {
+    public:
+        /// @brief The statement execution
+        struct execution
+        {
+            /// @brief The executed statement id
+            std::uint64_t statement_id;
+            /// @brief The query text on the first execution of the statement or std::nullopt
+            std::optional<std::string_view> query;
+        };
+
+        /// @brief Construct the empty cache
+        statement_cache();
+
+        /// @brief Create the prepared statement or replace the unnamed one on the Parse message.
+        /// The backend rejects the Parse of the existing named statement, so it is ignored.
+        /// The unnamed statement parsed again with the same text is kept, so it is neither copied nor reported again.
+        /// @param statement The statement name, the empty string is the unnamed statement
+        /// @param query The query text
+        void parse(std::string_view statement, std::string_view query);
+        /// @brief Create or replace the portal on the Bind message
+        /// @param portal The portal name, the empty string is the unnamed portal
+        /// @param statement The source statement name
+        void bind(std::string_view portal, std::string_view statement);
+        /// @brief Resolve the statement on the Execute message
+        /// @param portal The portal name
+        /// @return The statement execution or std::nullopt if the portal is unknown
+        std::optional<execution> execute(std::string_view portal);
+        /// @brief Destroy the prepared statement and the portals bound to it on the Close message
+        /// @param statement The statement name
+        void close_statement(std::string_view statement);
+        /// @brief Destroy the portal on the Close message
+        /// @param portal The portal name
+        void close_portal(std::string_view portal);
+
+        /// @brief Get the prepared statements count
+        /// @return The prepared statements count
+        std::size_t get_statements_count() const;
+        /// @brief Get the portals count
+        /// @return The portals count
+        std::size_t get_portals_count() const;
+
+    private:
+        /// @brief The prepared statement
+        struct statement
+        {
+            /// @brief The statement name, the map key refers to it
+            std::string name;
+            /// @brief The query text
+            std::string query;
+            /// @brief The statement id
+            std::uint64_t id;
+            /// @brief True if the query text was reported
+            bool is_reported;
+        };
+        /// @brief The portal
+        struct portal
+        {
+            /// @brief The portal name, the map key refers to it
+            std::string name;
+            /// @brief The source statement, kept alive while the statement is replaced
+            std::shared_ptr<statement> source;
+        };
+
+        // the keys are the views of the names the values own, so the lookups do not allocate
+        /// @brief The prepared statements by name
+        std::unordered_map<std::string_view, std::shared_ptr<statement>> _statements;
+        /// @brief The portals by name
+        std::unordered_map<std::string_view, std::unique_ptr<portal>> _portals;
+        /// @brief The last statement id
+        std::uint64_t _last_id;
+    };
+}
+
+#endif // H_PSQL_PROXY_STATEMENT_CACHE_T
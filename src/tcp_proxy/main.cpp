@@ -6,26 +6,48 @@
 
 #include <io/error.hpp>
 #include <io/epoll.hpp>
-#include <io/context.hpp>
+#include <io/uring.hpp>
+#include <io/context_pool.hpp>
+#include <io/resolver.hpp>
 
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 #include <signal.h>
 #include <memory>
 
 namespace
 {
-    io::context_ptr io_context;
+    io::context_pool_ptr io_contexts;
     void _cleanup(int signo)
     {
         std::cerr << "\nInterrupted with signal: " << signo << std::endl;
-        if (io_context)
+        if (io_contexts)
         {
-            io_context->stop();
+            io_contexts->stop();
         }
     }
 }
 
-/// @brief tcp_proxy [PROXY_HOST(127.0.0.1) [PROXY_PORT(1234) [TARGET_HOST(127.0.0.1) [TARGET_PORT(5432)]]]]
+/// @brief tcp_proxy [PROXY_HOST(127.0.0.1) [PROXY_PORT(1234) [TARGET_HOST(127.0.0.1) [TARGET_PORT(5432) [THREADS(1) [BUS(epoll) [BUSY_POLL_USEC(0) [UPSTREAM_POOL(0) [ZEROCOPY_THRESHOLD(0) [BUFFER_POOL(0) [CLIENT_SOCKET_OPTIONS(nodelay) [BACKEND_SOCKET_OPTIONS(nodelay) [HUGE_PAGES(0) [CONNECT_TIMEOUT_SEC(10) [IDLE_TIMEOUT_SEC(0)]]]]]]]]]]]]]]]
+/// The THREADS value of 0 means one reactor thread per CPU core.
+/// The BUS value is the I/O bus implementation: epoll or uring.
+/// The BUSY_POLL_USEC value enables the reactors busy-poll mode with that maximum spin time, 0 disables it.
+/// The SO_BUSY_POLL and SO_PREFER_BUSY_POLL options of the proxied sockets are set separately
+/// with the `busy_poll=USEC` and `prefer_busy_poll` socket options, they require the CAP_NET_ADMIN capability.
+/// The UPSTREAM_POOL value is the number of the pre-connected target connections every reactor keeps ready, 0 disables it.
+/// The ZEROCOPY_THRESHOLD value is the minimum size of the proxied socket writes sent with MSG_ZEROCOPY, 0 disables it.
+/// The BUFFER_POOL value is the number of the channel buffers every reactor maps and prefaults on start.
+/// The pool grows on demand beyond that.
+/// The CLIENT_SOCKET_OPTIONS and BACKEND_SOCKET_OPTIONS values are the comma separated TCP options lists
+/// of the client and the target sides, see io::ip::tcp::parse_socket_options. The `default` keeps the system defaults.
+/// The `defer_accept` and `fastopen` listening socket options are applied on the client side only,
+/// the `fastopen_connect` option is accepted on the backend side only.
+/// The HUGE_PAGES value of 1 backs the buffer pool with the huge pages if the system has them reserved,
+/// the transparent huge pages are requested otherwise, 0 keeps the regular pages.
+/// The CONNECT_TIMEOUT_SEC value is the time for the target connection to be established, 0 disables it.
+/// The IDLE_TIMEOUT_SEC value is the time a session without I/O is closed after, 0 disables it:
+/// the client pools keep their idle connections open on purpose.
 int main(int argc, char *argv[])
 {
     signal(SIGINT, _cleanup);
@@ -36,9 +58,6 @@ int main(int argc, char *argv[])
 
     try
     {
-        io::bus_ptr io_bus =
-            std::make_shared<io::system::epoll>(EPOLLIN | EPOLLOUT | EPOLLPRI | EPOLLET);
-
         std::string host = "127.0.0.1";
         if (argc > 1)
         {
@@ -62,15 +81,72 @@ int main(int argc, char *argv[])
         {
             target_port = argv[4];
         }
+
+        std::size_t threads_count = 1;
+        if (argc > 5)
+        {
+            threads_count = std::stoul(argv[5]);
+        }
+
+        std::string bus_type = "epoll";
+        if (argc > 6)
+        {
+            bus_type = argv[6];
+        }
+        if ("epoll" != bus_type && "uring" != bus_type)
+        {
+            throw std::invalid_argument("unknown BUS value: " + bus_type + "; epoll or uring expected");
+        }
+
+        std::chrono::microseconds busy_poll{0};
+        if (argc > 7)
+        {
+            busy_poll = std::chrono::microseconds{std::stol(argv[7])};
+        }
+        io::ip::tcp::connection_pool_options pool_options;
+        if (argc > 8)
+        {
+            pool_options.size = std::stoul(argv[8]);
+        }
+        io::ip::tcp::socket_options socket_options;
+        if (argc > 9)
+        {
+            socket_options.zerocopy_threshold = std::stoul(argv[9]);
+        }
+        std::size_t buffer_pool_size = 0;
+        if (argc > 10)
+        {
+            buffer_pool_size = std::stoul(argv[10]);
+        }
+        // the Nagle algorithm delays the small request and response messages on both proxy hops
+        const io::ip::tcp::socket_options client_socket_options = io::ip::tcp::parse_socket_options(argc > 11 ? argv[11] : "nodelay", socket_options);
+        if (client_socket_options.fast_open_connect)
+        {
+            throw std::invalid_argument("the fastopen_connect option is not applicable to the client connections");
+        }
+        const io::ip::tcp::socket_options backend_socket_options = io::ip::tcp::parse_socket_options(argc > 12 ? argv[12] : "nodelay", socket_options);
+        bool huge_pages = false;
+        if (argc > 13)
+        {
+            huge_pages = 0 != std::stoul(argv[13]);
+        }
+        // the backend connect timeout and the idle timeout to reap dead clients and half-open connections
+        io::ip::tcp::session_timeouts timeouts;
+        timeouts.connect = std::chrono::seconds{10};
+        if (argc > 14)
+        {
+            timeouts.connect = std::chrono::seconds{std::stoul(argv[14])};
+        }
+        if (argc > 15)
+        {
+            timeouts.idle = std::chrono::seconds{std::stoul(argv[15])};
+        }
+
         const io::ip::v4 endpoint_address(host, port);
         const io::ip::v4 target_address(target_host, target_port);
+        // resolved once here and refreshed off the reactors to follow the DNS based failover
+        const auto target = std::make_shared<io::ip::resolver>(target_address);
         const uint32_t tcp_backlog = 1024;
-        tcp_proxy::server tcp_server(
-            io_bus,
-            endpoint_address,
-            target_address,
-            tcp_backlog);
-
         auto error_handler = [](io::event_reciever *reciever, io::error const &ex)
         {
             std::cerr << "tcp_proxy io error: " << ex.what()
@@ -79,8 +155,46 @@ int main(int argc, char *argv[])
                       << std::endl;
         };
 
-        io_context = std::make_shared<io::context>(io_bus, std::chrono::milliseconds{10});
-        io_context->run(error_handler);
+        io_contexts = std::make_shared<io::context_pool>(
+            threads_count,
+            [&bus_type](std::size_t) -> io::bus_ptr
+            {
+                // the output readiness is watched only while a channel has pending data
+                const int event_mask = EPOLLIN | EPOLLPRI | EPOLLET;
+                if ("uring" == bus_type)
+                {
+                    return std::make_shared<io::system::uring>(event_mask);
+                }
+                return std::make_shared<io::system::epoll>(event_mask);
+            });
+        io_contexts->run(
+            [&](std::size_t index, const io::context_ptr &io_context)
+            {
+                // every reactor has its own SO_REUSEPORT acceptor
+                tcp_proxy::server tcp_server(
+                    io_context->get_bus(),
+                    endpoint_address,
+                    target,
+                    tcp_backlog,
+                    timeouts,
+                    client_socket_options,
+                backend_socket_options,
+                    pool_options);
+                // prefaulted on the reactor thread to be local to its NUMA node
+                io_context->get_bus()->get_buffer_pool().reserve(buffer_pool_size, huge_pages);
+                io_context->set_busy_poll(busy_poll);
+                io_context->run(error_handler);
+                std::ostringstream stats;
+                stats << "reactor " << index << ": " << io_context->get_run_stats() << "\n";
+                if (pool_options.size > 0)
+                {
+                    stats << "reactor " << index << " upstream pool: " << tcp_server.get_upstream_pool_metrics() << "\n";
+                }
+                const io::buffer_pool &buffer_pool = io_context->get_bus()->get_buffer_pool();
+                stats << "reactor " << index << " buffer pool: blocks " << buffer_pool.get_blocks_count() << "; free " << buffer_pool.get_free_count() << "\n";
+                IO_STATS((stats << "reactor " << index << " bus:\n" << io_context->get_bus()->get_stats()));
+                std::cout << stats.str();
+            });
 
         std::cout << "tcp_proxy service finish" << std::endl;
     }
@@ -9,8 +9,13 @@
 
 tcp_proxy::session::session(
     const socket_ptr_t &socket,
-    const socket_ptr_t &target_socket)
-    : io::ip::tcp::session_base(socket->get_bus(), io::file_descriptors_vec_t{socket->get_fd(), target_socket->get_fd()}),
+    const socket_ptr_t &target_socket,
+    const io::ip::tcp::session_timeouts &timeouts)
+    : io::ip::tcp::session_base(
+          socket->get_bus(),
+          io::file_descriptors_vec_t{socket->get_fd(), target_socket->get_fd()},
+          timeouts,
+          io::file_descriptors_vec_t{target_socket->get_fd()}),
       _socket_pipe_lr(io::make_channel(socket, target_socket)),
       _socket_pipe_rl(io::make_channel(target_socket, socket))
 {
@@ -24,9 +24,11 @@ namespace tcp_proxy
         /// \brief Create new proxy session object
         /// \param socket The client socket
         /// \param target_socket The target socket
+        /// \param timeouts The session timeouts, the connect timeout is applied to the \p target_socket
         session(
             const socket_ptr_t &socket,
-            const socket_ptr_t &target_socket);
+            const socket_ptr_t &target_socket,
+            const io::ip::tcp::session_timeouts &timeouts = io::ip::tcp::session_timeouts{});
         /// \brief Destroy the proxy session object
         ~session() override;
 
@@ -5,8 +5,17 @@
 #include <gtest/gtest.h>
 #include <io/acceptor.hpp>
 #include <io/socket.hpp>
+#include <io/epoll.hpp>
+#include <io/uring.hpp>
 #include "mock/bus_mock.hpp"
 
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 TEST(acceptor, constructor)
 {
     io::bus_ptr bus = std::make_shared<io::test::bus_mock>();
@@ -14,7 +23,7 @@ TEST(acceptor, constructor)
     io::ip::tcp::acceptor acceptor(
         bus,
         address, 1024,
-        [](io::file_descriptor_t fd, const io::ip::v4 &)
+        [](io::file_descriptor_t fd, const io::ip::endpoint &)
         {
             ;
         });
@@ -60,3 +69,113 @@ TEST(acceptor, constructor_error)
                      address, 1024}),
                  io::error);
 }
+
+TEST(acceptor, accept_batch)
+{
+    auto bus = std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
+    io::ip::v4 address{"127.0.0.1", "23456"};
+    std::vector<io::file_descriptor_t> accepted;
+    io::ip::tcp::acceptor acceptor(
+        bus,
+        address, 1024,
+        [&](io::file_descriptor_t fd, const io::ip::endpoint &peer)
+        {
+            EXPECT_EQ(peer.family(), AF_INET);
+            EXPECT_EQ(peer.host(), "127.0.0.1");
+            EXPECT_NE(peer.port(), 0);
+            // the accepted connection is ready for the async I/O already
+            EXPECT_TRUE(::fcntl(fd, F_GETFL) & O_NONBLOCK);
+            EXPECT_TRUE(::fcntl(fd, F_GETFD) & FD_CLOEXEC);
+            accepted.push_back(fd);
+        });
+    EXPECT_EQ(acceptor.get_accept_batch(), io::ip::acceptor_base::DEFAULT_ACCEPT_BATCH);
+    acceptor.set_accept_batch(2);
+
+    const io::ip::endpoint target(address);
+    std::vector<io::file_descriptor_t> clients;
+    for (int i = 0; i < 5; ++i)
+    {
+        io::file_descriptor_t client = ::socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_EQ(0, ::connect(client, target.data(), target.size()));
+        clients.push_back(client);
+    }
+
+    auto no_error = [](io::event_reciever *, const io::error &error)
+    {
+        ADD_FAILURE() << error.what() << "; errno = " << error.get_errno() << " for fd = " << error.get_fd();
+    };
+    // one edge for the whole backlog, the rest is accepted on the deferred events:
+    // the batch from the edge and the batch from its deferred event
+    bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+    EXPECT_EQ(accepted.size(), 4);
+    bus->wait_events(std::chrono::milliseconds{0}, 16, no_error);
+    EXPECT_EQ(accepted.size(), 5);
+
+    for (io::file_descriptor_t fd : accepted)
+    {
+        ::close(fd);
+    }
+    for (io::file_descriptor_t fd : clients)
+    {
+        ::close(fd);
+    }
+}
+
+TEST(acceptor, bus_accept)
+{
+    io::bus_ptr bus;
+    try
+    {
+        bus = std::make_shared<io::system::uring>(EPOLLIN | EPOLLPRI | EPOLLET, 8);
+    }
+    catch (io::error &error)
+    {
+        GTEST_SKIP() << "io_uring is not available: errno = " << error.get_errno();
+    }
+    io::ip::v4 address{"127.0.0.1", "23457"};
+    std::vector<io::file_descriptor_t> accepted;
+    io::ip::tcp::acceptor acceptor(
+        bus,
+        address, 1024,
+        [&](io::file_descriptor_t fd, const io::ip::endpoint &peer)
+        {
+            // the address comes with the accept completion
+            EXPECT_EQ(peer.family(), AF_INET);
+            EXPECT_EQ(peer.host(), "127.0.0.1");
+            EXPECT_NE(peer.port(), 0);
+            EXPECT_TRUE(::fcntl(fd, F_GETFL) & O_NONBLOCK);
+            EXPECT_TRUE(::fcntl(fd, F_GETFD) & FD_CLOEXEC);
+            accepted.push_back(fd);
+        });
+    acceptor.set_accept_batch(2);
+
+    const io::ip::endpoint target(address);
+    std::vector<io::file_descriptor_t> clients;
+    for (int i = 0; i < 5; ++i)
+    {
+        io::file_descriptor_t client = ::socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_EQ(0, ::connect(client, target.data(), target.size()));
+        clients.push_back(client);
+    }
+
+    auto no_error = [](io::event_reciever *, const io::error &error)
+    {
+        ADD_FAILURE() << error.what() << "; errno = " << error.get_errno() << " for fd = " << error.get_fd();
+    };
+    for (int i = 0; i < 10 && accepted.size() < clients.size(); ++i)
+    {
+        bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+    }
+    EXPECT_EQ(accepted.size(), clients.size());
+    EXPECT_TRUE(bus->is_accepting(acceptor.get_fd()));
+    EXPECT_EQ(bus->take_accepted(acceptor.get_fd()), -1);
+
+    for (io::file_descriptor_t fd : accepted)
+    {
+        ::close(fd);
+    }
+    for (io::file_descriptor_t fd : clients)
+    {
+        ::close(fd);
+    }
+}
@@ -0,0 +1,106 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <io/bipartite_buf.hpp>
+
+#include <cstring>
+
+namespace
+{
+    using buffer_t = io::util::bipartite_buffer<char, 8>;
+
+    /// @brief Write the \p data to the buffer regions
+    /// @return The bytes count written
+    std::size_t write_regions(buffer_t &buffer, const char *data, std::size_t len)
+    {
+        std::size_t written = 0;
+        for (const buffer_t::region_t &region : buffer.write_acquire_regions())
+        {
+            const std::size_t n = std::min(region.second, len - written);
+            std::memcpy(region.first, data + written, n);
+            written += n;
+        }
+        buffer.write_release_regions(written);
+        return written;
+    }
+
+    /// @brief Read all the buffer data from the regions
+    std::string read_regions(buffer_t &buffer, std::size_t max_len)
+    {
+        std::string data;
+        for (const buffer_t::region_t &region : buffer.read_acquire_regions())
+        {
+            data.append(region.first, std::min(region.second, max_len - data.size()));
+        }
+        buffer.read_release_regions(data.size());
+        return data;
+    }
+}
+
+TEST(bipartite_buffer, regions_empty_and_full)
+{
+    buffer_t buffer;
+    buffer_t::regions_t regions = buffer.read_acquire_regions();
+    EXPECT_EQ(regions[0].second + regions[1].second, 0);
+
+    // one element is always kept free
+    regions = buffer.write_acquire_regions();
+    EXPECT_EQ(regions[0].second, 7);
+    EXPECT_EQ(regions[1].second, 0);
+    EXPECT_EQ(write_regions(buffer, "abcdefgh", 8), 7);
+    regions = buffer.write_acquire_regions();
+    EXPECT_EQ(regions[0].second + regions[1].second, 0);
+    EXPECT_EQ(read_regions(buffer, 8), "abcdefg");
+}
+
+TEST(bipartite_buffer, regions_wrap)
+{
+    buffer_t buffer;
+    EXPECT_EQ(write_regions(buffer, "abcdef", 6), 6);
+    EXPECT_EQ(read_regions(buffer, 5), "abcde");
+
+    // the free space is split by the buffer end: 2 elements at the end and 4 at the beginning
+    buffer_t::regions_t regions = buffer.write_acquire_regions();
+    EXPECT_EQ(regions[0].second, 2);
+    EXPECT_EQ(regions[1].second, 4);
+    // the linear acquire can not find 5 elements
+    EXPECT_EQ(buffer.write_acquire(5), nullptr);
+    EXPECT_EQ(write_regions(buffer, "ghijk", 5), 5);
+
+    // the data is split by the buffer end as well
+    regions = buffer.read_acquire_regions();
+    EXPECT_EQ(regions[0].second, 3);
+    EXPECT_EQ(regions[1].second, 3);
+    EXPECT_EQ(read_regions(buffer, 4), "fghi");
+    EXPECT_EQ(read_regions(buffer, 8), "jk");
+    regions = buffer.read_acquire_regions();
+    EXPECT_EQ(regions[0].second + regions[1].second, 0);
+}
+
+TEST(bipartite_buffer, regions_after_linear_wrap)
+{
+    buffer_t buffer;
+    EXPECT_EQ(write_regions(buffer, "abcdef", 6), 6);
+    EXPECT_EQ(read_regions(buffer, 4), "abcd");
+
+    // the linear write skips the end of the buffer and invalidates it
+    char *data = buffer.write_acquire(3);
+    ASSERT_NE(data, nullptr);
+    std::memcpy(data, "xyz", 3);
+    buffer.write_release(3);
+
+    // the data until the invalidated space and the data from the beginning
+    const buffer_t::regions_t regions = buffer.read_acquire_regions();
+    EXPECT_EQ(regions[0].second, 2);
+    EXPECT_EQ(regions[1].second, 3);
+    EXPECT_EQ(read_regions(buffer, 8), "efxyz");
+
+    // the linear and the regions functions are interchangeable
+    EXPECT_EQ(write_regions(buffer, "12", 2), 2);
+    const auto [rbuf, len] = buffer.read_acquire();
+    ASSERT_EQ(len, 2);
+    EXPECT_EQ(std::string(rbuf, len), "12");
+    buffer.read_release(len);
+}
@@ -0,0 +1,65 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <io/buffer_pool.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+TEST(buffer_pool, acquire_release)
+{
+    io::buffer_pool pool(1000);
+    EXPECT_EQ(0, pool.get_block_size() % 4096);
+    EXPECT_GE(pool.get_block_size(), 1000);
+    EXPECT_EQ(0, pool.get_blocks_count());
+
+    void *block1 = pool.acquire();
+    void *block2 = pool.acquire();
+    ASSERT_NE(nullptr, block1);
+    ASSERT_NE(nullptr, block2);
+    EXPECT_NE(block1, block2);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(block1) % 4096);
+    std::memset(block1, 1, pool.get_block_size());
+    std::memset(block2, 2, pool.get_block_size());
+    EXPECT_EQ(pool.get_blocks_count() - 2, pool.get_free_count());
+
+    // the last released block is reused first
+    pool.release(block1);
+    EXPECT_EQ(block1, pool.acquire());
+    pool.release(block1);
+    pool.release(block2);
+    EXPECT_EQ(pool.get_blocks_count(), pool.get_free_count());
+}
+
+TEST(buffer_pool, grow)
+{
+    io::buffer_pool pool(4096);
+    pool.acquire();
+    const std::size_t slab_blocks = pool.get_blocks_count();
+    for (std::size_t i = 1; i < slab_blocks; ++i)
+    {
+        pool.acquire();
+    }
+    EXPECT_EQ(0, pool.get_free_count());
+    pool.acquire();
+    EXPECT_EQ(2 * slab_blocks, pool.get_blocks_count());
+    EXPECT_EQ(slab_blocks - 1, pool.get_free_count());
+}
+
+TEST(buffer_pool, reserve)
+{
+    io::buffer_pool pool;
+    pool.reserve(3);
+    EXPECT_EQ(3, pool.get_blocks_count());
+    EXPECT_EQ(3, pool.get_free_count());
+    pool.reserve(0);
+    EXPECT_EQ(3, pool.get_blocks_count());
+
+    // the huge pages fall back to the regular ones if none are reserved in the system
+    io::buffer_pool huge_pool;
+    huge_pool.reserve(1, true);
+    EXPECT_EQ(io::buffer_pool::HUGE_PAGE_SZ / huge_pool.get_block_size(), huge_pool.get_blocks_count());
+    std::memset(huge_pool.acquire(), 1, huge_pool.get_block_size());
+}
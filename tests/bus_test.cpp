@@ -9,6 +9,9 @@
 #include <memory>
 #include <stdexcept>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 TEST(bus, add_fd)
 {
     io::bus_ptr bus = std::make_shared<io::test::bus_mock>();
@@ -366,3 +369,256 @@ TEST(bus, global_unknown_exception_callback)
     EXPECT_TRUE(error_callback_called);
     EXPECT_FALSE(callback_called);
 }
+
+TEST(bus, stale_event_for_reused_fd)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    int old_callback_calls = 0;
+    bus->add_fd(
+        1,
+        [&](io::event_reciever *, io::file_descriptor_t, io::flags)
+        {
+            ++old_callback_calls;
+        });
+    const io::bus::handle_t old_handle = bus->get_handle(1);
+    bus->del_fd(1);
+
+    // the fd number is reused by a new connection
+    int new_callback_calls = 0;
+    bus->add_fd(
+        1,
+        [&](io::event_reciever *, io::file_descriptor_t fd, io::flags mask)
+        {
+            ++new_callback_calls;
+            EXPECT_EQ(fd, 1);
+            EXPECT_TRUE(mask.test(io::flags::in));
+        });
+    const io::bus::handle_t new_handle = bus->get_handle(1);
+    EXPECT_NE(old_handle, new_handle);
+
+    bus->push_native_event(old_handle, io::flags::in);
+    bus->push_native_event(new_handle, io::flags::in);
+
+    bool error_callback_called = false;
+    bus->wait_events(
+        std::chrono::milliseconds{0},
+        1,
+        [&](io::event_reciever *, const io::error &)
+        {
+            error_callback_called = true;
+        });
+    EXPECT_FALSE(error_callback_called);
+    EXPECT_EQ(old_callback_calls, 0);
+    EXPECT_EQ(new_callback_calls, 1);
+}
+
+TEST(bus, del_fd_callbacks_from_callback)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    int first_calls = 0;
+    int second_calls = 0;
+    auto counter = std::make_shared<int>(0);
+    bus->add_fd(
+        1,
+        [&, counter](io::event_reciever *, io::file_descriptor_t fd, io::flags)
+        {
+            ++first_calls;
+            bus->del_fd_callbacks(fd);
+            // the executing callback is still alive
+            EXPECT_EQ(*counter, 0);
+        });
+    bus->add_fd(
+        1,
+        [&](io::event_reciever *, io::file_descriptor_t, io::flags)
+        {
+            ++second_calls;
+        });
+    bus->enqueue_event(1, io::flags::in);
+    bus->wait_events(
+        std::chrono::milliseconds{0},
+        1,
+        [&](io::event_reciever *, const io::error &) {});
+    EXPECT_EQ(first_calls, 1);
+    EXPECT_EQ(second_calls, 0);
+    // the released callback is destroyed after the dispatch
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(bus, large_fd)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    const io::file_descriptor_t fd = 100000;
+    bool callback_called = false;
+    bus->add_fd(
+        fd,
+        [&](io::event_reciever *, io::file_descriptor_t event_fd, io::flags)
+        {
+            callback_called = true;
+            EXPECT_EQ(event_fd, fd);
+        });
+    bus->enqueue_event(fd, io::flags::in);
+    bus->wait_events(
+        std::chrono::milliseconds{0},
+        1,
+        [&](io::event_reciever *, const io::error &) {});
+    EXPECT_TRUE(callback_called);
+}
+
+TEST(bus, output_interest)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    EXPECT_THROW(bus->add_output_interest(1), io::error);
+    // the interest of not registered file descriptor is ignored
+    bus->del_output_interest(1);
+    bus->del_output_interest(100000);
+
+    bus->add_fd(1);
+    EXPECT_FALSE(bus->has_output_interest(1));
+    bus->add_output_interest(1);
+    bus->add_output_interest(1);
+    EXPECT_TRUE(bus->has_output_interest(1));
+    bus->del_output_interest(1);
+    EXPECT_TRUE(bus->has_output_interest(1));
+    bus->del_output_interest(1);
+    EXPECT_FALSE(bus->has_output_interest(1));
+    bus->del_output_interest(1);
+    EXPECT_FALSE(bus->has_output_interest(1));
+
+    // the interest is dropped with the registration
+    bus->add_output_interest(1);
+    bus->del_fd_callbacks(1);
+    bus->add_fd(1);
+    EXPECT_FALSE(bus->has_output_interest(1));
+    bus->add_output_interest(1);
+    EXPECT_TRUE(bus->has_output_interest(1));
+}
+
+TEST(bus, data_io)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    EXPECT_THROW(bus->receive_data(1), io::error);
+    EXPECT_THROW(bus->send_data(1), io::error);
+
+    // the caller reads and writes the file descriptor by default
+    bus->add_fd(1);
+    bus->receive_data(1);
+    bus->send_data(1);
+    EXPECT_FALSE(bus->is_receiving(1));
+    EXPECT_FALSE(bus->is_sending(1));
+    char buf[4];
+    const struct iovec iov = {buf, sizeof(buf)};
+    EXPECT_EQ(bus->take_received(1, &iov, 1), -1);
+    EXPECT_EQ(errno, EOPNOTSUPP);
+    EXPECT_EQ(bus->queue_send(1, &iov, 1), -1);
+    EXPECT_EQ(errno, EOPNOTSUPP);
+    EXPECT_EQ(bus->get_unsent_bytes(1), 0);
+}
+
+TEST(bus, wait_events_count)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    bus->add_fd(1, [](io::event_reciever *, io::file_descriptor_t, io::flags) {});
+    bus->add_fd(2);
+    EXPECT_EQ(bus->wait_events(std::chrono::milliseconds{0}, 1), 0u);
+
+    bus->enqueue_event(1, io::flags::in);
+    bus->enqueue_event(2, io::flags::in);
+    bus->push_native_event(bus->get_handle(1), io::flags::in);
+    EXPECT_EQ(bus->wait_events(std::chrono::milliseconds{0}, 1), 3u);
+
+    // the stale events are not counted
+    bus->enqueue_event(1, io::flags::in);
+    bus->del_fd(1);
+    EXPECT_EQ(bus->wait_events(std::chrono::milliseconds{0}, 1), 0u);
+}
+
+TEST(bus, replace_fd)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    int new_fds[2];
+    ASSERT_EQ(::pipe(new_fds), 0);
+
+    int callback_calls = 0;
+    bus->add_fd(
+        fds[0],
+        [&](io::event_reciever *, io::file_descriptor_t fd, io::flags mask)
+        {
+            ++callback_calls;
+            EXPECT_EQ(fd, fds[0]);
+        });
+    bus->add_output_interest(fds[0]);
+    const io::bus::handle_t old_handle = bus->get_handle(fds[0]);
+
+    bus->replace_fd(fds[0], new_fds[0]);
+    // the new file is moved to the old descriptor value, the callbacks and the output interest are kept
+    EXPECT_EQ(::fcntl(new_fds[0], F_GETFD), -1);
+    EXPECT_NE(old_handle, bus->get_handle(fds[0]));
+    EXPECT_TRUE(bus->has_output_interest(fds[0]));
+    ASSERT_EQ(::write(new_fds[1], "x", 1), 1);
+    char c = 0;
+    EXPECT_EQ(::read(fds[0], &c, 1), 1);
+    EXPECT_EQ(c, 'x');
+
+    bus->push_native_event(old_handle, io::flags::in);
+    bus->push_native_event(bus->get_handle(fds[0]), io::flags::in);
+    bus->wait_events(
+        std::chrono::milliseconds{0},
+        2,
+        [&](io::event_reciever *, const io::error &) {});
+    EXPECT_EQ(callback_calls, 1);
+
+    bus->del_fd(fds[0]);
+    ::close(fds[0]);
+    ::close(fds[1]);
+    ::close(new_fds[1]);
+}
+
+TEST(bus, event_filter)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    io::flags last_mask;
+    int callback_calls = 0;
+    bus->add_fd(
+        1,
+        [&](io::event_reciever *, io::file_descriptor_t, io::flags mask)
+        {
+            ++callback_calls;
+            last_mask = mask;
+        });
+    bus->set_event_filter(
+        1,
+        [](io::file_descriptor_t, io::flags mask)
+        {
+            // the error is reported as the output readiness, the input is dropped
+            return mask.test(io::flags::error) ? io::flags::out : io::flags::empty;
+        });
+
+    bus->push_native_event(bus->get_handle(1), io::flags::error);
+    bus->push_native_event(bus->get_handle(1), io::flags::in);
+    bus->wait_events(
+        std::chrono::milliseconds{0},
+        2,
+        [&](io::event_reciever *, const io::error &) {});
+    EXPECT_EQ(callback_calls, 1);
+    EXPECT_TRUE(last_mask.test(io::flags::out));
+    EXPECT_FALSE(last_mask.test(io::flags::error));
+
+    // the filter is removed with the callbacks
+    bus->del_fd(1);
+    bus->add_fd(
+        1,
+        [&](io::event_reciever *, io::file_descriptor_t, io::flags mask)
+        {
+            ++callback_calls;
+            last_mask = mask;
+        });
+    bus->push_native_event(bus->get_handle(1), io::flags::in);
+    bus->wait_events(
+        std::chrono::milliseconds{0},
+        1,
+        [&](io::event_reciever *, const io::error &) {});
+    EXPECT_EQ(callback_calls, 2);
+    EXPECT_TRUE(last_mask.test(io::flags::in));
+}
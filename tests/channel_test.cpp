@@ -6,7 +6,21 @@
 #include "mock/object_mock.hpp"
 #include "mock/bus_mock.hpp"
 #include <io/channel.hpp>
+#include <io/epoll.hpp>
+#include <io/socket.hpp>
+#include <io/uring.hpp>
+
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 TEST(channel, getters)
 {
@@ -228,3 +242,347 @@ TEST(channel, check_data)
     EXPECT_EQ(output_data[1], std::byte{0x0b});
     EXPECT_EQ(output_data[2], std::byte{0x0c});
 }
+
+TEST(channel, output_interest_while_pending)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    auto obj1 = std::make_shared<io::test::input_object_mock>(bus, 1);
+    auto obj2 = std::make_shared<io::test::output_object_mock>(bus, 2);
+    auto pipe = io::make_channel(obj1, obj2);
+
+    obj1->set_result_buf_len(3);
+    obj2->set_result_buf_len(1);
+
+    // the output is full after the first byte
+    bus->enqueue_event(1, io::flags::in);
+    bus->wait_events(std::chrono::milliseconds{0}, 1);
+    EXPECT_TRUE(bus->has_output_interest(2));
+
+    // the rest is written on the output readiness
+    obj2->set_result_buf_len(2);
+    bus->enqueue_event(2, io::flags::out);
+    bus->wait_events(std::chrono::milliseconds{0}, 1);
+    EXPECT_FALSE(bus->has_output_interest(2));
+
+    // the output is not watched when all the data is written at once
+    obj2->set_result_buf_len(3);
+    bus->enqueue_event(1, io::flags::in);
+    bus->wait_events(std::chrono::milliseconds{0}, 1);
+    EXPECT_FALSE(bus->has_output_interest(2));
+}
+
+TEST(channel, buffer_borrowed_while_pending)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    auto obj1 = std::make_shared<io::test::input_object_mock>(bus, 1);
+    auto obj2 = std::make_shared<io::test::output_object_mock>(bus, 2);
+    auto pipe1 = io::make_channel(obj1, obj2);
+    auto obj3 = std::make_shared<io::test::input_object_mock>(bus, 3);
+    auto obj4 = std::make_shared<io::test::output_object_mock>(bus, 4);
+    auto pipe2 = io::make_channel(obj3, obj4);
+    io::buffer_pool &pool = bus->get_buffer_pool();
+
+    // the idle channels hold no buffer
+    EXPECT_EQ(pool.get_blocks_count(), 0);
+
+    obj1->set_result_buf_len(3);
+    obj2->set_result_buf_len(1);
+    bus->enqueue_event(1, io::flags::in);
+    bus->wait_events(std::chrono::milliseconds{0}, 1);
+    EXPECT_EQ(pool.get_free_count(), pool.get_blocks_count() - 1);
+
+    // the drained channel buffer is reused by the other channel
+    obj2->set_result_buf_len(2);
+    bus->enqueue_event(2, io::flags::out);
+    bus->wait_events(std::chrono::milliseconds{0}, 1);
+    EXPECT_EQ(pool.get_free_count(), pool.get_blocks_count());
+
+    obj3->set_result_buf_len(3);
+    obj4->set_result_buf_len(3);
+    bus->enqueue_event(3, io::flags::in);
+    bus->wait_events(std::chrono::milliseconds{0}, 1);
+    EXPECT_EQ(pool.get_free_count(), pool.get_blocks_count());
+}
+
+TEST(channel, buffer_retained_on_destruction)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    auto obj1 = std::make_shared<io::test::input_object_mock>(bus, 1);
+    auto obj2 = std::make_shared<io::test::output_object_mock>(bus, 2);
+    auto pipe = io::make_channel(obj1, obj2);
+    io::buffer_pool &pool = bus->get_buffer_pool();
+
+    // the written data is still sent from the buffer like the zero-copy send
+    obj1->set_result_buf_len(3);
+    obj2->set_result_buf_len(3);
+    obj2->set_retained_bytes(3);
+    bus->enqueue_event(1, io::flags::in);
+    bus->wait_events(std::chrono::milliseconds{0}, 1);
+    const std::size_t blocks_count = pool.get_blocks_count();
+    const std::size_t free_count = pool.get_free_count();
+    EXPECT_EQ(free_count, blocks_count - 1);
+
+    // the retained buffer is not returned to the pool to be reused
+    obj1->del_bus_fd_callbacks();
+    obj2->del_bus_fd_callbacks();
+    pipe.reset();
+    // the released callbacks holding the channel are destroyed by the next wait
+    bus->wait_events(std::chrono::milliseconds{0}, 1);
+    EXPECT_EQ(pool.get_free_count(), free_count);
+    EXPECT_EQ(pool.get_blocks_count(), blocks_count - 1);
+}
+
+TEST(channel, watermarks)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    auto obj1 = std::make_shared<io::test::input_object_mock>(bus, 1);
+    auto obj2 = std::make_shared<io::test::output_object_mock>(bus, 2);
+    auto pipe = io::make_channel(obj1, obj2);
+
+    EXPECT_EQ(pipe->get_high_watermark(), io::channel::DEFAULT_HIGH_WATERMARK);
+    EXPECT_EQ(pipe->get_low_watermark(), io::channel::DEFAULT_LOW_WATERMARK);
+    pipe->set_watermarks(1000, 2000);
+    EXPECT_EQ(pipe->get_high_watermark(), 1000);
+    EXPECT_EQ(pipe->get_low_watermark(), 999);
+    pipe->set_watermarks(1000, 100);
+
+    std::size_t reads = 0;
+    pipe->add_handler(
+        [&](const io::input_object::result_type &)
+        {
+            ++reads;
+        });
+    // the output is stalled, so the input is read up to the high watermark only
+    obj1->set_result_buf_len(250);
+    obj2->set_result_buf_len(0);
+    for (int i = 0; i < 5; ++i)
+    {
+        bus->enqueue_event(1, io::flags::in);
+        bus->wait_events(std::chrono::milliseconds{0}, 1);
+    }
+    EXPECT_EQ(reads, 4);
+    EXPECT_EQ(pipe->get_throttled_count(), 1);
+    EXPECT_TRUE(bus->has_output_interest(2));
+
+    // the input edges are ignored until the buffered data is drained to the low watermark
+    obj2->set_result_buf_len(500);
+    bus->enqueue_event(2, io::flags::out);
+    bus->enqueue_event(1, io::flags::in);
+    bus->wait_events(std::chrono::milliseconds{0}, 1);
+    EXPECT_EQ(reads, 4);
+
+    // the reading is resumed without a new input edge
+    bus->enqueue_event(2, io::flags::out);
+    bus->wait_events(std::chrono::milliseconds{0}, 1);
+    EXPECT_EQ(reads, 4);
+    obj2->set_result_buf_len(0);
+    bus->wait_events(std::chrono::milliseconds{0}, 1);
+    EXPECT_EQ(reads, 5);
+    EXPECT_EQ(pipe->get_throttled_count(), 1);
+}
+
+TEST(channel, read_budget)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    auto obj1 = std::make_shared<io::test::input_object_mock>(bus, 1);
+    auto obj2 = std::make_shared<io::test::output_object_mock>(bus, 2);
+    auto pipe = io::make_channel(obj1, obj2);
+
+    // every read fills the whole chunk, so the input is never drained
+    constexpr int chunk = 64 * 1024 - 1;
+    obj1->set_result_buf_len(chunk);
+    obj2->set_result_buf_len(chunk);
+    std::size_t reads = 0;
+    pipe->add_handler(
+        [&](const io::input_object::result_type &)
+        {
+            ++reads;
+        });
+    EXPECT_EQ(pipe->get_read_budget(), io::channel::DEFAULT_READ_BUDGET);
+    pipe->set_read_budget(3 * chunk);
+
+    bus->enqueue_event(1, io::flags::in);
+    bus->wait_events(std::chrono::milliseconds{0}, 1);
+    EXPECT_EQ(reads, 3);
+    EXPECT_EQ(pipe->get_budget_exhausted_count(), 1);
+
+    // the rest is read on the deferred event without a new input event
+    bus->wait_events(std::chrono::milliseconds{0}, 1);
+    EXPECT_EQ(reads, 6);
+    EXPECT_EQ(pipe->get_budget_exhausted_count(), 2);
+}
+
+namespace
+{
+    /// @brief Open the non-blocking loopback TCP connection
+    /// @param fds The connected and the accepted sockets
+    /// @param port The listening port
+    void tcp_pair(int fds[2], std::uint16_t port)
+    {
+        const int listener = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        const int reuse = 1;
+        ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ASSERT_EQ(0, ::bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)));
+        ASSERT_EQ(0, ::listen(listener, 1));
+        fds[0] = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        ASSERT_EQ(0, ::connect(fds[0], reinterpret_cast<const sockaddr *>(&address), sizeof(address)));
+        fds[1] = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        ASSERT_NE(-1, fds[1]);
+        ::fcntl(fds[0], F_SETFL, O_NONBLOCK);
+        ::close(listener);
+    }
+
+    /// @brief Forward the burst the peer writes at once through the channel between the socket pairs
+    /// @param is_splice_enabled Is the channel splice mode allowed
+    /// @param zerocopy_threshold The output socket zero-copy writes threshold, the TCP connections are used if it is set
+    /// @param bus The bus to run the channel on, the epoll one if null
+    void forward_burst(bool is_splice_enabled, std::size_t zerocopy_threshold = 0, io::bus_ptr bus = nullptr)
+    {
+        if (!bus)
+        {
+            bus = std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
+        }
+        int input_fds[2];
+        int output_fds[2];
+        if (0 == zerocopy_threshold)
+        {
+            ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, input_fds));
+            ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, output_fds));
+        }
+        else
+        {
+            tcp_pair(input_fds, 23466);
+            tcp_pair(output_fds, 23467);
+        }
+        auto left = std::make_shared<io::ip::tcp::socket>(bus, input_fds[1]);
+        auto right = std::make_shared<io::ip::tcp::socket>(bus, output_fds[0]);
+        right->set_zerocopy_threshold(zerocopy_threshold);
+        auto pipe = io::make_channel(left, right);
+        pipe->set_splice_enabled(is_splice_enabled);
+
+        constexpr std::size_t burst_size = 1024 * 1024;
+        std::vector<char> sent(burst_size);
+        for (std::size_t i = 0; i < burst_size; ++i)
+        {
+            sent[i] = static_cast<char>(i * 7);
+        }
+        std::vector<char> recieved;
+        recieved.reserve(burst_size);
+        auto no_error = [](io::event_reciever *, const io::error &error)
+        {
+            ADD_FAILURE() << error.what() << "; errno = " << error.get_errno() << " for fd = " << error.get_fd();
+        };
+
+        // the peer writes the burst as fast as the input accepts it and sends nothing after that,
+        // so the tail queued in the input socket is forwarded only if the channel drains it
+        std::size_t sent_len = 0;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+        while (recieved.size() < burst_size && std::chrono::steady_clock::now() < deadline)
+        {
+            while (sent_len < burst_size)
+            {
+                const ssize_t n = ::write(input_fds[0], sent.data() + sent_len, burst_size - sent_len);
+                if (n <= 0)
+                {
+                    break;
+                }
+                sent_len += static_cast<std::size_t>(n);
+            }
+            char buf[16 * 1024];
+            for (ssize_t n = ::read(output_fds[1], buf, sizeof(buf)); n > 0; n = ::read(output_fds[1], buf, sizeof(buf)))
+            {
+                recieved.insert(recieved.end(), buf, buf + n);
+            }
+            bus->wait_events(std::chrono::milliseconds{10}, 16, no_error);
+        }
+        EXPECT_EQ(sent_len, burst_size);
+        ASSERT_EQ(recieved.size(), burst_size);
+        EXPECT_TRUE(sent == recieved);
+        EXPECT_EQ(pipe->is_splice_mode(), is_splice_enabled);
+        if (0 != zerocopy_threshold)
+        {
+            EXPECT_GT(right->get_zerocopy_sends_count(), 0);
+        }
+        if (!is_splice_enabled && dynamic_cast<io::system::uring *>(bus.get()))
+        {
+            // the copy mode data is received and sent by the io_uring requests
+            EXPECT_TRUE(bus->is_receiving(input_fds[1]));
+            EXPECT_TRUE(bus->is_sending(output_fds[0]));
+        }
+
+        ::close(input_fds[0]);
+        ::close(output_fds[1]);
+    }
+}
+
+TEST(channel, drain_burst)
+{
+    forward_burst(false);
+}
+
+TEST(channel, splice_burst)
+{
+    forward_burst(true);
+}
+
+TEST(channel, zerocopy_burst)
+{
+    forward_burst(false, 4096);
+}
+
+TEST(channel, uring_burst)
+{
+    io::bus_ptr bus;
+    try
+    {
+        bus = std::make_shared<io::system::uring>(EPOLLIN | EPOLLPRI | EPOLLET);
+    }
+    catch (io::error &error)
+    {
+        GTEST_SKIP() << "io_uring is not available: " << error.what();
+    }
+    forward_burst(false, 0, bus);
+}
+
+TEST(channel, eof_after_data)
+{
+    auto bus = std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
+    int input_fds[2];
+    int output_fds[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, input_fds));
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, output_fds));
+    auto left = std::make_shared<io::ip::tcp::socket>(bus, input_fds[1]);
+    auto right = std::make_shared<io::ip::tcp::socket>(bus, output_fds[0]);
+    auto pipe = io::make_channel(left, right);
+
+    std::size_t recieved = 0;
+    bool is_closed = false;
+    pipe->add_handler(
+        [&](const io::input_object::result_type &result)
+        {
+            if (std::holds_alternative<io::error>(result))
+            {
+                is_closed = true;
+                return;
+            }
+            recieved += std::get<io::input_object::success_result_type>(result).buf_len;
+        });
+
+    // the data and the end of the stream come with the single edge, the short read does not drain the input
+    const char data[100] = {};
+    ASSERT_EQ(sizeof(data), ::write(input_fds[0], data, sizeof(data)));
+    ASSERT_EQ(0, ::shutdown(input_fds[0], SHUT_WR));
+    for (int i = 0; i < 3 && !is_closed; ++i)
+    {
+        bus->wait_events(std::chrono::milliseconds{10}, 16, [](io::event_reciever *, const io::error &) {});
+    }
+    EXPECT_EQ(recieved, sizeof(data));
+    EXPECT_TRUE(is_closed);
+
+    ::close(input_fds[0]);
+    ::close(output_fds[1]);
+}
@@ -0,0 +1,116 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <io/connection_pool.hpp>
+#include <io/acceptor.hpp>
+#include <io/epoll.hpp>
+#include <io/resolver.hpp>
+
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+    auto no_error = [](io::event_reciever *, const io::error &error)
+    {
+        ADD_FAILURE() << error.what() << "; errno = " << error.get_errno() << " for fd = " << error.get_fd();
+    };
+
+    /// @brief Run the \p bus until the \p predicate becomes true
+    template <typename Predicate>
+    bool run_until(const io::bus_ptr &bus, Predicate predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (!predicate() && std::chrono::steady_clock::now() < deadline)
+        {
+            bus->wait_events(std::chrono::milliseconds{10}, 16, no_error);
+        }
+        return predicate();
+    }
+}
+
+TEST(connection_pool, acquire)
+{
+    auto bus = std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
+    const io::ip::v4 address{"127.0.0.1", "23459"};
+    std::vector<io::file_descriptor_t> accepted;
+    io::ip::tcp::acceptor acceptor(
+        bus,
+        address, 16,
+        [&](io::file_descriptor_t fd, const io::ip::endpoint &)
+        {
+            accepted.push_back(fd);
+        });
+    auto target = std::make_shared<io::ip::resolver>(address, std::chrono::milliseconds{0});
+
+    io::ip::tcp::connection_pool_options options;
+    options.size = 2;
+    io::ip::tcp::connection_pool pool(bus, target, options);
+    EXPECT_EQ(pool.get_connecting_count(), 2);
+    ASSERT_TRUE(run_until(bus, [&]
+                          { return 2 == pool.get_ready_count(); }));
+    EXPECT_EQ(pool.get_metrics().refill_us.count(), 2);
+
+    // the established connection is handed out and the pool is refilled at once
+    io::file_descriptor_t fd = pool.acquire();
+    ASSERT_NE(fd, -1);
+    sockaddr_storage peer{};
+    socklen_t peer_len = sizeof(peer);
+    EXPECT_EQ(0, ::getpeername(fd, reinterpret_cast<sockaddr *>(&peer), &peer_len));
+    EXPECT_EQ(pool.get_metrics().hits, 1);
+    EXPECT_EQ(pool.get_ready_count() + pool.get_connecting_count(), 2);
+    ::close(fd);
+
+    // the idle connection closed by the peer is replaced
+    ASSERT_TRUE(run_until(bus, [&]
+                          { return 3 == accepted.size() && 2 == pool.get_ready_count(); }));
+    for (io::file_descriptor_t conn : accepted)
+    {
+        ::close(conn);
+    }
+    ASSERT_TRUE(run_until(bus, [&]
+                          { return pool.get_metrics().expired >= 2; }));
+
+    std::ostringstream os;
+    os << pool.get_metrics();
+    EXPECT_NE(os.str().find("hits: 1; misses: 0"), std::string::npos);
+}
+
+TEST(connection_pool, upstream_down)
+{
+    auto bus = std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
+    // nothing listens on the port
+    auto target = std::make_shared<io::ip::resolver>(io::ip::v4{"127.0.0.1", "23460"}, std::chrono::milliseconds{0});
+
+    io::ip::tcp::connection_pool_options options;
+    options.size = 1;
+    io::ip::tcp::connection_pool pool(bus, target, options);
+    ASSERT_TRUE(run_until(bus, [&]
+                          { return pool.get_metrics().failures > 0; }));
+    EXPECT_EQ(pool.get_ready_count(), 0);
+    EXPECT_EQ(pool.get_connecting_count(), 0);
+
+    // the miss does not reconnect while the upstream is down, the sweep retries
+    EXPECT_EQ(pool.acquire(), -1);
+    EXPECT_EQ(pool.get_metrics().misses, 1);
+    EXPECT_EQ(pool.get_connecting_count(), 0);
+}
+
+TEST(connection_pool, disabled)
+{
+    auto bus = std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
+    auto target = std::make_shared<io::ip::resolver>(io::ip::v4{"127.0.0.1", "23460"}, std::chrono::milliseconds{0});
+    io::ip::tcp::connection_pool pool(bus, target, io::ip::tcp::connection_pool_options{});
+    EXPECT_EQ(pool.get_connecting_count(), 0);
+    EXPECT_EQ(pool.acquire(), -1);
+    EXPECT_EQ(pool.get_metrics().misses, 0);
+    EXPECT_EQ(bus->get_timers().size(), 0);
+}
@@ -0,0 +1,86 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <io/context_pool.hpp>
+#include "mock/bus_mock.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+TEST(context_pool, one_bus_per_thread)
+{
+    io::context_pool pool(
+        3,
+        [](std::size_t) -> io::bus_ptr
+        {
+            return std::make_shared<io::test::bus_mock>();
+        });
+    EXPECT_EQ(pool.size(), 3);
+    EXPECT_NE(pool.get_context(0)->get_bus().get(), pool.get_context(1)->get_bus().get());
+    EXPECT_NE(pool.get_context(1)->get_bus().get(), pool.get_context(2)->get_bus().get());
+
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+    std::set<std::size_t> indexes;
+    std::atomic_size_t started{0};
+    pool.run(
+        [&](std::size_t index, const io::context_ptr &io_context)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                thread_ids.insert(std::this_thread::get_id());
+                indexes.insert(index);
+            }
+            EXPECT_EQ(io_context.get(), pool.get_context(index).get());
+            if (pool.size() == ++started)
+            {
+                pool.stop();
+            }
+            io_context->run();
+        });
+
+    EXPECT_EQ(thread_ids.size(), 3);
+    EXPECT_EQ(indexes, (std::set<std::size_t>{0, 1, 2}));
+    for (std::size_t i = 0; i < pool.size(); ++i)
+    {
+        EXPECT_TRUE(pool.get_context(i)->is_stop_requested());
+    }
+}
+
+TEST(context_pool, zero_threads_means_cpu_count)
+{
+    io::context_pool pool(
+        0,
+        [](std::size_t) -> io::bus_ptr
+        {
+            return std::make_shared<io::test::bus_mock>();
+        });
+    EXPECT_LE(1, pool.size());
+}
+
+TEST(context_pool, thread_error_stops_all)
+{
+    io::context_pool pool(
+        2,
+        [](std::size_t) -> io::bus_ptr
+        {
+            return std::make_shared<io::test::bus_mock>();
+        });
+    EXPECT_THROW(
+        pool.run(
+            [&](std::size_t index, const io::context_ptr &io_context)
+            {
+                if (1 == index)
+                {
+                    throw std::runtime_error("test error");
+                }
+                io_context->run();
+            }),
+        std::runtime_error);
+    EXPECT_TRUE(pool.get_context(0)->is_stop_requested());
+}
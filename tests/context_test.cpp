@@ -4,8 +4,17 @@
 
 #include <gtest/gtest.h>
 #include <io/context.hpp>
+#include <io/epoll.hpp>
 #include "mock/bus_mock.hpp"
 
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/epoll.h>
+
 TEST(context, run_stop_is_stop_requested)
 {
     io::bus_ptr bus = std::make_shared<io::test::bus_mock>();
@@ -44,3 +53,99 @@ TEST(context, run_with_error_callback)
 
     EXPECT_TRUE(error_callback_called);
 }
+
+TEST(context, busy_poll)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    io::context ctx(bus);
+    ctx.set_busy_poll(std::chrono::microseconds{100});
+
+    int events_count = 0;
+    bus->add_fd(
+        1,
+        [&](io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask)
+        {
+            if (++events_count < 5)
+            {
+                reciever->enqueue_event(fd, io::flags::in);
+            }
+        });
+    bus->enqueue_event(1, io::flags::in);
+    bus->get_timers().arm(
+        std::chrono::milliseconds{5},
+        [&]()
+        {
+            ctx.stop();
+        });
+
+    ctx.run();
+
+    EXPECT_EQ(events_count, 5);
+    const io::context::run_stats &stats = ctx.get_run_stats();
+    EXPECT_EQ(stats.spin_hits, 5u);
+    EXPECT_GT(stats.spin_polls, stats.spin_hits);
+    EXPECT_GT(stats.blocking_waits, 0u);
+
+    std::ostringstream os;
+    os << stats;
+    EXPECT_NE(os.str().find("spin/block ratio"), std::string::npos);
+}
+
+TEST(context, post)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    io::context ctx(bus);
+
+    std::vector<int> order;
+    ctx.post(
+        [&]()
+        {
+            order.push_back(1);
+        });
+    ctx.post(
+        [&]()
+        {
+            order.push_back(2);
+            throw io::error("task error", -1, 0);
+        });
+    ctx.post(
+        [&]()
+        {
+            order.push_back(3);
+            ctx.stop();
+        });
+
+    bool error_callback_called = false;
+    ctx.run(
+        [&](io::event_reciever *, const io::error &)
+        {
+            error_callback_called = true;
+        });
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+    EXPECT_TRUE(error_callback_called);
+}
+
+TEST(context, post_wakes_up_infinite_wait)
+{
+    auto bus = std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
+    io::context ctx(bus);
+
+    std::thread::id task_thread_id;
+    std::thread producer(
+        [&]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            ctx.post(
+                [&]()
+                {
+                    task_thread_id = std::this_thread::get_id();
+                });
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            ctx.stop();
+        });
+    ctx.run();
+    producer.join();
+
+    EXPECT_EQ(task_thread_id, std::this_thread::get_id());
+    EXPECT_GE(ctx.get_run_stats().blocking_waits, 2u);
+}
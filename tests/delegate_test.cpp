@@ -0,0 +1,88 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <io/delegate.hpp>
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace
+{
+    int add(int a, int b)
+    {
+        return a + b;
+    }
+}
+
+TEST(delegate, empty)
+{
+    io::delegate<void()> d;
+    EXPECT_FALSE(d);
+    EXPECT_THROW(d(), std::bad_function_call);
+
+    io::delegate<void()> d2 = nullptr;
+    EXPECT_FALSE(d2);
+
+    int (*fn)(int, int) = nullptr;
+    io::delegate<int(int, int)> d3 = fn;
+    EXPECT_FALSE(d3);
+}
+
+TEST(delegate, invoke)
+{
+    io::delegate<int(int, int)> d = add;
+    EXPECT_TRUE(d);
+    EXPECT_EQ(d(2, 3), 5);
+
+    int counter = 0;
+    io::delegate<int()> mutable_lambda = [counter]() mutable
+    {
+        return ++counter;
+    };
+    EXPECT_EQ(mutable_lambda(), 1);
+    EXPECT_EQ(mutable_lambda(), 2);
+
+    std::unique_ptr<int> value = std::make_unique<int>(42);
+    io::delegate<int(const std::unique_ptr<int> &)> by_ref = [](const std::unique_ptr<int> &p)
+    {
+        return *p;
+    };
+    EXPECT_EQ(by_ref(value), 42);
+}
+
+TEST(delegate, move_only_capture)
+{
+    auto value = std::make_unique<int>(7);
+    io::delegate<int()> d = [value = std::move(value)]()
+    {
+        return *value;
+    };
+    io::delegate<int()> moved = std::move(d);
+    EXPECT_FALSE(d);
+    EXPECT_TRUE(moved);
+    EXPECT_EQ(moved(), 7);
+
+    io::delegate<int()> assigned;
+    assigned = std::move(moved);
+    EXPECT_FALSE(moved);
+    EXPECT_EQ(assigned(), 7);
+}
+
+TEST(delegate, destroys_callable)
+{
+    auto owned = std::make_shared<int>(1);
+    {
+        io::delegate<void()> d = [owned]() {};
+        EXPECT_EQ(owned.use_count(), 2);
+        io::delegate<void()> moved = std::move(d);
+        EXPECT_EQ(owned.use_count(), 2);
+        moved = nullptr;
+        EXPECT_EQ(owned.use_count(), 1);
+        moved = [owned]() {};
+        EXPECT_EQ(owned.use_count(), 2);
+    }
+    EXPECT_EQ(owned.use_count(), 1);
+}
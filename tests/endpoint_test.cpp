@@ -0,0 +1,58 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <io/endpoint.hpp>
+#include <io/v4.hpp>
+#include <io/error.hpp>
+
+#include <sstream>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+TEST(endpoint, empty)
+{
+    io::ip::endpoint address;
+    EXPECT_EQ(address.family(), AF_UNSPEC);
+    EXPECT_EQ(address.size(), 0);
+    EXPECT_EQ(address.port(), 0);
+    EXPECT_EQ(address.host(), "");
+}
+
+TEST(endpoint, from_v4)
+{
+    io::ip::endpoint address(io::ip::v4{"127.0.0.1", "5432"});
+    EXPECT_EQ(address.family(), AF_INET);
+    EXPECT_EQ(address.size(), sizeof(sockaddr_in));
+    EXPECT_EQ(address.port(), 5432);
+    EXPECT_EQ(address.host(), "127.0.0.1");
+
+    std::ostringstream os;
+    os << address;
+    EXPECT_EQ(os.str(), "127.0.0.1:5432");
+
+    EXPECT_THROW((io::ip::endpoint{io::ip::v4{"localhost", "5432"}}), io::error);
+}
+
+TEST(endpoint, from_sockaddr_in6)
+{
+    sockaddr_in6 sa{};
+    sa.sin6_family = AF_INET6;
+    sa.sin6_port = htons(6432);
+    sa.sin6_addr = in6addr_loopback;
+    io::ip::endpoint address(reinterpret_cast<const sockaddr *>(&sa), sizeof(sa));
+    EXPECT_EQ(address.family(), AF_INET6);
+    EXPECT_EQ(address.port(), 6432);
+    EXPECT_EQ(address.host(), "::1");
+
+    std::ostringstream os;
+    os << address;
+    EXPECT_EQ(os.str(), "[::1]:6432");
+
+    // the copy is a plain memory copy
+    io::ip::endpoint copy = address;
+    EXPECT_EQ(copy.size(), sizeof(sa));
+    EXPECT_EQ(copy.port(), 6432);
+}
@@ -11,6 +11,10 @@
 #include <memory>
 #include <iostream>
 
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
 TEST(epoll, constructor_native_callback)
 {
     try
@@ -34,7 +38,7 @@ TEST(epoll, constructor_native_callback)
         io::ip::tcp::acceptor acceptor(
             bus,
             address, 1024,
-            [&](io::file_descriptor_t fd, const io::ip::v4 &)
+            [&](io::file_descriptor_t fd, const io::ip::endpoint &)
             {
                 callback_called = true;
                 sock = std::make_shared<io::ip::tcp::socket>(bus, fd);
@@ -128,3 +132,40 @@ TEST(epoll, constructor_native_callback)
         std::cerr << error.what() << "; errno = " << error.get_errno() << " for fd = " << error.get_fd() << std::endl;
     }
 }
+
+TEST(epoll, output_interest)
+{
+    auto bus = std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
+    int fds[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds));
+
+    io::flags events = io::flags::empty;
+    bus->add_fd(
+        fds[0],
+        [&](io::event_reciever *, io::file_descriptor_t, io::flags mask)
+        {
+            events |= mask;
+        });
+    auto no_error = [](io::event_reciever *, const io::error &error)
+    {
+        ADD_FAILURE() << error.what() << "; errno = " << error.get_errno() << " for fd = " << error.get_fd();
+    };
+    bus->wait_events(std::chrono::milliseconds{10}, 16, no_error);
+    EXPECT_FALSE(events.test(io::flags::out));
+
+    // the writable socket is reported as soon as the output is watched
+    bus->add_output_interest(fds[0]);
+    bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+    EXPECT_TRUE(events.test(io::flags::out));
+
+    bus->del_output_interest(fds[0]);
+    events = io::flags::empty;
+    ASSERT_EQ(1, ::write(fds[1], "x", 1));
+    bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+    EXPECT_TRUE(events.test(io::flags::in));
+    EXPECT_FALSE(events.test(io::flags::out));
+
+    bus->del_fd(fds[0]);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
@@ -0,0 +1,39 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <io/eventfd.hpp>
+
+#include <chrono>
+#include <thread>
+
+TEST(eventfd, notify_wait)
+{
+    io::system::eventfd notifier;
+    EXPECT_GE(notifier.get_fd(), 0);
+    EXPECT_FALSE(notifier.wait(std::chrono::milliseconds{0}));
+
+    // the notifications are coalesced until the reset
+    notifier.notify();
+    notifier.notify();
+    EXPECT_TRUE(notifier.wait(std::chrono::milliseconds{0}));
+    EXPECT_FALSE(notifier.wait(std::chrono::milliseconds{0}));
+
+    notifier.notify();
+    notifier.reset();
+    EXPECT_FALSE(notifier.wait(std::chrono::milliseconds{0}));
+}
+
+TEST(eventfd, cross_thread_wakeup)
+{
+    io::system::eventfd notifier;
+    std::thread producer(
+        [&notifier]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            notifier.notify();
+        });
+    EXPECT_TRUE(notifier.wait(std::chrono::milliseconds{-1}));
+    producer.join();
+}
@@ -0,0 +1,297 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <psql_proxy/frame_decoder.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct decoded_frame
+    {
+        char code;
+        std::string payload;
+    };
+
+    void append_uint32(std::vector<std::byte> &stream, std::uint32_t value)
+    {
+        for (int shift = 24; shift >= 0; shift -= 8)
+        {
+            stream.push_back(std::byte(value >> shift));
+        }
+    }
+
+    void append_frame(std::vector<std::byte> &stream, char code, const std::string &payload)
+    {
+        if ('\0' != code)
+        {
+            stream.push_back(std::byte(code));
+        }
+        append_uint32(stream, static_cast<std::uint32_t>(payload.size() + sizeof(std::uint32_t)));
+        for (char c : payload)
+        {
+            stream.push_back(std::byte(c));
+        }
+    }
+
+    std::string startup_payload()
+    {
+        // the protocol version 3.0 followed by the parameters
+        return std::string("\0\3\0\0user\0postgres\0\0", 19);
+    }
+
+    /// @brief The startup message, a query, a large copy data and a termination
+    std::vector<std::byte> make_stream(std::size_t copy_data_len)
+    {
+        std::vector<std::byte> stream;
+        append_frame(stream, '\0', startup_payload());
+        append_frame(stream, 'Q', std::string("select 1;\0", 10));
+        append_frame(stream, 'd', std::string(copy_data_len, 'x'));
+        append_frame(stream, 'X', std::string());
+        return stream;
+    }
+
+    psql::frame_decoder::codes_t make_codes(const std::string &codes)
+    {
+        psql::frame_decoder::codes_t result;
+        for (char c : codes)
+        {
+            result.set(static_cast<unsigned char>(c));
+        }
+        return result;
+    }
+}
+
+TEST(frame_decoder, one_chunk)
+{
+    std::vector<decoded_frame> frames;
+    psql::frame_decoder decoder(
+        make_codes(std::string("\0QX", 3)),
+        [&frames](const psql::frame_decoder::frame &frame)
+        {
+            frames.push_back(decoded_frame{std::to_integer<char>(frame.code), std::string(reinterpret_cast<const char *>(frame.payload), frame.payload_len)});
+        });
+    const std::vector<std::byte> stream = make_stream(100);
+    decoder.decode(stream.data(), stream.size());
+
+    ASSERT_EQ(3, frames.size());
+    EXPECT_EQ('\0', frames[0].code);
+    EXPECT_EQ(startup_payload(), frames[0].payload);
+    EXPECT_EQ('Q', frames[1].code);
+    EXPECT_EQ(std::string("select 1;\0", 10), frames[1].payload);
+    EXPECT_EQ('X', frames[2].code);
+    EXPECT_TRUE(frames[2].payload.empty());
+    EXPECT_EQ(4, decoder.get_frames_count());
+    EXPECT_EQ(0, decoder.get_reassembled_bytes());
+    EXPECT_FALSE(decoder.is_broken());
+}
+
+TEST(frame_decoder, byte_by_byte)
+{
+    std::vector<decoded_frame> frames;
+    psql::frame_decoder decoder(
+        make_codes(std::string("\0QX", 3)),
+        [&frames](const psql::frame_decoder::frame &frame)
+        {
+            frames.push_back(decoded_frame{std::to_integer<char>(frame.code), std::string(reinterpret_cast<const char *>(frame.payload), frame.payload_len)});
+        });
+    const std::vector<std::byte> stream = make_stream(100);
+    for (const std::byte &b : stream)
+    {
+        decoder.decode(&b, 1);
+    }
+
+    ASSERT_EQ(3, frames.size());
+    EXPECT_EQ(startup_payload(), frames[0].payload);
+    EXPECT_EQ(std::string("select 1;\0", 10), frames[1].payload);
+    EXPECT_EQ('X', frames[2].code);
+    EXPECT_EQ(4, decoder.get_frames_count());
+    // the skipped copy data payload is not copied
+    EXPECT_EQ(stream.size() - 100, decoder.get_reassembled_bytes());
+}
+
+TEST(frame_decoder, skip_large_payload)
+{
+    std::size_t frames_count = 0;
+    psql::frame_decoder decoder(
+        make_codes("Q"),
+        [&frames_count](const psql::frame_decoder::frame &frame)
+        {
+            ++frames_count;
+        });
+    const std::vector<std::byte> stream = make_stream(4 * 1024 * 1024);
+    const std::size_t chunk_sz = 65536;
+    for (std::size_t pos = 0; pos < stream.size(); pos += chunk_sz)
+    {
+        decoder.decode(stream.data() + pos, std::min(chunk_sz, stream.size() - pos));
+    }
+    EXPECT_EQ(1, frames_count);
+    EXPECT_EQ(4, decoder.get_frames_count());
+    // only the split headers are copied
+    EXPECT_LE(decoder.get_reassembled_bytes(), 5 * 4);
+}
+
+TEST(frame_decoder, ssl_request)
+{
+    std::vector<decoded_frame> frames;
+    psql::frame_decoder decoder(
+        make_codes(std::string("\0Q", 2)),
+        [&frames](const psql::frame_decoder::frame &frame)
+        {
+            frames.push_back(decoded_frame{std::to_integer<char>(frame.code), std::string(reinterpret_cast<const char *>(frame.payload), frame.payload_len)});
+        });
+    std::vector<std::byte> stream;
+    append_uint32(stream, 8);
+    append_uint32(stream, psql::frame_decoder::SSL_REQUEST_CODE);
+    // the server declines the encryption and the client sends the untyped startup message
+    const std::vector<std::byte> rest = make_stream(0);
+    stream.insert(stream.end(), rest.begin(), rest.end());
+    decoder.decode(stream.data(), stream.size());
+
+    ASSERT_EQ(3, frames.size());
+    EXPECT_EQ('\0', frames[0].code);
+    EXPECT_EQ(4, frames[0].payload.size());
+    EXPECT_EQ('\0', frames[1].code);
+    EXPECT_EQ(startup_payload(), frames[1].payload);
+    EXPECT_EQ('Q', frames[2].code);
+    EXPECT_FALSE(decoder.is_broken());
+}
+
+TEST(frame_decoder, malformed_length)
+{
+    std::size_t frames_count = 0;
+    psql::frame_decoder decoder(
+        make_codes("Q"),
+        [&frames_count](const psql::frame_decoder::frame &frame)
+        {
+            ++frames_count;
+        });
+    std::vector<std::byte> stream;
+    append_frame(stream, '\0', startup_payload());
+    stream.push_back(std::byte{'Q'});
+    append_uint32(stream, 3);
+    append_frame(stream, 'Q', std::string("select 1;\0", 10));
+    decoder.decode(stream.data(), stream.size());
+
+    EXPECT_TRUE(decoder.is_broken());
+    EXPECT_EQ(0, frames_count);
+    // the rest of the stream is ignored
+    decoder.decode(stream.data(), stream.size());
+    EXPECT_EQ(1, decoder.get_frames_count());
+}
+
+TEST(frame_decoder, oversized_payload)
+{
+    std::vector<decoded_frame> frames;
+    psql::frame_decoder decoder(
+        make_codes("Q"),
+        [&frames](const psql::frame_decoder::frame &frame)
+        {
+            frames.push_back(decoded_frame{std::to_integer<char>(frame.code), std::string(reinterpret_cast<const char *>(frame.payload), frame.payload_len)});
+        },
+        32);
+    std::vector<std::byte> stream;
+    append_frame(stream, '\0', startup_payload());
+    append_frame(stream, 'Q', std::string(100, 'x'));
+    append_frame(stream, 'Q', std::string("select 1;\0", 10));
+    decoder.decode(stream.data(), stream.size());
+
+    ASSERT_EQ(1, frames.size());
+    EXPECT_EQ(std::string("select 1;\0", 10), frames[0].payload);
+    EXPECT_EQ(1, decoder.get_oversized_count());
+    EXPECT_EQ(3, decoder.get_frames_count());
+}
+
+TEST(frame_decoder, copy_in)
+{
+    std::vector<decoded_frame> frames;
+    psql::frame_decoder decoder(
+        make_codes("Qcf"),
+        [&frames](const psql::frame_decoder::frame &frame)
+        {
+            frames.push_back(decoded_frame{std::to_integer<char>(frame.code), std::string(reinterpret_cast<const char *>(frame.payload), frame.payload_len)});
+        });
+    std::vector<std::byte> stream;
+    append_frame(stream, '\0', startup_payload());
+    append_frame(stream, 'Q', std::string("copy t from stdin;\0", 19));
+    for (int i = 0; i < 100; ++i)
+    {
+        append_frame(stream, 'd', std::string(10 + i, 'x'));
+    }
+    append_frame(stream, 'c', std::string());
+    append_frame(stream, 'Q', std::string("copy t from stdin;\0", 19));
+    append_frame(stream, 'd', std::string(10, 'x'));
+    append_frame(stream, 'f', std::string("aborted\0", 8));
+
+    // the chunk boundaries split the copy data headers and payloads
+    const std::size_t chunk_sz = 7;
+    for (std::size_t pos = 0; pos < stream.size(); pos += chunk_sz)
+    {
+        decoder.decode(stream.data() + pos, std::min(chunk_sz, stream.size() - pos));
+        if (pos == chunk_sz * 20)
+        {
+            EXPECT_TRUE(decoder.is_copy_in());
+        }
+    }
+
+    ASSERT_EQ(4, frames.size());
+    EXPECT_EQ('Q', frames[0].code);
+    EXPECT_EQ('c', frames[1].code);
+    EXPECT_EQ('Q', frames[2].code);
+    EXPECT_EQ('f', frames[3].code);
+    EXPECT_EQ(std::string("aborted\0", 8), frames[3].payload);
+    EXPECT_FALSE(decoder.is_copy_in());
+    EXPECT_EQ(2, decoder.get_copy_count());
+    EXPECT_EQ(101, decoder.get_copy_data_count());
+    EXPECT_EQ(106, decoder.get_frames_count());
+
+    // the copy data in one chunk is walked in place
+    psql::frame_decoder one_chunk_decoder(make_codes("Q"), [](const psql::frame_decoder::frame &) {});
+    one_chunk_decoder.decode(stream.data(), stream.size());
+    EXPECT_EQ(101, one_chunk_decoder.get_copy_data_count());
+    EXPECT_EQ(106, one_chunk_decoder.get_frames_count());
+    EXPECT_EQ(0, one_chunk_decoder.get_reassembled_bytes());
+}
+
+TEST(frame_decoder, backend_counted)
+{
+    std::vector<decoded_frame> frames;
+    std::size_t counted_len = 0;
+    psql::frame_decoder decoder(
+        psql::frame_decoder::stream::backend,
+        make_codes("CZ"),
+        make_codes("D"),
+        [&frames, &counted_len](const psql::frame_decoder::frame &frame)
+        {
+            if (nullptr == frame.payload)
+            {
+                counted_len += frame.payload_len;
+                return;
+            }
+            frames.push_back(decoded_frame{std::to_integer<char>(frame.code), std::string(reinterpret_cast<const char *>(frame.payload), frame.payload_len)});
+        });
+    // the backend stream has no untyped messages
+    std::vector<std::byte> stream;
+    append_frame(stream, 'T', std::string(30, 't'));
+    append_frame(stream, 'D', std::string(10, 'd'));
+    append_frame(stream, 'D', std::string(20, 'd'));
+    append_frame(stream, 'C', std::string("SELECT 2\0", 9));
+    append_frame(stream, 'Z', std::string("I", 1));
+    for (const std::byte &b : stream)
+    {
+        decoder.decode(&b, 1);
+    }
+
+    ASSERT_EQ(2, frames.size());
+    EXPECT_EQ('C', frames[0].code);
+    EXPECT_EQ(std::string("SELECT 2\0", 9), frames[0].payload);
+    EXPECT_EQ('Z', frames[1].code);
+    EXPECT_EQ(30, counted_len);
+    EXPECT_EQ(5, decoder.get_frames_count());
+    EXPECT_FALSE(decoder.is_broken());
+}
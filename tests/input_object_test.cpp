@@ -58,3 +58,22 @@ TEST(input_object, async_read_some)
 // {
 //     delete global_input_obj;
 // }
+
+TEST(input_object, async_readv)
+{
+    io::bus_ptr bus = std::make_shared<io::test::bus_mock>();
+    auto obj = std::make_shared<io::test::input_object_mock>(bus, 1);
+
+    // the buffers are read one by one until the short read
+    std::byte data[4] = {};
+    struct iovec iov[2] = {{data, 1}, {data + 1, 3}};
+    obj->set_result_buf_len(1);
+    auto result = obj->async_readv(iov, 2);
+    ASSERT_TRUE(std::holds_alternative<io::input_object::success_result_type>(result));
+    EXPECT_EQ(std::get<io::input_object::success_result_type>(result).buf, data);
+    EXPECT_EQ(std::get<io::input_object::success_result_type>(result).buf_len, 2);
+
+    obj->set_throw_error(true);
+    result = obj->async_readv(iov, 2);
+    EXPECT_TRUE(std::holds_alternative<io::error>(result));
+}
@@ -4,20 +4,28 @@
 
 #include "acceptor_base_mock.hpp"
 
+#include <utility>
+
 io::test::acceptor_base_mock::acceptor_base_mock(
     io::bus_ptr io_bus,
     callback_t callback)
     : io::ip::acceptor_base(io_bus, 1)
 {
-    add_callback(callback);
+    add_callback(std::move(callback));
 }
 
 io::test::acceptor_base_mock::~acceptor_base_mock() noexcept
 {
 }
 
-std::pair<io::file_descriptor_t, io::ip::v4> io::test::acceptor_base_mock::_accept_new_client(io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask)
+std::pair<io::file_descriptor_t, io::ip::endpoint> io::test::acceptor_base_mock::_accept_new_client(io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask)
 {
-    io::ip::v4 address{"127.0.0.1", "12345"};
+    // one pending connection per input event
+    _is_accepted = !_is_accepted;
+    if (!_is_accepted)
+    {
+        return std::make_pair(-1, io::ip::endpoint());
+    }
+    io::ip::endpoint address{io::ip::v4{"127.0.0.1", "12345"}};
     return std::make_pair(1, address);
 }
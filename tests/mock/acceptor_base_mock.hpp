@@ -41,7 +41,9 @@ namespace io
             /// @param fd The file descriptor
             /// @param mask The I/O event mask
             /// @return The accepted client's address
-            std::pair<io::file_descriptor_t, io::ip::v4> _accept_new_client(io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask) override;
+            std::pair<io::file_descriptor_t, io::ip::endpoint> _accept_new_client(io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask) override;
+
+            bool _is_accepted = false;
         };
     }
 }
@@ -30,21 +30,48 @@ void io::test::bus_mock::set_throw_unknown_error(bool do_throw)
     _do_throw_unknown_error = do_throw;
 }
 
+io::bus::handle_t io::test::bus_mock::get_handle(file_descriptor_t fd) const
+{
+    return _file_descriptors.at(fd);
+}
+
+bool io::test::bus_mock::has_output_interest(file_descriptor_t fd) const
+{
+    auto it = _output_interest.find(fd);
+    return _output_interest.end() != it && it->second;
+}
+
+void io::test::bus_mock::push_native_event(handle_t handle, io::flags mask)
+{
+    _native_events.emplace_back(handle, mask);
+}
+
 io::test::bus_mock::~bus_mock() noexcept
 {
 }
 
-void io::test::bus_mock::_add_fd(io::file_descriptor_t fd)
+void io::test::bus_mock::_add_fd(io::file_descriptor_t fd, handle_t handle)
 {
-    _file_descriptors.insert(fd);
+    _file_descriptors[fd] = handle;
+    _output_interest[fd] = false;
 }
 
 void io::test::bus_mock::_del_fd(io::file_descriptor_t fd)
 {
     _file_descriptors.erase(fd);
+    _output_interest.erase(fd);
 }
 
-void io::test::bus_mock::_wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size, io::bus::callback_t callback)
+void io::test::bus_mock::_set_output_interest(io::file_descriptor_t fd, handle_t handle, bool enabled)
+{
+    if (_file_descriptors.at(fd) != handle)
+    {
+        throw io::error("stale handle", fd, ENOENT);
+    }
+    _output_interest[fd] = enabled;
+}
+
+void io::test::bus_mock::_wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size)
 {
     if (_do_throw_io_error)
     {
@@ -60,4 +87,11 @@ void io::test::bus_mock::_wait_events(std::chrono::milliseconds timeout_msec, st
     {
         throw "test error";
     }
+
+    std::vector<std::pair<handle_t, io::flags>> events;
+    std::swap(events, _native_events);
+    for (const auto &event : events)
+    {
+        dispatch_event(event.first, event.second);
+    }
 }
@@ -8,7 +8,9 @@
 #include <io/bus.hpp>
 
 #include <cstddef>
-#include <set>
+#include <map>
+#include <utility>
+#include <vector>
 
 /// \brief The input/output library namespace
 namespace io
@@ -40,30 +42,53 @@ namespace io
             void set_throw_std_exception(bool do_throw);
             void set_throw_unknown_error(bool do_throw);
 
+            /// @brief Get the registration handle of the \p fd file descriptor
+            /// @param fd The file descriptor
+            /// @return The handle passed to the last \ref _add_fd call for the \p fd
+            handle_t get_handle(file_descriptor_t fd) const;
+            /// @brief Emulate the native I/O event reported by the next \ref _wait_events call
+            /// @param handle The registration handle
+            /// @param mask The I/O event mask
+            void push_native_event(handle_t handle, io::flags mask);
+            /// @brief Check the output readiness watch of the \p fd file descriptor
+            /// @param fd The file descriptor
+            /// @return The last value passed to the \ref _set_output_interest for the \p fd
+            bool has_output_interest(file_descriptor_t fd) const;
+
         private:
             /// @brief Listen on the \p fd file descriptor.
             /// The \ref io::bus::_add_fd pure virtual function implementation.
             /// @param fd The file descriptor
-            void _add_fd(file_descriptor_t fd) override;
+            /// @param handle The registration handle
+            void _add_fd(file_descriptor_t fd, handle_t handle) override;
             /// @brief Stop listening on the \p fd file descriptor
             /// The \ref io::bus::_del_fd pure virtual function implementation.
             /// @param fd The file descriptor
             void _del_fd(file_descriptor_t fd) override;
+            /// @brief Change the output readiness watch of the \p fd file descriptor
+            /// The \ref io::bus::_set_output_interest pure virtual function implementation.
+            /// @param fd The file descriptor
+            /// @param handle The registration handle
+            /// @param enabled Is the output readiness watched
+            void _set_output_interest(file_descriptor_t fd, handle_t handle, bool enabled) override;
 
             /// @brief Wait for I/O events on this bus object.
             /// It waits for the \p timeout_msec milliseconds or
             /// while the \p events_buf_size events is read.
             /// The \ref io::bus::_wait_events pure virtual function implementation.
-            /// @param timeout_msec The maximum time to wait for events, in milliseconds. Or \ref std::chrono::milliseconds{0} for infinit wait.
+            /// @param timeout_msec The maximum time to wait for events, in milliseconds. A negative value means infinite wait, zero means no wait.
             /// @param events_buf_size The events buffer size
-            /// @param callback The I/O bus async event callback function to be called for each I/O event triggered.
-            void _wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size, io::bus::callback_t callback) override;
+            void _wait_events(std::chrono::milliseconds timeout_msec, std::size_t events_buf_size) override;
 
         private:
-            /// \brief The native bus_mock events buffer type.
-            using file_descriptors_set_t = std::set<file_descriptor_t>;
-            /// \brief The native bus_mock events buffer.
-            file_descriptors_set_t _file_descriptors;
+            /// \brief The registered file descriptors to handles map type.
+            using file_descriptors_map_t = std::map<file_descriptor_t, handle_t>;
+            /// \brief The registered file descriptors to handles map.
+            file_descriptors_map_t _file_descriptors;
+            /// \brief The file descriptors watched for the output readiness.
+            std::map<file_descriptor_t, bool> _output_interest;
+            /// \brief The native events to be reported by the next \ref _wait_events call.
+            std::vector<std::pair<handle_t, io::flags>> _native_events;
 
             bool _do_throw_io_error;
             bool _do_throw_std_exception;
@@ -10,7 +10,9 @@ io::test::object_base_mock::object_base_mock(io::bus_ptr bus, io::file_descripto
       _fd(fd),
       _throw_error(false),
       _result_buf_len(-1),
-      _buffer(nullptr)
+      _buffer(nullptr),
+      _is_drained(false),
+      _retained_bytes(0)
 {
 }
 
@@ -43,6 +45,11 @@ void io::test::object_base_mock::set_data_buffer(std::vector<std::byte> *buf)
     _buffer = buf;
 }
 
+void io::test::object_base_mock::set_retained_bytes(std::size_t val)
+{
+    _retained_bytes = val;
+}
+
 ///
 
 io::test::input_object_mock::input_object_mock(io::bus_ptr bus, io::file_descriptor_t fd)
@@ -64,6 +71,12 @@ io::input_object::result_type io::test::input_object_mock::_async_read_some(valu
     {
         return io::error("test error", get_fd(), 123);
     }
+    if (_is_drained)
+    {
+        // EAGAIN: the data of the edge is read
+        _is_drained = false;
+        return io::input_object::success_result_type{get_fd(), buf, 0};
+    }
     std::size_t result_buf_len = buf_len / 2;
     if (0 == result_buf_len)
     {
@@ -71,7 +84,8 @@ io::input_object::result_type io::test::input_object_mock::_async_read_some(valu
     }
     if (-1 != _result_buf_len)
     {
-        result_buf_len = _result_buf_len;
+        // the real socket never transfers more than the buffer length
+        result_buf_len = std::min<std::size_t>(_result_buf_len, buf_len);
     }
     for (std::size_t i = 0; i < result_buf_len; ++i)
     {
@@ -84,6 +98,7 @@ io::input_object::result_type io::test::input_object_mock::_async_read_some(valu
             reinterpret_cast<std::byte *>(buf)[i] = (*_buffer)[i];
         }
     }
+    _is_drained = result_buf_len < buf_len;
     return success_result_type{get_fd(), buf, result_buf_len};
 }
 
@@ -115,7 +130,8 @@ io::output_object::result_type io::test::output_object_mock::_async_write_some(c
     }
     if (-1 != _result_buf_len)
     {
-        result_buf_len = _result_buf_len;
+        // the real socket never transfers more than the buffer length
+        result_buf_len = std::min<std::size_t>(_result_buf_len, buf_len);
     }
     for (std::size_t i = 0; i < result_buf_len; ++i)
     {
@@ -127,6 +143,11 @@ io::output_object::result_type io::test::output_object_mock::_async_write_some(c
     return io::output_object::success_result_type{get_fd(), buf, result_buf_len};
 }
 
+std::size_t io::test::output_object_mock::_get_retained_bytes() const
+{
+    return _retained_bytes;
+}
+
 ///
 
 io::test::io_object_mock::io_object_mock(io::bus_ptr bus, io::file_descriptor_t fd)
@@ -147,6 +168,12 @@ io::input_object::result_type io::test::io_object_mock::_async_read_some(value_t
     {
         return io::error("test error", get_fd(), 123);
     }
+    if (_is_drained)
+    {
+        // EAGAIN: the data of the edge is read
+        _is_drained = false;
+        return io::input_object::success_result_type{get_fd(), buf, 0};
+    }
     std::size_t result_buf_len = buf_len / 2;
     if (0 == result_buf_len)
     {
@@ -154,7 +181,8 @@ io::input_object::result_type io::test::io_object_mock::_async_read_some(value_t
     }
     if (-1 != _result_buf_len)
     {
-        result_buf_len = _result_buf_len;
+        // the real socket never transfers more than the buffer length
+        result_buf_len = std::min<std::size_t>(_result_buf_len, buf_len);
     }
     for (std::size_t i = 0; i < result_buf_len; ++i)
     {
@@ -167,6 +195,7 @@ io::input_object::result_type io::test::io_object_mock::_async_read_some(value_t
             reinterpret_cast<std::byte *>(buf)[i] = (*_buffer)[i];
         }
     }
+    _is_drained = result_buf_len < buf_len;
     return io::input_object::success_result_type{get_fd(), buf, result_buf_len};
 }
 
@@ -187,7 +216,8 @@ io::output_object::result_type io::test::io_object_mock::_async_write_some(const
     }
     if (-1 != _result_buf_len)
     {
-        result_buf_len = _result_buf_len;
+        // the real socket never transfers more than the buffer length
+        result_buf_len = std::min<std::size_t>(_result_buf_len, buf_len);
     }
     for (std::size_t i = 0; i < result_buf_len; ++i)
     {
@@ -198,3 +228,8 @@ io::output_object::result_type io::test::io_object_mock::_async_write_some(const
     }
     return io::output_object::success_result_type{get_fd(), buf, result_buf_len};
 }
+
+std::size_t io::test::io_object_mock::_get_retained_bytes() const
+{
+    return _retained_bytes;
+}
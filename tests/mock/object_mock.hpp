@@ -28,6 +28,7 @@ namespace io
             void set_throw_error(bool val);
             void set_result_buf_len(int val);
             void set_data_buffer(std::vector<std::byte> *buf);
+            void set_retained_bytes(std::size_t val);
 
         private:
             /// @brief Get the underlying file descriptor value for this I/O object
@@ -43,6 +44,10 @@ namespace io
             bool _throw_error;
             int _result_buf_len;
             std::vector<std::byte> *_buffer;
+            /// @brief Was the last read short, the next one reports no data like the drained socket
+            bool _is_drained;
+            /// @brief The written bytes count the output reports as still referenced like the zero-copy send
+            std::size_t _retained_bytes;
 
         private:
             io::bus_ptr _bus;
@@ -85,6 +90,9 @@ namespace io
             /// @param buf_len The length of the \p buf
             /// @return The \ref result_type with length of data written or error occured
             result_type _async_write_some(const value_t *buf, std::size_t buf_len) override;
+            /// @brief Get the bytes count written and still referenced by this object
+            /// @return The count set with the \ref set_retained_bytes
+            std::size_t _get_retained_bytes() const override;
         };
         /// \brief The async output object abstraction smart pointer.
 
@@ -111,6 +119,9 @@ namespace io
             /// @param buf_len The length of the \p buf
             /// @return The \ref result_type with length of data written or error occured
             io::output_object::result_type _async_write_some(const value_t *buf, std::size_t buf_len) override;
+            /// @brief Get the bytes count written and still referenced by this object
+            /// @return The count set with the \ref set_retained_bytes
+            std::size_t _get_retained_bytes() const override;
         };
     }
 }
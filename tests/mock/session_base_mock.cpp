@@ -4,8 +4,12 @@
 
 #include "session_base_mock.hpp"
 
-io::test::session_base_mock::session_base_mock(const io::bus_ptr &bus, io::file_descriptors_vec_t fds)
-    : io::ip::tcp::session_base::session_base(bus, fds)
+io::test::session_base_mock::session_base_mock(
+    const io::bus_ptr &bus,
+    io::file_descriptors_vec_t fds,
+    const io::ip::tcp::session_timeouts &timeouts,
+    io::file_descriptors_vec_t connecting_fds)
+    : io::ip::tcp::session_base::session_base(bus, fds, timeouts, connecting_fds)
 {
 }
 
@@ -21,7 +21,13 @@ namespace io
             /// \brief Construct the session base class for a TCP service
             /// \param bus The \ref io::bus object instance to connect to the system level I/O
             /// \param fds File descriptors related to this session
-            session_base_mock(const io::bus_ptr &bus, io::file_descriptors_vec_t fds);
+            /// \param timeouts The session timeouts
+            /// \param connecting_fds The outgoing connections file descriptors
+            session_base_mock(
+                const io::bus_ptr &bus,
+                io::file_descriptors_vec_t fds,
+                const io::ip::tcp::session_timeouts &timeouts = io::ip::tcp::session_timeouts{},
+                io::file_descriptors_vec_t connecting_fds = io::file_descriptors_vec_t{});
             /// \brief Destruct the session base class for a TCP service
             ~session_base_mock() noexcept override;
 
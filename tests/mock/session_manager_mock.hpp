@@ -9,6 +9,7 @@
 
 #include <io/fd.hpp>
 #include <io/v4.hpp>
+#include <io/endpoint.hpp>
 #include <io/bus.hpp>
 #include <io/session_manager.hpp>
 
@@ -40,7 +41,7 @@ namespace io
             /// \param fd The new client connection file descriptor
             /// \param address The new client connection address
             /// \return The \ref io::ip::tcp::session_base derived object for the newly created session
-            io::ip::tcp::session_base_ptr _make_new_session(io::file_descriptor_t fd, const io::ip::v4 &address);
+            io::ip::tcp::session_base_ptr _make_new_session(io::file_descriptor_t fd, const io::ip::endpoint &address);
 
         private:
             /// \brief The TCP server class to manage new TCP sessions creation
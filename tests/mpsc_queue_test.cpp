@@ -0,0 +1,70 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <io/mpsc_queue.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(mpsc_queue, push_pop)
+{
+    io::util::mpsc_queue<std::unique_ptr<int>> queue;
+    std::unique_ptr<int> value;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(value));
+
+    queue.push(std::make_unique<int>(1));
+    queue.push(std::make_unique<int>(2));
+    EXPECT_FALSE(queue.empty());
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(*value, 1);
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(*value, 2);
+    EXPECT_FALSE(queue.pop(value));
+    EXPECT_TRUE(queue.empty());
+
+    // the values left are destroyed with the queue
+    queue.push(std::make_unique<int>(3));
+}
+
+TEST(mpsc_queue, producers_order)
+{
+    constexpr int producers_count = 4;
+    constexpr int values_count = 10000;
+    io::util::mpsc_queue<std::pair<int, int>> queue;
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < producers_count; ++producer)
+    {
+        producers.emplace_back(
+            [&queue, producer]()
+            {
+                for (int i = 0; i < values_count; ++i)
+                {
+                    queue.push(std::make_pair(producer, i));
+                }
+            });
+    }
+
+    // every producer's values come in its push order
+    std::vector<int> next(producers_count, 0);
+    int popped = 0;
+    std::pair<int, int> value;
+    while (popped < producers_count * values_count)
+    {
+        if (queue.pop(value))
+        {
+            EXPECT_EQ(value.second, next[value.first]);
+            next[value.first] = value.second + 1;
+            ++popped;
+        }
+    }
+    for (std::thread &producer : producers)
+    {
+        producer.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
@@ -35,3 +35,21 @@ TEST(output_object, async_write_some)
     EXPECT_FALSE(error_callback_called);
     EXPECT_TRUE(callback_called);
 }
+
+TEST(output_object, async_writev)
+{
+    io::bus_ptr bus = std::make_shared<io::test::bus_mock>();
+    auto obj = std::make_shared<io::test::output_object_mock>(bus, 1);
+
+    // the buffers are written one by one until the short write
+    const std::byte data[4] = {};
+    struct iovec iov[2] = {{const_cast<std::byte *>(data), 1}, {const_cast<std::byte *>(data) + 1, 3}};
+    obj->set_result_buf_len(1);
+    auto result = obj->async_writev(iov, 2);
+    ASSERT_TRUE(std::holds_alternative<io::output_object::success_result_type>(result));
+    EXPECT_EQ(std::get<io::output_object::success_result_type>(result).buf_len, 2);
+
+    obj->set_throw_error(true);
+    result = obj->async_writev(iov, 2);
+    EXPECT_TRUE(std::holds_alternative<io::error>(result));
+}
@@ -0,0 +1,228 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <psql_proxy/message.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    std::string int16(std::int16_t value)
+    {
+        return std::string{char(value >> 8), char(value)};
+    }
+
+    std::string int32(std::int32_t value)
+    {
+        return std::string{char(value >> 24), char(value >> 16), char(value >> 8), char(value)};
+    }
+
+    std::string str(std::string_view value)
+    {
+        return std::string(value) + '\0';
+    }
+
+    std::optional<psql::message> make(char code, const std::string &payload)
+    {
+        return psql::make_message(std::byte(code), reinterpret_cast<const std::byte *>(payload.data()), payload.size());
+    }
+
+    template <typename T>
+    T make_as(char code, const std::string &payload)
+    {
+        std::optional<psql::message> msg = make(code, payload);
+        EXPECT_TRUE(msg);
+        EXPECT_TRUE(std::holds_alternative<T>(*msg));
+        return std::get<T>(*msg);
+    }
+}
+
+TEST(psql_message, startup)
+{
+    const std::string payload = int16(3) + int16(0) + str("user") + str("postgres") + str("database") + str("db") + str("");
+    const psql::StartupMessage msg = make_as<psql::StartupMessage>('\0', payload);
+
+    EXPECT_EQ(msg.protocol_version.major, 3);
+    EXPECT_EQ(msg.protocol_version.minor, 0);
+    std::vector<std::pair<std::string_view, std::string_view>> params(msg.parameters.begin(), msg.parameters.end());
+    ASSERT_EQ(params.size(), 2);
+    EXPECT_EQ(params[0].first, "user");
+    EXPECT_EQ(params[0].second, "postgres");
+    EXPECT_EQ(params[1].first, "database");
+    EXPECT_EQ(params[1].second, "db");
+    EXPECT_EQ(msg.parameters.find("database"), "db");
+    EXPECT_FALSE(msg.parameters.find("options"));
+    // the fields are the views into the payload
+    EXPECT_EQ(params[0].first.data(), payload.data() + 4);
+}
+
+TEST(psql_message, startup_malformed)
+{
+    EXPECT_FALSE(make('\0', int16(3)));
+    // the closing empty name is missing
+    EXPECT_FALSE(make('\0', int16(3) + int16(0) + str("user") + str("postgres")));
+    // the value is missing
+    EXPECT_FALSE(make('\0', int16(3) + int16(0) + str("user") + str("")));
+    // the data after the closing empty name
+    EXPECT_FALSE(make('\0', int16(3) + int16(0) + str("") + "x"));
+}
+
+TEST(psql_message, untyped_requests)
+{
+    EXPECT_TRUE(std::holds_alternative<psql::SSLRequest>(*make('\0', int32(psql::SSLRequest::REQUEST_CODE))));
+    EXPECT_TRUE(std::holds_alternative<psql::GSSENCRequest>(*make('\0', int32(psql::GSSENCRequest::REQUEST_CODE))));
+    EXPECT_FALSE(make('\0', int32(psql::SSLRequest::REQUEST_CODE) + "x"));
+
+    const std::string payload = int32(psql::CancelRequest::REQUEST_CODE) + int32(4242) + int32(7);
+    const psql::CancelRequest msg = make_as<psql::CancelRequest>('\0', payload);
+    EXPECT_EQ(msg.process_id, 4242);
+    EXPECT_EQ(msg.secret_key, int32(7));
+    EXPECT_FALSE(make('\0', int32(psql::CancelRequest::REQUEST_CODE) + int16(1)));
+}
+
+TEST(psql_message, query)
+{
+    EXPECT_EQ(make_as<psql::Query>('Q', str("select 1;")).query, "select 1;");
+    EXPECT_EQ(make_as<psql::Query>('Q', str("")).query, "");
+    // the terminator is missing
+    EXPECT_FALSE(make('Q', "select 1;"));
+    EXPECT_FALSE(make('Q', ""));
+}
+
+TEST(psql_message, parse)
+{
+    // the message fields are the views, so the payload outlives them
+    const std::string payload = str("stmt") + str("select $1, $2") + int16(2) + int32(23) + int32(0);
+    const psql::Parse msg = make_as<psql::Parse>('P', payload);
+    EXPECT_EQ(msg.statement, "stmt");
+    EXPECT_EQ(msg.query, "select $1, $2");
+    ASSERT_EQ(msg.parameter_types.size(), 2);
+    EXPECT_EQ(msg.parameter_types[0], 23);
+    EXPECT_EQ(msg.parameter_types[1], 0);
+
+    EXPECT_FALSE(make('P', str("stmt") + str("select $1") + int16(2) + int32(23)));
+    EXPECT_FALSE(make('P', str("stmt") + str("select $1") + int16(-1)));
+}
+
+TEST(psql_message, bind)
+{
+    const std::string payload = str("portal") + str("stmt") +
+                                int16(1) + int16(1) +
+                                int16(3) + int32(2) + "42" + int32(-1) + int32(0) +
+                                int16(2) + int16(0) + int16(1);
+    const psql::Bind msg = make_as<psql::Bind>('B', payload);
+    EXPECT_EQ(msg.portal, "portal");
+    EXPECT_EQ(msg.statement, "stmt");
+    ASSERT_EQ(msg.parameter_formats.size(), 1);
+    EXPECT_EQ(msg.parameter_formats[0], 1);
+    std::vector<std::optional<std::string_view>> values(msg.parameters.begin(), msg.parameters.end());
+    ASSERT_EQ(values.size(), 3);
+    EXPECT_EQ(values[0], "42");
+    EXPECT_FALSE(values[1]);
+    EXPECT_EQ(values[2], "");
+    ASSERT_EQ(msg.result_formats.size(), 2);
+    EXPECT_EQ(msg.result_formats[1], 1);
+
+    // the value length overruns the payload
+    EXPECT_FALSE(make('B', str("") + str("") + int16(0) + int16(1) + int32(100) + "42" + int16(0)));
+    EXPECT_FALSE(make('B', str("") + str("") + int16(0) + int16(1) + int32(-2) + int16(0)));
+    // the result formats are missing
+    EXPECT_FALSE(make('B', str("") + str("") + int16(0) + int16(0)));
+}
+
+TEST(psql_message, bind_large_counts)
+{
+    // the counts are unsigned, the server accepts up to 65535 parameters
+    const std::uint16_t count = 0x8000;
+    std::string payload = str("") + str("") + int16(static_cast<std::int16_t>(count));
+    for (std::uint16_t i = 0; i < count; ++i)
+    {
+        payload += int16(1);
+    }
+    payload += int16(static_cast<std::int16_t>(count));
+    for (std::uint16_t i = 0; i < count; ++i)
+    {
+        payload += int32(-1);
+    }
+    payload += int16(0);
+    const psql::Bind msg = make_as<psql::Bind>('B', payload);
+    EXPECT_EQ(msg.parameter_formats.size(), count);
+    EXPECT_EQ(msg.parameter_formats[count - 1], 1);
+    std::vector<std::optional<std::string_view>> values(msg.parameters.begin(), msg.parameters.end());
+    ASSERT_EQ(values.size(), count);
+    EXPECT_FALSE(values[count - 1]);
+
+    // the unsigned count still has to fit the payload
+    EXPECT_FALSE(make('P', str("") + str("select 1") + int16(static_cast<std::int16_t>(0xFFFF)) + int32(23)));
+}
+
+TEST(psql_message, execute_describe_close)
+{
+    const std::string execute_payload = str("portal") + int32(100);
+    const psql::Execute execute = make_as<psql::Execute>('E', execute_payload);
+    EXPECT_EQ(execute.portal, "portal");
+    EXPECT_EQ(execute.max_rows, 100);
+    EXPECT_FALSE(make('E', str("portal") + int16(1)));
+
+    const std::string describe_payload = "S" + str("stmt");
+    const psql::Describe describe = make_as<psql::Describe>('D', describe_payload);
+    EXPECT_EQ(describe.kind, std::byte{'S'});
+    EXPECT_EQ(describe.name, "stmt");
+    EXPECT_FALSE(make('D', "X" + str("stmt")));
+
+    const std::string close_payload = "P" + str("");
+    const psql::Close close = make_as<psql::Close>('C', close_payload);
+    EXPECT_EQ(close.kind, std::byte{'P'});
+    EXPECT_EQ(close.name, "");
+    EXPECT_FALSE(make('C', "P"));
+}
+
+TEST(psql_message, empty_payload)
+{
+    // the frontend 'S' is the Sync, not the backend ParameterStatus
+    EXPECT_TRUE(std::holds_alternative<psql::Sync>(*make('S', "")));
+    EXPECT_TRUE(std::holds_alternative<psql::Flush>(*make('H', "")));
+    EXPECT_TRUE(std::holds_alternative<psql::CopyDone>(*make('c', "")));
+    EXPECT_TRUE(std::holds_alternative<psql::Terminate>(*make('X', "")));
+    EXPECT_FALSE(make('S', "x"));
+    EXPECT_FALSE(make('H', "x"));
+    EXPECT_FALSE(make('c', "x"));
+    EXPECT_FALSE(make('X', "x"));
+}
+
+TEST(psql_message, copy)
+{
+    const std::string rows("1\tone\n2\ttwo\n");
+    const psql::CopyData data = make_as<psql::CopyData>('d', rows);
+    EXPECT_EQ(data.data, rows);
+    EXPECT_EQ(make_as<psql::CopyData>('d', "").data, "");
+    EXPECT_EQ(make_as<psql::CopyFail>('f', str("aborted")).message, "aborted");
+    EXPECT_FALSE(make('f', "aborted"));
+}
+
+TEST(psql_message, password_and_function_call)
+{
+    EXPECT_EQ(make_as<psql::PasswordMessage>('p', str("secret")).data, str("secret"));
+
+    const std::string payload = int32(1598) + int16(0) + int16(1) + int32(1) + "7" + int16(1);
+    const psql::FunctionCall call = make_as<psql::FunctionCall>('F', payload);
+    EXPECT_EQ(call.function_id, 1598);
+    EXPECT_EQ(call.argument_formats.size(), 0);
+    ASSERT_EQ(call.arguments.size(), 1);
+    EXPECT_EQ(*call.arguments.begin(), "7");
+    EXPECT_EQ(call.result_format, 1);
+    EXPECT_FALSE(make('F', int32(1598) + int16(0) + int16(0)));
+}
+
+TEST(psql_message, unknown_code)
+{
+    // the backend messages and the unused codes are not decoded
+    EXPECT_FALSE(make('T', ""));
+    EXPECT_FALSE(make('Z', "I"));
+    EXPECT_FALSE(make('\xff', ""));
+}
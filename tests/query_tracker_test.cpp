@@ -0,0 +1,296 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <psql_proxy/query_tracker.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+    class recording_logger final
+        : public psql_proxy::message_logger
+    {
+    public:
+        std::vector<std::string> messages;
+
+    private:
+        void _add_message(std::string_view prefix, std::string_view message) override
+        {
+            messages.push_back(std::string(prefix) + std::string(message));
+        }
+    };
+
+    std::string frame(char code, const std::string &payload)
+    {
+        const std::uint32_t len = static_cast<std::uint32_t>(payload.size() + sizeof(std::uint32_t));
+        return std::string{code, char(len >> 24), char(len >> 16), char(len >> 8), char(len)} + payload;
+    }
+
+    std::string str(std::string_view value)
+    {
+        return std::string(value) + '\0';
+    }
+
+    std::string data_row(const std::string &value)
+    {
+        const std::uint32_t len = static_cast<std::uint32_t>(value.size());
+        return frame('D', std::string{'\0', '\1', char(len >> 24), char(len >> 16), char(len >> 8), char(len)} + value);
+    }
+
+    std::string error(std::string_view sqlstate)
+    {
+        return frame('E', "SERROR" + str("") + "C" + str(sqlstate) + "M" + str("relation does not exist") + str(""));
+    }
+
+    std::string ready()
+    {
+        return frame('Z', "I");
+    }
+
+    void feed(psql_proxy::query_tracker &tracker, const std::string &stream)
+    {
+        tracker.on_backend_data(reinterpret_cast<const std::byte *>(stream.data()), stream.size());
+    }
+}
+
+TEST(query_tracker, simple_query)
+{
+    recording_logger logger;
+    psql_proxy::query_metrics metrics;
+    psql_proxy::query_tracker tracker(&logger, &metrics, 7);
+
+    // the ReadyForQuery finishing the startup is not a query completion
+    feed(tracker, frame('R', std::string(4, '\0')) + ready());
+    EXPECT_EQ(metrics.latency_ns.count(), 0);
+
+    tracker.on_query("select 1; select 2");
+    ASSERT_EQ(logger.messages.size(), 1);
+    EXPECT_EQ(logger.messages[0], "/* 7.q1 */ select 1; select 2");
+    EXPECT_EQ(tracker.get_pending_count(), 1);
+
+    const std::string result = frame('T', std::string(20, 'x')) + data_row("1") + frame('C', str("SELECT 1"));
+    // byte by byte to split every header and payload
+    for (char c : result + result + ready())
+    {
+        feed(tracker, std::string(1, c));
+    }
+    EXPECT_EQ(tracker.get_pending_count(), 0);
+    EXPECT_EQ(metrics.latency_ns.count(), 1);
+    EXPECT_EQ(metrics.rows.max(), 2);
+    EXPECT_EQ(metrics.bytes.max(), 2 * (25 + 12));
+    ASSERT_EQ(logger.messages.size(), 2);
+    EXPECT_EQ(logger.messages[1].rfind("-- 7.q1: ", 0), 0);
+    EXPECT_NE(logger.messages[1].find("; rows 2; bytes 74"), std::string::npos);
+    EXPECT_TRUE(tracker.is_tracking());
+}
+
+TEST(query_tracker, query_before_startup_completion)
+{
+    recording_logger logger;
+    psql_proxy::query_metrics metrics;
+    psql_proxy::query_tracker tracker(&logger, &metrics, 1);
+
+    // the client may send the query before reading the startup ReadyForQuery
+    tracker.on_sync();
+    tracker.on_query("select 1");
+    feed(tracker, frame('R', std::string(4, '\0')) + ready());
+    EXPECT_EQ(metrics.latency_ns.count(), 0);
+    EXPECT_EQ(tracker.get_pending_count(), 1);
+
+    feed(tracker, data_row("1") + frame('C', str("SELECT 1")) + ready());
+    EXPECT_EQ(metrics.latency_ns.count(), 1);
+    EXPECT_EQ(metrics.rows.max(), 1);
+}
+
+TEST(query_tracker, simple_query_error)
+{
+    recording_logger logger;
+    psql_proxy::query_metrics metrics;
+    psql_proxy::query_tracker tracker(&logger, &metrics, 1);
+
+    tracker.on_query("select * from missing");
+    feed(tracker, error("42P01") + ready());
+    EXPECT_EQ(metrics.errors, 1);
+    ASSERT_EQ(logger.messages.size(), 2);
+    EXPECT_NE(logger.messages[1].find("; rows 0; bytes 0; error 42P01"), std::string::npos);
+}
+
+TEST(query_tracker, pipelined_executions)
+{
+    recording_logger logger;
+    psql_proxy::query_metrics metrics;
+    psql_proxy::query_tracker tracker(&logger, &metrics, 3);
+
+    // P/B/E/S sent three times before reading any response
+    tracker.on_execute(1, std::string_view("insert into t values ($1)"));
+    tracker.on_sync();
+    tracker.on_execute(1, std::nullopt);
+    tracker.on_sync();
+    tracker.on_execute(2, std::string_view("select v from t"));
+    tracker.on_sync();
+    EXPECT_EQ(tracker.get_pending_count(), 6);
+    ASSERT_EQ(logger.messages.size(), 3);
+    EXPECT_EQ(logger.messages[0], "/* 3.s1 */ insert into t values ($1)");
+    EXPECT_EQ(logger.messages[1], "/* 3.s1 */");
+    EXPECT_EQ(logger.messages[2], "/* 3.s2 */ select v from t");
+
+    const std::string parse_bind = frame('1', "") + frame('2', "");
+    feed(tracker, parse_bind + frame('C', str("INSERT 0 1")) + ready() +
+                      parse_bind + frame('C', str("INSERT 0 1")) + ready() +
+                      parse_bind + data_row("a") + data_row("b") + data_row("c") + frame('C', str("SELECT 3")) + ready());
+    EXPECT_EQ(tracker.get_pending_count(), 0);
+    EXPECT_EQ(metrics.latency_ns.count(), 3);
+    EXPECT_EQ(metrics.rows.max(), 3);
+    EXPECT_EQ(metrics.errors, 0);
+    ASSERT_EQ(logger.messages.size(), 6);
+    EXPECT_EQ(logger.messages[3].rfind("-- 3.s1: ", 0), 0);
+    EXPECT_NE(logger.messages[3].find("; rows 1; bytes 0"), std::string::npos);
+    EXPECT_EQ(logger.messages[4].rfind("-- 3.s1: ", 0), 0);
+    EXPECT_EQ(logger.messages[5].rfind("-- 3.s2: ", 0), 0);
+    EXPECT_NE(logger.messages[5].find("; rows 3; bytes 36"), std::string::npos);
+}
+
+TEST(query_tracker, skipped_after_error)
+{
+    recording_logger logger;
+    psql_proxy::query_metrics metrics;
+    psql_proxy::query_tracker tracker(&logger, &metrics, 1);
+
+    // the executions in the same batch after the failed one are skipped up to the Sync
+    tracker.on_execute(1, std::string_view("select 1/0"));
+    tracker.on_execute(2, std::string_view("select 1"));
+    tracker.on_execute(0, std::nullopt);
+    tracker.on_sync();
+    tracker.on_execute(2, std::nullopt);
+    tracker.on_sync();
+
+    feed(tracker, error("22012") + ready());
+    EXPECT_EQ(metrics.latency_ns.count(), 1);
+    EXPECT_EQ(metrics.errors, 1);
+    EXPECT_EQ(tracker.get_pending_count(), 2);
+
+    feed(tracker, data_row("1") + frame('C', str("SELECT 1")) + ready());
+    EXPECT_EQ(tracker.get_pending_count(), 0);
+    EXPECT_EQ(metrics.latency_ns.count(), 2);
+    EXPECT_EQ(metrics.errors, 1);
+    // the Execute of the unknown portal has no statement to refer to
+    ASSERT_EQ(logger.messages.size(), 5);
+    EXPECT_EQ(logger.messages[2], "/* 1.s2 */");
+    EXPECT_NE(logger.messages[3].find("-- 1.s1: "), std::string::npos);
+    EXPECT_NE(logger.messages[3].find("; error 22012"), std::string::npos);
+    EXPECT_EQ(logger.messages[4].rfind("-- 1.s2: ", 0), 0);
+    EXPECT_NE(logger.messages[4].find("; rows 1; bytes 12"), std::string::npos);
+}
+
+TEST(query_tracker, portal_suspended)
+{
+    recording_logger logger;
+    psql_proxy::query_metrics metrics;
+    psql_proxy::query_tracker tracker(&logger, &metrics, 1);
+
+    // the execution with the rows limit is completed by the PortalSuspended
+    tracker.on_execute(1, std::string_view("select v from t"));
+    tracker.on_execute(1, std::nullopt);
+    tracker.on_sync();
+    feed(tracker, data_row("a") + data_row("b") + frame('s', "") + data_row("c") + frame('C', str("SELECT 1")) + ready());
+    EXPECT_EQ(tracker.get_pending_count(), 0);
+    EXPECT_EQ(metrics.latency_ns.count(), 2);
+    EXPECT_EQ(metrics.rows.max(), 2);
+    EXPECT_EQ(metrics.rows.min(), 1);
+}
+
+TEST(query_tracker, encryption_refused)
+{
+    recording_logger logger;
+    psql_proxy::query_metrics metrics;
+    psql_proxy::query_tracker tracker(&logger, &metrics, 1);
+
+    tracker.on_encryption_request();
+    feed(tracker, "N" + frame('R', std::string(4, '\0')) + ready());
+    EXPECT_TRUE(tracker.is_tracking());
+
+    tracker.on_query("select 1");
+    feed(tracker, frame('C', str("SELECT 0")) + ready());
+    EXPECT_EQ(metrics.latency_ns.count(), 1);
+    EXPECT_EQ(metrics.untracked_sessions, 0);
+}
+
+TEST(query_tracker, encryption_accepted)
+{
+    recording_logger logger;
+    psql_proxy::query_metrics metrics;
+    psql_proxy::query_tracker tracker(&logger, &metrics, 1);
+
+    tracker.on_encryption_request();
+    feed(tracker, "S\x16\x03\x01");
+    EXPECT_FALSE(tracker.is_tracking());
+    EXPECT_EQ(metrics.untracked_sessions, 1);
+
+    // the queries are still logged without the reference
+    tracker.on_query("select 1");
+    ASSERT_EQ(logger.messages.size(), 1);
+    EXPECT_EQ(logger.messages[0], "select 1");
+    // the executions still refer to the statements
+    tracker.on_execute(1, std::string_view("select $1"));
+    tracker.on_execute(1, std::nullopt);
+    ASSERT_EQ(logger.messages.size(), 3);
+    EXPECT_EQ(logger.messages[1], "/* 1.s1 */ select $1");
+    EXPECT_EQ(logger.messages[2], "/* 1.s1 */");
+    EXPECT_EQ(tracker.get_pending_count(), 0);
+}
+
+TEST(query_tracker, disabled)
+{
+    recording_logger logger;
+    psql_proxy::query_metrics metrics;
+    psql_proxy::query_tracker tracker(&logger, &metrics, 5, false);
+    EXPECT_FALSE(tracker.is_tracking());
+
+    // the requests are logged, but nothing is pending for the backend stream
+    tracker.on_query("select 1");
+    tracker.on_execute(1, std::string_view("select $1"));
+    tracker.on_sync();
+    EXPECT_EQ(tracker.get_pending_count(), 0);
+    ASSERT_EQ(logger.messages.size(), 2);
+    EXPECT_EQ(logger.messages[0], "select 1");
+    EXPECT_EQ(logger.messages[1], "/* 5.s1 */ select $1");
+    // the session disabled on purpose is not counted as untracked
+    EXPECT_EQ(metrics.untracked_sessions, 0);
+}
+
+TEST(query_tracker, pending_limit)
+{
+    recording_logger logger;
+    psql_proxy::query_metrics metrics;
+    psql_proxy::query_tracker tracker(&logger, &metrics, 1);
+
+    for (std::size_t i = 0; i < psql_proxy::query_tracker::MAX_PENDING; ++i)
+    {
+        tracker.on_execute(1, std::nullopt);
+    }
+    EXPECT_TRUE(tracker.is_tracking());
+    tracker.on_sync();
+    EXPECT_FALSE(tracker.is_tracking());
+    EXPECT_EQ(tracker.get_pending_count(), 0);
+    EXPECT_EQ(metrics.untracked_sessions, 1);
+
+    feed(tracker, frame('C', str("SELECT 1")) + ready());
+    EXPECT_EQ(metrics.latency_ns.count(), 0);
+}
+
+TEST(query_tracker, malformed_stream)
+{
+    recording_logger logger;
+    psql_proxy::query_metrics metrics;
+    psql_proxy::query_tracker tracker(&logger, &metrics, 1);
+
+    tracker.on_query("select 1");
+    // the length is less than its own size
+    feed(tracker, std::string("C\0\0\0\1", 5));
+    EXPECT_FALSE(tracker.is_tracking());
+    EXPECT_EQ(metrics.untracked_sessions, 1);
+}
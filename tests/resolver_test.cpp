@@ -0,0 +1,89 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <io/resolver.hpp>
+#include <io/error.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    /// @brief Wait for the \p predicate to become true
+    template <typename Predicate>
+    bool wait_for(Predicate predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (!predicate() && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        return predicate();
+    }
+}
+
+TEST(resolver, resolve_addrinfo)
+{
+    io::ip::resolver resolver(io::ip::v4{"127.0.0.1", "5432"}, std::chrono::milliseconds{0});
+    auto endpoints = resolver.get_endpoints();
+    ASSERT_FALSE(endpoints->empty());
+    EXPECT_EQ(endpoints->front().family(), AF_INET);
+    EXPECT_EQ(endpoints->front().host(), "127.0.0.1");
+    EXPECT_EQ(endpoints->front().port(), 5432);
+    EXPECT_EQ(resolver.get_address().port(), 5432);
+    EXPECT_EQ(resolver.get_refresh_count(), 0);
+}
+
+TEST(resolver, resolve_error)
+{
+    EXPECT_THROW(
+        (io::ip::resolver{
+            io::ip::v4{"127.0.0.1", "5432"},
+            std::chrono::milliseconds{0},
+            [](const io::ip::v4 &) -> io::ip::resolver::endpoints_t
+            {
+                throw io::error("test error", -1, 0);
+            }}),
+        io::error);
+    EXPECT_THROW(
+        (io::ip::resolver{
+            io::ip::v4{"127.0.0.1", "5432"},
+            std::chrono::milliseconds{0},
+            [](const io::ip::v4 &)
+            {
+                return io::ip::resolver::endpoints_t{};
+            }}),
+        io::error);
+}
+
+TEST(resolver, refresh)
+{
+    // the first resolve is the primary, the refreshes fail over to the standby or fail
+    std::atomic_int calls{0};
+    io::ip::resolver resolver(
+        io::ip::v4{"127.0.0.1", "5432"},
+        std::chrono::milliseconds{1},
+        [&](const io::ip::v4 &address)
+        {
+            const int call = calls.fetch_add(1);
+            if (call > 0 && 0 == call % 2)
+            {
+                throw std::runtime_error("test resolve failure");
+            }
+            const uint16_t port = (0 == call) ? address.port() : address.port() + 1;
+            return io::ip::resolver::endpoints_t{io::ip::endpoint(io::ip::v4{"127.0.0.1", std::to_string(port)})};
+        });
+    auto primary = resolver.get_endpoints();
+    EXPECT_EQ(primary->front().port(), 5432);
+
+    ASSERT_TRUE(wait_for([&]
+                         { return resolver.get_refresh_count() > 0 && resolver.get_failure_count() > 0; }));
+    // the failed refresh keeps the last resolved endpoints
+    EXPECT_EQ(resolver.get_endpoints()->front().port(), 5433);
+    // the readers keep the old list alive
+    EXPECT_EQ(primary->front().port(), 5432);
+}
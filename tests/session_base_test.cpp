@@ -7,7 +7,10 @@
 #include "mock/bus_mock.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <memory>
 #include <sstream>
+#include <thread>
 
 TEST(session_base, getters_start)
 {
@@ -25,3 +28,54 @@ TEST(session_base, getters_start)
         std::chrono::milliseconds{0},
         1);
 }
+
+TEST(session_base, idle_timeout)
+{
+    io::bus_ptr bus = std::make_shared<io::test::bus_mock>();
+    io::ip::tcp::session_timeouts timeouts;
+    timeouts.idle = std::chrono::milliseconds{20};
+    auto sess = std::make_shared<io::test::session_base_mock>(bus, io::file_descriptors_vec_t{1, 2}, timeouts);
+    sess->base_start();
+    std::weak_ptr<io::test::session_base_mock> weak_sess = sess;
+    sess.reset();
+    EXPECT_FALSE(weak_sess.expired());
+
+    // the activity postpones the idle timeout
+    const auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds{40})
+    {
+        bus->enqueue_event(2, io::flags::in);
+        bus->wait_events(std::chrono::milliseconds{1}, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    EXPECT_FALSE(weak_sess.expired());
+
+    const auto idle_start = std::chrono::steady_clock::now();
+    while (!weak_sess.expired() && std::chrono::steady_clock::now() - idle_start < std::chrono::seconds{1})
+    {
+        bus->wait_events(std::chrono::milliseconds{1}, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    EXPECT_TRUE(weak_sess.expired());
+    EXPECT_LE(std::chrono::milliseconds{20}, std::chrono::steady_clock::now() - idle_start);
+}
+
+TEST(session_base, connect_timeout)
+{
+    io::bus_ptr bus = std::make_shared<io::test::bus_mock>();
+    io::ip::tcp::session_timeouts timeouts;
+    timeouts.connect = std::chrono::milliseconds{10};
+    // the fd is not a connected socket
+    auto sess = std::make_shared<io::test::session_base_mock>(bus, io::file_descriptors_vec_t{1, 12345}, timeouts, io::file_descriptors_vec_t{12345});
+    sess->base_start();
+    std::weak_ptr<io::test::session_base_mock> weak_sess = sess;
+    sess.reset();
+
+    const auto start = std::chrono::steady_clock::now();
+    while (!weak_sess.expired() && std::chrono::steady_clock::now() - start < std::chrono::seconds{1})
+    {
+        bus->wait_events(std::chrono::milliseconds{1}, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    EXPECT_TRUE(weak_sess.expired());
+}
@@ -0,0 +1,114 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <io/socket_options.hpp>
+#include <io/error.hpp>
+
+#include <stdexcept>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+    int get_option(int fd, int level, int name)
+    {
+        int value = -1;
+        socklen_t len = sizeof(value);
+        EXPECT_EQ(0, ::getsockopt(fd, level, name, &value, &len));
+        return value;
+    }
+}
+
+TEST(socket_options, parse)
+{
+    io::ip::tcp::socket_options base;
+    base.zerocopy_threshold = 4096;
+    const auto options = io::ip::tcp::parse_socket_options(
+        "nodelay,quickack,rcvbuf=262144,sndbuf=131072,notsent_lowat=16384,keepalive=60:10:3,incoming_cpu=1,fastopen_connect,defer_accept=5,fastopen=128",
+        base);
+    EXPECT_EQ(options.zerocopy_threshold, 4096);
+    EXPECT_TRUE(options.no_delay);
+    EXPECT_TRUE(options.quick_ack);
+    EXPECT_EQ(options.receive_buffer, 262144);
+    EXPECT_EQ(options.send_buffer, 131072);
+    EXPECT_EQ(options.not_sent_low_watermark, 16384);
+    EXPECT_TRUE(options.keep_alive);
+    EXPECT_EQ(options.keep_alive_idle.count(), 60);
+    EXPECT_EQ(options.keep_alive_interval.count(), 10);
+    EXPECT_EQ(options.keep_alive_count, 3);
+    EXPECT_EQ(options.incoming_cpu, 1);
+    EXPECT_TRUE(options.fast_open_connect);
+    EXPECT_EQ(options.defer_accept.count(), 5);
+    EXPECT_EQ(options.fast_open_queue, 128);
+    EXPECT_EQ(options.busy_poll.count(), 0);
+    EXPECT_FALSE(options.prefer_busy_poll);
+
+    const auto busy_poll = io::ip::tcp::parse_socket_options("busy_poll=50,prefer_busy_poll");
+    EXPECT_EQ(busy_poll.busy_poll.count(), 50);
+    EXPECT_TRUE(busy_poll.prefer_busy_poll);
+
+    const auto defaults = io::ip::tcp::parse_socket_options("default");
+    EXPECT_FALSE(defaults.no_delay);
+    EXPECT_EQ(defaults.incoming_cpu, -1);
+    EXPECT_TRUE(io::ip::tcp::parse_socket_options("keepalive").keep_alive);
+    EXPECT_FALSE(io::ip::tcp::parse_socket_options("").no_delay);
+
+    EXPECT_THROW(io::ip::tcp::parse_socket_options("nagle"), std::invalid_argument);
+    EXPECT_THROW(io::ip::tcp::parse_socket_options("nodelay=1"), std::invalid_argument);
+    EXPECT_THROW(io::ip::tcp::parse_socket_options("rcvbuf"), std::invalid_argument);
+    EXPECT_THROW(io::ip::tcp::parse_socket_options("rcvbuf=64k"), std::invalid_argument);
+    EXPECT_THROW(io::ip::tcp::parse_socket_options("rcvbuf=-1"), std::invalid_argument);
+    EXPECT_THROW(io::ip::tcp::parse_socket_options("keepalive=1:2:3:4"), std::invalid_argument);
+    EXPECT_THROW(io::ip::tcp::parse_socket_options("busy_poll"), std::invalid_argument);
+    EXPECT_THROW(io::ip::tcp::parse_socket_options("prefer_busy_poll=1"), std::invalid_argument);
+}
+
+TEST(socket_options, set_socket_options)
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    ASSERT_NE(-1, fd);
+    const auto options = io::ip::tcp::parse_socket_options("nodelay,quickack,sndbuf=65536,notsent_lowat=16384,keepalive=60:10:3,incoming_cpu=0,fastopen_connect");
+    io::ip::tcp::set_socket_options(fd, options);
+    EXPECT_EQ(1, get_option(fd, IPPROTO_TCP, TCP_NODELAY));
+    // the kernel doubles the value to account for the bookkeeping overhead
+    EXPECT_EQ(2 * 65536, get_option(fd, SOL_SOCKET, SO_SNDBUF));
+    EXPECT_EQ(16384, get_option(fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT));
+    EXPECT_EQ(1, get_option(fd, SOL_SOCKET, SO_KEEPALIVE));
+    EXPECT_EQ(60, get_option(fd, IPPROTO_TCP, TCP_KEEPIDLE));
+    EXPECT_EQ(10, get_option(fd, IPPROTO_TCP, TCP_KEEPINTVL));
+    EXPECT_EQ(3, get_option(fd, IPPROTO_TCP, TCP_KEEPCNT));
+    EXPECT_EQ(0, get_option(fd, SOL_SOCKET, SO_INCOMING_CPU));
+    ::close(fd);
+
+    io::ip::tcp::socket_options invalid;
+    invalid.no_delay = true;
+    EXPECT_THROW(io::ip::tcp::set_socket_options(-1, invalid), io::error);
+}
+
+TEST(socket_options, set_busy_poll)
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    ASSERT_NE(-1, fd);
+    // the unprivileged process is refused above net.core.busy_read, the option is skipped then, the session is not
+    EXPECT_NO_THROW(io::ip::tcp::set_socket_options(fd, io::ip::tcp::parse_socket_options("busy_poll=1000000,prefer_busy_poll,nodelay")));
+    EXPECT_EQ(1, get_option(fd, IPPROTO_TCP, TCP_NODELAY));
+    ::close(fd);
+}
+
+TEST(socket_options, set_listener_options)
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    ASSERT_NE(-1, fd);
+    const auto options = io::ip::tcp::parse_socket_options("rcvbuf=65536,defer_accept=5,fastopen=16");
+    io::ip::tcp::set_listener_options(fd, options);
+    EXPECT_EQ(2 * 65536, get_option(fd, SOL_SOCKET, SO_RCVBUF));
+    // the seconds are rounded up to the SYN-ACK retransmits schedule
+    EXPECT_GE(get_option(fd, IPPROTO_TCP, TCP_DEFER_ACCEPT), 5);
+    EXPECT_EQ(16, get_option(fd, IPPROTO_TCP, TCP_FASTOPEN));
+    ::close(fd);
+}
@@ -11,6 +11,12 @@
 
 #include <memory>
 #include <iostream>
+#include <thread>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 TEST(socket, constructor_getters)
 {
@@ -27,7 +33,7 @@ TEST(socket, constructor_getters)
         io::ip::tcp::acceptor acceptor(
             bus,
             address, 1024,
-            [&](io::file_descriptor_t fd, const io::ip::v4 &)
+            [&](io::file_descriptor_t fd, const io::ip::endpoint &)
             {
                 callback_called = true;
                 sock = std::make_shared<io::ip::tcp::socket>(bus, fd);
@@ -154,3 +160,235 @@ TEST(socket, constructor_getters)
         std::cerr << error.what() << "; errno = " << error.get_errno() << " for fd = " << error.get_fd() << std::endl;
     }
 }
+
+TEST(socket, connect_endpoints)
+{
+    io::bus_ptr bus = std::make_shared<io::test::bus_mock>();
+    EXPECT_THROW((io::ip::tcp::socket{bus, std::vector<io::ip::endpoint>{}}), io::error);
+
+    io::ip::v4 address{"127.0.0.1", "23458"};
+    std::size_t accepted = 0;
+    io::ip::tcp::acceptor acceptor(
+        bus,
+        address, 16,
+        [&](io::file_descriptor_t fd, const io::ip::endpoint &)
+        {
+            ++accepted;
+        });
+    // the unsupported address family is skipped
+    io::ip::tcp::socket sock(bus, std::vector<io::ip::endpoint>{io::ip::endpoint{}, io::ip::endpoint{address}});
+    EXPECT_NE(sock.get_fd(), -1);
+}
+
+TEST(socket, connect_fallback)
+{
+    auto bus = std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
+
+    // nobody listens on the first address
+    io::ip::v4 refused{"127.0.0.1", "23461"};
+    io::ip::v4 address{"127.0.0.1", "23462"};
+    io::file_descriptor_t accepted = -1;
+    io::ip::tcp::acceptor acceptor(
+        bus,
+        address, 16,
+        [&](io::file_descriptor_t fd, const io::ip::endpoint &)
+        {
+            accepted = fd;
+        });
+
+    io::ip::tcp::socket sock(
+        bus,
+        std::vector<io::ip::endpoint>{io::ip::endpoint{refused}, io::ip::endpoint{address}},
+        std::chrono::milliseconds{1000});
+    const io::file_descriptor_t fd = sock.get_fd();
+
+    const char data[] = "ping";
+    for (int i = 0; i < 100 && (sock.is_connecting() || -1 == accepted); ++i)
+    {
+        if (sock.is_connecting())
+        {
+            // nothing is written until the connection is established
+            auto result = sock.async_write_some(data, sizeof(data));
+            ASSERT_TRUE(std::holds_alternative<io::output_object::success_result_type>(result));
+            EXPECT_EQ(std::get<io::output_object::success_result_type>(result).buf_len, 0);
+        }
+        bus->wait_events(
+            std::chrono::milliseconds{10},
+            16,
+            [&](io::event_reciever *, const io::error &error)
+            {
+                ADD_FAILURE() << error.what();
+            });
+    }
+    EXPECT_FALSE(sock.is_connecting());
+    ASSERT_NE(accepted, -1);
+    // the file descriptor value is kept by the fallback
+    EXPECT_EQ(sock.get_fd(), fd);
+
+    auto result = sock.async_write_some(data, sizeof(data));
+    ASSERT_TRUE(std::holds_alternative<io::output_object::success_result_type>(result));
+    EXPECT_EQ(std::get<io::output_object::success_result_type>(result).buf_len, sizeof(data));
+    char recieved[sizeof(data)] = {};
+    EXPECT_EQ(::recv(accepted, recieved, sizeof(recieved), MSG_WAITALL), static_cast<ssize_t>(sizeof(data)));
+    EXPECT_STREQ(recieved, data);
+    ::close(accepted);
+}
+
+TEST(socket, connect_deadline)
+{
+    // the mock bus reports no readiness, so the connect attempts never complete
+    auto bus = std::make_shared<io::test::bus_mock>();
+    io::ip::v4 address{"127.0.0.1", "23463"};
+    io::ip::tcp::acceptor acceptor(
+        bus,
+        address, 16,
+        [&](io::file_descriptor_t fd, const io::ip::endpoint &)
+        {
+            ::close(fd);
+        });
+
+    io::ip::tcp::socket sock(
+        bus,
+        std::vector<io::ip::endpoint>{io::ip::endpoint{address}, io::ip::endpoint{address}},
+        std::chrono::milliseconds{20});
+    EXPECT_TRUE(sock.is_connecting());
+    EXPECT_TRUE(bus->has_output_interest(sock.get_fd()));
+
+    bool error_event = false;
+    sock.add_bus_callback(
+        [&](io::event_reciever *, io::file_descriptor_t, io::flags mask)
+        {
+            error_event = error_event || mask.test(io::flags::error);
+        });
+    for (int i = 0; i < 100 && !error_event; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+        bus->wait_events(
+            std::chrono::milliseconds{0},
+            1,
+            [&](io::event_reciever *, const io::error &error)
+            {
+                ADD_FAILURE() << error.what();
+            });
+    }
+    EXPECT_TRUE(error_event);
+    EXPECT_FALSE(sock.is_connecting());
+
+    char data[1];
+    auto result = sock.async_write_some(data, sizeof(data));
+    ASSERT_TRUE(std::holds_alternative<io::error>(result));
+    EXPECT_EQ(std::get<io::error>(result).get_errno(), ETIMEDOUT);
+}
+
+TEST(socket, zerocopy_completion)
+{
+    auto bus = std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
+    io::ip::v4 address{"127.0.0.1", "23465"};
+    io::file_descriptor_t accepted = -1;
+    io::ip::tcp::acceptor acceptor(
+        bus,
+        address, 16,
+        [&](io::file_descriptor_t fd, const io::ip::endpoint &)
+        {
+            accepted = fd;
+        });
+    io::ip::tcp::socket sock(bus, std::vector<io::ip::endpoint>{io::ip::endpoint{address}});
+    sock.set_zerocopy_threshold(1024);
+    EXPECT_EQ(sock.get_zerocopy_threshold(), 1024);
+
+    bool error_event = false;
+    bool output_event = false;
+    sock.add_bus_callback(
+        [&](io::event_reciever *, io::file_descriptor_t, io::flags mask)
+        {
+            error_event = error_event || mask.test(io::flags::error);
+            output_event = output_event || mask.test(io::flags::out);
+        });
+    auto no_error = [](io::event_reciever *, const io::error &error)
+    {
+        ADD_FAILURE() << error.what();
+    };
+    for (int i = 0; i < 100 && (sock.is_connecting() || -1 == accepted); ++i)
+    {
+        bus->wait_events(std::chrono::milliseconds{10}, 16, no_error);
+    }
+    ASSERT_FALSE(sock.is_connecting());
+    ASSERT_NE(accepted, -1);
+    output_event = false;
+
+    // the small write is copied, the large one is retained until its completion is reported
+    std::vector<char> data(64 * 1024, 'z');
+    auto result = sock.async_write_some(data.data(), 100);
+    ASSERT_TRUE(std::holds_alternative<io::output_object::success_result_type>(result));
+    EXPECT_EQ(sock.get_retained_bytes(), 0);
+    result = sock.async_write_some(data.data(), data.size());
+    ASSERT_TRUE(std::holds_alternative<io::output_object::success_result_type>(result));
+    const std::size_t written = std::get<io::output_object::success_result_type>(result).buf_len;
+    EXPECT_EQ(sock.get_zerocopy_sends_count(), 1);
+    EXPECT_EQ(sock.get_retained_bytes(), written);
+
+    for (int i = 0; i < 100 && 0 != sock.get_retained_bytes(); ++i)
+    {
+        char buf[16 * 1024];
+        while (::recv(accepted, buf, sizeof(buf), MSG_DONTWAIT) > 0)
+        {
+        }
+        bus->wait_events(std::chrono::milliseconds{10}, 16, no_error);
+    }
+    EXPECT_EQ(sock.get_retained_bytes(), 0);
+    // the completion is not an error
+    EXPECT_TRUE(output_event);
+    EXPECT_FALSE(error_event);
+    ::close(accepted);
+}
+
+TEST(socket, quick_ack)
+{
+    auto bus = std::make_shared<io::system::epoll>(EPOLLIN | EPOLLPRI | EPOLLET);
+    io::ip::v4 address{"127.0.0.1", "23466"};
+    io::file_descriptor_t accepted = -1;
+    io::ip::tcp::acceptor acceptor(
+        bus,
+        address, 16,
+        [&](io::file_descriptor_t fd, const io::ip::endpoint &)
+        {
+            accepted = fd;
+        });
+    io::ip::tcp::socket_options options;
+    options.quick_ack = true;
+    io::ip::tcp::socket sock(bus, std::vector<io::ip::endpoint>{io::ip::endpoint{address}}, std::chrono::milliseconds{0}, options);
+    EXPECT_TRUE(sock.is_quick_ack());
+
+    auto no_error = [](io::event_reciever *, const io::error &error)
+    {
+        ADD_FAILURE() << error.what();
+    };
+    for (int i = 0; i < 100 && (sock.is_connecting() || -1 == accepted); ++i)
+    {
+        bus->wait_events(std::chrono::milliseconds{10}, 16, no_error);
+    }
+    ASSERT_FALSE(sock.is_connecting());
+    ASSERT_NE(accepted, -1);
+
+    // the delayed ACKs are back like after the system left the quick ACK mode
+    int value = 0;
+    ASSERT_EQ(0, ::setsockopt(sock.get_fd(), IPPROTO_TCP, TCP_QUICKACK, &value, sizeof(value)));
+    ASSERT_EQ(1, ::send(accepted, "x", 1, 0));
+    char buf[16];
+    std::size_t recieved = 0;
+    for (int i = 0; i < 100 && 0 == recieved; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        io::input_object::result_type result = sock.async_read_some(buf, sizeof(buf));
+        ASSERT_TRUE(std::holds_alternative<io::input_object::success_result_type>(result));
+        recieved = std::get<io::input_object::success_result_type>(result).buf_len;
+    }
+    ASSERT_EQ(recieved, 1);
+    socklen_t value_size = sizeof(value);
+    ASSERT_EQ(0, ::getsockopt(sock.get_fd(), IPPROTO_TCP, TCP_QUICKACK, &value, &value_size));
+    EXPECT_EQ(value, 1);
+
+    sock.set_quick_ack(false);
+    EXPECT_FALSE(sock.is_quick_ack());
+    ::close(accepted);
+}
@@ -0,0 +1,102 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <psql_proxy/statement_cache.hpp>
+
+#include <string>
+
+namespace
+{
+    /// @brief Get the reported query text of the execution
+    std::optional<std::string_view> reported(psql_proxy::statement_cache &cache, std::string_view portal)
+    {
+        std::optional<psql_proxy::statement_cache::execution> execution = cache.execute(portal);
+        return execution ? execution->query : std::nullopt;
+    }
+}
+
+TEST(statement_cache, unnamed)
+{
+    psql_proxy::statement_cache cache;
+    cache.parse("", "select $1");
+    cache.bind("", "");
+    EXPECT_EQ(reported(cache, ""), "select $1");
+    // the statement is reported once
+    EXPECT_FALSE(reported(cache, ""));
+
+    // the same text parsed again is the same statement
+    cache.parse("", std::string("select $1"));
+    cache.bind("", "");
+    EXPECT_FALSE(reported(cache, ""));
+
+    cache.parse("", "select $1, $2");
+    cache.bind("", "");
+    EXPECT_EQ(reported(cache, ""), "select $1, $2");
+    // the executions refer to the statement by id
+    EXPECT_EQ(cache.execute("")->statement_id, 2);
+    EXPECT_EQ(cache.get_statements_count(), 1);
+    EXPECT_EQ(cache.get_portals_count(), 1);
+}
+
+TEST(statement_cache, named)
+{
+    psql_proxy::statement_cache cache;
+    cache.parse("s1", "select 1");
+    cache.parse("s2", "select 2");
+    cache.bind("p1", "s1");
+    cache.bind("", "s2");
+    EXPECT_EQ(reported(cache, ""), "select 2");
+    EXPECT_EQ(reported(cache, "p1"), "select 1");
+    EXPECT_EQ(cache.get_statements_count(), 2);
+    EXPECT_EQ(cache.get_portals_count(), 2);
+
+    // the backend keeps the named statement defined again
+    cache.parse("s2", "select 22");
+    cache.bind("", "s2");
+    EXPECT_EQ(cache.execute("")->statement_id, 2);
+    EXPECT_EQ(cache.get_statements_count(), 2);
+
+    // the portal keeps the unnamed statement replaced after the Bind
+    cache.parse("", "select 3");
+    cache.bind("p2", "");
+    cache.parse("", "select 33");
+    cache.bind("", "");
+    EXPECT_EQ(reported(cache, "p2"), "select 3");
+    EXPECT_EQ(reported(cache, ""), "select 33");
+}
+
+TEST(statement_cache, unknown)
+{
+    psql_proxy::statement_cache cache;
+    EXPECT_FALSE(cache.execute(""));
+    cache.parse("s1", "select 1");
+    cache.bind("", "s1");
+    // the failed Bind destroys the portal
+    cache.bind("", "s2");
+    EXPECT_FALSE(cache.execute(""));
+    EXPECT_EQ(cache.get_portals_count(), 0);
+}
+
+TEST(statement_cache, close)
+{
+    psql_proxy::statement_cache cache;
+    cache.parse("s1", "select 1");
+    cache.parse("s2", "select 2");
+    cache.bind("p1", "s1");
+    cache.bind("p2", "s1");
+    cache.bind("p3", "s2");
+
+    cache.close_portal("p3");
+    EXPECT_EQ(cache.get_portals_count(), 2);
+    // closing the statement closes its portals
+    cache.close_statement("s1");
+    EXPECT_EQ(cache.get_statements_count(), 1);
+    EXPECT_EQ(cache.get_portals_count(), 0);
+    EXPECT_FALSE(cache.execute("p1"));
+
+    cache.close_statement("s3");
+    cache.close_portal("p4");
+    EXPECT_EQ(cache.get_statements_count(), 1);
+}
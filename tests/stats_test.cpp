@@ -0,0 +1,114 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <io/stats.hpp>
+#include <io/bus.hpp>
+#include "mock/bus_mock.hpp"
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+TEST(stats, histogram_bucket_of)
+{
+    EXPECT_EQ(io::stats::histogram::bucket_of(0), 0);
+    EXPECT_EQ(io::stats::histogram::bucket_of(1), 1);
+    EXPECT_EQ(io::stats::histogram::bucket_of(2), 2);
+    EXPECT_EQ(io::stats::histogram::bucket_of(3), 2);
+    EXPECT_EQ(io::stats::histogram::bucket_of(4), 3);
+    EXPECT_EQ(io::stats::histogram::bucket_of(UINT64_MAX), 64);
+}
+
+TEST(stats, histogram_record)
+{
+    io::stats::histogram h;
+    EXPECT_EQ(h.count(), 0);
+    EXPECT_EQ(h.percentile(0.5), 0);
+    for (std::uint64_t value : {5, 1, 100, 7})
+    {
+        h.record(value);
+    }
+    EXPECT_EQ(h.count(), 4);
+    EXPECT_EQ(h.sum(), 113);
+    EXPECT_EQ(h.min(), 1);
+    EXPECT_EQ(h.max(), 100);
+    EXPECT_EQ(h.buckets()[1], 1);
+    EXPECT_EQ(h.buckets()[3], 2);
+    EXPECT_EQ(h.buckets()[7], 1);
+    EXPECT_EQ(h.percentile(0.0), 1);
+    EXPECT_EQ(h.percentile(0.5), 7);
+    EXPECT_EQ(h.percentile(1.0), 100);
+
+    h.reset();
+    EXPECT_EQ(h.count(), 0);
+    EXPECT_EQ(h.max(), 0);
+}
+
+TEST(stats, ostream)
+{
+    io::stats::bus_stats stats;
+    std::ostringstream empty;
+    empty << stats.wait_ns;
+    EXPECT_EQ(empty.str(), "count: 0");
+
+    stats.wait_ns.record(10);
+    stats.callback_ns[static_cast<std::size_t>(io::callback_class::acceptor)].record(3);
+    std::ostringstream os;
+    os << stats;
+    EXPECT_NE(os.str().find("wait ns: count: 1; mean: 10; min: 10"), std::string::npos);
+    EXPECT_NE(os.str().find("acceptor callback ns: count: 1"), std::string::npos);
+    EXPECT_EQ(os.str().find("session callback ns"), std::string::npos);
+    EXPECT_NE(os.str().find("exceptions: 0"), std::string::npos);
+}
+
+TEST(stats, callback_class_to_string)
+{
+    EXPECT_STREQ(io::to_string(io::callback_class::other), "other");
+    EXPECT_STREQ(io::to_string(io::callback_class::acceptor), "acceptor");
+    EXPECT_STREQ(io::to_string(io::callback_class::channel_left), "channel_left");
+    EXPECT_STREQ(io::to_string(io::callback_class::channel_right), "channel_right");
+    EXPECT_STREQ(io::to_string(io::callback_class::session), "session");
+    EXPECT_STREQ(io::to_string(io::callback_class::wakeup), "wakeup");
+}
+
+#ifdef _IO_STATS_ENABLED
+TEST(stats, bus_stats)
+{
+    auto bus = std::make_shared<io::test::bus_mock>();
+    bus->add_fd(
+        1,
+        [](io::event_reciever *, io::file_descriptor_t, io::flags)
+        {
+        },
+        io::callback_class::session);
+    bus->add_fd(
+        2,
+        [](io::event_reciever *, io::file_descriptor_t, io::flags)
+        {
+            throw std::runtime_error("test");
+        });
+    bus->enqueue_event(1, io::flags::in);
+    bus->enqueue_event(2, io::flags::in);
+    bus->wait_events(
+        std::chrono::milliseconds{0},
+        1,
+        [](io::event_reciever *, const io::error &)
+        {
+        });
+
+    const io::stats::bus_stats &stats = bus->get_stats();
+    EXPECT_EQ(stats.wait_ns.count(), 1);
+    EXPECT_EQ(stats.processing_ns.count(), 1);
+    EXPECT_EQ(stats.events_per_wait.count(), 1);
+    EXPECT_EQ(stats.deferred_per_wait.count(), 1);
+    EXPECT_EQ(stats.deferred_per_wait.max(), 2);
+    EXPECT_EQ(stats.callback_ns[static_cast<std::size_t>(io::callback_class::session)].count(), 1);
+    EXPECT_EQ(stats.callback_ns[static_cast<std::size_t>(io::callback_class::other)].count(), 1);
+    EXPECT_EQ(stats.exceptions, 1);
+
+    bus->get_stats().reset();
+    EXPECT_EQ(bus->get_stats().wait_ns.count(), 0);
+}
+#endif // _IO_STATS_ENABLED
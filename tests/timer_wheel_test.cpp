@@ -0,0 +1,166 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <io/timer_wheel.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST(timer_wheel, fires_in_order)
+{
+    const auto start = io::timer_wheel::clock_t::now();
+    io::timer_wheel timers(start);
+    std::vector<int> fired;
+    timers.arm(5ms, [&]() { fired.push_back(5); });
+    timers.arm(1ms, [&]() { fired.push_back(1); });
+    timers.arm(300ms, [&]() { fired.push_back(300); });
+    timers.arm(70000ms, [&]() { fired.push_back(70000); });
+    EXPECT_EQ(timers.size(), 4);
+
+    timers.advance(start + 4ms);
+    EXPECT_EQ(fired, (std::vector<int>{1}));
+    timers.advance(start + 5ms);
+    EXPECT_EQ(fired, (std::vector<int>{1, 5}));
+    timers.advance(start + 299ms);
+    EXPECT_EQ(fired, (std::vector<int>{1, 5}));
+    timers.advance(start + 300ms);
+    EXPECT_EQ(fired, (std::vector<int>{1, 5, 300}));
+    timers.advance(start + 69999ms);
+    EXPECT_EQ(fired.size(), 3);
+    timers.advance(start + 70000ms);
+    EXPECT_EQ(fired, (std::vector<int>{1, 5, 300, 70000}));
+    EXPECT_EQ(timers.size(), 0);
+}
+
+TEST(timer_wheel, cascades_from_all_levels)
+{
+    const auto start = io::timer_wheel::clock_t::now();
+    io::timer_wheel timers(start);
+    // move the wheel to the middle of the slot rotations
+    timers.advance(start + 12345ms);
+    const std::vector<std::int64_t> delays = {255, 256, 257, 65535, 65536, 65537, 16777217};
+    std::vector<std::int64_t> fired_at;
+    for (std::int64_t delay : delays)
+    {
+        timers.arm(std::chrono::milliseconds{delay}, [&, delay]()
+                   { fired_at.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(timers.now() - start).count() - 12345); });
+    }
+    for (std::int64_t delay : delays)
+    {
+        timers.advance(start + 12345ms + std::chrono::milliseconds{delay - 1});
+        timers.advance(start + 12345ms + std::chrono::milliseconds{delay});
+    }
+    EXPECT_EQ(fired_at, delays);
+}
+
+TEST(timer_wheel, cancel)
+{
+    const auto start = io::timer_wheel::clock_t::now();
+    io::timer_wheel timers(start);
+    bool fired = false;
+    auto id = timers.arm(10ms, [&]() { fired = true; });
+    EXPECT_NE(id, io::timer_wheel::invalid_timer_id);
+    EXPECT_TRUE(timers.cancel(id));
+    EXPECT_FALSE(timers.cancel(id));
+    EXPECT_FALSE(timers.cancel(io::timer_wheel::invalid_timer_id));
+    timers.advance(start + 20ms);
+    EXPECT_FALSE(fired);
+
+    // the stale identifier does not cancel the reused node
+    auto id2 = timers.arm(10ms, [&]() { fired = true; });
+    EXPECT_NE(id, id2);
+    EXPECT_FALSE(timers.cancel(id));
+    timers.advance(start + 30ms);
+    EXPECT_TRUE(fired);
+    EXPECT_FALSE(timers.cancel(id2));
+}
+
+TEST(timer_wheel, rearm_and_cancel_from_callback)
+{
+    const auto start = io::timer_wheel::clock_t::now();
+    io::timer_wheel timers(start);
+    int periodic_calls = 0;
+    bool cancelled_fired = false;
+    io::timer_wheel::timer_id_t cancelled = timers.arm(2ms, [&]() { cancelled_fired = true; });
+    std::function<void()> periodic = [&]()
+    {
+        ++periodic_calls;
+        timers.cancel(cancelled);
+        if (periodic_calls < 3)
+        {
+            timers.arm(1ms, periodic);
+        }
+    };
+    timers.arm(0ms, periodic);
+    timers.advance(start + 1ms);
+    EXPECT_EQ(periodic_calls, 1);
+    timers.advance(start + 10ms);
+    EXPECT_EQ(periodic_calls, 3);
+    EXPECT_FALSE(cancelled_fired);
+    EXPECT_EQ(timers.size(), 0);
+}
+
+TEST(timer_wheel, callback_exception)
+{
+    const auto start = io::timer_wheel::clock_t::now();
+    io::timer_wheel timers(start);
+    bool fired = false;
+    timers.arm(1ms, [&]() { throw std::runtime_error("test error"); });
+    timers.arm(1ms, [&]() { fired = true; });
+    EXPECT_THROW(timers.advance(start + 1ms), std::runtime_error);
+    EXPECT_TRUE(fired);
+    EXPECT_EQ(timers.size(), 0);
+}
+
+TEST(timer_wheel, get_timeout)
+{
+    const auto start = io::timer_wheel::clock_t::now();
+    io::timer_wheel timers(start);
+    EXPECT_EQ(timers.get_timeout(10ms), 10ms);
+    EXPECT_EQ(timers.get_timeout(-1ms), -1ms);
+
+    auto id = timers.arm(5ms, nullptr);
+    EXPECT_EQ(timers.get_timeout(10ms), 5ms);
+    EXPECT_EQ(timers.get_timeout(3ms), 3ms);
+    EXPECT_EQ(timers.get_timeout(0ms), 0ms);
+    EXPECT_EQ(timers.get_timeout(-1ms), 5ms);
+    timers.cancel(id);
+
+    // the higher level timer wakes up the wheel on the lowest level rotation
+    timers.arm(100000ms, nullptr);
+    EXPECT_EQ(timers.get_timeout(-1ms), 256ms);
+    timers.advance(start + 56ms);
+    EXPECT_EQ(timers.get_timeout(-1ms), 200ms);
+}
+
+TEST(timer_wheel, many_timers)
+{
+    const auto start = io::timer_wheel::clock_t::now();
+    io::timer_wheel timers(start);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> delay(1, 100000);
+    const std::size_t count = 100000;
+    std::vector<io::timer_wheel::timer_id_t> ids;
+    ids.reserve(count);
+    std::size_t fired = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ids.push_back(timers.arm(std::chrono::milliseconds{delay(rng)}, [&]() { ++fired; }));
+    }
+    EXPECT_EQ(timers.size(), count);
+    for (std::size_t i = 0; i < count; i += 2)
+    {
+        EXPECT_TRUE(timers.cancel(ids[i]));
+    }
+    EXPECT_EQ(timers.size(), count / 2);
+    timers.advance(start + 100000ms);
+    EXPECT_EQ(fired, count / 2);
+    EXPECT_EQ(timers.size(), 0);
+}
@@ -0,0 +1,425 @@
+/// @file
+/// @author Oleg Abrosimov <olegabrosimovnsk@gmail.com>
+/// @copyright MIT
+
+#include <gtest/gtest.h>
+#include <io/uring.hpp>
+
+#include <chrono>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+    io::bus_ptr make_uring_bus(io::system::uring::event_mask_t event_mask = EPOLLIN | EPOLLOUT | EPOLLPRI | EPOLLET)
+    {
+        try
+        {
+            return std::make_shared<io::system::uring>(event_mask, 8);
+        }
+        catch (io::error &error)
+        {
+            // io_uring can be disabled by the kernel or the seccomp policy
+            if (ENOSYS == error.get_errno() || EPERM == error.get_errno())
+            {
+                return nullptr;
+            }
+            throw;
+        }
+    }
+
+    void no_error(io::event_reciever *, const io::error &error)
+    {
+        ADD_FAILURE() << error.what() << "; errno = " << error.get_errno() << " for fd = " << error.get_fd();
+    }
+}
+
+TEST(uring, in_out_events)
+{
+    io::bus_ptr bus = make_uring_bus();
+    if (!bus)
+    {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    int fds[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds));
+
+    io::flags events = io::flags::empty;
+    bus->add_fd(
+        fds[0],
+        [&](io::event_reciever *reciever, io::file_descriptor_t fd, io::flags mask)
+        {
+            EXPECT_EQ(fd, fds[0]);
+            EXPECT_EQ(reinterpret_cast<void *>(reciever), reinterpret_cast<void *>(bus.get()));
+            events |= mask;
+        });
+    bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+    EXPECT_TRUE(events.test(io::flags::out));
+    EXPECT_FALSE(events.test(io::flags::in));
+
+    // the multishot poll reports the next edge without re-registration
+    events = io::flags::empty;
+    ASSERT_EQ(1, ::write(fds[1], "x", 1));
+    bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+    EXPECT_TRUE(events.test(io::flags::in));
+
+    events = io::flags::empty;
+    ASSERT_EQ(1, ::write(fds[1], "y", 1));
+    bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+    EXPECT_TRUE(events.test(io::flags::in));
+
+    bus->del_fd(fds[0]);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(uring, del_fd_drops_events)
+{
+    io::bus_ptr bus = make_uring_bus();
+    if (!bus)
+    {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    int fds[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds));
+
+    int calls = 0;
+    bus->add_fd(
+        fds[0],
+        [&](io::event_reciever *, io::file_descriptor_t, io::flags)
+        {
+            ++calls;
+        });
+    bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+    EXPECT_EQ(calls, 1);
+
+    bus->del_fd(fds[0]);
+    ASSERT_EQ(1, ::write(fds[1], "x", 1));
+    bus->wait_events(std::chrono::milliseconds{10}, 16, no_error);
+    EXPECT_EQ(calls, 1);
+
+    // re-registration of the same fd works after the removal
+    bus->add_fd(
+        fds[0],
+        [&](io::event_reciever *, io::file_descriptor_t, io::flags mask)
+        {
+            EXPECT_TRUE(mask.test(io::flags::in));
+            ++calls;
+        });
+    bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+    EXPECT_EQ(calls, 2);
+
+    bus->del_fd(fds[0]);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(uring, timeout)
+{
+    io::bus_ptr bus = make_uring_bus();
+    if (!bus)
+    {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    const auto start = std::chrono::steady_clock::now();
+    bus->wait_events(std::chrono::milliseconds{20}, 16, no_error);
+    EXPECT_LE(std::chrono::milliseconds{15}, std::chrono::steady_clock::now() - start);
+}
+
+TEST(uring, del_unknown_fd)
+{
+    io::bus_ptr bus = make_uring_bus();
+    if (!bus)
+    {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    EXPECT_THROW(bus->del_fd(12345), io::error);
+}
+
+TEST(uring, submission_queue_overflow)
+{
+    io::bus_ptr bus = make_uring_bus();
+    if (!bus)
+    {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    // more registrations than the 8 entries submission queue size
+    const int pairs_count = 20;
+    int fds[pairs_count][2];
+    int calls = 0;
+    for (auto &pair : fds)
+    {
+        ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, pair));
+        bus->add_fd(
+            pair[0],
+            [&](io::event_reciever *, io::file_descriptor_t, io::flags)
+            {
+                ++calls;
+            });
+    }
+    bus->wait_events(std::chrono::milliseconds{100}, 64, no_error);
+    EXPECT_EQ(calls, pairs_count);
+    for (auto &pair : fds)
+    {
+        bus->del_fd(pair[0]);
+        ::close(pair[0]);
+        ::close(pair[1]);
+    }
+}
+
+TEST(uring, output_interest)
+{
+    io::bus_ptr bus = make_uring_bus(EPOLLIN | EPOLLPRI | EPOLLET);
+    if (!bus)
+    {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    int fds[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds));
+
+    io::flags events = io::flags::empty;
+    bus->add_fd(
+        fds[0],
+        [&](io::event_reciever *, io::file_descriptor_t, io::flags mask)
+        {
+            events |= mask;
+        });
+    bus->wait_events(std::chrono::milliseconds{50}, 16, no_error);
+    EXPECT_FALSE(events.test(io::flags::out));
+
+    bus->add_output_interest(fds[0]);
+    bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+    EXPECT_TRUE(events.test(io::flags::out));
+
+    bus->del_output_interest(fds[0]);
+    events = io::flags::empty;
+    ASSERT_EQ(1, ::write(fds[1], "x", 1));
+    bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+    EXPECT_TRUE(events.test(io::flags::in));
+    EXPECT_FALSE(events.test(io::flags::out));
+
+    bus->del_fd(fds[0]);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(uring, accept_connections)
+{
+    io::bus_ptr bus = make_uring_bus(EPOLLIN | EPOLLPRI | EPOLLET);
+    if (!bus)
+    {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    const int listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    ASSERT_NE(-1, listener);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(0, ::bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)));
+    socklen_t address_size = sizeof(address);
+    ASSERT_EQ(0, ::getsockname(listener, reinterpret_cast<sockaddr *>(&address), &address_size));
+    ASSERT_EQ(0, ::listen(listener, 16));
+
+    int calls = 0;
+    bus->add_fd(
+        listener,
+        [&](io::event_reciever *, io::file_descriptor_t fd, io::flags mask)
+        {
+            EXPECT_EQ(fd, listener);
+            EXPECT_TRUE(mask.test(io::flags::in));
+            ++calls;
+        });
+    EXPECT_FALSE(bus->is_accepting(listener));
+    bus->accept_connections(listener);
+    bus->wait_events(std::chrono::milliseconds{0}, 16, no_error);
+    ASSERT_TRUE(bus->is_accepting(listener));
+    EXPECT_EQ(bus->take_accepted(listener), -1);
+
+    int clients[3];
+    for (int &client : clients)
+    {
+        client = ::socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_EQ(0, ::connect(client, reinterpret_cast<const sockaddr *>(&address), sizeof(address)));
+    }
+    for (int i = 0; i < 10 && calls < 3; ++i)
+    {
+        bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+    }
+    EXPECT_EQ(calls, 3);
+    std::set<in_port_t> client_ports;
+    for (int client : clients)
+    {
+        sockaddr_in client_address = {};
+        socklen_t client_address_size = sizeof(client_address);
+        ASSERT_EQ(0, ::getsockname(client, reinterpret_cast<sockaddr *>(&client_address), &client_address_size));
+        client_ports.insert(client_address.sin_port);
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        // the peer address comes with the connection
+        sockaddr_in peer = {};
+        socklen_t peer_size = sizeof(peer);
+        const io::file_descriptor_t conn = bus->take_accepted(listener, reinterpret_cast<sockaddr *>(&peer), &peer_size);
+        ASSERT_NE(conn, -1);
+        EXPECT_TRUE(::fcntl(conn, F_GETFL) & O_NONBLOCK);
+        EXPECT_EQ(peer_size, sizeof(peer));
+        EXPECT_EQ(peer.sin_family, AF_INET);
+        EXPECT_EQ(client_ports.erase(peer.sin_port), 1);
+        ::close(conn);
+    }
+    EXPECT_EQ(bus->take_accepted(listener), -1);
+
+    // the removed listener reports no more connections
+    bus->del_fd(listener);
+    EXPECT_FALSE(bus->is_accepting(listener));
+    const int late = ::socket(AF_INET, SOCK_STREAM, 0);
+    ::connect(late, reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+    bus->wait_events(std::chrono::milliseconds{10}, 16, no_error);
+    EXPECT_EQ(calls, 3);
+
+    ::close(late);
+    for (int client : clients)
+    {
+        ::close(client);
+    }
+    ::close(listener);
+}
+
+TEST(uring, receive_data)
+{
+    io::bus_ptr bus = make_uring_bus();
+    if (!bus)
+    {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    int fds[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds));
+
+    int inputs = 0;
+    bus->add_fd(
+        fds[0],
+        [&](io::event_reciever *, io::file_descriptor_t, io::flags mask)
+        {
+            inputs += mask.test(io::flags::in) ? 1 : 0;
+        });
+    bus->receive_data(fds[0]);
+    bus->wait_events(std::chrono::milliseconds{0}, 16, no_error);
+    if (!bus->is_receiving(fds[0]))
+    {
+        bus->del_fd(fds[0]);
+        ::close(fds[0]);
+        ::close(fds[1]);
+        GTEST_SKIP() << "io_uring multishot receive is not available";
+    }
+    char head[3] = {};
+    char tail[16] = {};
+    const struct iovec iov[2] = {{head, sizeof(head)}, {tail, sizeof(tail)}};
+    EXPECT_EQ(bus->take_received(fds[0], iov, 2), -1);
+    EXPECT_EQ(errno, EAGAIN);
+    // the poll events may come before the input readiness is dropped from the poll request
+    auto take = [&](int iovcnt)
+    {
+        ssize_t len = bus->take_received(fds[0], iov, iovcnt);
+        for (int i = 0; i < 10 && -1 == len && EAGAIN == errno; ++i)
+        {
+            const int before = inputs;
+            bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+            EXPECT_NE(inputs, before);
+            len = bus->take_received(fds[0], iov, iovcnt);
+        }
+        return len;
+    };
+
+    // the received data is copied to the buffers in order
+    ASSERT_EQ(5, ::write(fds[1], "hello", 5));
+    ASSERT_EQ(take(2), 5);
+    EXPECT_EQ(std::string(head, sizeof(head)), "hel");
+    EXPECT_EQ(std::string(tail, 2), "lo");
+    EXPECT_EQ(bus->take_received(fds[0], iov, 2), -1);
+    EXPECT_EQ(errno, EAGAIN);
+
+    // the data above the buffers size is taken by the next call
+    ASSERT_EQ(4, ::write(fds[1], "abcd", 4));
+    ASSERT_EQ(take(1), 3);
+    EXPECT_EQ(std::string(head, sizeof(head)), "abc");
+    ASSERT_EQ(bus->take_received(fds[0], iov, 1), 1);
+    EXPECT_EQ(head[0], 'd');
+
+    // the end of the stream is reported as the recv call does
+    ASSERT_EQ(0, ::shutdown(fds[1], SHUT_WR));
+    EXPECT_EQ(take(2), 0);
+
+    bus->del_fd(fds[0]);
+    EXPECT_FALSE(bus->is_receiving(fds[0]));
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(uring, send_data)
+{
+    io::bus_ptr bus = make_uring_bus();
+    if (!bus)
+    {
+        GTEST_SKIP() << "io_uring is not available";
+    }
+    int fds[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds));
+
+    io::flags events = io::flags::empty;
+    bus->add_fd(
+        fds[0],
+        [&](io::event_reciever *, io::file_descriptor_t, io::flags mask)
+        {
+            events |= mask;
+        });
+    bus->wait_events(std::chrono::milliseconds{50}, 16, no_error);
+    EXPECT_TRUE(events.test(io::flags::out));
+    bus->send_data(fds[0]);
+    EXPECT_TRUE(bus->is_sending(fds[0]));
+    // the output readiness is not watched anymore
+    bus->wait_events(std::chrono::milliseconds{50}, 16, no_error);
+    events = io::flags::empty;
+    ASSERT_EQ(1, ::write(fds[1], "x", 1));
+    bus->wait_events(std::chrono::milliseconds{50}, 16, no_error);
+    EXPECT_FALSE(events.test(io::flags::out));
+
+    const struct iovec iov[2] = {{const_cast<char *>("ab"), 2}, {const_cast<char *>("cd"), 2}};
+    EXPECT_EQ(bus->queue_send(fds[0], iov, 2), 4);
+    EXPECT_EQ(bus->get_unsent_bytes(fds[0]), 4);
+    // one send is in flight
+    EXPECT_EQ(bus->queue_send(fds[0], iov, 2), -1);
+    EXPECT_EQ(errno, EAGAIN);
+    for (int i = 0; i < 10 && !events.test(io::flags::out); ++i)
+    {
+        bus->wait_events(std::chrono::milliseconds{100}, 16, no_error);
+    }
+    EXPECT_TRUE(events.test(io::flags::out));
+    EXPECT_EQ(bus->get_unsent_bytes(fds[0]), 0);
+    char buf[8] = {};
+    ASSERT_EQ(4, ::read(fds[1], buf, sizeof(buf)));
+    EXPECT_EQ(std::string(buf, 4), "abcd");
+
+    // the send error is reported by the error event and the next send
+    ::close(fds[1]);
+    events = io::flags::empty;
+    EXPECT_EQ(bus->queue_send(fds[0], iov, 1), 2);
+    for (int i = 0; i < 10 && !events.test(io::flags::error); ++i)
+    {
+        bus->wait_events(std::chrono::milliseconds{100}, 16, [](io::event_reciever *, const io::error &) {});
+    }
+    EXPECT_TRUE(events.test(io::flags::error));
+    EXPECT_EQ(bus->queue_send(fds[0], iov, 1), -1);
+    EXPECT_EQ(errno, EPIPE);
+
+    bus->del_fd(fds[0]);
+    EXPECT_FALSE(bus->is_sending(fds[0]));
+    ::close(fds[0]);
+}